@@ -50,6 +50,17 @@ static CDC_LineEncoding_t LineEncoding = { .BaudRateBPS = 0,
  */
 static uint32_t CurrAddress;
 
+#if !defined(NO_BLOCK_SUPPORT) && !defined(NO_BACKGROUND_FLASH_WRITES)
+/** Buffer for the FLASH page of a block write command currently being received from the host. */
+static uint8_t PageBuffer[SPM_PAGESIZE];
+
+/** Address of the block write page being programmed while the rest of the block is received. */
+static uint32_t FlashWriteAddress;
+
+/** Current step of the block write page programming, a value from the \ref FlashPageWriteStates_t enum. */
+static uint8_t FlashWriteState = FLASH_PAGE_WRITE_Idle;
+#endif
+
 /** Flag to indicate if the bootloader should be running, or should exit and allow the application code to run
  *  via a watchdog reset. When cleared the bootloader will exit, starting the watchdog and entering an infinite
  *  loop until the AVR restarts and the application runs.
@@ -279,7 +290,6 @@ static void ReadWriteMemoryBlock(const uint8_t Command)
 	char     MemoryType;
 
 	uint8_t  HighByte = 0;
-	uint8_t  LowByte  = 0;
 
 	BlockSize  = (FetchNextCommandByte() << 8);
 	BlockSize |=  FetchNextCommandByte();
@@ -324,21 +334,27 @@ static void ReadWriteMemoryBlock(const uint8_t Command)
 			}
 		}
 	}
-	else
+	else if (MemoryType == MEMORY_TYPE_FLASH)
 	{
-		uint32_t PageStartAddress = CurrAddress;
-
-		if (MemoryType == MEMORY_TYPE_FLASH)
-		  BootloaderAPI_ErasePage(PageStartAddress);
+		#if defined(NO_BACKGROUND_FLASH_WRITES)
+		uint8_t LowByte = 0;
 
-		while (BlockSize--)
+		while (BlockSize)
 		{
-			if (MemoryType == MEMORY_TYPE_FLASH)
+			uint16_t PageOffset  = (CurrAddress & (SPM_PAGESIZE - 1));
+			uint16_t PageBytes   = MIN(BlockSize, (SPM_PAGESIZE - PageOffset));
+			uint32_t PageAddress = (CurrAddress - PageOffset);
+
+			BlockSize -= PageBytes;
+
+			/* Erase the page before filling the AVR's temporary page buffer, as re-enabling the RWW section clears it */
+			BootloaderAPI_ErasePage(PageAddress);
+
+			while (PageBytes--)
 			{
-				/* If both bytes in current word have been written, increment the address counter */
+				/* If both bytes in current word have been received, write the word to the current FLASH page */
 				if (HighByte)
 				{
-					/* Write the next FLASH word to the current FLASH page */
 					BootloaderAPI_FillWord(CurrAddress, ((FetchNextCommandByte() << 8) | LowByte));
 
 					/* Increment the address counter after use */
@@ -351,21 +367,50 @@ static void ReadWriteMemoryBlock(const uint8_t Command)
 
 				HighByte = !HighByte;
 			}
-			else
-			{
-				/* Write the next EEPROM byte from the endpoint */
-				eeprom_update_byte((uint8_t*)((intptr_t)(CurrAddress >> 1)), FetchNextCommandByte());
 
-				/* Increment the address counter after use */
-				CurrAddress += 2;
-			}
+			/* Commit the flash page to memory */
+			BootloaderAPI_WritePage(PageAddress);
 		}
 
-		/* If in FLASH programming mode, commit the page after writing */
-		if (MemoryType == MEMORY_TYPE_FLASH)
+		/* Send response byte back to the host */
+		WriteNextResponseByte('\r');
+		#else
+		while (BlockSize)
 		{
-			/* Commit the flash page to memory */
-			BootloaderAPI_WritePage(PageStartAddress);
+			uint16_t PageOffset = (CurrAddress & (SPM_PAGESIZE - 1));
+			uint16_t PageBytes  = MIN(BlockSize, (SPM_PAGESIZE - PageOffset));
+
+			/* Receive the next page from the host while the previous page is still being programmed, leaving any bytes
+			 * not covered by the block erased */
+			memset(PageBuffer, 0xFF, sizeof(PageBuffer));
+			FetchNextCommandBlock(&PageBuffer[PageOffset], PageBytes);
+
+			/* Start programming the received page, which completes in the background */
+			StartFlashPageWrite(CurrAddress - PageOffset);
+
+			/* Increment the address counter after use */
+			CurrAddress += PageBytes;
+			BlockSize   -= PageBytes;
+		}
+
+		/* Send response byte back to the host without waiting for the last page to finish programming */
+		WriteNextResponseByte('\r');
+		#endif
+	}
+	else
+	{
+		#if !defined(NO_BACKGROUND_FLASH_WRITES)
+		/* EEPROM cannot be written while a FLASH page is still being programmed */
+		FinishFlashPageWrite();
+		#endif
+
+		while (BlockSize--)
+		{
+			/* Write the next EEPROM byte from the endpoint */
+			eeprom_update_byte((uint8_t*)((intptr_t)(CurrAddress >> 1)), FetchNextCommandByte());
+
+			/* Increment the address counter after use */
+			CurrAddress += 2;
 		}
 
 		/* Send response byte back to the host */
@@ -374,6 +419,108 @@ static void ReadWriteMemoryBlock(const uint8_t Command)
 }
 #endif
 
+#if !defined(NO_BLOCK_SUPPORT) && !defined(NO_BACKGROUND_FLASH_WRITES)
+/** Retrieves a block of bytes from the host in the CDC data OUT endpoint, a packet at a time. Any pending background
+ *  FLASH page programming is advanced while waiting for each packet from the host.
+ *
+ *  \param[out] Buffer  Pointer to the destination buffer for the received bytes
+ *  \param[in]  Length  Number of bytes to retrieve from the host
+ */
+static void FetchNextCommandBlock(uint8_t* Buffer,
+                                  uint16_t Length)
+{
+	/* Select the OUT endpoint so that the next data bytes can be read */
+	Endpoint_SelectEndpoint(CDC_RX_EPADDR);
+
+	while (Length)
+	{
+		/* If OUT endpoint empty, clear it and wait for the next packet from the host */
+		if (!(Endpoint_IsReadWriteAllowed()))
+		{
+			Endpoint_ClearOUT();
+
+			while (!(Endpoint_IsOUTReceived()))
+			{
+				if (USB_DeviceState == DEVICE_STATE_Unattached)
+				  return;
+
+				ContinueFlashPageWrite();
+			}
+
+			continue;
+		}
+
+		/* Copy out as much of the current packet as is needed */
+		uint16_t PacketBytes = MIN(Endpoint_BytesInEndpoint(), Length);
+		Length -= PacketBytes;
+
+		while (PacketBytes--)
+		  *(Buffer++) = Endpoint_Read_8();
+	}
+}
+
+/** Loads the received block write page into the AVR's temporary page buffer and starts erasing it, once the
+ *  previous page of the block has been programmed.
+ *
+ *  \param[in] PageAddress  Byte address of the FLASH page to program
+ */
+static void StartFlashPageWrite(const uint32_t PageAddress)
+{
+	FinishFlashPageWrite();
+
+	/* Pages within the bootloader section cannot be programmed */
+	if (PageAddress >= (uint32_t)BOOT_START_ADDR)
+	  return;
+
+	/* Load the AVR's temporary page buffer, which is retained across the following page erase */
+	for (uint16_t PageByte = 0; PageByte < SPM_PAGESIZE; PageByte += 2)
+	{
+		uint16_t Word = (PageBuffer[PageByte] | (PageBuffer[PageByte + 1] << 8));
+
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			boot_page_fill_safe(PageAddress + PageByte, Word);
+		}
+	}
+
+	FlashWriteAddress = PageAddress;
+	FlashWriteState   = FLASH_PAGE_WRITE_Erasing;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		boot_page_erase_safe(PageAddress);
+	}
+}
+
+/** Moves the block write page being programmed on to its write or RWW re-enable step, once the SPM unit is idle. */
+static void ContinueFlashPageWrite(void)
+{
+	if ((FlashWriteState == FLASH_PAGE_WRITE_Idle) || boot_spm_busy())
+	  return;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if (FlashWriteState == FLASH_PAGE_WRITE_Erasing)
+		{
+			boot_page_write(FlashWriteAddress);
+			FlashWriteState = FLASH_PAGE_WRITE_Writing;
+		}
+		else
+		{
+			boot_rww_enable();
+			FlashWriteState = FLASH_PAGE_WRITE_Idle;
+		}
+	}
+}
+
+/** Waits for the last block write page to be programmed, before any command other than another block write. */
+static void FinishFlashPageWrite(void)
+{
+	while (FlashWriteState != FLASH_PAGE_WRITE_Idle)
+	  ContinueFlashPageWrite();
+}
+#endif
+
 /** Retrieves the next byte from the host in the CDC data OUT endpoint, and clears the endpoint bank if needed
  *  to allow reception of the next data packet from the host.
  *
@@ -393,6 +540,10 @@ static uint8_t FetchNextCommandByte(void)
 		{
 			if (USB_DeviceState == DEVICE_STATE_Unattached)
 			  return 0;
+
+			#if !defined(NO_BLOCK_SUPPORT) && !defined(NO_BACKGROUND_FLASH_WRITES)
+			ContinueFlashPageWrite();
+			#endif
 		}
 	}
 
@@ -431,6 +582,11 @@ static void WriteNextResponseByte(const uint8_t Response)
  */
 static void CDC_Task(void)
 {
+	#if !defined(NO_BLOCK_SUPPORT) && !defined(NO_BACKGROUND_FLASH_WRITES)
+	/* Advance any FLASH page programming left running in the background by the last block write */
+	ContinueFlashPageWrite();
+	#endif
+
 	/* Select the OUT endpoint */
 	Endpoint_SelectEndpoint(CDC_RX_EPADDR);
 
@@ -441,6 +597,12 @@ static void CDC_Task(void)
 	/* Read in the bootloader command (first byte sent from host) */
 	uint8_t Command = FetchNextCommandByte();
 
+	#if !defined(NO_BLOCK_SUPPORT) && !defined(NO_BACKGROUND_FLASH_WRITES)
+	/* Only further FLASH block writes may overlap the programming of the last written page */
+	if (Command != AVR109_COMMAND_BlockWrite)
+	  FinishFlashPageWrite();
+	#endif
+
 	if (Command == AVR109_COMMAND_ExitBootloader)
 	{
 		RunBootloader = false;
@@ -544,8 +706,8 @@ static void CDC_Task(void)
 		WriteNextResponseByte('Y');
 
 		/* Send block size to the host */
-		WriteNextResponseByte(SPM_PAGESIZE >> 8);
-		WriteNextResponseByte(SPM_PAGESIZE & 0xFF);
+		WriteNextResponseByte(BLOCK_TRANSFER_SIZE >> 8);
+		WriteNextResponseByte(BLOCK_TRANSFER_SIZE & 0xFF);
 	}
 	else if ((Command == AVR109_COMMAND_BlockWrite) || (Command == AVR109_COMMAND_BlockRead))
 	{
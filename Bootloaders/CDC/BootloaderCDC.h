@@ -44,7 +44,9 @@
 		#include <avr/power.h>
 		#include <avr/interrupt.h>
 		#include <util/delay.h>
+		#include <util/atomic.h>
 		#include <stdbool.h>
+		#include <string.h>
 
 		#include "Descriptors.h"
 		#include "BootloaderAPI.h"
@@ -59,6 +61,10 @@
 			#error This bootloader requires that it be optimized for size, not speed, to fit into the target device. Change optimization settings and try again.
 		#endif
 
+		#if ((FLASHEND + 1 - BOOT_START_ADDR) <= 4096) && !defined(NO_BACKGROUND_FLASH_WRITES)
+			#define NO_BACKGROUND_FLASH_WRITES
+		#endif
+
 	/* Macros: */
 		/** Version major of the CDC bootloader. */
 		#define BOOTLOADER_VERSION_MAJOR     0x01
@@ -78,6 +84,16 @@
 		/** Magic bootloader key to unlock forced application start mode. */
 		#define MAGIC_BOOT_KEY               0xDC42
 
+		#if !defined(BLOCK_TRANSFER_PAGES) || defined(__DOXYGEN__)
+			/** Number of FLASH pages in the maximum memory block size reported to the host, for the memory block read and
+			 *  write commands. This may be overridden in the bootloader's \c AppConfig.h configuration header.
+			 */
+			#define BLOCK_TRANSFER_PAGES     4
+		#endif
+
+		/** Maximum size in bytes of a memory block read or write command, reported to the host when requested. */
+		#define BLOCK_TRANSFER_SIZE          (BLOCK_TRANSFER_PAGES * SPM_PAGESIZE)
+
 	/* Enums: */
 		/** Possible memory types that can be addressed via the bootloader. */
 		enum AVR109_Memories
@@ -86,6 +102,14 @@
 			MEMORY_TYPE_EEPROM = 'E',
 		};
 
+		/** Possible steps of programming a block write page in the background. */
+		enum FlashPageWriteStates_t
+		{
+			FLASH_PAGE_WRITE_Idle      = 0, /**< No block write page is being programmed. */
+			FLASH_PAGE_WRITE_Erasing   = 1, /**< Page is being erased. */
+			FLASH_PAGE_WRITE_Writing   = 2, /**< Page is being written. */
+		};
+
 		/** Possible commands that can be issued to the bootloader. */
 		enum AVR109_Commands
 		{
@@ -137,6 +161,13 @@
 			#if !defined(NO_BLOCK_SUPPORT)
 			static void    ReadWriteMemoryBlock(const uint8_t Command);
 			#endif
+			#if !defined(NO_BLOCK_SUPPORT) && !defined(NO_BACKGROUND_FLASH_WRITES)
+			static void    FetchNextCommandBlock(uint8_t* Buffer,
+			                                     uint16_t Length);
+			static void    StartFlashPageWrite(const uint32_t PageAddress);
+			static void    ContinueFlashPageWrite(void);
+			static void    FinishFlashPageWrite(void);
+			#endif
 			static uint8_t FetchNextCommandByte(void);
 			static void    WriteNextResponseByte(const uint8_t Response);
 		#endif
@@ -43,6 +43,8 @@
 #define _APP_CONFIG_H_
 
 //	#define NO_BLOCK_SUPPORT
+//	#define BLOCK_TRANSFER_PAGES        4
+//	#define NO_BACKGROUND_FLASH_WRITES
 //	#define NO_EEPROM_BYTE_SUPPORT
 //	#define NO_FLASH_BYTE_SUPPORT
 //	#define NO_LOCK_BYTE_WRITE_SUPPORT
@@ -92,6 +92,17 @@ static uint16_t StartAddr = 0x0000;
  */
 static uint16_t EndAddr = 0x0000;
 
+#if (BACKGROUND_FLASH_WRITES)
+/** Buffer for the FLASH page currently being downloaded from the host. */
+static uint8_t PageBuffer[SPM_PAGESIZE];
+
+/** Address of the downloaded FLASH page being programmed, if any. */
+static uint32_t FlashWriteAddress;
+
+/** Current step of the downloaded page programming, a value from the \ref FlashPageWriteStates_t enum. */
+static uint8_t FlashWriteState = FLASH_PAGE_WRITE_Idle;
+#endif
+
 /** Magic lock for forced application start. If the HWBE fuse is programmed and BOOTRST is unprogrammed, the bootloader
  *  will start if the /HWB line of the AVR is held low and the system is reset. However, if the /HWB line is still held
  *  low when the application attempts to start via a watchdog reset, the bootloader will re-start. If set to the value
@@ -189,7 +200,13 @@ int main(void)
 
 	/* Run the USB management task while the bootloader is supposed to be running */
 	while (RunBootloader || WaitForExit)
-	  USB_USBTask();
+	{
+		USB_USBTask();
+		ContinueFlashPageWrite();
+	}
+
+	/* Make sure the last FLASH page has been programmed before the application is started */
+	FinishFlashPageWrite();
 
 	/* Wait a short time to end all USB transactions and then disconnect */
 	_delay_us(1000);
@@ -327,6 +344,59 @@ void EVENT_USB_Device_ControlRequest(void)
 
 					if (IS_ONEBYTE_COMMAND(SentCommand.Data, 0x00))        // Write flash
 					{
+						#if (BACKGROUND_FLASH_WRITES)
+						/* Only whole words can be written to the flash */
+						BytesRemaining &= ~0x0001;
+
+						union
+						{
+							uint16_t Words[2];
+							uint32_t Long;
+						} CurrFlashAddress = {.Words = {StartAddr, Flash64KBPage}};
+
+						while (BytesRemaining)
+						{
+							uint16_t PageOffset  = (CurrFlashAddress.Words[0] & (SPM_PAGESIZE - 1));
+							uint16_t PageBytes   = MIN(BytesRemaining, (SPM_PAGESIZE - PageOffset));
+							uint32_t PageAddress = (CurrFlashAddress.Long - PageOffset);
+							uint8_t* PageData    = &PageBuffer[PageOffset];
+
+							/* Adjust counters */
+							BytesRemaining        -= PageBytes;
+							CurrFlashAddress.Long += PageBytes;
+
+							/* Receive the next page while the previous page is still being programmed, leaving any bytes
+							 * not covered by the write erased */
+							memset(PageBuffer, 0xFF, sizeof(PageBuffer));
+
+							while (PageBytes)
+							{
+								/* Check if endpoint is empty - if so clear it and wait until ready for next packet */
+								if (!(Endpoint_BytesInEndpoint()))
+								{
+									Endpoint_ClearOUT();
+
+									while (!(Endpoint_IsOUTReceived()))
+									{
+										if (USB_DeviceState == DEVICE_STATE_Unattached)
+										  return;
+
+										ContinueFlashPageWrite();
+									}
+								}
+
+								/* Copy out as much of the current packet as is needed for the page */
+								uint8_t PacketBytes = MIN(PageBytes, Endpoint_BytesInEndpoint());
+								PageBytes -= PacketBytes;
+
+								while (PacketBytes--)
+								  *(PageData++) = Endpoint_Read_8();
+							}
+
+							/* Start programming the received page into the flash */
+							StartFlashPageWrite(PageAddress);
+						}
+						#else
 						/* Calculate the number of words to be written from the number of bytes to be written */
 						uint16_t WordsRemaining = (BytesRemaining >> 1);
 
@@ -377,6 +447,7 @@ void EVENT_USB_Device_ControlRequest(void)
 								}
 							}
 						}
+						#endif
 
 						/* Once programming complete, start address equals the end address */
 						StartAddr = EndAddr;
@@ -418,6 +489,9 @@ void EVENT_USB_Device_ControlRequest(void)
 		case DFU_REQ_UPLOAD:
 			Endpoint_ClearSETUP();
 
+			/* Memory cannot be read back until the last FLASH page has been programmed */
+			FinishFlashPageWrite();
+
 			while (!(Endpoint_IsINReady()))
 			{
 				if (USB_DeviceState == DEVICE_STATE_Unattached)
@@ -454,7 +528,7 @@ void EVENT_USB_Device_ControlRequest(void)
 						uint32_t Long;
 					} CurrFlashAddress = {.Words = {StartAddr, Flash64KBPage}};
 
-					while (WordsRemaining--)
+					while (WordsRemaining)
 					{
 						/* Check if endpoint is full - if so clear it and wait until ready for next packet */
 						if (Endpoint_BytesInEndpoint() == FIXED_CONTROL_ENDPOINT_SIZE)
@@ -468,15 +542,22 @@ void EVENT_USB_Device_ControlRequest(void)
 							}
 						}
 
-						/* Read the flash word and send it via USB to the host */
-						#if (FLASHEND > 0xFFFF)
-							Endpoint_Write_16_LE(pgm_read_word_far(CurrFlashAddress.Long));
-						#else
-							Endpoint_Write_16_LE(pgm_read_word(CurrFlashAddress.Long));
-						#endif
+						/* Fill the remainder of the current packet in one pass */
+						uint8_t PacketWords = MIN(WordsRemaining, ((FIXED_CONTROL_ENDPOINT_SIZE - Endpoint_BytesInEndpoint()) >> 1));
+						WordsRemaining -= PacketWords;
+
+						while (PacketWords--)
+						{
+							/* Read the flash word and send it via USB to the host */
+							#if (FLASHEND > 0xFFFF)
+								Endpoint_Write_16_LE(pgm_read_word_far(CurrFlashAddress.Long));
+							#else
+								Endpoint_Write_16_LE(pgm_read_word(CurrFlashAddress.Long));
+							#endif
 
-						/* Adjust counters */
-						CurrFlashAddress.Long += 2;
+							/* Adjust counters */
+							CurrFlashAddress.Long += 2;
+						}
 					}
 
 					/* Once reading is complete, start address equals the end address */
@@ -484,7 +565,7 @@ void EVENT_USB_Device_ControlRequest(void)
 				}
 				else if (IS_ONEBYTE_COMMAND(SentCommand.Data, 0x02))       // Read EEPROM
 				{
-					while (BytesRemaining--)
+					while (BytesRemaining)
 					{
 						/* Check if endpoint is full - if so clear it and wait until ready for next packet */
 						if (Endpoint_BytesInEndpoint() == FIXED_CONTROL_ENDPOINT_SIZE)
@@ -498,11 +579,18 @@ void EVENT_USB_Device_ControlRequest(void)
 							}
 						}
 
-						/* Read the EEPROM byte and send it via USB to the host */
-						Endpoint_Write_8(eeprom_read_byte((uint8_t*)StartAddr));
+						/* Fill the remainder of the current packet in one pass */
+						uint8_t PacketBytes = MIN(BytesRemaining, (FIXED_CONTROL_ENDPOINT_SIZE - Endpoint_BytesInEndpoint()));
+						BytesRemaining -= PacketBytes;
+
+						while (PacketBytes--)
+						{
+							/* Read the EEPROM byte and send it via USB to the host */
+							Endpoint_Write_8(eeprom_read_byte((uint8_t*)StartAddr));
 
-						/* Adjust counters */
-						StartAddr++;
+							/* Adjust counters */
+							StartAddr++;
+						}
 					}
 				}
 
@@ -523,15 +611,34 @@ void EVENT_USB_Device_ControlRequest(void)
 				  return;
 			}
 
-			/* Write 8-bit status value */
-			Endpoint_Write_8(DFU_Status);
+			{
+				uint8_t PollTimeout = 0;
+				uint8_t State       = DFU_State;
 
-			/* Write 24-bit poll timeout value */
-			Endpoint_Write_8(0);
-			Endpoint_Write_16_LE(0);
+				#if (BACKGROUND_FLASH_WRITES)
+				/* Report the time needed to finish programming the last FLASH page, during which the device is busy */
+				if (FlashWriteState != FLASH_PAGE_WRITE_Idle)
+				{
+					PollTimeout = FLASH_PAGE_PROGRAM_TIME_MS;
 
-			/* Write 8-bit state value */
-			Endpoint_Write_8(DFU_State);
+					if (FlashWriteState == FLASH_PAGE_WRITE_Erasing)
+					  PollTimeout += FLASH_PAGE_PROGRAM_TIME_MS;
+
+					if (State == dfuDNLOAD_IDLE)
+					  State = dfuDNBUSY;
+				}
+				#endif
+
+				/* Write 8-bit status value */
+				Endpoint_Write_8(DFU_Status);
+
+				/* Write 24-bit poll timeout value */
+				Endpoint_Write_8(PollTimeout);
+				Endpoint_Write_16_LE(0);
+
+				/* Write 8-bit state value */
+				Endpoint_Write_8(State);
+			}
 
 			/* Write 8-bit state string ID number */
 			Endpoint_Write_8(0);
@@ -628,6 +735,10 @@ static void ProcessBootloaderCommand(void)
 		}
 	}
 
+	/* Only further FLASH programming may overlap the programming of the last received FLASH page */
+	if (!((SentCommand.Command == COMMAND_PROG_START) && IS_ONEBYTE_COMMAND(SentCommand.Data, 0x00)))
+	  FinishFlashPageWrite();
+
 	/* Dispatch the required command processing routine based on the command type */
 	switch (SentCommand.Command)
 	{
@@ -679,6 +790,7 @@ static void ProcessMemProgCommand(void)
 		/* Load in the start and ending read addresses */
 		LoadStartEndAddresses();
 
+		#if !(BACKGROUND_FLASH_WRITES)
 		/* If FLASH is being written to, we need to pre-erase the first page to write to */
 		if (IS_ONEBYTE_COMMAND(SentCommand.Data, 0x00))
 		{
@@ -691,6 +803,7 @@ static void ProcessMemProgCommand(void)
 			/* Erase the current page's temp buffer */
 			BootloaderAPI_ErasePage(CurrFlashAddress.Long);
 		}
+		#endif
 
 		/* Set the state so that the next DNLOAD requests reads in the firmware */
 		DFU_State = dfuDNLOAD_IDLE;
@@ -842,3 +955,65 @@ static void ProcessReadCommand(void)
 		DFU_Status = errADDRESS;
 	}
 }
+
+#if (BACKGROUND_FLASH_WRITES)
+/** Fills the AVR's temporary page buffer from \ref PageBuffer and starts erasing the given page, once the previous
+ *  downloaded page has been programmed.
+ *
+ *  \param[in] PageAddress  Byte address of the FLASH page to program
+ */
+static void StartFlashPageWrite(const uint32_t PageAddress)
+{
+	FinishFlashPageWrite();
+
+	/* Pages within the bootloader section cannot be programmed */
+	if (PageAddress >= (uint32_t)BOOT_START_ADDR)
+	  return;
+
+	/* Load the AVR's temporary page buffer, which is retained across a page erase */
+	for (uint16_t PageByte = 0; PageByte < SPM_PAGESIZE; PageByte += 2)
+	  BootloaderAPI_FillWord(PageAddress + PageByte, (PageBuffer[PageByte] | (PageBuffer[PageByte + 1] << 8)));
+
+	FlashWriteAddress = PageAddress;
+	FlashWriteState   = FLASH_PAGE_WRITE_Erasing;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		boot_page_erase_safe(PageAddress);
+	}
+}
+#endif
+
+/** Steps the downloaded page programming each time the SPM unit becomes idle. Does nothing unless
+ *  \c BACKGROUND_FLASH_WRITES is enabled.
+ */
+static void ContinueFlashPageWrite(void)
+{
+	#if (BACKGROUND_FLASH_WRITES)
+	if ((FlashWriteState == FLASH_PAGE_WRITE_Idle) || boot_spm_busy())
+	  return;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if (FlashWriteState == FLASH_PAGE_WRITE_Erasing)
+		{
+			boot_page_write(FlashWriteAddress);
+			FlashWriteState = FLASH_PAGE_WRITE_Writing;
+		}
+		else
+		{
+			boot_rww_enable();
+			FlashWriteState = FLASH_PAGE_WRITE_Idle;
+		}
+	}
+	#endif
+}
+
+/** Waits for the last downloaded page to be programmed, before memory is read back or the application is started. */
+static void FinishFlashPageWrite(void)
+{
+	#if (BACKGROUND_FLASH_WRITES)
+	while (FlashWriteState != FLASH_PAGE_WRITE_Idle)
+	  ContinueFlashPageWrite();
+	#endif
+}
@@ -46,6 +46,7 @@
 		#include <avr/interrupt.h>
 		#include <util/delay.h>
 		#include <stdbool.h>
+		#include <string.h>
 
 		#include "Descriptors.h"
 		#include "BootloaderAPI.h"
@@ -107,6 +108,11 @@
 		 */
 		#define DFU_FILLER_BYTES_SIZE    26
 
+		/** Maximum time in milliseconds taken by a single FLASH page erase or write, used to calculate the poll timeout
+		 *  reported to the host while a page is being programmed.
+		 */
+		#define FLASH_PAGE_PROGRAM_TIME_MS 5
+
 		/** DFU class command request to detach from the host. */
 		#define DFU_REQ_DETATCH          0x00
 
@@ -194,6 +200,14 @@
 			errSTALLEDPKT                = 15
 		};
 
+		/** Possible steps of programming a downloaded FLASH page, during which \c dfuDNBUSY is reported to the host. */
+		enum FlashPageWriteStates_t
+		{
+			FLASH_PAGE_WRITE_Idle        = 0, /**< No downloaded page is being programmed. */
+			FLASH_PAGE_WRITE_Erasing     = 1, /**< Page is being erased, with two page programming times remaining. */
+			FLASH_PAGE_WRITE_Writing     = 2, /**< Page is being written, with one page programming time remaining. */
+		};
+
 	/* Function Prototypes: */
 		static void SetupHardware(void);
 		static void ResetHardware(void);
@@ -208,6 +222,11 @@
 			static void ProcessMemReadCommand(void);
 			static void ProcessWriteCommand(void);
 			static void ProcessReadCommand(void);
+			#if (BACKGROUND_FLASH_WRITES)
+			static void StartFlashPageWrite(const uint32_t PageAddress);
+			#endif
+			static void ContinueFlashPageWrite(void);
+			static void FinishFlashPageWrite(void);
 		#endif
 
 		void Application_Jump_Check(void) ATTR_INIT_SECTION(3);
@@ -44,5 +44,6 @@
 #define _APP_CONFIG_H_
 
 	#define SECURE_MODE              false
+	#define BACKGROUND_FLASH_WRITES  false
 
 #endif
@@ -39,9 +39,13 @@
 #include <string.h>
 #include <unistd.h>
 
+#if defined USE_WIN32
+#define strcasecmp stricmp
+#endif
+
 void usage(void)
 {
-	fprintf(stderr, "Usage: hid_bootloader_cli -mmcu=<MCU> [-w] [-h] [-n] [-v] <file.hex>\n");
+	fprintf(stderr, "Usage: hid_bootloader_cli -mmcu=<MCU> [-w] [-h] [-n] [-v] <file.hex|file.bin>\n");
 	fprintf(stderr, "\t-w : Wait for device to appear\n");
 	fprintf(stderr, "\t-r : Use hard reboot if device not online\n");
 	fprintf(stderr, "\t-n : No reboot after programming\n");
@@ -59,13 +63,15 @@ void usage(void)
 // USB Access Functions
 int teensy_open(void);
 int teensy_write(void *buf, int len, double timeout);
+int teensy_write_async(void *buf, int len, double timeout);
+int teensy_flush_writes(void);
 void teensy_close(void);
 int hard_reboot(void);
 
 // Intel Hex File Functions
 int read_intel_hex(const char *filename);
-int ihex_bytes_within_range(int begin, int end);
 void ihex_get_data(int addr, int len, unsigned char *bytes);
+int ihex_image_end(void);
 
 // Misc stuff
 int printf_verbose(const char *format, ...);
@@ -91,7 +97,7 @@ const char *filename=NULL;
 int main(int argc, char **argv)
 {
 	unsigned char buf[260];
-	int num, addr, r, first_block=1, waited=0;
+	int num, addr, r, first_block=1, waited=0, skipped=0, image_end;
 
 	// parse command line arguments
 	parse_options(argc, argv);
@@ -143,12 +149,16 @@ int main(int argc, char **argv)
 	// program the data
 	printf_verbose("Programming");
 	fflush(stdout);
+	image_end = ihex_image_end();
 	for (addr = 0; addr < code_size; addr += block_size) {
-		if (addr > 0 && !ihex_bytes_within_range(addr, addr + block_size - 1)) {
-			// don't waste time on blocks that are unused,
-			// but always do the first one to erase the chip
+		if (addr > 0 && addr >= image_end) {
+			// don't waste time on blocks beyond the end of the image,
+			// but send every block within it, even if blank, as the
+			// bootloader only erases the pages it is sent
+			skipped++;
 			continue;
 		}
+		ihex_get_data(addr, block_size, buf + 2);
 		printf_verbose(".");
 		if (code_size < 0x10000) {
 			buf[0] = addr & 255;
@@ -157,12 +167,19 @@ int main(int argc, char **argv)
 			buf[0] = (addr >> 8) & 255;
 			buf[1] = (addr >> 16) & 255;
 		}
-		ihex_get_data(addr, block_size, buf + 2);
-		r = teensy_write(buf, block_size + 2, first_block ? 3.0 : 0.25);
+		if (first_block) {
+			r = teensy_write(buf, block_size + 2, 3.0);
+		} else {
+			// queue the block behind any still being written, so the
+			// device never waits on us between blocks
+			r = teensy_write_async(buf, block_size + 2, 0.25);
+		}
 		if (!r) die("error writing to Teensy\n");
 		first_block = 0;
 	}
+	if (!teensy_flush_writes()) die("error writing to Teensy\n");
 	printf_verbose("\n");
+	if (skipped) printf_verbose("Skipped %d blocks beyond the end of the image\n", skipped);
 
 	// reboot to the user's new code
 	if (reboot_after_programming) {
@@ -298,6 +315,162 @@ int hard_reboot(void)
 #endif
 
 
+/****************************************************************/
+/*                                                              */
+/*            USB Access - libusb-1.0 (Linux & FreeBSD)         */
+/*                                                              */
+/****************************************************************/
+
+#if defined(USE_LIBUSB1)
+
+// http://libusb.sourceforge.io/api-1.0/
+#include <libusb.h>
+
+// number of block writes kept queued in the USB stack at once
+#define MAX_WRITES_IN_FLIGHT 4
+
+struct pending_write {
+	struct libusb_transfer *transfer;
+	int busy;
+	unsigned char buf[LIBUSB_CONTROL_SETUP_SIZE + 260];
+};
+
+static libusb_context *libusb1_context = NULL;
+static libusb_device_handle *libusb1_teensy_handle = NULL;
+static struct pending_write pending_writes[MAX_WRITES_IN_FLIGHT];
+static int pending_write_count = 0;
+static int pending_write_error = 0;
+
+libusb_device_handle * open_usb_device(int vid, int pid)
+{
+	libusb_device_handle *h;
+	int r;
+
+	if (!libusb1_context && libusb_init(&libusb1_context) < 0) return NULL;
+	h = libusb_open_device_with_vid_pid(libusb1_context, vid, pid);
+	if (!h) return NULL;
+	// let libusb detach the kernel's HID driver while we own the interface
+	libusb_set_auto_detach_kernel_driver(h, 1);
+	r = libusb_claim_interface(h, 0);
+	if (r < 0) {
+		libusb_close(h);
+		printf_verbose("Unable to claim interface, check USB permissions");
+		return NULL;
+	}
+	return h;
+}
+
+static void LIBUSB_CALL write_complete(struct libusb_transfer *transfer)
+{
+	struct pending_write *w = transfer->user_data;
+
+	if (transfer->status != LIBUSB_TRANSFER_COMPLETED) pending_write_error = 1;
+	w->busy = 0;
+	pending_write_count--;
+}
+
+static int wait_for_writes(int max_pending)
+{
+	// each transfer carries its own timeout, so this always returns
+	while (pending_write_count > max_pending) {
+		if (libusb_handle_events(libusb1_context) < 0) return 0;
+	}
+	return !pending_write_error;
+}
+
+int teensy_open(void)
+{
+	teensy_close();
+	libusb1_teensy_handle = open_usb_device(0x16C0, 0x0478);
+
+	if (!libusb1_teensy_handle)
+		libusb1_teensy_handle = open_usb_device(0x03eb, 0x2067);
+
+	if (!libusb1_teensy_handle) return 0;
+	return 1;
+}
+
+int teensy_write_async(void *buf, int len, double timeout)
+{
+	struct pending_write *w;
+	int i;
+
+	if (!libusb1_teensy_handle) return 0;
+	if (!wait_for_writes(MAX_WRITES_IN_FLIGHT - 1)) return 0;
+	for (i=0; pending_writes[i].busy; i++) ;
+	w = &pending_writes[i];
+	if (!w->transfer) {
+		w->transfer = libusb_alloc_transfer(0);
+		if (!w->transfer) return 0;
+	}
+	libusb_fill_control_setup(w->buf, 0x21, 9, 0x0200, 0, len);
+	memcpy(w->buf + LIBUSB_CONTROL_SETUP_SIZE, buf, len);
+	libusb_fill_control_transfer(w->transfer, libusb1_teensy_handle, w->buf,
+		write_complete, w, (unsigned int)(timeout * 1000.0));
+	if (libusb_submit_transfer(w->transfer) < 0) return 0;
+	w->busy = 1;
+	pending_write_count++;
+	return 1;
+}
+
+int teensy_flush_writes(void)
+{
+	int r;
+
+	if (!libusb1_teensy_handle) return 0;
+	r = wait_for_writes(0);
+	pending_write_error = 0;
+	return r;
+}
+
+int teensy_write(void *buf, int len, double timeout)
+{
+	int r;
+
+	if (!teensy_flush_writes()) return 0;
+	r = libusb_control_transfer(libusb1_teensy_handle, 0x21, 9, 0x0200, 0, buf,
+		len, (unsigned int)(timeout * 1000.0));
+	if (r < 0) return 0;
+	return 1;
+}
+
+void teensy_close(void)
+{
+	int i;
+
+	if (!libusb1_teensy_handle) return;
+	teensy_flush_writes();
+	for (i=0; i<MAX_WRITES_IN_FLIGHT; i++) {
+		libusb_free_transfer(pending_writes[i].transfer);
+		pending_writes[i].transfer = NULL;
+	}
+	libusb_release_interface(libusb1_teensy_handle, 0);
+	libusb_close(libusb1_teensy_handle);
+	libusb1_teensy_handle = NULL;
+}
+
+int hard_reboot(void)
+{
+	libusb_device_handle *rebootor;
+	int r;
+
+	rebootor = open_usb_device(0x16C0, 0x0477);
+
+	if (!rebootor)
+		rebootor = open_usb_device(0x03eb, 0x2067);
+
+	if (!rebootor) return 0;
+	r = libusb_control_transfer(rebootor, 0x21, 9, 0x0200, 0,
+		(unsigned char *)"reboot", 6, 100);
+	libusb_release_interface(rebootor, 0);
+	libusb_close(rebootor);
+	if (r < 0) return 0;
+	return 1;
+}
+
+#endif
+
+
 /****************************************************************/
 /*                                                              */
 /*               USB Access - Microsoft WIN32                   */
@@ -751,6 +924,133 @@ int hard_reboot(void)
 #endif
 
 
+/****************************************************************/
+/*                                                              */
+/*              USB Access - Loopback Device Model              */
+/*                                                              */
+/****************************************************************/
+
+#if defined(USE_LOOPBACK)
+
+// A local model of the bootloader, so the loader's throughput can be
+// measured without hardware. Each block write is modelled as its data
+// stage in 64 byte control packets followed by the device's page erase
+// and write. A write issued only once the previous one has completed
+// also pays the host's turnaround before its SETUP is sent, which a
+// queued write does not.
+#define LOOPBACK_PACKET_US        60
+#define LOOPBACK_PAGE_PROGRAM_US  8000
+#define LOOPBACK_TURNAROUND_US    1000
+
+static unsigned char loopback_flash[0x20000];
+static int loopback_open = 0;
+static int loopback_queued = 0;
+static int loopback_pages = 0;
+static double loopback_time_us = 0;
+
+static int loopback_transfer(const unsigned char *buf, int len)
+{
+	int addr;
+
+	if (!loopback_open) return 0;
+	if (!loopback_queued) loopback_time_us += LOOPBACK_TURNAROUND_US;
+	loopback_time_us += ((len + 63) / 64) * LOOPBACK_PACKET_US;
+	if (buf[0] == 0xFF && buf[1] == 0xFF) return 1;  // start application
+	if (code_size < 0x10000) {
+		addr = buf[0] | (buf[1] << 8);
+	} else {
+		addr = (buf[0] << 8) | (buf[1] << 16);
+	}
+	if (addr % block_size || addr + len - 2 > (int)sizeof(loopback_flash)) return 0;
+	memcpy(loopback_flash + addr, buf + 2, len - 2);
+	loopback_time_us += LOOPBACK_PAGE_PROGRAM_US;
+	loopback_pages++;
+	return 1;
+}
+
+int teensy_open(void)
+{
+	teensy_close();
+	// start from a previous application's code rather than erased
+	// flash, so that any page of the image not sent is noticed
+	memset(loopback_flash, 0x5A, sizeof(loopback_flash));
+	loopback_open = 1;
+	loopback_queued = 0;
+	loopback_pages = 0;
+	loopback_time_us = 0;
+	return 1;
+}
+
+int teensy_write(void *buf, int len, double timeout)
+{
+	(void)timeout;
+	loopback_queued = 0;
+	return loopback_transfer(buf, len);
+}
+
+int teensy_write_async(void *buf, int len, double timeout)
+{
+	int r;
+
+	(void)timeout;
+	r = loopback_transfer(buf, len);
+	loopback_queued = 1;
+	return r;
+}
+
+int teensy_flush_writes(void)
+{
+	loopback_queued = 0;
+	return loopback_open;
+}
+
+void teensy_close(void)
+{
+	const char *image;
+	FILE *fp;
+
+	if (!loopback_open) return;
+	loopback_open = 0;
+	if (loopback_time_us > 0) {
+		printf_verbose("Loopback: %d pages in %.1f ms, %.1f KB/s\n",
+			loopback_pages, loopback_time_us / 1000.0,
+			loopback_pages * block_size / loopback_time_us * 1000000.0 / 1024.0);
+	}
+
+	// optionally save the programmed flash, to check it against the image
+	image = getenv("HID_LOOPBACK_IMAGE");
+	if (!image) return;
+	fp = fopen(image, "wb");
+	if (!fp) die("unable to write loopback image \"%s\"", image);
+	fwrite(loopback_flash, 1, code_size, fp);
+	fclose(fp);
+}
+
+int hard_reboot(void)
+{
+	return 1;
+}
+
+#endif
+
+
+#if !defined(USE_LIBUSB1) && !defined(USE_LOOPBACK)
+
+// without asynchronous transfers, each block is written immediately
+
+int teensy_write_async(void *buf, int len, double timeout)
+{
+	return teensy_write(buf, len, timeout);
+}
+
+int teensy_flush_writes(void)
+{
+	return 1;
+}
+
+#endif
+
+
 
 /****************************************************************/
 /*                                                              */
@@ -768,135 +1068,183 @@ static unsigned char firmware_mask[MAX_MEMORY_SIZE];
 static int end_record_seen=0;
 static int byte_count;
 static unsigned int extended_addr = 0;
-static int parse_hex_line(char *line);
+static int parse_hex_line(const char *line, int len);
 
-int read_intel_hex(const char *filename)
+#if !defined(USE_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
+
+// map the whole file into memory, so it can be parsed in place
+static const char * map_file(const char *filename, size_t *size)
 {
+	#if defined(USE_WIN32)
 	FILE *fp;
-	int i, lineno=0;
-	char buf[1024];
+	char *data;
+	long len;
+
+	fp = fopen(filename, "rb");
+	if (fp == NULL) return NULL;
+	fseek(fp, 0, SEEK_END);
+	len = ftell(fp);
+	rewind(fp);
+	data = malloc(len > 0 ? len : 1);
+	if (data == NULL || len < 0 || fread(data, 1, len, fp) != (size_t)len) {
+		free(data);
+		fclose(fp);
+		return NULL;
+	}
+	fclose(fp);
+	*size = len;
+	return data;
+	#else
+	struct stat st;
+	void *data;
+	int fd;
+
+	fd = open(filename, O_RDONLY);
+	if (fd < 0) return NULL;
+	if (fstat(fd, &st) < 0) {
+		close(fd);
+		return NULL;
+	}
+	*size = st.st_size;
+	if (*size == 0) {
+		close(fd);
+		return "";
+	}
+	data = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) return NULL;
+	return data;
+	#endif
+}
+
+static void unmap_file(const char *data, size_t size)
+{
+	#if defined(USE_WIN32)
+	free((void *)data);
+	#else
+	if (size) munmap((void *)data, size);
+	#endif
+}
+
+// raw binary images are loaded from address zero
+static int is_binary_file(const char *filename)
+{
+	size_t len = strlen(filename);
+
+	return (len > 4 && strcasecmp(filename + len - 4, ".bin") == 0);
+}
+
+int read_intel_hex(const char *filename)
+{
+	const char *data, *line, *eol, *end;
+	size_t size;
+	int len;
 
 	byte_count = 0;
 	end_record_seen = 0;
-	for (i=0; i<MAX_MEMORY_SIZE; i++) {
-		firmware_image[i] = 0xFF;
-		firmware_mask[i] = 0;
-	}
+	memset(firmware_image, 0xFF, sizeof(firmware_image));
+	memset(firmware_mask, 0, sizeof(firmware_mask));
 	extended_addr = 0;
 
-	fp = fopen(filename, "r");
-	if (fp == NULL) {
+	data = map_file(filename, &size);
+	if (data == NULL) {
 		//printf("Unable to read file %s\n", filename);
 		return -1;
 	}
-	while (!feof(fp)) {
-		*buf = '\0';
-		if (!fgets(buf, sizeof(buf), fp)) break;
-		lineno++;
-		if (*buf) {
-			if (parse_hex_line(buf) == 0) {
-				//printf("Warning, parse error line %d\n", lineno);
-				fclose(fp);
-				return -2;
-			}
+	if (is_binary_file(filename)) {
+		if (size > MAX_MEMORY_SIZE) {
+			unmap_file(data, size);
+			return -2;
 		}
-		if (end_record_seen) break;
-		if (feof(stdin)) break;
+		memcpy(firmware_image, data, size);
+		memset(firmware_mask, 1, size);
+		byte_count = size;
+		unmap_file(data, size);
+		return byte_count;
 	}
-	fclose(fp);
+	end = data + size;
+	for (line = data; line < end && !end_record_seen; line = eol + 1) {
+		eol = memchr(line, '\n', end - line);
+		if (eol == NULL) eol = end;
+		len = eol - line;
+		while (len > 0 && (line[len - 1] == '\r' || line[len - 1] == ' ')) len--;
+		if (len == 0) continue;
+		if (parse_hex_line(line, len) == 0) {
+			//printf("Warning, parse error at offset %d\n", (int)(line - data));
+			unmap_file(data, size);
+			return -2;
+		}
+	}
+	unmap_file(data, size);
 	return byte_count;
 }
 
 
-/* from ihex.c, at http://www.pjrc.com/tech/8051/pm2_docs/intel-hex.html */
-
-/* parses a line of intel hex code, stores the data in bytes[] */
-/* and the beginning address in addr, and returns a 1 if the */
-/* line was valid, or a 0 if an error occurred.  The variable */
-/* num gets the number of bytes that were stored into bytes[] */
-
-
-int
-parse_hex_line(char *line)
-{
-	int addr, code, num;
-        int sum, len, cksum, i;
-        char *ptr;
-
-        num = 0;
-        if (line[0] != ':') return 0;
-        if (strlen(line) < 11) return 0;
-        ptr = line+1;
-        if (!sscanf(ptr, "%02x", &len)) return 0;
-        ptr += 2;
-        if ((int)strlen(line) < (11 + (len * 2)) ) return 0;
-        if (!sscanf(ptr, "%04x", &addr)) return 0;
-        ptr += 4;
-          /* printf("Line: length=%d Addr=%d\n", len, addr); */
-        if (!sscanf(ptr, "%02x", &code)) return 0;
-	if (addr + extended_addr + len >= MAX_MEMORY_SIZE) return 0;
-        ptr += 2;
-        sum = (len & 255) + ((addr >> 8) & 255) + (addr & 255) + (code & 255);
-	if (code != 0) {
-		if (code == 1) {
-			end_record_seen = 1;
-			return 1;
-		}
-		if (code == 2 && len == 2) {
-			if (!sscanf(ptr, "%04x", &i)) return 1;
-			ptr += 4;
-			sum += ((i >> 8) & 255) + (i & 255);
-        		if (!sscanf(ptr, "%02x", &cksum)) return 1;
-			if (((sum & 255) + (cksum & 255)) & 255) return 1;
-			extended_addr = i << 4;
-			//printf("ext addr = %05X\n", extended_addr);
-		}
-		if (code == 4 && len == 2) {
-			if (!sscanf(ptr, "%04x", &i)) return 1;
-			ptr += 4;
-			sum += ((i >> 8) & 255) + (i & 255);
-        		if (!sscanf(ptr, "%02x", &cksum)) return 1;
-			if (((sum & 255) + (cksum & 255)) & 255) return 1;
-			extended_addr = i << 16;
-			//printf("ext addr = %08X\n", extended_addr);
-		}
-		return 1;	// non-data line
-	}
-	byte_count += len;
-        while (num != len) {
-                if (sscanf(ptr, "%02x", &i) != 1) return 0;
-		i &= 255;
-		firmware_image[addr + extended_addr + num] = i;
-		firmware_mask[addr + extended_addr + num] = 1;
-                ptr += 2;
-                sum += i;
-                (num)++;
-                if (num >= 256) return 0;
-        }
-        if (!sscanf(ptr, "%02x", &cksum)) return 0;
-        if (((sum & 255) + (cksum & 255)) & 255) return 0; /* checksum error */
-        return 1;
-}
-
-int ihex_bytes_within_range(int begin, int end)
+/* decodes a pair of hex digits, or returns -1 if either is invalid */
+static int hex_byte(const char *ptr)
 {
-	int i;
+	int i, digit, value = 0;
+
+	for (i=0; i<2; i++) {
+		if (ptr[i] >= '0' && ptr[i] <= '9') digit = ptr[i] - '0';
+		else if (ptr[i] >= 'A' && ptr[i] <= 'F') digit = ptr[i] - 'A' + 10;
+		else if (ptr[i] >= 'a' && ptr[i] <= 'f') digit = ptr[i] - 'a' + 10;
+		else return -1;
+		value = (value << 4) | digit;
+	}
+	return value;
+}
+
+/* based on ihex.c, at http://www.pjrc.com/tech/8051/pm2_docs/intel-hex.html */
+
+/* parses a line of intel hex code of the given length, stores its */
+/* data in firmware_image[], and returns a 1 if the line was valid, */
+/* or a 0 if an error occurred. */
 
-	if (begin < 0 || begin >= MAX_MEMORY_SIZE ||
-	   end < 0 || end >= MAX_MEMORY_SIZE) {
-		return 0;
+
+static int
+parse_hex_line(const char *line, int len)
+{
+	unsigned char record[260];	// length, address, type, data, checksum
+	int addr, code, num, i, b, sum;
+
+	if (line[0] != ':' || len < 11) return 0;
+	if ((num = hex_byte(line + 1)) < 0) return 0;
+	if (len < 11 + (num * 2)) return 0;
+	for (i=0, sum=0; i<num + 5; i++) {
+		if ((b = hex_byte(line + 1 + (i * 2))) < 0) return 0;
+		record[i] = b;
+		sum += b;
 	}
-	for (i=begin; i<=end; i++) {
-		if (firmware_mask[i]) return 1;
+	if (sum & 255) return 0; /* checksum error */
+	addr = (record[1] << 8) | record[2];
+	code = record[3];
+	if (code == 1) {
+		end_record_seen = 1;
+	} else if (code == 2 && num == 2) {
+		extended_addr = ((record[4] << 8) | record[5]) << 4;
+		//printf("ext addr = %05X\n", extended_addr);
+	} else if (code == 4 && num == 2) {
+		extended_addr = ((record[4] << 8) | record[5]) << 16;
+		//printf("ext addr = %08X\n", extended_addr);
+	} else if (code == 0) {
+		if (addr + extended_addr + num > MAX_MEMORY_SIZE) return 0;
+		memcpy(firmware_image + addr + extended_addr, record + 4, num);
+		memset(firmware_mask + addr + extended_addr, 1, num);
+		byte_count += num;
 	}
-	return 0;
+	return 1;	// other record types are ignored
 }
 
 void ihex_get_data(int addr, int len, unsigned char *bytes)
 {
 	int i;
 
-	if (addr < 0 || len < 0 || addr + len >= MAX_MEMORY_SIZE) {
+	if (addr < 0 || len < 0 || addr + len > MAX_MEMORY_SIZE) {
 		for (i=0; i<len; i++) {
 			bytes[i] = 255;
 		}
@@ -912,6 +1260,17 @@ void ihex_get_data(int addr, int len, unsigned char *bytes)
 	}
 }
 
+// returns the address just past the last byte of data in the image
+int ihex_image_end(void)
+{
+	int addr;
+
+	for (addr = MAX_MEMORY_SIZE; addr > 0; addr--) {
+		if (firmware_mask[addr - 1]) break;
+	}
+	return addr;
+}
+
 /****************************************************************/
 /*                                                              */
 /*                       Misc Functions                         */
@@ -954,10 +1313,6 @@ void die(const char *str, ...)
 	exit(1);
 }
 
-#if defined USE_WIN32
-#define strcasecmp stricmp
-#endif
-
 void parse_options(int argc, char **argv)
 {
 	int i;
@@ -55,7 +55,7 @@ USB_ClassInfo_MS_Device_t Disk_MS_Interface =
 					{
 						.Address           = MASS_STORAGE_OUT_EPADDR,
 						.Size              = MASS_STORAGE_IO_EPSIZE,
-						.Banks             = 1,
+						.Banks             = (BACKGROUND_FLASH_WRITES ? 2 : 1),
 					},
 				.TotalLUNs                 = 1,
 			},
@@ -167,8 +167,13 @@ int main(void)
 	{
 		MS_Device_USBTask(&Disk_MS_Interface);
 		USB_USBTask();
+
+		VirtualFAT_ContinueFLASHWrite();
 	}
 
+	/* Ensure the last written FLASH page has been fully programmed before the application is started */
+	VirtualFAT_FinishFLASHWrite();
+
 	/* Wait a short time to end all USB transactions and then disconnect */
 	_delay_us(1000);
 
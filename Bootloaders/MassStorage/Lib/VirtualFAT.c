@@ -195,6 +195,14 @@ static const uint16_t* FLASHFileStartCluster  = &FirmwareFileEntries[DISK_FILE_E
  */
 static const uint16_t* EEPROMFileStartCluster = &FirmwareFileEntries[DISK_FILE_ENTRY_EEPROM_MSDOS].MSDOS_File.StartingCluster;
 
+#if (BACKGROUND_FLASH_WRITES)
+/** Address of the firmware file page being programmed, if any. */
+static uint32_t FlashWriteAddress;
+
+/** Current step of the firmware file page programming, a value from the \ref FlashPageWriteStates_t enum. */
+static uint8_t FlashWriteState = FLASH_PAGE_WRITE_Idle;
+#endif
+
 /** Reads a byte of EEPROM out from the EEPROM memory space.
  *
  *  \note This function is required as the avr-libc EEPROM functions do not cope
@@ -291,26 +299,82 @@ static void UpdateFAT12ClusterChain(uint8_t* const FATTable,
 	}
 }
 
-/** Reads or writes a block of data from/to the physical device FLASH using a
- *  block buffer stored in RAM, if the requested block is within the virtual
- *  firmware file's sector ranges in the emulated FAT file system.
+#if (BACKGROUND_FLASH_WRITES)
+/** Steps the firmware file page programming each time the SPM unit becomes idle, from the bootloader main loop. */
+void VirtualFAT_ContinueFLASHWrite(void)
+{
+	if ((FlashWriteState == FLASH_PAGE_WRITE_Idle) || boot_spm_busy())
+	  return;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if (FlashWriteState == FLASH_PAGE_WRITE_Erasing)
+		{
+			boot_page_write(FlashWriteAddress);
+			FlashWriteState = FLASH_PAGE_WRITE_Writing;
+		}
+		else
+		{
+			boot_rww_enable();
+			FlashWriteState = FLASH_PAGE_WRITE_Idle;
+		}
+	}
+}
+
+/** Waits for the last firmware file page to be programmed, before the FLASH or EEPROM is accessed again. */
+void VirtualFAT_FinishFLASHWrite(void)
+{
+	while (FlashWriteState != FLASH_PAGE_WRITE_Idle)
+	  VirtualFAT_ContinueFLASHWrite();
+}
+#endif
+
+/** Programs the given FLASH page from the filled temporary page buffer. With \c BACKGROUND_FLASH_WRITES only the
+ *  page erase is started here; otherwise the page must already have been erased.
  *
- *  \param[in]      BlockNumber  Physical disk block to read from/write to
- *  \param[in,out]  BlockBuffer  Pointer to the start of the block buffer in RAM
- *  \param[in]      Read         If \c true, the requested block is read, if
- *                               \c false, the requested block is written
+ *  \param[in] PageAddress  Byte address of the FLASH page to program
+ */
+static void StartFLASHPageWrite(const uint32_t PageAddress)
+{
+	#if (BACKGROUND_FLASH_WRITES)
+	/* Pages outside the application section cannot be programmed */
+	if (!(IsPageAddressValid(PageAddress)))
+	  return;
+
+	FlashWriteAddress = PageAddress;
+	FlashWriteState   = FLASH_PAGE_WRITE_Erasing;
+
+	/* The temporary page buffer is retained across the page erase, and written once the erase completes */
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		boot_page_erase_safe(PageAddress);
+	}
+	#else
+	BootloaderAPI_WritePage(PageAddress);
+	#endif
+}
+
+/** Reads or writes a block of data from/to the physical device FLASH directly from/to the Mass Storage data
+ *  endpoint, if the requested block is within the virtual firmware file's sector ranges in the emulated FAT
+ *  file system. Written data is loaded into the AVR's temporary page buffer word by word as it arrives, with
+ *  each page programmed once it has been filled.
+ *
+ *  \param[in]  BlockNumber  Physical disk block to read from/write to
+ *  \param[in]  Read         If \c true, the requested block is read, if
+ *                           \c false, the requested block is written
+ *
+ *  \return Boolean \c true if the block was part of the virtual firmware file and was transferred, \c false otherwise.
  */
-static void ReadWriteFLASHFileBlock(const uint16_t BlockNumber,
-                                    uint8_t* BlockBuffer,
+static bool ReadWriteFLASHFileBlock(const uint16_t BlockNumber,
                                     const bool Read)
 {
 	uint16_t FileStartBlock = DISK_BLOCK_DataStartBlock + (*FLASHFileStartCluster - 2) * SECTOR_PER_CLUSTER;
 	uint16_t FileEndBlock   = FileStartBlock + (FILE_SECTORS(FLASH_FILE_SIZE_BYTES) - 1);
 
-	/* Range check the write request - abort if requested block is not within the
-	 * virtual firmware file sector range */
-	if (!((BlockNumber >= FileStartBlock) && (BlockNumber <= FileEndBlock)))
-	  return;
+	/* Range check the request - abort if requested block is not within the
+	 * virtual firmware file sector range, or is one of the file system blocks */
+	if ((BlockNumber < DISK_BLOCK_DataStartBlock) || !((BlockNumber >= FileStartBlock) && (BlockNumber <= FileEndBlock)))
+	  return false;
 
 	#if (FLASHEND > 0xFFFF)
 	uint32_t FlashAddress = (uint32_t)(BlockNumber - FileStartBlock) * SECTOR_SIZE_BYTES;
@@ -318,40 +382,65 @@ static void ReadWriteFLASHFileBlock(const uint16_t BlockNumber,
 	uint16_t FlashAddress = (uint16_t)(BlockNumber - FileStartBlock) * SECTOR_SIZE_BYTES;
 	#endif
 
-	if (Read)
+	/* FLASH cannot be read back or reprogrammed until the previous page has finished programming */
+	VirtualFAT_FinishFLASHWrite();
+
+	if (Endpoint_WaitUntilReady())
+	  return true;
+
+	for (uint16_t i = 0; i < SECTOR_SIZE_BYTES; i += 2)
 	{
-		/* Read out the mapped block of data from the device's FLASH */
-		for (uint16_t i = 0; i < SECTOR_SIZE_BYTES; i++)
+		/* Move on to the next endpoint bank once the current one has been completely filled or emptied */
+		if (!(Endpoint_IsReadWriteAllowed()))
+		{
+			if (Read)
+			  Endpoint_ClearIN();
+			else
+			  Endpoint_ClearOUT();
+
+			if (Endpoint_WaitUntilReady())
+			  return true;
+		}
+
+		if (Read)
 		{
+			/* Send the next word of the mapped block of data from the device's FLASH */
 			#if (FLASHEND > 0xFFFF)
-			  BlockBuffer[i] = pgm_read_byte_far(FlashAddress++);
+			  Endpoint_Write_16_LE(pgm_read_word_far(FlashAddress));
 			#else
-			  BlockBuffer[i] = pgm_read_byte(FlashAddress++);
+			  Endpoint_Write_16_LE(pgm_read_word(FlashAddress));
 			#endif
 		}
-	}
-	else
-	{
-		/* Write out the mapped block of data to the device's FLASH */
-		for (uint16_t i = 0; i < SECTOR_SIZE_BYTES; i += 2)
+		else
 		{
 			if ((FlashAddress % SPM_PAGESIZE) == 0)
 			{
-				/* Erase the given FLASH page, ready to be programmed */
+				#if (BACKGROUND_FLASH_WRITES)
+				/* Wait for the previous page to finish programming before the page buffer is reloaded */
+				VirtualFAT_FinishFLASHWrite();
+				#else
+				/* Erase the page before it is filled, as re-enabling the RWW section after the erase clears the page buffer */
 				BootloaderAPI_ErasePage(FlashAddress);
+				#endif
 			}
 
-			/* Write the next data word to the FLASH page */
-			BootloaderAPI_FillWord(FlashAddress, (BlockBuffer[i + 1] << 8) | BlockBuffer[i]);
-			FlashAddress += 2;
+			/* Load the next data word from the host into the FLASH page buffer */
+			BootloaderAPI_FillWord(FlashAddress, Endpoint_Read_16_LE());
 
-			if ((FlashAddress % SPM_PAGESIZE) == 0)
-			{
-				/* Write the filled FLASH page to memory */
-				BootloaderAPI_WritePage(FlashAddress - SPM_PAGESIZE);
-			}
+			/* Program the page once it has been filled, while the host sends the next page */
+			if (((FlashAddress + 2) % SPM_PAGESIZE) == 0)
+			  StartFLASHPageWrite(FlashAddress + 2 - SPM_PAGESIZE);
 		}
+
+		FlashAddress += 2;
 	}
+
+	if (Read)
+	  Endpoint_ClearIN();
+	else
+	  Endpoint_ClearOUT();
+
+	return true;
 }
 
 /** Reads or writes a block of data from/to the physical device EEPROM using a
@@ -398,6 +487,13 @@ static void ReadWriteEEPROMFileBlock(const uint16_t BlockNumber,
  */
 void VirtualFAT_WriteBlock(const uint16_t BlockNumber)
 {
+	/* Firmware file blocks are programmed directly from the endpoint, without buffering the block */
+	if (ReadWriteFLASHFileBlock(BlockNumber, false))
+	  return;
+
+	/* EEPROM cannot be written while a FLASH page is being programmed */
+	VirtualFAT_FinishFLASHWrite();
+
 	uint8_t BlockBuffer[SECTOR_SIZE_BYTES];
 
 	/* Buffer the entire block to be written from the host */
@@ -420,7 +516,6 @@ void VirtualFAT_WriteBlock(const uint16_t BlockNumber)
 			break;
 
 		default:
-			ReadWriteFLASHFileBlock(BlockNumber, BlockBuffer, false);
 			ReadWriteEEPROMFileBlock(BlockNumber, BlockBuffer, false);
 
 			break;
@@ -434,6 +529,13 @@ void VirtualFAT_WriteBlock(const uint16_t BlockNumber)
  */
 void VirtualFAT_ReadBlock(const uint16_t BlockNumber)
 {
+	/* Firmware file blocks are sent directly from FLASH, without buffering the block */
+	if (ReadWriteFLASHFileBlock(BlockNumber, true))
+	  return;
+
+	/* EEPROM cannot be read while a FLASH page is being programmed */
+	VirtualFAT_FinishFLASHWrite();
+
 	uint8_t BlockBuffer[SECTOR_SIZE_BYTES];
 	memset(BlockBuffer, 0x00, sizeof(BlockBuffer));
 
@@ -470,7 +572,6 @@ void VirtualFAT_ReadBlock(const uint16_t BlockNumber)
 			break;
 
 		default:
-			ReadWriteFLASHFileBlock(BlockNumber, BlockBuffer, true);
 			ReadWriteEEPROMFileBlock(BlockNumber, BlockBuffer, true);
 
 			break;
@@ -43,6 +43,13 @@
 		/** Size of the virtual FLASH.BIN file in bytes. */
 		#define FLASH_FILE_SIZE_BYTES     (FLASHEND - (FLASHEND - BOOT_START_ADDR) - AUX_BOOT_SECTION_SIZE)
 
+		/** Indicates if FLASH pages written by the host are erased and programmed in the background while the next
+		 *  page is received, rather than stalling the transfer for each page. This is only possible when the whole
+		 *  bootloader resides in the NRWW section, as code in the auxiliary bootloader section cannot be executed
+		 *  while the RWW section is busy.
+		 */
+		#define BACKGROUND_FLASH_WRITES   (AUX_BOOT_SECTION_SIZE == 0)
+
 		/** Size of the virtual EEPROM.BIN file in bytes. */
 		#define EEPROM_FILE_SIZE_BYTES    E2END
 
@@ -272,6 +279,14 @@
 			} MSDOS_Directory;
 		} FATDirectoryEntry_t;
 
+		/** Possible steps of programming a firmware file page while the next block is received. */
+		enum FlashPageWriteStates_t
+		{
+			FLASH_PAGE_WRITE_Idle        = 0, /**< No firmware file page is being programmed. */
+			FLASH_PAGE_WRITE_Erasing     = 1, /**< Page is being erased, keeping the filled temporary page buffer. */
+			FLASH_PAGE_WRITE_Writing     = 2, /**< Page is being written. */
+		};
+
 	/* Function Prototypes: */
 		#if defined(INCLUDE_FROM_VIRTUAL_FAT_C)
 			static uint8_t ReadEEPROMByte(const uint8_t* const Address) ATTR_NO_INLINE;
@@ -287,8 +302,9 @@
 			                                    const uint16_t StartIndex,
 			                                    const uint8_t ChainLength) AUX_BOOT_SECTION;
 
-			static void ReadWriteFLASHFileBlock(const uint16_t BlockNumber,
-			                                    uint8_t* BlockBuffer,
+			static void StartFLASHPageWrite(const uint32_t PageAddress) AUX_BOOT_SECTION;
+
+			static bool ReadWriteFLASHFileBlock(const uint16_t BlockNumber,
 			                                    const bool Read) AUX_BOOT_SECTION;
 
 			static void ReadWriteEEPROMFileBlock(const uint16_t BlockNumber,
@@ -299,4 +315,15 @@
 		void VirtualFAT_WriteBlock(const uint16_t BlockNumber) AUX_BOOT_SECTION;
 		void VirtualFAT_ReadBlock(const uint16_t BlockNumber) AUX_BOOT_SECTION;
 
+		#if (BACKGROUND_FLASH_WRITES)
+			void VirtualFAT_ContinueFLASHWrite(void);
+			void VirtualFAT_FinishFLASHWrite(void);
+		#endif
+
+	/* Inline Functions: */
+		#if !(BACKGROUND_FLASH_WRITES)
+			static inline void VirtualFAT_ContinueFLASHWrite(void) {}
+			static inline void VirtualFAT_FinishFLASHWrite(void) {}
+		#endif
+
 #endif
@@ -0,0 +1,190 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Throughput benchmark for the HID parser test. For each corpus descriptor this reports the time taken to parse
+ *  the descriptor, and the time taken per report to decode all IN report items of the descriptor's first input
+ *  report, both by walking each item with \ref USB_GetHIDReportItemInfo() and via a compiled extraction plan.
+ *  Times are measured on the host, and so are only meaningful relative to one another. The benchmark fails if any
+ *  corpus descriptor cannot be parsed or has no input report, so that every descriptor is always measured.
+ */
+
+#include <time.h>
+
+#include "HIDParserTest.h"
+
+/** Minimum time each measurement is repeated for, in nanoseconds. */
+#define MIN_MEASURE_TIME_NS      50000000ULL
+
+/** Number of distinct random reports cycled through when measuring report decode times. */
+#define BENCHMARK_REPORTS        64
+
+/** Returns the current monotonic time, in nanoseconds. */
+static uint64_t GetTimeNS(void)
+{
+	struct timespec Time;
+
+	clock_gettime(CLOCK_MONOTONIC, &Time);
+	return ((uint64_t)Time.tv_sec * 1000000000ULL) + Time.tv_nsec;
+}
+
+/** Parses the given descriptor, into a preallocated arena when the parser is built in arena mode. */
+static uint8_t ParseDescriptor(const HIDParserTest_Descriptor_t* const Descriptor,
+                               HID_ReportInfo_t* const ParserData)
+{
+	#if defined(HID_PARSER_USE_ARENA)
+	static HID_ReportItem_t Arena[UINT16_MAX / sizeof(HID_ReportItem_t)];
+
+	ParserData->Arena     = Arena;
+	ParserData->ArenaSize = sizeof(Arena);
+	#endif
+
+	return USB_ProcessHIDReport(Descriptor->Data, Descriptor->Size, ParserData);
+}
+
+int main(void)
+{
+	static HID_ReportInfo_t     ParserData;
+	static HID_ExtractionPlan_t Plan;
+	static uint8_t              Reports[BENCHMARK_REPORTS][UINT16_MAX / 8 + 2];
+	volatile uint32_t           Sink     = 0;
+	int                         Failures = 0;
+
+	#if defined(HID_PARSER_USE_ARENA)
+	printf("HID parser benchmark (arena allocated parser tables):\n");
+	#else
+	printf("HID parser benchmark (fixed parser tables):\n");
+	#endif
+
+	printf("%-16s %6s %6s %10s %8s %14s %14s\n", "Descriptor", "Bytes", "Items", "Parse (ns)", "Fields",
+	       "Bit-walk (ns)", "Plan (ns)");
+
+	for (uint8_t i = 0; i < HIDParserTest_CorpusSize; i++)
+	{
+		const HIDParserTest_Descriptor_t* Descriptor = &HIDParserTest_Corpus[i];
+		uint64_t                          Iterations = 0;
+		uint64_t                          StartTime  = GetTimeNS();
+		uint64_t                          ParseTime;
+
+		do
+		{
+			ParseDescriptor(Descriptor, &ParserData);
+			Iterations++;
+		} while ((ParseTime = (GetTimeNS() - StartTime)) < MIN_MEASURE_TIME_NS);
+
+		if (ParseDescriptor(Descriptor, &ParserData) != HID_PARSE_Successful)
+		{
+			printf("%-16s %6u %6s %10.1f (parse failed)\n", Descriptor->Name, Descriptor->Size, "-",
+			       (double)ParseTime / Iterations);
+			Failures++;
+			continue;
+		}
+
+		/* Decode the first report which contains IN items, with its report ID prefix if used */
+		uint8_t  ReportID   = ParserData.ReportIDSizes[0].ReportID;
+		uint16_t ReportSize = 0;
+
+		for (uint8_t ReportIndex = 0; ReportIndex < ParserData.TotalDeviceReports; ReportIndex++)
+		{
+			ReportID = ParserData.ReportIDSizes[ReportIndex].ReportID;
+
+			if ((ReportSize = USB_GetHIDReportSize(&ParserData, ReportID, HID_REPORT_ITEM_In)) != 0)
+			  break;
+		}
+
+		if (!(ReportSize) || (USB_CompileHIDReportPlan(&ParserData, HID_REPORT_ITEM_In, &Plan) != HID_PARSE_Successful))
+		{
+			printf("%-16s %6u %6u %10.1f (no IN report)\n", Descriptor->Name, Descriptor->Size,
+			       ParserData.TotalReportItems, (double)ParseTime / Iterations);
+			Failures++;
+			continue;
+		}
+
+		HIDParserTest_Seed(i + 1);
+
+		for (uint8_t ReportIndex = 0; ReportIndex < BENCHMARK_REPORTS; ReportIndex++)
+		{
+			for (uint16_t j = 0; j <= ReportSize; j++)
+			  Reports[ReportIndex][j] = HIDParserTest_Random();
+
+			if (ParserData.UsingReportIDs)
+			  Reports[ReportIndex][0] = ReportID;
+		}
+
+		uint8_t  TotalFields     = 0;
+		uint64_t ParseIterations = Iterations;
+
+		Iterations = 0;
+		StartTime  = GetTimeNS();
+
+		uint64_t BitWalkTime;
+
+		do
+		{
+			const uint8_t* Report = Reports[Iterations % BENCHMARK_REPORTS];
+
+			TotalFields = 0;
+
+			for (uint8_t ItemIndex = 0; ItemIndex < ParserData.TotalReportItems; ItemIndex++)
+			{
+				HID_ReportItem_t* ReportItem = &ParserData.ReportItems[ItemIndex];
+
+				if ((ReportItem->ItemType == HID_REPORT_ITEM_In) && USB_GetHIDReportItemInfo(Report, ReportItem))
+				{
+					Sink += ReportItem->Value;
+					TotalFields++;
+				}
+			}
+
+			Iterations++;
+		} while ((BitWalkTime = (GetTimeNS() - StartTime)) < MIN_MEASURE_TIME_NS);
+
+		uint64_t BitWalkIterations = Iterations;
+
+		Iterations = 0;
+		StartTime  = GetTimeNS();
+
+		uint64_t PlanTime;
+
+		do
+		{
+			Sink += USB_ExtractHIDReportFields(&ParserData, &Plan, Reports[Iterations % BENCHMARK_REPORTS]);
+			Iterations++;
+		} while ((PlanTime = (GetTimeNS() - StartTime)) < MIN_MEASURE_TIME_NS);
+
+		printf("%-16s %6u %6u %10.1f %8u %14.1f %14.1f\n", Descriptor->Name, Descriptor->Size, ParserData.TotalReportItems,
+		       (double)ParseTime / ParseIterations, TotalFields, (double)BitWalkTime / BitWalkIterations,
+		       (double)PlanTime / Iterations);
+	}
+
+	(void)Sink;
+	return (Failures ? EXIT_FAILURE : EXIT_SUCCESS);
+}
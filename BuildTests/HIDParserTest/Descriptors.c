@@ -0,0 +1,479 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Corpus of HID report descriptors for the HID parser test, modelled on the layouts used by common
+ *  real-world devices. These are used as the seed corpus for fuzzing, and as the benchmark workload.
+ */
+
+#include "HIDParserTest.h"
+
+/** Boot protocol compatible keyboard, with six key rollover and LED output report. */
+static const uint8_t Corpus_BootKeyboard[] =
+{
+	HID_DESCRIPTOR_KEYBOARD(6)
+};
+
+/** Boot protocol compatible three button relative mouse. */
+static const uint8_t Corpus_BootMouse[] =
+{
+	HID_DESCRIPTOR_MOUSE(-127, 127, -127, 127, 3, false)
+};
+
+/** Simple joystick with two 8-bit axes and two buttons. */
+static const uint8_t Corpus_Joystick[] =
+{
+	HID_DESCRIPTOR_JOYSTICK(-100, 100, -1, 1, 2)
+};
+
+/** High resolution gaming mouse, with 16 buttons, packed 12-bit X/Y axes, a wheel and a horizontal pan control. */
+static const uint8_t Corpus_GamingMouse[] =
+{
+	HID_RI_USAGE_PAGE(8, 0x01),
+	HID_RI_USAGE(8, 0x02),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_REPORT_ID(8, 0x02),
+		HID_RI_USAGE(8, 0x01),
+		HID_RI_COLLECTION(8, 0x00),
+			HID_RI_USAGE_PAGE(8, 0x09),
+			HID_RI_USAGE_MINIMUM(8, 0x01),
+			HID_RI_USAGE_MAXIMUM(8, 0x10),
+			HID_RI_LOGICAL_MINIMUM(8, 0x00),
+			HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+			HID_RI_REPORT_COUNT(8, 0x10),
+			HID_RI_REPORT_SIZE(8, 0x01),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_USAGE_PAGE(8, 0x01),
+			HID_RI_LOGICAL_MINIMUM(16, -2047),
+			HID_RI_LOGICAL_MAXIMUM(16, 2047),
+			HID_RI_REPORT_SIZE(8, 0x0C),
+			HID_RI_REPORT_COUNT(8, 0x02),
+			HID_RI_USAGE(8, 0x30),
+			HID_RI_USAGE(8, 0x31),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_RELATIVE),
+			HID_RI_LOGICAL_MINIMUM(8, -127),
+			HID_RI_LOGICAL_MAXIMUM(8, 127),
+			HID_RI_REPORT_SIZE(8, 0x08),
+			HID_RI_REPORT_COUNT(8, 0x01),
+			HID_RI_USAGE(8, 0x38),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_RELATIVE),
+			HID_RI_USAGE_PAGE(8, 0x0C),
+			HID_RI_USAGE(16, 0x0238),
+			HID_RI_REPORT_COUNT(8, 0x01),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_RELATIVE),
+		HID_RI_END_COLLECTION(0),
+	HID_RI_END_COLLECTION(0),
+	HID_RI_USAGE_PAGE(16, 0xFF00),
+	HID_RI_USAGE(8, 0x01),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_REPORT_ID(8, 0x10),
+		HID_RI_REPORT_SIZE(8, 0x08),
+		HID_RI_REPORT_COUNT(8, 0x06),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(16, 0x00FF),
+		HID_RI_USAGE(8, 0x01),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_ARRAY | HID_IOF_ABSOLUTE),
+		HID_RI_USAGE(8, 0x01),
+		HID_RI_OUTPUT(8, HID_IOF_DATA | HID_IOF_ARRAY | HID_IOF_ABSOLUTE),
+	HID_RI_END_COLLECTION(0),
+};
+
+/** Multimedia keyboard, with keyboard, consumer control and system control reports and a vendor feature report. */
+static const uint8_t Corpus_MediaKeyboard[] =
+{
+	HID_RI_USAGE_PAGE(8, 0x01),
+	HID_RI_USAGE(8, 0x06),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_REPORT_ID(8, 0x01),
+		HID_RI_USAGE_PAGE(8, 0x07),
+		HID_RI_USAGE_MINIMUM(8, 0xE0),
+		HID_RI_USAGE_MAXIMUM(8, 0xE7),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+		HID_RI_REPORT_SIZE(8, 0x01),
+		HID_RI_REPORT_COUNT(8, 0x08),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_REPORT_COUNT(8, 0x01),
+		HID_RI_REPORT_SIZE(8, 0x08),
+		HID_RI_INPUT(8, HID_IOF_CONSTANT),
+		HID_RI_USAGE_PAGE(8, 0x08),
+		HID_RI_USAGE_MINIMUM(8, 0x01),
+		HID_RI_USAGE_MAXIMUM(8, 0x05),
+		HID_RI_REPORT_COUNT(8, 0x05),
+		HID_RI_REPORT_SIZE(8, 0x01),
+		HID_RI_OUTPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE | HID_IOF_NON_VOLATILE),
+		HID_RI_REPORT_COUNT(8, 0x01),
+		HID_RI_REPORT_SIZE(8, 0x03),
+		HID_RI_OUTPUT(8, HID_IOF_CONSTANT),
+		HID_RI_USAGE_PAGE(8, 0x07),
+		HID_RI_USAGE_MINIMUM(8, 0x00),
+		HID_RI_USAGE_MAXIMUM(8, 0x65),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(8, 0x65),
+		HID_RI_REPORT_COUNT(8, 0x06),
+		HID_RI_REPORT_SIZE(8, 0x08),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_ARRAY | HID_IOF_ABSOLUTE),
+	HID_RI_END_COLLECTION(0),
+	HID_RI_USAGE_PAGE(8, 0x0C),
+	HID_RI_USAGE(8, 0x01),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_REPORT_ID(8, 0x02),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(16, 0x029C),
+		HID_RI_USAGE_MINIMUM(8, 0x00),
+		HID_RI_USAGE_MAXIMUM(16, 0x029C),
+		HID_RI_REPORT_SIZE(8, 0x10),
+		HID_RI_REPORT_COUNT(8, 0x02),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_ARRAY | HID_IOF_ABSOLUTE),
+	HID_RI_END_COLLECTION(0),
+	HID_RI_USAGE_PAGE(8, 0x01),
+	HID_RI_USAGE(8, 0x80),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_REPORT_ID(8, 0x03),
+		HID_RI_USAGE_MINIMUM(8, 0x81),
+		HID_RI_USAGE_MAXIMUM(8, 0x83),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+		HID_RI_REPORT_SIZE(8, 0x01),
+		HID_RI_REPORT_COUNT(8, 0x03),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_REPORT_COUNT(8, 0x05),
+		HID_RI_INPUT(8, HID_IOF_CONSTANT),
+	HID_RI_END_COLLECTION(0),
+	HID_RI_USAGE_PAGE(16, 0xFF31),
+	HID_RI_USAGE(8, 0x74),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_REPORT_ID(8, 0x04),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(16, 0x00FF),
+		HID_RI_REPORT_SIZE(8, 0x08),
+		HID_RI_REPORT_COUNT(8, 0x07),
+		HID_RI_USAGE(8, 0x75),
+		HID_RI_FEATURE(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+	HID_RI_END_COLLECTION(0),
+};
+
+/** Game pad with twelve buttons, a hat switch with a null state, two analog sticks and two 10-bit triggers. */
+static const uint8_t Corpus_Gamepad[] =
+{
+	HID_RI_USAGE_PAGE(8, 0x01),
+	HID_RI_USAGE(8, 0x05),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_USAGE_PAGE(8, 0x09),
+		HID_RI_USAGE_MINIMUM(8, 0x01),
+		HID_RI_USAGE_MAXIMUM(8, 0x0C),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+		HID_RI_REPORT_SIZE(8, 0x01),
+		HID_RI_REPORT_COUNT(8, 0x0C),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_USAGE_PAGE(8, 0x01),
+		HID_RI_USAGE(8, 0x39),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(8, 0x07),
+		HID_RI_PHYSICAL_MINIMUM(8, 0x00),
+		HID_RI_PHYSICAL_MAXIMUM(16, 0x013B),
+		HID_RI_UNIT(8, 0x14),
+		HID_RI_REPORT_SIZE(8, 0x04),
+		HID_RI_REPORT_COUNT(8, 0x01),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE | HID_IOF_NULLSTATE),
+		HID_RI_UNIT(8, 0x00),
+		HID_RI_PUSH(0),
+			HID_RI_USAGE(8, 0x01),
+			HID_RI_COLLECTION(8, 0x00),
+				HID_RI_USAGE(8, 0x30),
+				HID_RI_USAGE(8, 0x31),
+				HID_RI_USAGE(8, 0x32),
+				HID_RI_USAGE(8, 0x35),
+				HID_RI_LOGICAL_MINIMUM(8, 0x00),
+				HID_RI_LOGICAL_MAXIMUM(16, 0x00FF),
+				HID_RI_PHYSICAL_MAXIMUM(16, 0x00FF),
+				HID_RI_REPORT_SIZE(8, 0x08),
+				HID_RI_REPORT_COUNT(8, 0x04),
+				HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_END_COLLECTION(0),
+		HID_RI_POP(0),
+		HID_RI_USAGE_PAGE(8, 0x02),
+		HID_RI_USAGE(8, 0xC4),
+		HID_RI_USAGE(8, 0xC5),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(16, 0x03FF),
+		HID_RI_REPORT_SIZE(8, 0x0A),
+		HID_RI_REPORT_COUNT(8, 0x02),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_REPORT_SIZE(8, 0x04),
+		HID_RI_REPORT_COUNT(8, 0x01),
+		HID_RI_INPUT(8, HID_IOF_CONSTANT),
+		HID_RI_USAGE_PAGE(8, 0x0F),
+		HID_RI_USAGE(8, 0x97),
+		HID_RI_COLLECTION(8, 0x02),
+			HID_RI_USAGE(8, 0x70),
+			HID_RI_USAGE(8, 0x70),
+			HID_RI_LOGICAL_MAXIMUM(8, 0x64),
+			HID_RI_REPORT_SIZE(8, 0x08),
+			HID_RI_REPORT_COUNT(8, 0x02),
+			HID_RI_OUTPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_END_COLLECTION(0),
+	HID_RI_END_COLLECTION(0),
+};
+
+/** Two finger touch pad digitizer, with per-contact logical collections, physical units, a scan time and a feature
+ *  report giving the maximum contact count, followed by a vendor defined certification blob.
+ */
+static const uint8_t Corpus_TouchDigitizer[] =
+{
+	HID_RI_USAGE_PAGE(8, 0x0D),
+	HID_RI_USAGE(8, 0x05),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_REPORT_ID(8, 0x01),
+		HID_RI_USAGE(8, 0x22),
+		HID_RI_COLLECTION(8, 0x02),
+			HID_RI_USAGE(8, 0x47),
+			HID_RI_USAGE(8, 0x42),
+			HID_RI_LOGICAL_MINIMUM(8, 0x00),
+			HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+			HID_RI_REPORT_SIZE(8, 0x01),
+			HID_RI_REPORT_COUNT(8, 0x02),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_REPORT_COUNT(8, 0x02),
+			HID_RI_INPUT(8, HID_IOF_CONSTANT),
+			HID_RI_USAGE(8, 0x51),
+			HID_RI_LOGICAL_MAXIMUM(8, 0x0F),
+			HID_RI_REPORT_SIZE(8, 0x04),
+			HID_RI_REPORT_COUNT(8, 0x01),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_USAGE_PAGE(8, 0x01),
+			HID_RI_LOGICAL_MAXIMUM(16, 0x0FFF),
+			HID_RI_REPORT_SIZE(8, 0x10),
+			HID_RI_UNIT_EXPONENT(8, 0x0E),
+			HID_RI_UNIT(8, 0x11),
+			HID_RI_USAGE(8, 0x30),
+			HID_RI_PHYSICAL_MAXIMUM(16, 0x04B0),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_USAGE(8, 0x31),
+			HID_RI_PHYSICAL_MAXIMUM(16, 0x0320),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_END_COLLECTION(0),
+		HID_RI_USAGE_PAGE(8, 0x0D),
+		HID_RI_USAGE(8, 0x22),
+		HID_RI_COLLECTION(8, 0x02),
+			HID_RI_USAGE(8, 0x47),
+			HID_RI_USAGE(8, 0x42),
+			HID_RI_LOGICAL_MINIMUM(8, 0x00),
+			HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+			HID_RI_REPORT_SIZE(8, 0x01),
+			HID_RI_REPORT_COUNT(8, 0x02),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_REPORT_COUNT(8, 0x02),
+			HID_RI_INPUT(8, HID_IOF_CONSTANT),
+			HID_RI_USAGE(8, 0x51),
+			HID_RI_LOGICAL_MAXIMUM(8, 0x0F),
+			HID_RI_REPORT_SIZE(8, 0x04),
+			HID_RI_REPORT_COUNT(8, 0x01),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_USAGE_PAGE(8, 0x01),
+			HID_RI_LOGICAL_MAXIMUM(16, 0x0FFF),
+			HID_RI_REPORT_SIZE(8, 0x10),
+			HID_RI_UNIT_EXPONENT(8, 0x0E),
+			HID_RI_UNIT(8, 0x11),
+			HID_RI_USAGE(8, 0x30),
+			HID_RI_PHYSICAL_MAXIMUM(16, 0x04B0),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_USAGE(8, 0x31),
+			HID_RI_PHYSICAL_MAXIMUM(16, 0x0320),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_END_COLLECTION(0),
+		HID_RI_USAGE_PAGE(8, 0x0D),
+		HID_RI_UNIT_EXPONENT(8, 0x0C),
+		HID_RI_UNIT(16, 0x1001),
+		HID_RI_LOGICAL_MAXIMUM(32, 0x0000FFFF),
+		HID_RI_PHYSICAL_MAXIMUM(32, 0x0000FFFF),
+		HID_RI_REPORT_SIZE(8, 0x10),
+		HID_RI_REPORT_COUNT(8, 0x01),
+		HID_RI_USAGE(8, 0x56),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_USAGE(8, 0x54),
+		HID_RI_LOGICAL_MAXIMUM(8, 0x7F),
+		HID_RI_REPORT_SIZE(8, 0x08),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_USAGE_PAGE(8, 0x09),
+		HID_RI_USAGE(8, 0x01),
+		HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+		HID_RI_REPORT_SIZE(8, 0x01),
+		HID_RI_REPORT_COUNT(8, 0x01),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_REPORT_COUNT(8, 0x07),
+		HID_RI_INPUT(8, HID_IOF_CONSTANT),
+		HID_RI_USAGE_PAGE(8, 0x0D),
+		HID_RI_REPORT_ID(8, 0x02),
+		HID_RI_USAGE(8, 0x55),
+		HID_RI_USAGE(8, 0x59),
+		HID_RI_LOGICAL_MAXIMUM(8, 0x0F),
+		HID_RI_REPORT_SIZE(8, 0x04),
+		HID_RI_REPORT_COUNT(8, 0x02),
+		HID_RI_FEATURE(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_USAGE_PAGE(16, 0xFF00),
+		HID_RI_REPORT_ID(8, 0x03),
+		HID_RI_USAGE(8, 0xC5),
+		HID_RI_LOGICAL_MAXIMUM(16, 0x00FF),
+		HID_RI_REPORT_SIZE(8, 0x08),
+		HID_RI_REPORT_COUNT(16, 0x0100),
+		HID_RI_FEATURE(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+	HID_RI_END_COLLECTION(0),
+};
+
+/** Uninterruptible power supply, using the Power Device and Battery System pages with a separate feature report for
+ *  each reported value, as is typical for UPS devices.
+ */
+static const uint8_t Corpus_UPS[] =
+{
+	HID_RI_USAGE_PAGE(8, 0x84),
+	HID_RI_USAGE(8, 0x04),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_USAGE(8, 0x24),
+		HID_RI_COLLECTION(8, 0x00),
+			HID_RI_REPORT_ID(8, 0x01),
+			HID_RI_USAGE(8, 0xFE),
+			HID_RI_USAGE(8, 0xFF),
+			HID_RI_USAGE_PAGE(8, 0x85),
+			HID_RI_USAGE(8, 0x89),
+			HID_RI_USAGE(8, 0x8F),
+			HID_RI_LOGICAL_MINIMUM(8, 0x00),
+			HID_RI_LOGICAL_MAXIMUM(16, 0x00FF),
+			HID_RI_REPORT_SIZE(8, 0x08),
+			HID_RI_REPORT_COUNT(8, 0x04),
+			HID_RI_FEATURE(8, HID_IOF_CONSTANT | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_REPORT_ID(8, 0x06),
+			HID_RI_USAGE(8, 0x66),
+			HID_RI_LOGICAL_MAXIMUM(8, 0x64),
+			HID_RI_REPORT_COUNT(8, 0x01),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE | HID_IOF_VOLATILE),
+			HID_RI_USAGE(8, 0x66),
+			HID_RI_FEATURE(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE | HID_IOF_VOLATILE),
+			HID_RI_REPORT_ID(8, 0x07),
+			HID_RI_USAGE(8, 0x68),
+			HID_RI_LOGICAL_MAXIMUM(32, 0x0000FFFF),
+			HID_RI_UNIT(16, 0x1001),
+			HID_RI_REPORT_SIZE(8, 0x10),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE | HID_IOF_VOLATILE),
+			HID_RI_USAGE(8, 0x68),
+			HID_RI_FEATURE(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE | HID_IOF_VOLATILE),
+			HID_RI_REPORT_ID(8, 0x08),
+			HID_RI_USAGE(8, 0x29),
+			HID_RI_USAGE(8, 0x67),
+			HID_RI_UNIT(8, 0x00),
+			HID_RI_LOGICAL_MAXIMUM(8, 0x64),
+			HID_RI_REPORT_SIZE(8, 0x08),
+			HID_RI_REPORT_COUNT(8, 0x02),
+			HID_RI_FEATURE(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_REPORT_ID(8, 0x09),
+			HID_RI_USAGE(8, 0x83),
+			HID_RI_USAGE(8, 0x8D),
+			HID_RI_REPORT_COUNT(8, 0x02),
+			HID_RI_FEATURE(8, HID_IOF_CONSTANT | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_USAGE_PAGE(8, 0x84),
+			HID_RI_REPORT_ID(8, 0x0A),
+			HID_RI_USAGE(8, 0x40),
+			HID_RI_LOGICAL_MAXIMUM(16, 0x00FA),
+			HID_RI_UNIT(32, 0x00F0D121),
+			HID_RI_UNIT_EXPONENT(8, 0x07),
+			HID_RI_REPORT_SIZE(8, 0x10),
+			HID_RI_REPORT_COUNT(8, 0x01),
+			HID_RI_FEATURE(8, HID_IOF_CONSTANT | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_REPORT_ID(8, 0x0B),
+			HID_RI_USAGE(8, 0x30),
+			HID_RI_FEATURE(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE | HID_IOF_VOLATILE),
+			HID_RI_UNIT(8, 0x00),
+			HID_RI_UNIT_EXPONENT(8, 0x00),
+			HID_RI_USAGE(8, 0x02),
+			HID_RI_COLLECTION(8, 0x02),
+				HID_RI_REPORT_ID(8, 0x03),
+				HID_RI_USAGE_PAGE(8, 0x85),
+				HID_RI_USAGE(8, 0x44),
+				HID_RI_USAGE(8, 0x45),
+				HID_RI_USAGE(8, 0xD0),
+				HID_RI_USAGE(8, 0x42),
+				HID_RI_USAGE(8, 0x4B),
+				HID_RI_USAGE_PAGE(8, 0x84),
+				HID_RI_USAGE(8, 0x69),
+				HID_RI_USAGE(8, 0x65),
+				HID_RI_USAGE(8, 0x62),
+				HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+				HID_RI_REPORT_SIZE(8, 0x01),
+				HID_RI_REPORT_COUNT(8, 0x08),
+				HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE | HID_IOF_VOLATILE),
+				HID_RI_USAGE_PAGE(8, 0x85),
+				HID_RI_USAGE(8, 0x44),
+				HID_RI_USAGE(8, 0x45),
+				HID_RI_USAGE(8, 0xD0),
+				HID_RI_USAGE(8, 0x42),
+				HID_RI_USAGE(8, 0x4B),
+				HID_RI_USAGE_PAGE(8, 0x84),
+				HID_RI_USAGE(8, 0x69),
+				HID_RI_USAGE(8, 0x65),
+				HID_RI_USAGE(8, 0x62),
+				HID_RI_FEATURE(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE | HID_IOF_VOLATILE),
+			HID_RI_END_COLLECTION(0),
+			HID_RI_REPORT_ID(8, 0x0C),
+			HID_RI_USAGE_PAGE(8, 0x84),
+			HID_RI_USAGE(8, 0x57),
+			HID_RI_USAGE(8, 0x56),
+			HID_RI_LOGICAL_MINIMUM(8, -1),
+			HID_RI_LOGICAL_MAXIMUM(16, 0x7FFF),
+			HID_RI_UNIT(16, 0x1001),
+			HID_RI_REPORT_SIZE(8, 0x10),
+			HID_RI_REPORT_COUNT(8, 0x02),
+			HID_RI_FEATURE(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE | HID_IOF_VOLATILE),
+			HID_RI_UNIT(8, 0x00),
+			HID_RI_REPORT_ID(8, 0x0D),
+			HID_RI_USAGE(8, 0x5A),
+			HID_RI_LOGICAL_MINIMUM(8, 0x01),
+			HID_RI_LOGICAL_MAXIMUM(8, 0x03),
+			HID_RI_REPORT_SIZE(8, 0x08),
+			HID_RI_REPORT_COUNT(8, 0x01),
+			HID_RI_FEATURE(8, HID_IOF_DATA | HID_IOF_ARRAY | HID_IOF_ABSOLUTE | HID_IOF_NULLSTATE),
+		HID_RI_END_COLLECTION(0),
+	HID_RI_END_COLLECTION(0),
+};
+
+const HIDParserTest_Descriptor_t HIDParserTest_Corpus[] =
+	{
+		{.Name = "BootKeyboard",    .Data = Corpus_BootKeyboard,    .Size = sizeof(Corpus_BootKeyboard)},
+		{.Name = "BootMouse",       .Data = Corpus_BootMouse,       .Size = sizeof(Corpus_BootMouse)},
+		{.Name = "Joystick",        .Data = Corpus_Joystick,        .Size = sizeof(Corpus_Joystick)},
+		{.Name = "GamingMouse",     .Data = Corpus_GamingMouse,     .Size = sizeof(Corpus_GamingMouse)},
+		{.Name = "MediaKeyboard",   .Data = Corpus_MediaKeyboard,   .Size = sizeof(Corpus_MediaKeyboard)},
+		{.Name = "Gamepad",         .Data = Corpus_Gamepad,         .Size = sizeof(Corpus_Gamepad)},
+		{.Name = "TouchDigitizer",  .Data = Corpus_TouchDigitizer,  .Size = sizeof(Corpus_TouchDigitizer)},
+		{.Name = "UPS",             .Data = Corpus_UPS,             .Size = sizeof(Corpus_UPS)},
+	};
+
+const uint8_t HIDParserTest_CorpusSize = (sizeof(HIDParserTest_Corpus) / sizeof(HIDParserTest_Corpus[0]));
@@ -0,0 +1,267 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Fuzzing entry point for the HID parser test. When built with \c HIDPARSERTEST_LIBFUZZER defined this file
+ *  provides only the libFuzzer entry point; otherwise it also provides a standalone driver, which can be used
+ *  with AFL (reading a single descriptor from standard input), to replay individual descriptor files, to run
+ *  the built-in corpus, to run a deterministic mutation pass over the corpus, or to write out the corpus as
+ *  seed files for a fuzzer.
+ */
+
+#include "HIDParserTest.h"
+
+/** Maximum size of a mutated descriptor in the standalone mutation pass. */
+#define MAX_MUTATED_SIZE         1024
+
+int LLVMFuzzerTestOneInput(const uint8_t* Data,
+                           size_t Size);
+
+int LLVMFuzzerTestOneInput(const uint8_t* Data,
+                           size_t Size)
+{
+	HIDParserTest_Result_t Result;
+
+	/* Seed the report generator from the input, so that each input is processed deterministically */
+	HIDParserTest_Seed(Size ^ (Size ? (Data[0] << 16) : 0));
+	HIDParserTest_Process(Data, Size, 16, &Result);
+
+	return 0;
+}
+
+#if !defined(HIDPARSERTEST_LIBFUZZER)
+/** Processes a single descriptor from an exactly sized copy, so that any overrun of the descriptor is detected. */
+static void RunInput(const uint8_t* Data,
+                     const size_t Size)
+{
+	uint8_t* Input = malloc(Size ? Size : 1);
+
+	memcpy(Input, Data, Size);
+	LLVMFuzzerTestOneInput(Input, Size);
+	free(Input);
+}
+
+/** Reads and processes a single descriptor from the given stream. */
+static int RunStream(FILE* Stream)
+{
+	static uint8_t Buffer[UINT16_MAX + 1];
+	size_t         Size = fread(Buffer, 1, sizeof(Buffer), Stream);
+
+	RunInput(Buffer, Size);
+	return 0;
+}
+
+/** Processes each descriptor of the corpus, reporting the parse results. Corpus descriptors must either parse
+ *  successfully, or fail only due to the configured parser table limits.
+ */
+static int RunCorpus(void)
+{
+	int Failures = 0;
+
+	printf("%-16s %6s %6s %6s %8s %8s\n", "Descriptor", "Bytes", "Result", "Items", "Reports", "Arena");
+
+	for (uint8_t i = 0; i < HIDParserTest_CorpusSize; i++)
+	{
+		const HIDParserTest_Descriptor_t* Descriptor = &HIDParserTest_Corpus[i];
+		HIDParserTest_Result_t            Result;
+
+		HIDParserTest_Seed(i + 1);
+		HIDParserTest_Process(Descriptor->Data, Descriptor->Size, 1000, &Result);
+
+		printf("%-16s %6u %6u %6u %8u %8u\n", Descriptor->Name, Descriptor->Size, Result.ErrorCode,
+		       Result.TotalItems, Result.TotalReports, Result.ArenaRequired);
+
+		switch (Result.ErrorCode)
+		{
+			case HID_PARSE_Successful:
+				break;
+
+			#if !defined(HID_PARSER_USE_ARENA)
+			case HID_PARSE_HIDStackOverflow:
+			case HID_PARSE_InsufficientReportItems:
+			case HID_PARSE_InsufficientCollectionPaths:
+			case HID_PARSE_UsageListOverflow:
+			case HID_PARSE_InsufficientReportIDItems:
+				break;
+			#endif
+
+			default:
+				Failures++;
+				break;
+		}
+	}
+
+	return (Failures ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+/** Processes the given number of randomly mutated copies of the corpus descriptors. */
+static int RunMutations(const unsigned long Iterations)
+{
+	static uint8_t Buffer[MAX_MUTATED_SIZE];
+	unsigned long  ResultCounts[0x100] = {0};
+
+	for (unsigned long Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		HIDParserTest_Seed(Iteration + 1);
+
+		const HIDParserTest_Descriptor_t* Descriptor = &HIDParserTest_Corpus[HIDParserTest_Random() % HIDParserTest_CorpusSize];
+		size_t                            Size       = Descriptor->Size;
+		uint8_t                           Mutations  = (1 + (HIDParserTest_Random() % 8));
+
+		memcpy(Buffer, Descriptor->Data, Size);
+
+		while (Mutations--)
+		{
+			size_t Position = (Size ? (HIDParserTest_Random() % Size) : 0);
+
+			switch (HIDParserTest_Random() % 6)
+			{
+				case 0:
+					if (Size)
+					  Buffer[Position] ^= (1 << (HIDParserTest_Random() % 8));
+					break;
+
+				case 1:
+					if (Size)
+					  Buffer[Position] = HIDParserTest_Random();
+					break;
+
+				case 2:
+					if (Size < MAX_MUTATED_SIZE)
+					{
+						memmove(&Buffer[Position + 1], &Buffer[Position], (Size - Position));
+						Buffer[Position] = HIDParserTest_Random();
+						Size++;
+					}
+					break;
+
+				case 3:
+					if (Size)
+					{
+						memmove(&Buffer[Position], &Buffer[Position + 1], (Size - Position - 1));
+						Size--;
+					}
+					break;
+
+				case 4:
+					Size = Position;
+					break;
+
+				default:
+				{
+					size_t Length = MIN((1 + HIDParserTest_Random() % 32), (Size - Position));
+
+					if ((Size + Length) <= MAX_MUTATED_SIZE)
+					{
+						memmove(&Buffer[Position + Length], &Buffer[Position], (Size - Position));
+						Size += Length;
+					}
+					break;
+				}
+			}
+		}
+
+		HIDParserTest_Result_t Result;
+		uint8_t*               Input = malloc(Size ? Size : 1);
+
+		memcpy(Input, Buffer, Size);
+		HIDParserTest_Process(Input, Size, 16, &Result);
+		free(Input);
+
+		ResultCounts[Result.ErrorCode]++;
+	}
+
+	printf("Processed %lu mutated descriptors:\n", Iterations);
+
+	for (uint16_t ErrorCode = 0; ErrorCode < 0x100; ErrorCode++)
+	{
+		if (ResultCounts[ErrorCode])
+		  printf("  Result %3u: %lu\n", ErrorCode, ResultCounts[ErrorCode]);
+	}
+
+	return EXIT_SUCCESS;
+}
+
+/** Writes each corpus descriptor to a separate file in the given directory, for use as a fuzzer seed corpus. */
+static int WriteCorpus(const char* Directory)
+{
+	for (uint8_t i = 0; i < HIDParserTest_CorpusSize; i++)
+	{
+		char  FileName[FILENAME_MAX];
+		FILE* CorpusFile;
+
+		snprintf(FileName, sizeof(FileName), "%s/%s.bin", Directory, HIDParserTest_Corpus[i].Name);
+
+		if ((CorpusFile = fopen(FileName, "wb")) == NULL)
+		{
+			perror(FileName);
+			return EXIT_FAILURE;
+		}
+
+		fwrite(HIDParserTest_Corpus[i].Data, 1, HIDParserTest_Corpus[i].Size, CorpusFile);
+		fclose(CorpusFile);
+	}
+
+	return EXIT_SUCCESS;
+}
+
+int main(int argc,
+         char* argv[])
+{
+	if (argc < 2)
+	  return RunStream(stdin);
+
+	if (!(strcmp(argv[1], "--corpus")))
+	  return RunCorpus();
+
+	if (!(strcmp(argv[1], "--mutate")) && (argc == 3))
+	  return RunMutations(strtoul(argv[2], NULL, 0));
+
+	if (!(strcmp(argv[1], "--write-corpus")) && (argc == 3))
+	  return WriteCorpus(argv[2]);
+
+	for (int i = 1; i < argc; i++)
+	{
+		FILE* InputFile;
+
+		if ((InputFile = fopen(argv[i], "rb")) == NULL)
+		{
+			perror(argv[i]);
+			return EXIT_FAILURE;
+		}
+
+		RunStream(InputFile);
+		fclose(InputFile);
+	}
+
+	return EXIT_SUCCESS;
+}
+#endif
@@ -0,0 +1,285 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Common processing for the HID parser test. Each HID report descriptor is parsed, checked for a consistent
+ *  report layout, and then used to decode and encode randomly generated reports, cross-checking the bit-walking
+ *  report item functions against the compiled field extraction plans. Any inconsistency aborts the test, so that
+ *  it is detected as a crash by the fuzzers.
+ */
+
+#include "HIDParserTest.h"
+
+/** Current state of the test's pseudo-random number generator. */
+static uint32_t RandomState = 1;
+
+#if defined(HID_PARSER_USE_ARENA)
+/** Arena allocated for the most recently parsed HID report descriptor, sized exactly to the parser's requirements
+ *  so that any overrun of the parser tables is detected by the address sanitizer.
+ */
+static void* ParserArena = NULL;
+#endif
+
+/** Aborts the test with the given failure message. */
+static void HIDParserTest_Fail(const char* Message,
+                               const uint16_t Value)
+{
+	fprintf(stderr, "HIDParserTest failure: %s (%u)\n", Message, Value);
+	abort();
+}
+
+void HIDParserTest_Seed(const uint32_t Seed)
+{
+	RandomState = (Seed ? Seed : 1);
+}
+
+uint32_t HIDParserTest_Random(void)
+{
+	RandomState ^= (RandomState << 13);
+	RandomState ^= (RandomState >> 17);
+	RandomState ^= (RandomState << 5);
+
+	return RandomState;
+}
+
+uint8_t HIDParserTest_Parse(const uint8_t* Descriptor,
+                            const uint16_t Size,
+                            HID_ReportInfo_t* const ParserData)
+{
+	#if defined(HID_PARSER_USE_ARENA)
+	uint8_t ErrorCode;
+
+	free(ParserArena);
+	ParserArena = NULL;
+
+	/* Measure the descriptor first, then parse it into an arena of exactly the reported size */
+	ParserData->Arena     = NULL;
+	ParserData->ArenaSize = 0;
+
+	if ((ErrorCode = USB_ProcessHIDReport(Descriptor, Size, ParserData)) != HID_PARSE_InsufficientArena)
+	  return ErrorCode;
+
+	ParserArena           = malloc(ParserData->ArenaRequired ? ParserData->ArenaRequired : 1);
+	ParserData->Arena     = ParserArena;
+	ParserData->ArenaSize = ParserData->ArenaRequired;
+
+	if ((ErrorCode = USB_ProcessHIDReport(Descriptor, Size, ParserData)) == HID_PARSE_InsufficientArena)
+	  HIDParserTest_Fail("Measured arena size is insufficient", ParserData->ArenaRequired);
+
+	return ErrorCode;
+	#else
+	return USB_ProcessHIDReport(Descriptor, Size, ParserData);
+	#endif
+}
+
+/** Determines if the given report ID has a report size entry in the parsed report information. */
+static bool HIDParserTest_HasReportID(HID_ReportInfo_t* const ParserData,
+                                      const uint8_t ReportID)
+{
+	for (uint8_t ReportIndex = 0; ReportIndex < ParserData->TotalDeviceReports; ReportIndex++)
+	{
+		if (ParserData->ReportIDSizes[ReportIndex].ReportID == ReportID)
+		  return true;
+	}
+
+	return false;
+}
+
+/** Checks that every parsed report item lies entirely within its report, as sized by \ref USB_GetHIDReportSize(),
+ *  and that every collection path is terminated. Items declared outside of any report ID once report IDs are in use
+ *  are sized into the surrounding report instead, and so are only checked against the largest report.
+ */
+static void HIDParserTest_CheckLayout(HID_ReportInfo_t* const ParserData)
+{
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+	{
+		HID_ReportItem_t* ReportItem = &ParserData->ReportItems[ItemIndex];
+		uint32_t          ReportBits = ((uint32_t)USB_GetHIDReportSize(ParserData, ReportItem->ReportID, ReportItem->ItemType) * 8);
+
+		if (ParserData->UsingReportIDs && !(HIDParserTest_HasReportID(ParserData, ReportItem->ReportID)))
+		  ReportBits = ParserData->LargestReportSizeBits;
+
+		if (((uint32_t)ReportItem->BitOffset + ReportItem->Attributes.BitSize) > ReportBits)
+		  HIDParserTest_Fail("Report item lies outside of its report", ItemIndex);
+
+		if ((uint32_t)ReportItem->BitOffset + ReportItem->Attributes.BitSize > ParserData->LargestReportSizeBits)
+		  HIDParserTest_Fail("Report item lies outside of the largest report", ItemIndex);
+
+		uint16_t Depth = 0;
+
+		for (HID_CollectionPath_t* CollectionPath = ReportItem->CollectionPath; CollectionPath != NULL; CollectionPath = CollectionPath->Parent)
+		{
+			if (++Depth > 0xFF)
+			  HIDParserTest_Fail("Collection path is not terminated", ItemIndex);
+		}
+	}
+}
+
+/** Generates a random report of the given ID and type, and cross-checks the decoding and encoding of its items. */
+static bool HIDParserTest_DecodeReport(HID_ReportInfo_t* const ParserData,
+                                       const HID_ExtractionPlan_t* const Plan,
+                                       const bool PlanValid,
+                                       const uint8_t ReportID,
+                                       const uint8_t ReportType)
+{
+	static uint32_t PlanValues[0x100];
+
+	uint16_t ReportSize = USB_GetHIDReportSize(ParserData, ReportID, ReportType);
+
+	/* Items of report ID zero are not prefixed by a report ID byte in the bit-walking functions */
+	if (!(ReportSize) || (ParserData->UsingReportIDs && !(ReportID)))
+	  return false;
+
+	uint16_t Length = (ReportSize + (ParserData->UsingReportIDs ? 1 : 0));
+	uint8_t* Report = malloc(Length);
+
+	for (uint16_t i = 0; i < Length; i++)
+	  Report[i] = HIDParserTest_Random();
+
+	if (ParserData->UsingReportIDs)
+	  Report[0] = ReportID;
+
+	if (PlanValid)
+	{
+		USB_ExtractHIDReportFields(ParserData, Plan, Report);
+
+		for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+		  PlanValues[ItemIndex] = ParserData->ReportItems[ItemIndex].Value;
+	}
+
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+	{
+		HID_ReportItem_t* ReportItem = &ParserData->ReportItems[ItemIndex];
+
+		if ((ReportItem->ItemType != ReportType) || (ReportItem->ReportID != ReportID))
+		  continue;
+
+		if (!(USB_GetHIDReportItemInfo(Report, ReportItem)))
+		  HIDParserTest_Fail("Report item not found in its report", ItemIndex);
+
+		uint8_t  BitSize = ReportItem->Attributes.BitSize;
+		uint32_t Mask    = (BitSize >= 32) ? 0xFFFFFFFF : (((uint32_t)1 << BitSize) - 1);
+
+		if (PlanValid && BitSize && ((ReportItem->Value & Mask) != (PlanValues[ItemIndex] & Mask)))
+		  HIDParserTest_Fail("Extraction plan value differs from report item value", ItemIndex);
+
+		/* Fields with a negative logical minimum must be sign extended by the extraction plan, all others zero extended */
+		uint32_t Extended = (ReportItem->Value & Mask);
+
+		uint8_t  MinimumBits = (ReportItem->Attributes.LogicalMinimumSize * 8);
+		bool     Signed      = (MinimumBits && (ReportItem->Attributes.Logical.Minimum & ((uint32_t)1 << (MinimumBits - 1))));
+
+		if (BitSize && Signed && (Extended & ~(Mask >> 1)))
+		  Extended |= ~Mask;
+
+		if (PlanValid && BitSize && (BitSize <= 32) && (PlanValues[ItemIndex] != Extended))
+		  HIDParserTest_Fail("Extraction plan value incorrectly sign extended", ItemIndex);
+	}
+
+	/* Re-encode all items into a cleared report, which must decode back to the same values */
+	memset(Report, 0x00, Length);
+
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+	{
+		HID_ReportItem_t* ReportItem = &ParserData->ReportItems[ItemIndex];
+
+		if ((ReportItem->ItemType == ReportType) && (ReportItem->ReportID == ReportID))
+		  USB_SetHIDReportItemInfo(Report, ReportItem);
+	}
+
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+	{
+		HID_ReportItem_t* ReportItem = &ParserData->ReportItems[ItemIndex];
+
+		if ((ReportItem->ItemType != ReportType) || (ReportItem->ReportID != ReportID))
+		  continue;
+
+		uint32_t EncodedValue = ReportItem->Value;
+
+		USB_GetHIDReportItemInfo(Report, ReportItem);
+
+		if (ReportItem->Value != EncodedValue)
+		  HIDParserTest_Fail("Report item value changed when re-encoded", ItemIndex);
+	}
+
+	free(Report);
+	return true;
+}
+
+void HIDParserTest_Process(const uint8_t* Descriptor,
+                           const size_t Size,
+                           const uint16_t ReportsToDecode,
+                           HIDParserTest_Result_t* const Result)
+{
+	static HID_ReportInfo_t     ParserData;
+	static HID_ExtractionPlan_t Plans[3];
+	bool                        PlansValid[3];
+
+	memset(Result, 0x00, sizeof(HIDParserTest_Result_t));
+
+	if (Size > UINT16_MAX)
+	{
+		Result->ErrorCode = HID_PARSE_MalformedReport;
+		return;
+	}
+
+	Result->ErrorCode = HIDParserTest_Parse(Descriptor, Size, &ParserData);
+
+	#if defined(HID_PARSER_USE_ARENA)
+	Result->ArenaRequired = ParserData.ArenaRequired;
+	#endif
+
+	if (Result->ErrorCode != HID_PARSE_Successful)
+	  return;
+
+	Result->TotalItems   = ParserData.TotalReportItems;
+	Result->TotalReports = ParserData.TotalDeviceReports;
+
+	HIDParserTest_CheckLayout(&ParserData);
+
+	for (uint8_t ReportType = HID_REPORT_ITEM_In; ReportType <= HID_REPORT_ITEM_Feature; ReportType++)
+	  PlansValid[ReportType] = (USB_CompileHIDReportPlan(&ParserData, ReportType, &Plans[ReportType]) == HID_PARSE_Successful);
+
+	for (uint16_t Attempt = 0; Attempt < ReportsToDecode; Attempt++)
+	{
+		uint8_t ReportType = (HIDParserTest_Random() % 3);
+		uint8_t ReportID   = ParserData.ReportIDSizes[HIDParserTest_Random() % ParserData.TotalDeviceReports].ReportID;
+
+		if (HIDParserTest_DecodeReport(&ParserData, &Plans[ReportType], PlansValid[ReportType], ReportID, ReportType))
+		  Result->ReportsDecoded++;
+	}
+}
+
+bool CALLBACK_HIDParser_FilterHIDReportItem(HID_ReportItem_t* const CurrentItem)
+{
+	/* Ignore vendor defined items, as a typical host application would */
+	return (CurrentItem->Attributes.Usage.Page < 0xFF00);
+}
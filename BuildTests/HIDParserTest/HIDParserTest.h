@@ -0,0 +1,83 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Header file for HIDParserTest.c.
+ */
+
+#ifndef _HID_PARSER_TEST_H_
+#define _HID_PARSER_TEST_H_
+
+	/* Includes: */
+		#include <stdio.h>
+		#include <stdlib.h>
+		#include <stdint.h>
+		#include <stdbool.h>
+		#include <string.h>
+
+		#include <LUFA/Drivers/USB/USB.h>
+
+	/* Type Defines: */
+		/** Type define for a single HID report descriptor of the test corpus. */
+		typedef struct
+		{
+			const char*    Name; /**< Short name of the descriptor, also used as its corpus file name. */
+			const uint8_t* Data; /**< Pointer to the HID report descriptor. */
+			uint16_t       Size; /**< Size of the HID report descriptor in bytes. */
+		} HIDParserTest_Descriptor_t;
+
+		/** Type define for the results of processing a single HID report descriptor. */
+		typedef struct
+		{
+			uint8_t  ErrorCode;      /**< Parser result, a value in the \ref HID_Parse_ErrorCodes_t enum. */
+			uint8_t  TotalItems;     /**< Total number of report items stored by the parser. */
+			uint8_t  TotalReports;   /**< Total number of reports in the descriptor. */
+			uint16_t ArenaRequired;  /**< Arena bytes required, when built with \c HID_PARSER_USE_ARENA. */
+			uint16_t ReportsDecoded; /**< Total number of reports decoded and cross-checked. */
+		} HIDParserTest_Result_t;
+
+	/* External Variables: */
+		extern const HIDParserTest_Descriptor_t HIDParserTest_Corpus[];
+		extern const uint8_t                    HIDParserTest_CorpusSize;
+
+	/* Function Prototypes: */
+		void HIDParserTest_Process(const uint8_t* Descriptor,
+		                           const size_t Size,
+		                           const uint16_t ReportsToDecode,
+		                           HIDParserTest_Result_t* const Result);
+		uint8_t HIDParserTest_Parse(const uint8_t* Descriptor,
+		                            const uint16_t Size,
+		                            HID_ReportInfo_t* const ParserData);
+		uint32_t HIDParserTest_Random(void);
+		void HIDParserTest_Seed(const uint32_t Seed);
+
+#endif
+
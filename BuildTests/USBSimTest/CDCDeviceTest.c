@@ -0,0 +1,242 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+
+/** \file
+ *
+ *  CDC device class driver test for the simulated USB controller. The device enumerates as the ClassDriver
+ *  VirtualSerial demo, and then echoes a stream of random data sent by the simulated host in randomly sized
+ *  packets back to the host, which checks that every byte is returned in order. Further data is then sent to
+ *  the host in spans, checking that transfers ending with a full packet are terminated with a zero length packet.
+ */
+
+#include "USBSimTest.h"
+
+/** Total number of bytes the simulated host sends to the device in the echo test. */
+#define ECHO_TEST_BYTES      100000UL
+
+/** LUFA CDC Class driver interface configuration and state information. */
+static USB_ClassInfo_CDC_Device_t VirtualSerial_CDC_Interface =
+	{
+		.Config =
+			{
+				.ControlInterfaceNumber   = INTERFACE_ID_CDC_CCI,
+				.DataINEndpoint           =
+					{
+						.Address          = CDC_TX_EPADDR,
+						.Size             = CDC_TXRX_EPSIZE,
+						.Banks            = 1,
+					},
+				.DataOUTEndpoint          =
+					{
+						.Address          = CDC_RX_EPADDR,
+						.Size             = CDC_TXRX_EPSIZE,
+						.Banks            = 1,
+					},
+				.NotificationEndpoint     =
+					{
+						.Address          = CDC_NOTIFICATION_EPADDR,
+						.Size             = CDC_NOTIFICATION_EPSIZE,
+						.Banks            = 1,
+					},
+			},
+	};
+
+/** Number of bytes sent to and received from the device by the simulated host. */
+static uint32_t HostBytesSent, HostBytesReceived;
+
+/** Pseudo-random generator states of the data sent by the host, and of the data expected back from the device. */
+static uint32_t HostSendState = 1, HostReceiveState = 1;
+
+/** Number of zero length data packets received by the simulated host. */
+static uint16_t HostZLPs;
+
+/** Number of control line state change notification bytes received by the simulated host. */
+static uint16_t HostNotificationBytes;
+
+/** Returns the next byte of the given test data stream. */
+static uint8_t NextStreamByte(uint32_t* const State)
+{
+	*State = (*State * 1103515245UL) + 12345;
+	return (*State >> 16);
+}
+
+/** Simulated host handler for IN packets sent by the device, which checks echoed data against the data sent. */
+static void HostModel_INPacket(const uint8_t Address,
+                               const uint8_t* const Data,
+                               const uint16_t Length)
+{
+	if (Address == CDC_NOTIFICATION_EPADDR)
+	{
+		HostNotificationBytes += Length;
+		return;
+	}
+
+	USBSimTest_Check(Address == CDC_TX_EPADDR, Address);
+	USBSimTest_Check(Length <= CDC_TXRX_EPSIZE, Length);
+
+	if (!(Length))
+	  HostZLPs++;
+
+	for (uint16_t i = 0; i < Length; i++)
+	  USBSimTest_Check(Data[i] == NextStreamByte(&HostReceiveState), HostBytesReceived + i);
+
+	HostBytesReceived += Length;
+}
+
+/** Simulated host handler for free OUT endpoint banks, which sends randomly sized packets of test data. */
+static int16_t HostModel_OUTPacket(const uint8_t Address,
+                                   uint8_t* const Data,
+                                   const uint16_t MaxLength)
+{
+	USBSimTest_Check(Address == CDC_RX_EPADDR, Address);
+
+	/* Limit the data in flight so that the device always has room to echo it back */
+	if ((HostBytesSent == ECHO_TEST_BYTES) || ((HostBytesSent - HostBytesReceived) > (4 * CDC_TXRX_EPSIZE)))
+	  return -1;
+
+	uint16_t Length = MIN(USBSimTest_Random() % (MaxLength + 1), ECHO_TEST_BYTES - HostBytesSent);
+
+	for (uint16_t i = 0; i < Length; i++)
+	  Data[i] = NextStreamByte(&HostSendState);
+
+	HostBytesSent += Length;
+	return Length;
+}
+
+/** Simulated host model, exchanging test data with the CDC interface's endpoints. */
+static const USB_Sim_HostModel_t HostModel =
+	{
+		.INPacketReceived   = HostModel_INPacket,
+		.OUTPacketRequested = HostModel_OUTPacket,
+	};
+
+/** Event handler for the library USB Configuration Changed event. */
+void EVENT_USB_Device_ConfigurationChanged(void)
+{
+	USBSimTest_Check(CDC_Device_ConfigureEndpoints(&VirtualSerial_CDC_Interface), 0);
+}
+
+/** Event handler for the library USB Control Request reception event. */
+void EVENT_USB_Device_ControlRequest(void)
+{
+	CDC_Device_ProcessControlRequest(&VirtualSerial_CDC_Interface);
+}
+
+int main(void)
+{
+	USBSimTest_Enumerate(&HostModel);
+
+	/* Set and read back the virtual serial port's line encoding */
+	CDC_LineEncoding_t LineEncoding = {.BaudRateBPS = 115200, .CharFormat = CDC_LINEENCODING_OneStopBit,
+	                                   .ParityType = CDC_PARITY_None, .DataBits = 8};
+
+	USBSimTest_Check(USBSimTest_ControlRequest((REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE), CDC_REQ_SetLineEncoding,
+	                                           0, INTERFACE_ID_CDC_CCI, sizeof(CDC_LineEncoding_t), &LineEncoding) == USB_SIM_CONTROL_Complete, 0);
+	USBSimTest_Check(VirtualSerial_CDC_Interface.State.LineEncoding.BaudRateBPS == 115200,
+	                 VirtualSerial_CDC_Interface.State.LineEncoding.BaudRateBPS);
+
+	memset(&LineEncoding, 0x00, sizeof(LineEncoding));
+	USBSimTest_Check(USBSimTest_ControlRequest((REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE), CDC_REQ_GetLineEncoding,
+	                                           0, INTERFACE_ID_CDC_CCI, sizeof(CDC_LineEncoding_t), &LineEncoding) == USB_SIM_CONTROL_Complete, 0);
+	USBSimTest_Check((LineEncoding.BaudRateBPS == 115200) && (LineEncoding.DataBits == 8), LineEncoding.BaudRateBPS);
+
+	USBSimTest_Check(USBSimTest_ControlRequest((REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE), CDC_REQ_SetControlLineState,
+	                                           CDC_CONTROL_LINE_OUT_DTR, INTERFACE_ID_CDC_CCI, 0, NULL) == USB_SIM_CONTROL_Complete, 0);
+	USBSimTest_Check(VirtualSerial_CDC_Interface.State.ControlLineStates.HostToDevice == CDC_CONTROL_LINE_OUT_DTR,
+	                 VirtualSerial_CDC_Interface.State.ControlLineStates.HostToDevice);
+
+	/* Send a control line state change notification to the host */
+	VirtualSerial_CDC_Interface.State.ControlLineStates.DeviceToHost = CDC_CONTROL_LINE_IN_DCD;
+	CDC_Device_SendControlLineStateChange(&VirtualSerial_CDC_Interface);
+	USBSimTest_RunFrames(2);
+	USBSimTest_Check(HostNotificationBytes == (sizeof(USB_Request_Header_t) + sizeof(uint16_t)), HostNotificationBytes);
+
+	/* Echo the host's test data back to it a byte at a time, as the VirtualSerial demos do */
+	for (uint32_t Loops = 0; HostBytesReceived < ECHO_TEST_BYTES; Loops++)
+	{
+		USBSimTest_Check(Loops < (ECHO_TEST_BYTES * 4), HostBytesReceived);
+
+		int16_t ReceivedByte = CDC_Device_ReceiveByte(&VirtualSerial_CDC_Interface);
+
+		if (ReceivedByte >= 0)
+		  USBSimTest_Check(CDC_Device_SendByte(&VirtualSerial_CDC_Interface, ReceivedByte) == ENDPOINT_READYWAIT_NoError, ReceivedByte);
+
+		CDC_Device_USBTask(&VirtualSerial_CDC_Interface);
+		USBSimTest_RunFrames(1);
+	}
+
+	USBSimTest_Check(HostBytesSent == ECHO_TEST_BYTES, HostBytesSent);
+
+	/* Send further data in spans, continuing the host's test data stream now that the host has stopped sending */
+	static const uint16_t SpanLengths[] = {CDC_TXRX_EPSIZE, (CDC_TXRX_EPSIZE * 3), (CDC_TXRX_EPSIZE + 5), 7, 0};
+
+	for (uint8_t i = 0; SpanLengths[i]; i++)
+	{
+		uint8_t  SpanData[CDC_TXRX_EPSIZE * 4];
+		uint16_t BytesSent = 0;
+		uint32_t ExpectedBytes = (HostBytesReceived + SpanLengths[i]);
+
+		for (uint16_t j = 0; j < SpanLengths[i]; j++)
+		  SpanData[j] = NextStreamByte(&HostSendState);
+
+		HostZLPs = 0;
+
+		for (uint16_t Loops = 0; BytesSent < SpanLengths[i]; Loops++)
+		{
+			USBSimTest_Check(Loops < 100, BytesSent);
+
+			BytesSent += CDC_Device_SendSpan(&VirtualSerial_CDC_Interface, &SpanData[BytesSent], (SpanLengths[i] - BytesSent));
+			USBSimTest_RunFrames(1);
+		}
+
+		CDC_Device_USBTask(&VirtualSerial_CDC_Interface);
+		USBSimTest_RunFrames(4);
+
+		USBSimTest_Check(HostBytesReceived == ExpectedBytes, HostBytesReceived);
+		USBSimTest_Check(HostZLPs == ((SpanLengths[i] % CDC_TXRX_EPSIZE) == 0), SpanLengths[i]);
+	}
+
+	/* The device must follow the host through suspend, resume and disconnection */
+	USB_Sim_Suspend();
+	USBSimTest_RunFrames(1);
+	USBSimTest_Check(USB_DeviceState == DEVICE_STATE_Suspended, USB_DeviceState);
+
+	USB_Sim_Resume();
+	USBSimTest_RunFrames(1);
+	USBSimTest_Check(USB_DeviceState == DEVICE_STATE_Configured, USB_DeviceState);
+
+	USB_Sim_Disconnect();
+	USBSimTest_RunFrames(1);
+	USBSimTest_Check(USB_DeviceState == DEVICE_STATE_Unattached, USB_DeviceState);
+
+	printf("CDCDeviceTest: %lu bytes received by the host\n", (unsigned long)HostBytesReceived);
+	return EXIT_SUCCESS;
+}
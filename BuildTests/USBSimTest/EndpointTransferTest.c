@@ -0,0 +1,313 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+
+/** \file
+ *
+ *  Asynchronous endpoint transfer test for the simulated USB controller. IN transfers of various lengths are
+ *  sent to the simulated host with and without terminating zero length packets, including transfers which top up
+ *  a bank already partially filled by the application, and OUT transfers are received from the host ending on
+ *  short packets, on the full transfer length and with data left over in the endpoint bank. Cancellation of a
+ *  pending transfer, and the ending of pending transfers by a bus reset, are also checked.
+ */
+
+#include "USBSimTest.h"
+
+/** Address of the bulk IN endpoint used for the test transfers. */
+#define TEST_IN_EPADDR        CDC_TX_EPADDR
+
+/** Address of the bulk OUT endpoint used for the test transfers. */
+#define TEST_OUT_EPADDR       CDC_RX_EPADDR
+
+/** Size in bytes of the test transfer endpoints. */
+#define TEST_EPSIZE           64
+
+/** Size in bytes of the test transfer buffers. */
+#define TEST_BUFFER_SIZE      5000
+
+/** Endpoint table entry of the bulk IN test endpoint. */
+static const USB_Endpoint_Table_t TestINEndpoint  = {.Address = TEST_IN_EPADDR,  .Size = TEST_EPSIZE, .Type = EP_TYPE_BULK, .Banks = 1};
+
+/** Endpoint table entry of the bulk OUT test endpoint. */
+static const USB_Endpoint_Table_t TestOUTEndpoint = {.Address = TEST_OUT_EPADDR, .Size = TEST_EPSIZE, .Type = EP_TYPE_BULK, .Banks = 1};
+
+/** Data received from the device by the simulated host, and the number of packets and ZLPs it arrived in. */
+static uint8_t  HostINData[TEST_BUFFER_SIZE];
+static uint16_t HostINLength, HostINZLPs;
+
+/** Data sent to the device by the simulated host, and the position of the next byte to send. */
+static uint8_t  HostOUTData[TEST_BUFFER_SIZE];
+static uint16_t HostOUTLength, HostOUTPosition;
+
+/** Indicates if the simulated host should end its OUT data with a zero length packet. */
+static bool HostOUTZLP;
+
+/** Number of transfer completion callbacks run. */
+static uint16_t CompletionCallbacks;
+
+/** Simulated host handler for IN packets sent by the device. */
+static void HostModel_INPacket(const uint8_t Address,
+                               const uint8_t* const Data,
+                               const uint16_t Length)
+{
+	USBSimTest_Check(Address == TEST_IN_EPADDR, Address);
+	USBSimTest_Check(Length <= TEST_EPSIZE, Length);
+	USBSimTest_Check((HostINLength + Length) <= TEST_BUFFER_SIZE, HostINLength);
+
+	memcpy(&HostINData[HostINLength], Data, Length);
+	HostINLength += Length;
+
+	if (!(Length))
+	  HostINZLPs++;
+}
+
+/** Simulated host handler for free OUT endpoint banks, which randomly NAKs or sends the next packet of host data. */
+static int16_t HostModel_OUTPacket(const uint8_t Address,
+                                   uint8_t* const Data,
+                                   const uint16_t MaxLength)
+{
+	USBSimTest_Check(Address == TEST_OUT_EPADDR, Address);
+
+	if (HostOUTPosition == HostOUTLength)
+	{
+		if (!(HostOUTZLP))
+		  return -1;
+
+		HostOUTZLP = false;
+		return 0;
+	}
+
+	if (USBSimTest_Random() & 1)
+	  return -1;
+
+	uint16_t Length = MIN(MaxLength, (HostOUTLength - HostOUTPosition));
+
+	memcpy(Data, &HostOUTData[HostOUTPosition], Length);
+	HostOUTPosition += Length;
+
+	return Length;
+}
+
+/** Simulated host model, exchanging test data with the test endpoints. */
+static const USB_Sim_HostModel_t HostModel =
+	{
+		.INPacketReceived   = HostModel_INPacket,
+		.OUTPacketRequested = HostModel_OUTPacket,
+	};
+
+/** Event handler for the library USB Configuration Changed event. */
+void EVENT_USB_Device_ConfigurationChanged(void)
+{
+	USBSimTest_Check(Endpoint_ConfigureEndpointTable(&TestINEndpoint, 1), 0);
+	USBSimTest_Check(Endpoint_ConfigureEndpointTable(&TestOUTEndpoint, 1), 0);
+}
+
+/** Transfer completion callback, counting the completed transfers. */
+static void TransferComplete(USB_Endpoint_Transfer_t* const Transfer)
+{
+	USBSimTest_Check(Endpoint_IsTransferComplete(Transfer), Transfer->State.Status);
+
+	CompletionCallbacks++;
+}
+
+/** Processes the given transfer until it finishes, then lets any packets still in flight reach the host.
+ *
+ *  \return Final status of the transfer, a value from the \ref Endpoint_TransferStatus_t enum.
+ */
+static uint8_t RunTransfer(USB_Endpoint_Transfer_t* const Transfer)
+{
+	for (uint16_t Frames = 0; !(Endpoint_IsTransferComplete(Transfer)); Frames++)
+	{
+		USBSimTest_Check(Frames < 10000, Transfer->State.BytesTransferred);
+
+		Endpoint_ProcessTransfers();
+		USBSimTest_RunFrames(1);
+	}
+
+	USBSimTest_RunFrames(4);
+	return Transfer->State.Status;
+}
+
+/** Sends an IN transfer of the given length, optionally after first partially filling the endpoint bank via the
+ *  regular endpoint functions, and checks the data and terminating ZLP received by the host.
+ */
+static void TestINTransfer(const uint8_t* const Data,
+                           const uint16_t Length,
+                           const uint16_t PrefillLength,
+                           const bool SendZLP)
+{
+	USB_Endpoint_Transfer_t Transfer =
+		{
+			.Config =
+				{
+					.Endpoint           = &TestINEndpoint,
+					.Buffer             = (void*)&Data[PrefillLength],
+					.Length             = (Length - PrefillLength),
+					.Flags              = (SendZLP ? ENDPOINT_TRANSFER_FLAG_SEND_ZLP : 0),
+					.CompletionCallback = TransferComplete,
+				},
+		};
+
+	HostINLength = 0;
+	HostINZLPs   = 0;
+
+	if (PrefillLength)
+	{
+		Endpoint_SelectEndpoint(TEST_IN_EPADDR);
+		USBSimTest_Check(Endpoint_Write_Stream_LE(Data, PrefillLength, NULL) == ENDPOINT_RWSTREAM_NoError, PrefillLength);
+	}
+
+	uint16_t PrevCallbacks = CompletionCallbacks;
+
+	USBSimTest_Check(Endpoint_SubmitTransfer(&Transfer) == ENDPOINT_TRANSFER_Pending, Length);
+	USBSimTest_Check(Endpoint_SubmitTransfer(&Transfer) == ENDPOINT_TRANSFER_EndpointBusy, Length);
+	USBSimTest_Check(RunTransfer(&Transfer) == ENDPOINT_TRANSFER_Complete, Transfer.State.Status);
+
+	/* A ZLP must follow the data exactly when requested and the final packet of the data was full */
+	bool ExpectZLP = (SendZLP && !(Length % TEST_EPSIZE));
+
+	USBSimTest_Check(CompletionCallbacks == (PrevCallbacks + 1), Length);
+	USBSimTest_Check(Transfer.State.BytesTransferred == (Length - PrefillLength), Transfer.State.BytesTransferred);
+	USBSimTest_Check(HostINLength == Length, HostINLength);
+	USBSimTest_Check(memcmp(HostINData, Data, Length) == 0, Length);
+	USBSimTest_Check(HostINZLPs == ExpectZLP, Length);
+}
+
+/** Receives an OUT transfer of the given length while the host sends the given amount of data, and checks the
+ *  received data. Any host data which did not fit into the transfer is then received by a second transfer.
+ */
+static void TestOUTTransfer(const uint16_t Length,
+                            const uint16_t HostLength)
+{
+	static uint8_t ReceivedData[TEST_BUFFER_SIZE];
+
+	USB_Endpoint_Transfer_t Transfer =
+		{
+			.Config =
+				{
+					.Endpoint = &TestOUTEndpoint,
+					.Buffer   = ReceivedData,
+					.Length   = Length,
+				},
+		};
+
+	for (uint16_t i = 0; i < HostLength; i++)
+	  HostOUTData[i] = USBSimTest_Random();
+
+	HostOUTLength   = HostLength;
+	HostOUTPosition = 0;
+	HostOUTZLP      = ((HostLength < Length) && !(HostLength % TEST_EPSIZE));
+
+	memset(ReceivedData, 0x00, sizeof(ReceivedData));
+
+	uint16_t ExpectedLength = MIN(Length, HostLength);
+
+	USBSimTest_Check(Endpoint_SubmitTransfer(&Transfer) == ENDPOINT_TRANSFER_Pending, Length);
+	USBSimTest_Check(RunTransfer(&Transfer) == ENDPOINT_TRANSFER_Complete, Transfer.State.Status);
+	USBSimTest_Check(Transfer.State.BytesTransferred == ExpectedLength, Transfer.State.BytesTransferred);
+	USBSimTest_Check(memcmp(ReceivedData, HostOUTData, ExpectedLength) == 0, Length);
+
+	if (HostLength > Length)
+	{
+		Transfer.Config.Length = sizeof(ReceivedData);
+
+		USBSimTest_Check(Endpoint_SubmitTransfer(&Transfer) == ENDPOINT_TRANSFER_Pending, Length);
+		USBSimTest_Check(RunTransfer(&Transfer) == ENDPOINT_TRANSFER_Complete, Transfer.State.Status);
+		USBSimTest_Check(Transfer.State.BytesTransferred == (HostLength - Length), Transfer.State.BytesTransferred);
+		USBSimTest_Check(memcmp(ReceivedData, &HostOUTData[Length], (HostLength - Length)) == 0, Length);
+	}
+}
+
+int main(void)
+{
+	static uint8_t SendData[TEST_BUFFER_SIZE];
+
+	USBSimTest_Enumerate(&HostModel);
+
+	for (uint16_t i = 0; i < sizeof(SendData); i++)
+	  SendData[i] = USBSimTest_Random();
+
+	static const uint16_t INLengths[] = {0, 1, 63, 64, 65, 128, 1000, 1023, 1024, 4096};
+
+	for (uint8_t i = 0; i < (sizeof(INLengths) / sizeof(INLengths[0])); i++)
+	{
+		TestINTransfer(SendData, INLengths[i], 0, false);
+		TestINTransfer(SendData, INLengths[i], 0, true);
+
+		/* Top up a bank partially filled by the application, so that the final packet size differs from the transfer length */
+		if (INLengths[i] > 10)
+		{
+			TestINTransfer(SendData, INLengths[i], 10, false);
+			TestINTransfer(SendData, INLengths[i], 10, true);
+		}
+	}
+
+	static const uint16_t OUTLengths[][2] = {{64, 64}, {128, 64}, {100, 64}, {1000, 1000}, {1000, 640}, {640, 1000}, {63, 64}, {4096, 4096}};
+
+	for (uint8_t i = 0; i < (sizeof(OUTLengths) / sizeof(OUTLengths[0])); i++)
+	  TestOUTTransfer(OUTLengths[i][0], OUTLengths[i][1]);
+
+	/* A cancelled transfer must not complete or run its callback */
+	static uint8_t ReceivedData[100];
+
+	USB_Endpoint_Transfer_t Transfer =
+		{
+			.Config =
+				{
+					.Endpoint           = &TestOUTEndpoint,
+					.Buffer             = ReceivedData,
+					.Length             = sizeof(ReceivedData),
+					.CompletionCallback = TransferComplete,
+				},
+		};
+
+	uint16_t PrevCallbacks = CompletionCallbacks;
+
+	HostOUTLength   = 0;
+	HostOUTPosition = 0;
+
+	USBSimTest_Check(Endpoint_SubmitTransfer(&Transfer) == ENDPOINT_TRANSFER_Pending, 0);
+	Endpoint_ProcessTransfers();
+	Endpoint_CancelTransfer(&Transfer);
+	USBSimTest_Check(Transfer.State.Status == ENDPOINT_TRANSFER_Cancelled, Transfer.State.Status);
+	USBSimTest_Check(CompletionCallbacks == PrevCallbacks, CompletionCallbacks);
+
+	/* A bus reset must end any pending transfers */
+	USBSimTest_Check(Endpoint_SubmitTransfer(&Transfer) == ENDPOINT_TRANSFER_Pending, 0);
+	Endpoint_ProcessTransfers();
+	USB_Sim_BusReset();
+	USBSimTest_RunFrames(1);
+	Endpoint_ProcessTransfers();
+	USBSimTest_Check(Transfer.State.Status == ENDPOINT_TRANSFER_DeviceDisconnected, Transfer.State.Status);
+	USBSimTest_Check(CompletionCallbacks == (PrevCallbacks + 1), CompletionCallbacks);
+
+	printf("EndpointTransferTest: %u transfers completed\n", CompletionCallbacks);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,161 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+
+/** \file
+ *
+ *  Common processing for the simulated USB controller tests. This contains the test failure reporting, a
+ *  pseudo-random number generator for test data, and helpers to run the simulated bus and to enumerate the
+ *  device through the simulated host in the same way as a real host would.
+ */
+
+#include "USBSimTest.h"
+
+/** Current state of the test's pseudo-random number generator. */
+static uint32_t RandomState = 1;
+
+void USBSimTest_Fail(const char* Condition,
+                     const int32_t Value)
+{
+	fprintf(stderr, "USBSimTest failure: %s (%ld)\n", Condition, (long)Value);
+	abort();
+}
+
+void USBSimTest_Seed(const uint32_t Seed)
+{
+	RandomState = (Seed ? Seed : 1);
+}
+
+uint32_t USBSimTest_Random(void)
+{
+	RandomState ^= (RandomState << 13);
+	RandomState ^= (RandomState >> 17);
+	RandomState ^= (RandomState << 5);
+
+	return RandomState;
+}
+
+/** Runs the USB management task and advances the simulated bus by the given number of frames. */
+void USBSimTest_RunFrames(const uint16_t Frames)
+{
+	for (uint16_t i = 0; i < Frames; i++)
+	{
+		USB_USBTask();
+		USB_Sim_ServiceBus();
+	}
+}
+
+/** Performs a control transfer on the device's default control endpoint through the simulated host, and
+ *  waits for it to complete.
+ *
+ *  \return Final status of the transfer, a value from the \ref USB_Sim_ControlStatus_t enum.
+ */
+uint8_t USBSimTest_ControlRequest(const uint8_t bmRequestType,
+                                  const uint8_t bRequest,
+                                  const uint16_t wValue,
+                                  const uint16_t wIndex,
+                                  const uint16_t wLength,
+                                  void* const Data)
+{
+	USB_Request_Header_t Request =
+		{
+			.bmRequestType = bmRequestType,
+			.bRequest      = bRequest,
+			.wValue        = wValue,
+			.wIndex        = wIndex,
+			.wLength       = wLength,
+		};
+
+	USBSimTest_Check(USB_Sim_SubmitControlRequest(&Request, Data), bRequest);
+
+	for (uint16_t Timeout = 0; USB_Sim_GetControlStatus() == USB_SIM_CONTROL_Pending; Timeout++)
+	{
+		USBSimTest_Check(Timeout < 1000, bRequest);
+		USBSimTest_RunFrames(1);
+	}
+
+	return USB_Sim_GetControlStatus();
+}
+
+/** Attaches the device to the simulated bus with the given host model, and enumerates it by reading and
+ *  checking its descriptors, assigning it an address and selecting its first configuration.
+ */
+void USBSimTest_Enumerate(const USB_Sim_HostModel_t* const HostModel)
+{
+	USB_Descriptor_Device_t        DeviceDescriptor;
+	USB_Descriptor_Configuration_t ConfigDescriptor;
+	uint8_t                        StringDescriptor[64];
+
+	USB_Init(USB_DEVICE_OPT_FULLSPEED);
+	GlobalInterruptEnable();
+
+	USB_Sim_SetHostModel(HostModel);
+	USB_Sim_Connect();
+	USB_Sim_BusReset();
+	USBSimTest_RunFrames(1);
+
+	USBSimTest_Check(USB_DeviceState == DEVICE_STATE_Default, USB_DeviceState);
+
+	/* Read the start of the device descriptor with the default control endpoint size, then the full descriptor */
+	USBSimTest_Check(USBSimTest_ControlRequest((REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor,
+	                                           (DTYPE_Device << 8), 0, 8, &DeviceDescriptor) == USB_SIM_CONTROL_Complete, 0);
+	USBSimTest_Check(USB_Sim_GetControlBytesTransferred() == 8, USB_Sim_GetControlBytesTransferred());
+
+	USBSimTest_Check(USBSimTest_ControlRequest((REQDIR_HOSTTODEVICE | REQTYPE_STANDARD | REQREC_DEVICE), REQ_SetAddress,
+	                                           USBSIMTEST_DEVICE_ADDRESS, 0, 0, NULL) == USB_SIM_CONTROL_Complete, 0);
+	USBSimTest_Check(USB_DeviceState == DEVICE_STATE_Addressed, USB_DeviceState);
+	USBSimTest_Check(USB_Sim_Controller.Address == USBSIMTEST_DEVICE_ADDRESS, USB_Sim_Controller.Address);
+
+	USBSimTest_Check(USBSimTest_ControlRequest((REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor,
+	                                           (DTYPE_Device << 8), 0, sizeof(DeviceDescriptor), &DeviceDescriptor) == USB_SIM_CONTROL_Complete, 0);
+	USBSimTest_Check(USB_Sim_GetControlBytesTransferred() == sizeof(DeviceDescriptor), USB_Sim_GetControlBytesTransferred());
+	USBSimTest_Check(DeviceDescriptor.Header.Type == DTYPE_Device, DeviceDescriptor.Header.Type);
+	USBSimTest_Check(DeviceDescriptor.VendorID == 0x03EB, DeviceDescriptor.VendorID);
+
+	/* Read the full configuration descriptor, which spans several control packets */
+	USBSimTest_Check(USBSimTest_ControlRequest((REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor,
+	                                           (DTYPE_Configuration << 8), 0, 0xFF, &ConfigDescriptor) == USB_SIM_CONTROL_Complete, 0);
+	USBSimTest_Check(USB_Sim_GetControlBytesTransferred() == sizeof(ConfigDescriptor), USB_Sim_GetControlBytesTransferred());
+	USBSimTest_Check(ConfigDescriptor.Config.TotalConfigurationSize == sizeof(ConfigDescriptor), ConfigDescriptor.Config.TotalConfigurationSize);
+
+	/* Read the product string descriptor, and check that the wide string was encoded as UTF-16 */
+	USBSimTest_Check(USBSimTest_ControlRequest((REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor,
+	                                           ((DTYPE_String << 8) | STRING_ID_Product), LANGUAGE_ID_ENG, sizeof(StringDescriptor),
+	                                           StringDescriptor) == USB_SIM_CONTROL_Complete, 0);
+	USBSimTest_Check((StringDescriptor[1] == DTYPE_String) && (StringDescriptor[2] == 'L') && (StringDescriptor[3] == 0), StringDescriptor[0]);
+
+	/* Requests not supported by the device must be stalled */
+	USBSimTest_Check(USBSimTest_ControlRequest((REQDIR_DEVICETOHOST | REQTYPE_VENDOR | REQREC_DEVICE), 0x55,
+	                                           0, 0, 1, StringDescriptor) == USB_SIM_CONTROL_Stalled, 0);
+
+	USBSimTest_Check(USBSimTest_ControlRequest((REQDIR_HOSTTODEVICE | REQTYPE_STANDARD | REQREC_DEVICE), REQ_SetConfiguration,
+	                                           1, 0, 0, NULL) == USB_SIM_CONTROL_Complete, 0);
+	USBSimTest_Check(USB_DeviceState == DEVICE_STATE_Configured, USB_DeviceState);
+}
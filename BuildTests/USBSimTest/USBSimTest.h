@@ -0,0 +1,77 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+
+/** \file
+ *
+ *  Header file for USBSimTest.c.
+ */
+
+#ifndef _USB_SIM_TEST_H_
+#define _USB_SIM_TEST_H_
+
+	/* Includes: */
+		#include <stdio.h>
+		#include <stdlib.h>
+		#include <stdint.h>
+		#include <stdbool.h>
+		#include <string.h>
+
+		#include <LUFA/Drivers/USB/USB.h>
+
+		#include "Descriptors.h"
+
+	/* Macros: */
+		/** Address the simulated host assigns to the device during enumeration. */
+		#define USBSIMTEST_DEVICE_ADDRESS    5
+
+		/** Checks the given condition, and aborts the test with a message giving the failing condition and value if it is false.
+		 *
+		 *  \param[in] Condition  Condition which must be true for the test to continue.
+		 *  \param[in] Value      Value to report alongside the failed condition.
+		 */
+		#define USBSimTest_Check(Condition, Value)  do { if (!(Condition)) USBSimTest_Fail(#Condition, (Value)); } while (0)
+
+	/* Function Prototypes: */
+		void USBSimTest_Fail(const char* Condition,
+		                     const int32_t Value) ATTR_NO_RETURN;
+		void USBSimTest_Seed(const uint32_t Seed);
+		uint32_t USBSimTest_Random(void);
+		void USBSimTest_RunFrames(const uint16_t Frames);
+		uint8_t USBSimTest_ControlRequest(const uint8_t bmRequestType,
+		                                  const uint8_t bRequest,
+		                                  const uint16_t wValue,
+		                                  const uint16_t wIndex,
+		                                  const uint16_t wLength,
+		                                  void* const Data);
+		void USBSimTest_Enumerate(const USB_Sim_HostModel_t* const HostModel);
+
+#endif
+
@@ -36,6 +36,17 @@
 
 #include "AudioInput.h"
 
+/** Buffer to hold the audio samples to send, filled into the streaming endpoint by the class driver. */
+static uint8_t AudioSampleBuffer[AUDIO_SAMPLE_FIFO_SIZE];
+
+/** Sample FIFO for the audio samples to send, written from the sample reload timer ISR. */
+static Audio_SampleFIFO_t AudioSampleFIFO =
+	{
+		.Buffer          = AudioSampleBuffer,
+		.Size            = sizeof(AudioSampleBuffer),
+		.SampleFrameSize = sizeof(int16_t),
+	};
+
 /** LUFA Audio Class driver interface configuration and state information. This structure is
  *  passed to all Audio Class driver functions, so that multiple instances of the same class
  *  within a device can be differentiated from one another.
@@ -52,6 +63,7 @@ USB_ClassInfo_Audio_Device_t Microphone_Audio_Interface =
 						.Size             = AUDIO_STREAM_EPSIZE,
 						.Banks            = 2,
 					},
+				.INSampleFIFO             = &AudioSampleFIFO,
 			},
 	};
 
@@ -102,10 +114,8 @@ void SetupHardware(void)
 /** ISR to handle the reloading of the data endpoint with the next sample. */
 ISR(TIMER0_COMPA_vect, ISR_BLOCK)
 {
-	uint8_t PrevEndpoint = Endpoint_GetCurrentEndpoint();
-
-	/* Check that the USB bus is ready for the next sample to write */
-	if (Audio_Device_IsReadyForNextSample(&Microphone_Audio_Interface))
+	/* Check that there is space to buffer the next sample to write */
+	if (Audio_Device_IsReadyForNextFIFOSample(&Microphone_Audio_Interface))
 	{
 		int16_t AudioSample;
 
@@ -129,10 +139,8 @@ ISR(TIMER0_COMPA_vect, ISR_BLOCK)
 			#endif
 		#endif
 
-		Audio_Device_WriteSample16(&Microphone_Audio_Interface, AudioSample);
+		Audio_Device_WriteFIFOSample16(&Microphone_Audio_Interface, AudioSample);
 	}
-
-	Endpoint_SelectEndpoint(PrevEndpoint);
 }
 
 /** Event handler for the library USB Connection event. */
@@ -52,6 +52,9 @@
 		#include "Config/AppConfig.h"
 
 	/* Macros: */
+		/** Size in bytes of the audio sample FIFO to send, which must be a power of two. */
+		#define AUDIO_SAMPLE_FIFO_SIZE    512
+
 		/** Maximum audio sample value for the microphone input. */
 		#define SAMPLE_MAX_RANGE          0xFFFF
 
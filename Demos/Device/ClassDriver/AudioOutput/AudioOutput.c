@@ -36,6 +36,17 @@
 
 #include "AudioOutput.h"
 
+/** Buffer to hold the received audio samples, drained from the streaming endpoint by the class driver. */
+static uint8_t AudioSampleBuffer[AUDIO_SAMPLE_FIFO_SIZE];
+
+/** Sample FIFO for the received audio samples, read from the sample reload timer ISR. */
+static Audio_SampleFIFO_t AudioSampleFIFO =
+	{
+		.Buffer          = AudioSampleBuffer,
+		.Size            = sizeof(AudioSampleBuffer),
+		.SampleFrameSize = (2 * sizeof(int16_t)),
+	};
+
 /** LUFA Audio Class driver interface configuration and state information. This structure is
  *  passed to all Audio Class driver functions, so that multiple instances of the same class
  *  within a device can be differentiated from one another.
@@ -52,12 +63,17 @@ USB_ClassInfo_Audio_Device_t Speaker_Audio_Interface =
 						.Size             = AUDIO_STREAM_EPSIZE,
 						.Banks            = 2,
 					},
+				.FeedbackINEndpoint       =
+					{
+						.Address          = AUDIO_FEEDBACK_EPADDR,
+						.Size             = AUDIO_FEEDBACK_EPSIZE,
+						.Banks            = 1,
+					},
+				.OUTSampleFIFO            = &AudioSampleFIFO,
+				.SampleFrequency          = 48000,
 			},
 	};
 
-/** Current audio sampling frequency of the streaming audio endpoint. */
-static uint32_t CurrentAudioSampleFrequency = 48000;
-
 
 /** Main program entry point. This routine contains the overall program flow, including initial
  *  setup of all components and the main program loop.
@@ -96,14 +112,12 @@ void SetupHardware(void)
 /** ISR to handle the reloading of the PWM timer with the next sample. */
 ISR(TIMER0_COMPA_vect, ISR_BLOCK)
 {
-	uint8_t PrevEndpoint = Endpoint_GetCurrentEndpoint();
-
-	/* Check that the USB bus is ready for the next sample to read */
-	if (Audio_Device_IsSampleReceived(&Speaker_Audio_Interface))
+	/* Check that the next sample has been buffered from the USB bus */
+	if (Audio_Device_IsFIFOSampleReceived(&Speaker_Audio_Interface))
 	{
 		/* Retrieve the signed 16-bit left and right audio samples, convert to 8-bit */
-		int8_t LeftSample_8Bit  = (Audio_Device_ReadSample16(&Speaker_Audio_Interface) >> 8);
-		int8_t RightSample_8Bit = (Audio_Device_ReadSample16(&Speaker_Audio_Interface) >> 8);
+		int8_t LeftSample_8Bit  = (Audio_Device_ReadFIFOSample16(&Speaker_Audio_Interface) >> 8);
+		int8_t RightSample_8Bit = (Audio_Device_ReadFIFOSample16(&Speaker_Audio_Interface) >> 8);
 
 		/* Mix the two channels together to produce a mono, 8-bit sample */
 		int8_t MixedSample_8Bit = (((int16_t)LeftSample_8Bit + (int16_t)RightSample_8Bit) >> 1);
@@ -134,8 +148,6 @@ ISR(TIMER0_COMPA_vect, ISR_BLOCK)
 
 		LEDs_SetAllLEDs(LEDMask);
 	}
-
-	Endpoint_SelectEndpoint(PrevEndpoint);
 }
 
 /** Event handler for the library USB Connection event. */
@@ -145,7 +157,7 @@ void EVENT_USB_Device_Connect(void)
 
 	/* Sample reload timer initialization */
 	TIMSK0  = (1 << OCIE0A);
-	OCR0A   = ((F_CPU / 8 / CurrentAudioSampleFrequency) - 1);
+	OCR0A   = ((F_CPU / 8 / Speaker_Audio_Interface.Config.SampleFrequency) - 1);
 	TCCR0A  = (1 << WGM01);  // CTC mode
 	TCCR0B  = (1 << CS01);   // Fcpu/8 speed
 
@@ -251,10 +263,11 @@ bool CALLBACK_Audio_Device_GetSetEndpointProperty(USB_ClassInfo_Audio_Device_t*
 					if (DataLength != NULL)
 					{
 						/* Set the new sampling frequency to the value given by the host */
-						CurrentAudioSampleFrequency = (((uint32_t)Data[2] << 16) | ((uint32_t)Data[1] << 8) | (uint32_t)Data[0]);
+						Speaker_Audio_Interface.Config.SampleFrequency =
+						    (((uint32_t)Data[2] << 16) | ((uint32_t)Data[1] << 8) | (uint32_t)Data[0]);
 
 						/* Adjust sample reload timer to the new frequency */
-						OCR0A = ((F_CPU / 8 / CurrentAudioSampleFrequency) - 1);
+						OCR0A = ((F_CPU / 8 / Speaker_Audio_Interface.Config.SampleFrequency) - 1);
 					}
 
 					return true;
@@ -264,9 +277,9 @@ bool CALLBACK_Audio_Device_GetSetEndpointProperty(USB_ClassInfo_Audio_Device_t*
 					{
 						*DataLength = 3;
 
-						Data[2] = (CurrentAudioSampleFrequency >> 16);
-						Data[1] = (CurrentAudioSampleFrequency >> 8);
-						Data[0] = (CurrentAudioSampleFrequency &  0xFF);
+						Data[2] = (Speaker_Audio_Interface.Config.SampleFrequency >> 16);
+						Data[1] = (Speaker_Audio_Interface.Config.SampleFrequency >> 8);
+						Data[0] = (Speaker_Audio_Interface.Config.SampleFrequency &  0xFF);
 					}
 
 					return true;
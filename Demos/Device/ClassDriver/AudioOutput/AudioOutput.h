@@ -51,6 +51,9 @@
 		#include <LUFA/Platform/Platform.h>
 
 	/* Macros: */
+		/** Size in bytes of the received audio sample FIFO, which must be a power of two. */
+		#define AUDIO_SAMPLE_FIFO_SIZE    1024
+
 		/** LED mask for the library LED driver, to indicate that the USB interface is not ready. */
 		#define LEDMASK_USB_NOTREADY      LEDS_LED1
 
@@ -133,14 +133,14 @@ void SetupHardware(void)
 	USB_Init();
 
 	/* Check if the Dataflash is working, abort if not */
-	if (!(DataflashManager_CheckDataflashOperation()))
+	if (!(DataflashStorage_CheckOperation()))
 	{
 		LEDs_SetAllLEDs(LEDMASK_USB_ERROR);
 		for(;;);
 	}
 
 	/* Clear Dataflash sector protections, if enabled */
-	DataflashManager_ResetDataflashProtections();
+	DataflashStorage_ResetProtections();
 }
 
 /** Event handler for the library USB Connection event. */
@@ -0,0 +1,189 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Internet checksum routines, shared by the IP, ICMP and TCP protocol handlers. The Internet checksum is the complement of the
+ *  one's complement sum of each 16-bit word of the data; as this sum is independent of byte order, all sums here are calculated
+ *  on the words as they are stored in the packet, so that no byte swapping is required.
+ */
+
+#define  INCLUDE_FROM_CHECKSUM_C
+#include "Checksum.h"
+
+/** Adds each 16-bit word of the given data to a partial one's complement sum. A trailing odd byte is treated as if it was
+ *  followed by a zero padding byte, as required for the Internet checksum.
+ *
+ *  \param[in] Data   Pointer to the packet data to add to the sum
+ *  \param[in] Bytes  Number of bytes in the data buffer to process
+ *  \param[in] Sum    Partial sum to add the data to, zero for a new sum
+ *
+ *  \return The partial 16-bit one's complement sum including the given data
+ */
+uint16_t Checksum_Add(const void* Data,
+                      uint16_t Bytes,
+                      uint16_t Sum)
+{
+	const uint8_t* DataBytes = (const uint8_t*)Data;
+
+	#if (ARCH == ARCH_AVR8) || (ARCH == ARCH_XMEGA)
+	/* Add the data in eight byte blocks with the unrolled assembly loop, at most 255 blocks at a time */
+	while (Bytes >= 8)
+	{
+		uint8_t Blocks = ((Bytes >> 3) > 0xFF) ? 0xFF : (Bytes >> 3);
+
+		Sum        = Checksum_AddBlocks(DataBytes, Blocks, Sum);
+		DataBytes += ((uint16_t)Blocks << 3);
+		Bytes     -= ((uint16_t)Blocks << 3);
+	}
+	#endif
+
+	uint32_t Checksum = Sum;
+
+	/* Add the remaining whole words, reading each word in the packet's byte order */
+	while (Bytes >= 2)
+	{
+		uint16_t Word;
+
+		memcpy(&Word, DataBytes, sizeof(uint16_t));
+		Checksum  += Word;
+		DataBytes += 2;
+		Bytes     -= 2;
+	}
+
+	/* Pad a trailing odd byte with a zero byte */
+	if (Bytes)
+	{
+		uint16_t Word = 0;
+
+		memcpy(&Word, DataBytes, sizeof(uint8_t));
+		Checksum += Word;
+	}
+
+	while (Checksum & 0xFFFF0000)
+	  Checksum = ((Checksum & 0xFFFF) + (Checksum >> 16));
+
+	return Checksum;
+}
+
+/** Calculates the Internet checksum of the given data, consisting of the addition of the one's complement of each word,
+ *  complemented.
+ *
+ *  \param[in] Data   Pointer to the packet buffer data whose checksum must be calculated
+ *  \param[in] Bytes  Number of bytes in the data buffer to process
+ *
+ *  \return A 16-bit Internet checksum value
+ */
+uint16_t Checksum_Calculate(const void* Data,
+                            const uint16_t Bytes)
+{
+	return ~Checksum_Add(Data, Bytes, 0);
+}
+
+/** Calculates the partial one's complement sum of the IP pseudo-header covered by the TCP and UDP checksums. The checksum of
+ *  a TCP or UDP packet is then the complement of the packet's sum added to the pseudo-header sum via \ref Checksum_Add().
+ *
+ *  \param[in] SourceAddress       Source protocol IP address of the packet's IP header
+ *  \param[in] DestinationAddress  Destination protocol IP address of the packet's IP header
+ *  \param[in] Protocol            Protocol of the packet, a \c PROTOCOL_* constant
+ *  \param[in] Length              Size in bytes of the packet's protocol header and payload
+ *
+ *  \return The partial 16-bit one's complement sum of the pseudo-header
+ */
+uint16_t Checksum_PseudoHeader(const IP_Address_t* SourceAddress,
+                               const IP_Address_t* DestinationAddress,
+                               const uint8_t Protocol,
+                               const uint16_t Length)
+{
+	uint32_t Checksum = (SwapEndian_16(Protocol) + SwapEndian_16(Length));
+
+	Checksum += Checksum_Add(SourceAddress, sizeof(IP_Address_t), 0);
+	Checksum += Checksum_Add(DestinationAddress, sizeof(IP_Address_t), 0);
+
+	while (Checksum & 0xFFFF0000)
+	  Checksum = ((Checksum & 0xFFFF) + (Checksum >> 16));
+
+	return Checksum;
+}
+
+#if (ARCH == ARCH_AVR8) || (ARCH == ARCH_XMEGA)
+/** Adds each 16-bit word of the given eight byte blocks of data to a partial one's complement sum. The carry out of each word
+ *  addition is added into the following word via a single unbroken chain of add with carry instructions, with the final
+ *  carry wrapped around into the sum once the last block has been added.
+ *
+ *  \param[in] Data    Pointer to the packet data to add to the sum
+ *  \param[in] Blocks  Number of eight byte blocks of data to process, must be non-zero
+ *  \param[in] Sum     Partial sum to add the data to
+ *
+ *  \return The partial 16-bit one's complement sum including the given data
+ */
+static uint16_t Checksum_AddBlocks(const uint8_t* Data,
+                                   uint8_t Blocks,
+                                   uint16_t Sum)
+{
+	uint8_t Temp;
+
+	/* Note that the LD and DEC instructions leave the carry flag unchanged, so that the carry is kept between words and blocks */
+	__asm__ __volatile__ (
+		"clc"                        "\n\t"
+		"1:"                         "\n\t"
+		"ld  %[Temp], %a[Data]+"     "\n\t"
+		"adc %A[Sum], %[Temp]"       "\n\t"
+		"ld  %[Temp], %a[Data]+"     "\n\t"
+		"adc %B[Sum], %[Temp]"       "\n\t"
+		"ld  %[Temp], %a[Data]+"     "\n\t"
+		"adc %A[Sum], %[Temp]"       "\n\t"
+		"ld  %[Temp], %a[Data]+"     "\n\t"
+		"adc %B[Sum], %[Temp]"       "\n\t"
+		"ld  %[Temp], %a[Data]+"     "\n\t"
+		"adc %A[Sum], %[Temp]"       "\n\t"
+		"ld  %[Temp], %a[Data]+"     "\n\t"
+		"adc %B[Sum], %[Temp]"       "\n\t"
+		"ld  %[Temp], %a[Data]+"     "\n\t"
+		"adc %A[Sum], %[Temp]"       "\n\t"
+		"ld  %[Temp], %a[Data]+"     "\n\t"
+		"adc %B[Sum], %[Temp]"       "\n\t"
+		"dec %[Blocks]"              "\n\t"
+		"brne 1b"                    "\n\t"
+		"adc %A[Sum], __zero_reg__"  "\n\t"
+		"adc %B[Sum], __zero_reg__"  "\n\t"
+		"adc %A[Sum], __zero_reg__"  "\n\t"
+		: [Sum]    "+r" (Sum),
+		  [Data]   "+e" (Data),
+		  [Blocks] "+r" (Blocks),
+		  [Temp]   "=&r" (Temp)
+		:
+		: "memory"
+	);
+
+	return Sum;
+}
+#endif
+
@@ -0,0 +1,107 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Header file for Checksum.c.
+ */
+
+#ifndef _CHECKSUM_H_
+#define _CHECKSUM_H_
+
+	/* Includes: */
+		#include <avr/io.h>
+		#include <string.h>
+
+		#include <LUFA/Common/Common.h>
+
+		#include "EthernetProtocols.h"
+
+	/* Inline Functions: */
+		/** Updates an Internet checksum for a change of a single 16-bit word of the data it covers, without recalculating it over
+		 *  the whole of the data, as described in RFC 1624.
+		 *
+		 *  \param[in] Checksum  Existing Internet checksum of the data, as stored in the packet
+		 *  \param[in] OldWord   Previous value of the changed word, as stored in the packet
+		 *  \param[in] NewWord   New value of the changed word, as stored in the packet
+		 *
+		 *  \return The updated 16-bit Internet checksum
+		 */
+		static inline uint16_t Checksum_Update16(const uint16_t Checksum,
+		                                         const uint16_t OldWord,
+		                                         const uint16_t NewWord)
+		{
+			/* RFC 1624 eqn. 3, HC' = ~(~HC + ~m + m'), which never produces a negative zero from a non-zero checksum */
+			uint32_t Sum = ((uint32_t)(uint16_t)~Checksum + (uint16_t)~OldWord + NewWord);
+
+			Sum = ((Sum & 0xFFFF) + (Sum >> 16));
+			Sum = ((Sum & 0xFFFF) + (Sum >> 16));
+
+			return ~Sum;
+		}
+
+		/** Updates an Internet checksum for a change of a single 32-bit value of the data it covers, such as an IP address or a
+		 *  TCP sequence number, without recalculating it over the whole of the data, as described in RFC 1624.
+		 *
+		 *  \param[in] Checksum  Existing Internet checksum of the data, as stored in the packet
+		 *  \param[in] OldValue  Previous value of the changed 32-bit value, as stored in the packet
+		 *  \param[in] NewValue  New value of the changed 32-bit value, as stored in the packet
+		 *
+		 *  \return The updated 16-bit Internet checksum
+		 */
+		static inline uint16_t Checksum_Update32(const uint16_t Checksum,
+		                                         const uint32_t OldValue,
+		                                         const uint32_t NewValue)
+		{
+			return Checksum_Update16(Checksum_Update16(Checksum, (uint16_t)OldValue, (uint16_t)NewValue),
+			                         (uint16_t)(OldValue >> 16), (uint16_t)(NewValue >> 16));
+		}
+
+	/* Function Prototypes: */
+		uint16_t Checksum_Add(const void* Data,
+		                      uint16_t Bytes,
+		                      uint16_t Sum);
+		uint16_t Checksum_Calculate(const void* Data,
+		                            const uint16_t Bytes);
+		uint16_t Checksum_PseudoHeader(const IP_Address_t* SourceAddress,
+		                               const IP_Address_t* DestinationAddress,
+		                               const uint8_t Protocol,
+		                               const uint16_t Length);
+
+		#if defined(INCLUDE_FROM_CHECKSUM_C)
+			#if (ARCH == ARCH_AVR8) || (ARCH == ARCH_XMEGA)
+			static uint16_t Checksum_AddBlocks(const uint8_t* Data,
+			                                   uint8_t Blocks,
+			                                   uint16_t Sum);
+			#endif
+		#endif
+
+#endif
+
@@ -45,6 +45,7 @@
 		#include "Config/AppConfig.h"
 
 		#include "EthernetProtocols.h"
+		#include "Checksum.h"
 		#include "ProtocolDecoders.h"
 		#include "ICMP.h"
 		#include "TCP.h"
@@ -94,8 +95,6 @@
 	/* Function Prototypes: */
 		void     Ethernet_ProcessPacket(Ethernet_Frame_Info_t* const FrameIN,
 		                                Ethernet_Frame_Info_t* const FrameOUT);
-		uint16_t Ethernet_Checksum16(void* Data,
-		                             uint16_t Bytes);
 
 #endif
 
@@ -72,7 +72,9 @@ int16_t ICMP_ProcessICMPPacket(Ethernet_Frame_Info_t* const FrameIN,
 		        &((uint8_t*)InDataStart)[sizeof(ICMP_Header_t)],
 			    DataSize);
 
-		ICMPHeaderOUT->Checksum = Ethernet_Checksum16(ICMPHeaderOUT, (DataSize + sizeof(ICMP_Header_t)));
+		/* The reply differs from the request only in its type and code, so update the request's checksum rather than recalculating
+		   it over the whole echoed payload */
+		ICMPHeaderOUT->Checksum = Checksum_Update16(ICMPHeaderIN->Checksum, ((uint16_t*)ICMPHeaderIN)[0], ((uint16_t*)ICMPHeaderOUT)[0]);
 
 		/* Return the size of the response so far */
 		return (DataSize + sizeof(ICMP_Header_t));
@@ -50,27 +50,64 @@ TCP_PortState_t        PortStateTable[MAX_OPEN_TCP_PORTS];
  */
 TCP_ConnectionState_t  ConnectionStateTable[MAX_TCP_CONNECTIONS];
 
+/** Connection lookup hash table. Each bucket holds the index of the first active connection in the \ref ConnectionStateTable whose
+ *  local port, remote address and remote port hash to the bucket, with further connections chained through each entry's
+ *  \c NextInBucket index, so that a connection can be found without scanning the entire connection state table.
+ */
+static uint8_t         ConnectionHashTable[TCP_CONNECTION_HASH_BUCKETS];
+
+/** Index of the first closed entry in the \ref ConnectionStateTable, with further closed entries chained through each entry's
+ *  \c NextInBucket index.
+ */
+static uint8_t         FreeConnectionList;
+
+/** Timer wheel of connection timeouts. Each slot holds the index of the first connection whose timer expires when the wheel reaches
+ *  the slot, with further connections chained through each entry's \c NextTimer index.
+ */
+static uint8_t         TimerWheel[TCP_TIMER_WHEEL_SLOTS];
+
+/** Index of the timer wheel slot which will be processed on the next timer tick. */
+static uint8_t         TimerWheelPosition;
+
+/** Free running count of elapsed milliseconds, incremented by \ref TCP_MillisecondElapsed(). */
+static volatile uint16_t ElapsedMilliseconds;
+
+/** Value of \ref ElapsedMilliseconds at the last timer wheel tick. */
+static uint16_t        LastTimerTick;
+
 
 /** Task to handle the calling of each registered application's callback function, to process and generate TCP packets at the application
  *  level. If an application produces a response, this task constructs the appropriate Ethernet frame and places it into the Ethernet OUT
- *  buffer for later transmission.
+ *  buffer for later transmission. This task also advances the connection timer wheel, closing connections which have timed out.
  */
 void TCP_TCPTask(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
 		         Ethernet_Frame_Info_t* const FrameOUT)
 {
+	uint16_t CurrentMilliseconds;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		CurrentMilliseconds = ElapsedMilliseconds;
+	}
+
+	/* Advance the timer wheel by one slot for each timer tick period which has elapsed */
+	while ((uint16_t)(CurrentMilliseconds - LastTimerTick) >= TCP_TIMER_TICK_MS)
+	{
+		LastTimerTick += TCP_TIMER_TICK_MS;
+		TCP_TimerTick();
+	}
+
 	/* Run each application in sequence, to process incoming and generate outgoing packets */
-	for (uint8_t CSTableEntry = 0; CSTableEntry < MAX_TCP_CONNECTIONS; CSTableEntry++)
+	for (uint8_t Bucket = 0; Bucket < TCP_CONNECTION_HASH_BUCKETS; Bucket++)
 	{
-		/* Find the corresponding port entry in the port table */
-		for (uint8_t PTableEntry = 0; PTableEntry < MAX_OPEN_TCP_PORTS; PTableEntry++)
+		for (uint8_t CSTableEntry = ConnectionHashTable[Bucket]; CSTableEntry != TCP_NO_CONNECTION;
+		     CSTableEntry = ConnectionStateTable[CSTableEntry].NextInBucket)
 		{
-			/* Run the application handler for the port */
-			if ((PortStateTable[PTableEntry].Port  == ConnectionStateTable[CSTableEntry].Port) &&
-			    (PortStateTable[PTableEntry].State == TCP_Port_Open))
-			{
-				PortStateTable[PTableEntry].ApplicationHandler(&ConnectionStateTable[CSTableEntry],
-				                                               &ConnectionStateTable[CSTableEntry].Info.Buffer);
-			}
+			TCP_ConnectionState_t* Connection = &ConnectionStateTable[CSTableEntry];
+
+			/* Run the application handler for the connection's port */
+			if (TCP_IsConnectionPortOpen(Connection))
+			  PortStateTable[Connection->PortEntry].ApplicationHandler(Connection, &Connection->Info.Buffer);
 		}
 	}
 
@@ -79,80 +116,93 @@ void TCP_TCPTask(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
 	  return;
 
 	/* Send response packets from each application as the TCP packet buffers are filled by the applications */
-	for (uint8_t CSTableEntry = 0; CSTableEntry < MAX_TCP_CONNECTIONS; CSTableEntry++)
+	for (uint8_t Bucket = 0; Bucket < TCP_CONNECTION_HASH_BUCKETS; Bucket++)
 	{
-		/* For each completely received packet, pass it along to the listening application */
-		if ((ConnectionStateTable[CSTableEntry].Info.Buffer.Direction == TCP_PACKETDIR_OUT) &&
-		    (ConnectionStateTable[CSTableEntry].Info.Buffer.Ready))
+		for (uint8_t CSTableEntry = ConnectionHashTable[Bucket]; CSTableEntry != TCP_NO_CONNECTION;
+		     CSTableEntry = ConnectionStateTable[CSTableEntry].NextInBucket)
 		{
-			Ethernet_Frame_Header_t* FrameOUTHeader = (Ethernet_Frame_Header_t*)&FrameOUT->FrameData;
-			IP_Header_t*             IPHeaderOUT    = (IP_Header_t*)&FrameOUT->FrameData[sizeof(Ethernet_Frame_Header_t)];
-			TCP_Header_t*            TCPHeaderOUT   = (TCP_Header_t*)&FrameOUT->FrameData[sizeof(Ethernet_Frame_Header_t) +
-			                                                                              sizeof(IP_Header_t)];
-			void*                    TCPDataOUT     = &FrameOUT->FrameData[sizeof(Ethernet_Frame_Header_t) +
-			                                                               sizeof(IP_Header_t) +
-			                                                               sizeof(TCP_Header_t)];
-
-			uint16_t PacketSize = ConnectionStateTable[CSTableEntry].Info.Buffer.Length;
-
-			/* Fill out the TCP data */
-			TCPHeaderOUT->SourcePort           = ConnectionStateTable[CSTableEntry].Port;
-			TCPHeaderOUT->DestinationPort      = ConnectionStateTable[CSTableEntry].RemotePort;
-			TCPHeaderOUT->SequenceNumber       = SwapEndian_32(ConnectionStateTable[CSTableEntry].Info.SequenceNumberOut);
-			TCPHeaderOUT->AcknowledgmentNumber = SwapEndian_32(ConnectionStateTable[CSTableEntry].Info.SequenceNumberIn);
-			TCPHeaderOUT->DataOffset           = (sizeof(TCP_Header_t) / sizeof(uint32_t));
-			TCPHeaderOUT->WindowSize           = SwapEndian_16(TCP_WINDOW_SIZE);
-
-			TCPHeaderOUT->Flags                = TCP_FLAG_ACK;
-			TCPHeaderOUT->UrgentPointer        = 0;
-			TCPHeaderOUT->Checksum             = 0;
-			TCPHeaderOUT->Reserved             = 0;
-
-			memcpy(TCPDataOUT, ConnectionStateTable[CSTableEntry].Info.Buffer.Data, PacketSize);
-
-			ConnectionStateTable[CSTableEntry].Info.SequenceNumberOut += PacketSize;
-
-			TCPHeaderOUT->Checksum             = TCP_Checksum16(TCPHeaderOUT, &ServerIPAddress,
-			                                                    &ConnectionStateTable[CSTableEntry].RemoteAddress,
-			                                                    (sizeof(TCP_Header_t) + PacketSize));
-
-			PacketSize += sizeof(TCP_Header_t);
-
-			/* Fill out the response IP header */
-			IPHeaderOUT->TotalLength        = SwapEndian_16(sizeof(IP_Header_t) + PacketSize);
-			IPHeaderOUT->TypeOfService      = 0;
-			IPHeaderOUT->HeaderLength       = (sizeof(IP_Header_t) / sizeof(uint32_t));
-			IPHeaderOUT->Version            = 4;
-			IPHeaderOUT->Flags              = 0;
-			IPHeaderOUT->FragmentOffset     = 0;
-			IPHeaderOUT->Identification     = 0;
-			IPHeaderOUT->HeaderChecksum     = 0;
-			IPHeaderOUT->Protocol           = PROTOCOL_TCP;
-			IPHeaderOUT->TTL                = DEFAULT_TTL;
-			IPHeaderOUT->SourceAddress      = ServerIPAddress;
-			IPHeaderOUT->DestinationAddress = ConnectionStateTable[CSTableEntry].RemoteAddress;
-
-			IPHeaderOUT->HeaderChecksum     = Ethernet_Checksum16(IPHeaderOUT, sizeof(IP_Header_t));
-
-			PacketSize += sizeof(IP_Header_t);
-
-			/* Fill out the response Ethernet frame header */
-			FrameOUTHeader->Source          = ServerMACAddress;
-			FrameOUTHeader->Destination     = (MAC_Address_t){{0x02, 0x00, 0x02, 0x00, 0x02, 0x00}};
-			FrameOUTHeader->EtherType       = SwapEndian_16(ETHERTYPE_IPV4);
-
-			PacketSize += sizeof(Ethernet_Frame_Header_t);
-
-			/* Set the response length in the buffer and indicate that a response is ready to be sent */
-			FrameOUT->FrameLength           = PacketSize;
-
-			ConnectionStateTable[CSTableEntry].Info.Buffer.Ready = false;
-
-			break;
+			TCP_ConnectionState_t* Connection = &ConnectionStateTable[CSTableEntry];
+
+			/* For each completely received packet, pass it along to the listening application */
+			if ((Connection->Info.Buffer.Direction == TCP_PACKETDIR_OUT) && (Connection->Info.Buffer.Ready))
+			{
+				Ethernet_Frame_Header_t* FrameOUTHeader = (Ethernet_Frame_Header_t*)&FrameOUT->FrameData;
+				IP_Header_t*             IPHeaderOUT    = (IP_Header_t*)&FrameOUT->FrameData[sizeof(Ethernet_Frame_Header_t)];
+				TCP_Header_t*            TCPHeaderOUT   = (TCP_Header_t*)&FrameOUT->FrameData[sizeof(Ethernet_Frame_Header_t) +
+				                                                                              sizeof(IP_Header_t)];
+				void*                    TCPDataOUT     = &FrameOUT->FrameData[sizeof(Ethernet_Frame_Header_t) +
+				                                                               sizeof(IP_Header_t) +
+				                                                               sizeof(TCP_Header_t)];
+
+				uint16_t PacketSize = Connection->Info.Buffer.Length;
+
+				/* Fill out the TCP data */
+				TCPHeaderOUT->SourcePort           = Connection->Port;
+				TCPHeaderOUT->DestinationPort      = Connection->RemotePort;
+				TCPHeaderOUT->SequenceNumber       = SwapEndian_32(Connection->Info.SequenceNumberOut);
+				TCPHeaderOUT->AcknowledgmentNumber = SwapEndian_32(Connection->Info.SequenceNumberIn);
+				TCPHeaderOUT->DataOffset           = (sizeof(TCP_Header_t) / sizeof(uint32_t));
+				TCPHeaderOUT->WindowSize           = SwapEndian_16(TCP_WINDOW_SIZE);
+
+				TCPHeaderOUT->Flags                = TCP_FLAG_ACK;
+				TCPHeaderOUT->UrgentPointer        = 0;
+				TCPHeaderOUT->Checksum             = 0;
+				TCPHeaderOUT->Reserved             = 0;
+
+				memcpy(TCPDataOUT, Connection->Info.Buffer.Data, PacketSize);
+
+				Connection->Info.SequenceNumberOut += PacketSize;
+
+				TCPHeaderOUT->Checksum             = ~Checksum_Add(TCPHeaderOUT, (sizeof(TCP_Header_t) + PacketSize),
+				                                                   Checksum_PseudoHeader(&ServerIPAddress, &Connection->RemoteAddress,
+				                                                                         PROTOCOL_TCP, (sizeof(TCP_Header_t) + PacketSize)));
+
+				PacketSize += sizeof(TCP_Header_t);
+
+				/* Fill out the response IP header */
+				IPHeaderOUT->TotalLength        = SwapEndian_16(sizeof(IP_Header_t) + PacketSize);
+				IPHeaderOUT->TypeOfService      = 0;
+				IPHeaderOUT->HeaderLength       = (sizeof(IP_Header_t) / sizeof(uint32_t));
+				IPHeaderOUT->Version            = 4;
+				IPHeaderOUT->Flags              = 0;
+				IPHeaderOUT->FragmentOffset     = 0;
+				IPHeaderOUT->Identification     = 0;
+				IPHeaderOUT->HeaderChecksum     = 0;
+				IPHeaderOUT->Protocol           = PROTOCOL_TCP;
+				IPHeaderOUT->TTL                = DEFAULT_TTL;
+				IPHeaderOUT->SourceAddress      = ServerIPAddress;
+				IPHeaderOUT->DestinationAddress = Connection->RemoteAddress;
+
+				IPHeaderOUT->HeaderChecksum     = Checksum_Calculate(IPHeaderOUT, sizeof(IP_Header_t));
+
+				PacketSize += sizeof(IP_Header_t);
+
+				/* Fill out the response Ethernet frame header */
+				FrameOUTHeader->Source          = ServerMACAddress;
+				FrameOUTHeader->Destination     = (MAC_Address_t){{0x02, 0x00, 0x02, 0x00, 0x02, 0x00}};
+				FrameOUTHeader->EtherType       = SwapEndian_16(ETHERTYPE_IPV4);
+
+				PacketSize += sizeof(Ethernet_Frame_Header_t);
+
+				/* Set the response length in the buffer and indicate that a response is ready to be sent */
+				FrameOUT->FrameLength           = PacketSize;
+
+				Connection->Info.Buffer.Ready = false;
+
+				return;
+			}
 		}
 	}
 }
 
+/** Millisecond timer event handler for the TCP protocol handler. This should be called once every millisecond, typically from the
+ *  USB Start of Frame event, to provide the time base for the connection timeouts.
+ */
+void TCP_MillisecondElapsed(void)
+{
+	ElapsedMilliseconds++;
+}
+
 /** Initializes the TCP protocol handler, clearing the port and connection state tables. This must be called before TCP packets are
  *  processed.
  */
@@ -162,9 +212,26 @@ void TCP_Init(void)
 	for (uint8_t PTableEntry = 0; PTableEntry < MAX_OPEN_TCP_PORTS; PTableEntry++)
 	  PortStateTable[PTableEntry].State = TCP_Port_Closed;
 
-	/* Initialize the connection table with all CLOSED entries */
+	/* Initialize the connection table with all CLOSED entries, chained together into the free connection list */
 	for (uint8_t CSTableEntry = 0; CSTableEntry < MAX_TCP_CONNECTIONS; CSTableEntry++)
-	  ConnectionStateTable[CSTableEntry].State = TCP_Connection_Closed;
+	{
+		ConnectionStateTable[CSTableEntry].State        = TCP_Connection_Closed;
+		ConnectionStateTable[CSTableEntry].TimerSlot    = TCP_TIMER_NOT_ARMED;
+		ConnectionStateTable[CSTableEntry].NextInBucket = ((CSTableEntry + 1) < MAX_TCP_CONNECTIONS) ? (CSTableEntry + 1) : TCP_NO_CONNECTION;
+	}
+
+	FreeConnectionList = 0;
+
+	/* Initialize the connection lookup hash table and timer wheel with all empty entries */
+	memset(ConnectionHashTable, TCP_NO_CONNECTION, sizeof(ConnectionHashTable));
+	memset(TimerWheel, TCP_NO_CONNECTION, sizeof(TimerWheel));
+
+	TimerWheelPosition = 0;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		LastTimerTick = ElapsedMilliseconds;
+	}
 }
 
 /** Sets the state and callback handler of the given port, specified in big endian to the given state.
@@ -256,32 +323,22 @@ bool TCP_SetConnectionState(const uint16_t Port,
 {
 	/* Note, Port number should be specified in BIG endian to simplify network code */
 
-	for (uint8_t CSTableEntry = 0; CSTableEntry < MAX_TCP_CONNECTIONS; CSTableEntry++)
-	{
-		/* Find port entry in the table */
-		if ((ConnectionStateTable[CSTableEntry].Port == Port) &&
-		     IP_COMPARE(&ConnectionStateTable[CSTableEntry].RemoteAddress, RemoteAddress) &&
-			 ConnectionStateTable[CSTableEntry].RemotePort == RemotePort)
-		{
-			ConnectionStateTable[CSTableEntry].State = State;
-			return true;
-		}
-	}
+	TCP_ConnectionState_t* Connection = TCP_FindConnection(Port, RemoteAddress, RemotePort);
 
-	for (uint8_t CSTableEntry = 0; CSTableEntry < MAX_TCP_CONNECTIONS; CSTableEntry++)
+	/* Closing a connection returns its entry to the free connection list */
+	if (State == TCP_Connection_Closed)
 	{
-		/* Find empty entry in the table */
-		if (ConnectionStateTable[CSTableEntry].State == TCP_Connection_Closed)
-		{
-			ConnectionStateTable[CSTableEntry].Port          = Port;
-			ConnectionStateTable[CSTableEntry].RemoteAddress = *RemoteAddress;
-			ConnectionStateTable[CSTableEntry].RemotePort    = RemotePort;
-			ConnectionStateTable[CSTableEntry].State         = State;
-			return true;
-		}
+		if (Connection)
+		  TCP_ReleaseConnection(Connection);
+
+		return true;
 	}
 
-	return false;
+	if (!(Connection) && !(Connection = TCP_CreateConnection(Port, RemoteAddress, RemotePort)))
+	  return false;
+
+	Connection->State = State;
+	return true;
 }
 
 /** Retrieves the current state of a given TCP connection to a host.
@@ -298,19 +355,9 @@ uint8_t TCP_GetConnectionState(const uint16_t Port,
 {
 	/* Note, Port number should be specified in BIG endian to simplify network code */
 
-	for (uint8_t CSTableEntry = 0; CSTableEntry < MAX_TCP_CONNECTIONS; CSTableEntry++)
-	{
-		/* Find port entry in the table */
-		if ((ConnectionStateTable[CSTableEntry].Port == Port) &&
-		     IP_COMPARE(&ConnectionStateTable[CSTableEntry].RemoteAddress, RemoteAddress) &&
-			 ConnectionStateTable[CSTableEntry].RemotePort == RemotePort)
-
-		{
-			return ConnectionStateTable[CSTableEntry].State;
-		}
-	}
+	TCP_ConnectionState_t* Connection = TCP_FindConnection(Port, RemoteAddress, RemotePort);
 
-	return TCP_Connection_Closed;
+	return (Connection ? Connection->State : TCP_Connection_Closed);
 }
 
 /** Retrieves the connection info structure of a given connection to a host.
@@ -327,18 +374,9 @@ TCP_ConnectionInfo_t* TCP_GetConnectionInfo(const uint16_t Port,
 {
 	/* Note, Port number should be specified in BIG endian to simplify network code */
 
-	for (uint8_t CSTableEntry = 0; CSTableEntry < MAX_TCP_CONNECTIONS; CSTableEntry++)
-	{
-		/* Find port entry in the table */
-		if ((ConnectionStateTable[CSTableEntry].Port == Port) &&
-		     IP_COMPARE(&ConnectionStateTable[CSTableEntry].RemoteAddress, RemoteAddress) &&
-			 ConnectionStateTable[CSTableEntry].RemotePort == RemotePort)
-		{
-			return &ConnectionStateTable[CSTableEntry].Info;
-		}
-	}
+	TCP_ConnectionState_t* Connection = TCP_FindConnection(Port, RemoteAddress, RemotePort);
 
-	return NULL;
+	return (Connection ? &Connection->Info : NULL);
 }
 
 /** Processes a TCP packet inside an Ethernet frame, and writes the appropriate response
@@ -360,53 +398,65 @@ int16_t TCP_ProcessTCPPacket(void* IPHeaderInStart,
 	TCP_Header_t* TCPHeaderIN  = (TCP_Header_t*)TCPHeaderInStart;
 	TCP_Header_t* TCPHeaderOUT = (TCP_Header_t*)TCPHeaderOutStart;
 
-	TCP_ConnectionInfo_t* ConnectionInfo;
+	TCP_ConnectionState_t* Connection;
+	TCP_ConnectionInfo_t*  ConnectionInfo;
 
 	DecodeTCPHeader(TCPHeaderInStart);
 
 	bool PacketResponse = false;
 
+	/* Look up the existing connection for the sender and port, if any, once for the whole packet */
+	Connection = TCP_FindConnection(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress, TCPHeaderIN->SourcePort);
+
 	/* Check if the destination port is open and allows incoming connections */
-	if (TCP_GetPortState(TCPHeaderIN->DestinationPort) == TCP_Port_Open)
+	if ((Connection && TCP_IsConnectionPortOpen(Connection)) || (TCP_GetPortState(TCPHeaderIN->DestinationPort) == TCP_Port_Open))
 	{
 		/* Detect SYN from host to start a connection */
 		if (TCPHeaderIN->Flags & TCP_FLAG_SYN)
-		  TCP_SetConnectionState(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress, TCPHeaderIN->SourcePort, TCP_Connection_Listen);
+		{
+			if (!(Connection))
+			  Connection = TCP_CreateConnection(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress, TCPHeaderIN->SourcePort);
+
+			if (Connection)
+			  Connection->State = TCP_Connection_Listen;
+		}
 
-		/* Detect RST from host to abort existing connection */
-		if (TCPHeaderIN->Flags & TCP_FLAG_RST)
+		if (!(Connection))
 		{
-			if (TCP_SetConnectionState(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-			                           TCPHeaderIN->SourcePort, TCP_Connection_Closed))
+			/* Unknown connection or no more space in the connection state table, reset the sender unless it is already resetting */
+			if (!(TCPHeaderIN->Flags & TCP_FLAG_RST))
 			{
 				TCPHeaderOUT->Flags = (TCP_FLAG_RST | TCP_FLAG_ACK);
-				PacketResponse = true;
+				PacketResponse      = true;
 			}
 		}
+		else if (TCPHeaderIN->Flags & TCP_FLAG_RST)
+		{
+			/* Detect RST from host to abort existing connection */
+			TCP_ReleaseConnection(Connection);
+
+			TCPHeaderOUT->Flags = (TCP_FLAG_RST | TCP_FLAG_ACK);
+			PacketResponse = true;
+		}
 		else
 		{
+			ConnectionInfo = &Connection->Info;
+
 			/* Process the incoming TCP packet based on the current connection state for the sender and port */
-			switch (TCP_GetConnectionState(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress, TCPHeaderIN->SourcePort))
+			switch (Connection->State)
 			{
 				case TCP_Connection_Listen:
 					if (TCPHeaderIN->Flags == TCP_FLAG_SYN)
 					{
 						/* SYN connection starts a connection with a peer */
-						if (TCP_SetConnectionState(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-						                           TCPHeaderIN->SourcePort, TCP_Connection_SYNReceived))
-						{
-							TCPHeaderOUT->Flags = (TCP_FLAG_SYN | TCP_FLAG_ACK);
+						Connection->State   = TCP_Connection_SYNReceived;
 
-							ConnectionInfo = TCP_GetConnectionInfo(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress, TCPHeaderIN->SourcePort);
+						TCPHeaderOUT->Flags = (TCP_FLAG_SYN | TCP_FLAG_ACK);
 
-							ConnectionInfo->SequenceNumberIn  = (SwapEndian_32(TCPHeaderIN->SequenceNumber) + 1);
-							ConnectionInfo->SequenceNumberOut = 0;
-							ConnectionInfo->Buffer.InUse      = false;
-						}
-						else
-						{
-							TCPHeaderOUT->Flags = TCP_FLAG_RST;
-						}
+						ConnectionInfo->SequenceNumberIn  = (SwapEndian_32(TCPHeaderIN->SequenceNumber) + 1);
+						ConnectionInfo->SequenceNumberOut = 0;
+						ConnectionInfo->Buffer.InUse      = false;
+						ConnectionInfo->Buffer.Ready      = false;
 
 						PacketResponse      = true;
 					}
@@ -416,12 +466,7 @@ int16_t TCP_ProcessTCPPacket(void* IPHeaderInStart,
 					if (TCPHeaderIN->Flags == TCP_FLAG_ACK)
 					{
 						/* ACK during the connection process completes the connection to a peer */
-
-						TCP_SetConnectionState(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-											   TCPHeaderIN->SourcePort, TCP_Connection_Established);
-
-						ConnectionInfo = TCP_GetConnectionInfo(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-															   TCPHeaderIN->SourcePort);
+						Connection->State = TCP_Connection_Established;
 
 						ConnectionInfo->SequenceNumberOut++;
 					}
@@ -435,20 +480,13 @@ int16_t TCP_ProcessTCPPacket(void* IPHeaderInStart,
 						TCPHeaderOUT->Flags = (TCP_FLAG_FIN | TCP_FLAG_ACK);
 						PacketResponse      = true;
 
-						TCP_SetConnectionState(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-											   TCPHeaderIN->SourcePort, TCP_Connection_CloseWait);
-
-						ConnectionInfo = TCP_GetConnectionInfo(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-															   TCPHeaderIN->SourcePort);
+						Connection->State   = TCP_Connection_CloseWait;
 
 						ConnectionInfo->SequenceNumberIn++;
 						ConnectionInfo->SequenceNumberOut++;
 					}
 					else if ((TCPHeaderIN->Flags == TCP_FLAG_ACK) || (TCPHeaderIN->Flags == (TCP_FLAG_ACK | TCP_FLAG_PSH)))
 					{
-						ConnectionInfo = TCP_GetConnectionInfo(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-															   TCPHeaderIN->SourcePort);
-
 						/* Check if the buffer is currently in use either by a buffered data to send, or receive */
 						if ((ConnectionInfo->Buffer.InUse == false) && (ConnectionInfo->Buffer.Ready == false))
 						{
@@ -492,66 +530,54 @@ int16_t TCP_ProcessTCPPacket(void* IPHeaderInStart,
 
 					break;
 				case TCP_Connection_Closing:
-						ConnectionInfo = TCP_GetConnectionInfo(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-															   TCPHeaderIN->SourcePort);
-
 						TCPHeaderOUT->Flags = (TCP_FLAG_ACK | TCP_FLAG_FIN);
 						PacketResponse      = true;
 
 						ConnectionInfo->Buffer.InUse = false;
 
-						TCP_SetConnectionState(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-											   TCPHeaderIN->SourcePort, TCP_Connection_FINWait1);
+						Connection->State   = TCP_Connection_FINWait1;
 
 					break;
 				case TCP_Connection_FINWait1:
+				case TCP_Connection_FINWait2:
 					if (TCPHeaderIN->Flags == (TCP_FLAG_FIN | TCP_FLAG_ACK))
 					{
-						ConnectionInfo = TCP_GetConnectionInfo(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-															   TCPHeaderIN->SourcePort);
-
+						/* FIN ACK from the peer completes the finalization process, linger until any retransmitted FIN has been seen */
 						TCPHeaderOUT->Flags = TCP_FLAG_ACK;
 						PacketResponse      = true;
 
 						ConnectionInfo->SequenceNumberIn++;
 						ConnectionInfo->SequenceNumberOut++;
 
-						TCP_SetConnectionState(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-											   TCPHeaderIN->SourcePort, TCP_Connection_Closed);
+						Connection->State   = TCP_Connection_TimeWait;
 					}
-					else if (TCPHeaderIN->Flags == TCP_FLAG_ACK)
+					else if ((TCPHeaderIN->Flags == TCP_FLAG_ACK) && (Connection->State == TCP_Connection_FINWait1))
 					{
-						TCP_SetConnectionState(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-											   TCPHeaderIN->SourcePort, TCP_Connection_FINWait2);
+						Connection->State   = TCP_Connection_FINWait2;
 					}
 
 					break;
-				case TCP_Connection_FINWait2:
+				case TCP_Connection_CloseWait:
+					if (TCPHeaderIN->Flags == TCP_FLAG_ACK)
+					  TCP_ReleaseConnection(Connection);
+
+					break;
+				case TCP_Connection_TimeWait:
 					if (TCPHeaderIN->Flags == (TCP_FLAG_FIN | TCP_FLAG_ACK))
 					{
-						ConnectionInfo = TCP_GetConnectionInfo(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-															   TCPHeaderIN->SourcePort);
-
+						/* Peer did not see our final ACK and retransmitted its FIN ACK, acknowledge it again */
 						TCPHeaderOUT->Flags = TCP_FLAG_ACK;
 						PacketResponse      = true;
-
-						ConnectionInfo->SequenceNumberIn++;
-						ConnectionInfo->SequenceNumberOut++;
-
-						TCP_SetConnectionState(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-											   TCPHeaderIN->SourcePort, TCP_Connection_Closed);
-					}
-
-					break;
-				case TCP_Connection_CloseWait:
-					if (TCPHeaderIN->Flags == TCP_FLAG_ACK)
-					{
-						TCP_SetConnectionState(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-											   TCPHeaderIN->SourcePort, TCP_Connection_Closed);
 					}
 
 					break;
 			}
+
+			/* Restart the connection's timeout now that the peer has been heard from */
+			if (Connection->State == TCP_Connection_TimeWait)
+			  TCP_StartTimer(Connection, TCP_TIME_WAIT_TICKS);
+			else if (Connection->State != TCP_Connection_Closed)
+			  TCP_StartTimer(Connection, TCP_CONNECTION_TIMEOUT_TICKS);
 		}
 	}
 	else
@@ -564,26 +590,38 @@ int16_t TCP_ProcessTCPPacket(void* IPHeaderInStart,
 	/* Check if we need to respond to the sent packet */
 	if (PacketResponse)
 	{
-		ConnectionInfo = TCP_GetConnectionInfo(TCPHeaderIN->DestinationPort, &IPHeaderIN->SourceAddress,
-		                                       TCPHeaderIN->SourcePort);
-
 		TCPHeaderOUT->SourcePort           = TCPHeaderIN->DestinationPort;
 		TCPHeaderOUT->DestinationPort      = TCPHeaderIN->SourcePort;
-		TCPHeaderOUT->SequenceNumber       = SwapEndian_32(ConnectionInfo->SequenceNumberOut);
-		TCPHeaderOUT->AcknowledgmentNumber = SwapEndian_32(ConnectionInfo->SequenceNumberIn);
 		TCPHeaderOUT->DataOffset           = (sizeof(TCP_Header_t) / sizeof(uint32_t));
 
-		if (!(ConnectionInfo->Buffer.InUse))
-		  TCPHeaderOUT->WindowSize         = SwapEndian_16(TCP_WINDOW_SIZE);
+		if (Connection)
+		{
+			/* Entries of closed connections retain their sequence numbers until reused by a new connection */
+			ConnectionInfo = &Connection->Info;
+
+			TCPHeaderOUT->SequenceNumber       = SwapEndian_32(ConnectionInfo->SequenceNumberOut);
+			TCPHeaderOUT->AcknowledgmentNumber = SwapEndian_32(ConnectionInfo->SequenceNumberIn);
+
+			if (!(ConnectionInfo->Buffer.InUse))
+			  TCPHeaderOUT->WindowSize         = SwapEndian_16(TCP_WINDOW_SIZE);
+			else
+			  TCPHeaderOUT->WindowSize         = SwapEndian_16(TCP_WINDOW_SIZE - ConnectionInfo->Buffer.Length);
+		}
 		else
-		  TCPHeaderOUT->WindowSize         = SwapEndian_16(TCP_WINDOW_SIZE - ConnectionInfo->Buffer.Length);
+		{
+			/* No connection to take the sequence numbers from, so reset using the sender's own sequence numbers */
+			TCPHeaderOUT->SequenceNumber       = TCPHeaderIN->AcknowledgmentNumber;
+			TCPHeaderOUT->AcknowledgmentNumber = TCPHeaderIN->SequenceNumber;
+			TCPHeaderOUT->WindowSize           = 0;
+		}
 
 		TCPHeaderOUT->UrgentPointer        = 0;
 		TCPHeaderOUT->Checksum             = 0;
 		TCPHeaderOUT->Reserved             = 0;
 
-		TCPHeaderOUT->Checksum             = TCP_Checksum16(TCPHeaderOUT, &IPHeaderIN->DestinationAddress,
-		                                                    &IPHeaderIN->SourceAddress, sizeof(TCP_Header_t));
+		TCPHeaderOUT->Checksum             = ~Checksum_Add(TCPHeaderOUT, sizeof(TCP_Header_t),
+		                                                   Checksum_PseudoHeader(&IPHeaderIN->DestinationAddress, &IPHeaderIN->SourceAddress,
+		                                                                         PROTOCOL_TCP, sizeof(TCP_Header_t)));
 
 		return sizeof(TCP_Header_t);
 	}
@@ -591,42 +629,204 @@ int16_t TCP_ProcessTCPPacket(void* IPHeaderInStart,
 	return NO_RESPONSE;
 }
 
-/** Calculates the appropriate TCP checksum, consisting of the addition of the one's compliment of each word,
- *  complimented.
+/** Calculates the connection lookup hash table bucket of a given connection to a host.
+ *
+ *  \param[in] Port           TCP port on the device in the connection, specified in big endian
+ *  \param[in] RemoteAddress  Remote protocol IP address of the connected host
+ *  \param[in] RemotePort     Remote TCP port of the connected host, specified in big endian
+ *
+ *  \return Index of the connection's bucket in the connection lookup hash table
+ */
+static uint8_t TCP_ConnectionHash(const uint16_t Port,
+                                  const IP_Address_t* RemoteAddress,
+                                  const uint16_t RemotePort)
+{
+	uint8_t Hash = (RemoteAddress->Octets[0] ^ RemoteAddress->Octets[1] ^ RemoteAddress->Octets[2] ^ RemoteAddress->Octets[3]);
+
+	Hash ^= (uint8_t)(RemotePort ^ (RemotePort >> 8));
+	Hash ^= (uint8_t)(Port ^ (Port >> 8));
+
+	return (Hash & (TCP_CONNECTION_HASH_BUCKETS - 1));
+}
+
+/** Finds the connection state table entry of a given connection to a host, via the connection lookup hash table.
+ *
+ *  \param[in] Port           TCP port on the device in the connection, specified in big endian
+ *  \param[in] RemoteAddress  Remote protocol IP address of the connected host
+ *  \param[in] RemotePort     Remote TCP port of the connected host, specified in big endian
+ *
+ *  \return Pointer to the connection's state table entry if found, NULL otherwise
+ */
+static TCP_ConnectionState_t* TCP_FindConnection(const uint16_t Port,
+                                                 const IP_Address_t* RemoteAddress,
+                                                 const uint16_t RemotePort)
+{
+	for (uint8_t CSTableEntry = ConnectionHashTable[TCP_ConnectionHash(Port, RemoteAddress, RemotePort)];
+	     CSTableEntry != TCP_NO_CONNECTION; CSTableEntry = ConnectionStateTable[CSTableEntry].NextInBucket)
+	{
+		TCP_ConnectionState_t* Connection = &ConnectionStateTable[CSTableEntry];
+
+		if ((Connection->Port == Port) && (Connection->RemotePort == RemotePort) &&
+		    IP_COMPARE(&Connection->RemoteAddress, RemoteAddress))
+		{
+			return Connection;
+		}
+	}
+
+	return NULL;
+}
+
+/** Creates a new connection to a host, taking a closed entry from the free connection list and adding it to the connection
+ *  lookup hash table. The new connection is left in the \ref TCP_Connection_Closed state for the caller to update.
  *
- *  \param[in] TCPHeaderOutStart   Pointer to the start of the packet's outgoing TCP header
- *  \param[in] SourceAddress       Source protocol IP address of the outgoing IP header
- *  \param[in] DestinationAddress  Destination protocol IP address of the outgoing IP header
- *  \param[in] TCPOutSize          Size in bytes of the TCP data header and payload
+ *  \param[in] Port           TCP port on the device in the connection, specified in big endian
+ *  \param[in] RemoteAddress  Remote protocol IP address of the connected host
+ *  \param[in] RemotePort     Remote TCP port of the connected host, specified in big endian
  *
- *  \return A 16-bit TCP checksum value
+ *  \return Pointer to the new connection's state table entry, NULL if no more space in the connection state table
  */
-static uint16_t TCP_Checksum16(void* TCPHeaderOutStart,
-                               const IP_Address_t* SourceAddress,
-                               const IP_Address_t* DestinationAddress,
-                               uint16_t TCPOutSize)
+static TCP_ConnectionState_t* TCP_CreateConnection(const uint16_t Port,
+                                                   const IP_Address_t* RemoteAddress,
+                                                   const uint16_t RemotePort)
 {
-	uint32_t Checksum = 0;
+	uint8_t CSTableEntry = FreeConnectionList;
+
+	if (CSTableEntry == TCP_NO_CONNECTION)
+	  return NULL;
+
+	TCP_ConnectionState_t* Connection = &ConnectionStateTable[CSTableEntry];
+	uint8_t                Bucket     = TCP_ConnectionHash(Port, RemoteAddress, RemotePort);
 
-	/* TCP/IP checksums are the addition of the one's compliment of each word including the IP pseudo-header,
-	   complimented */
+	FreeConnectionList = Connection->NextInBucket;
 
-	Checksum += ((uint16_t*)SourceAddress)[0];
-	Checksum += ((uint16_t*)SourceAddress)[1];
-	Checksum += ((uint16_t*)DestinationAddress)[0];
-	Checksum += ((uint16_t*)DestinationAddress)[1];
-	Checksum += SwapEndian_16(PROTOCOL_TCP);
-	Checksum += SwapEndian_16(TCPOutSize);
+	Connection->Port          = Port;
+	Connection->RemoteAddress = *RemoteAddress;
+	Connection->RemotePort    = RemotePort;
+	Connection->PortEntry     = TCP_NO_PORT;
 
-	for (uint16_t CurrWord = 0; CurrWord < (TCPOutSize >> 1); CurrWord++)
-	  Checksum += ((uint16_t*)TCPHeaderOutStart)[CurrWord];
+	/* Cache the port's state table entry, so that the connection's application handler can be found without a search */
+	for (uint8_t PTableEntry = 0; PTableEntry < MAX_OPEN_TCP_PORTS; PTableEntry++)
+	{
+		if (PortStateTable[PTableEntry].Port == Port)
+		  Connection->PortEntry = PTableEntry;
+	}
+
+	Connection->NextInBucket  = ConnectionHashTable[Bucket];
+	ConnectionHashTable[Bucket] = CSTableEntry;
 
-	if (TCPOutSize & 0x01)
-	  Checksum += (((uint16_t*)TCPHeaderOutStart)[TCPOutSize >> 1] & 0x00FF);
+	return Connection;
+}
 
-	while (Checksum & 0xFFFF0000)
-	  Checksum = ((Checksum & 0xFFFF) + (Checksum >> 16));
+/** Closes a connection to a host, stopping its timer and removing it from the connection lookup hash table before returning
+ *  its entry to the free connection list.
+ *
+ *  \param[in,out] Connection  Pointer to the state table entry of the connection to close
+ */
+static void TCP_ReleaseConnection(TCP_ConnectionState_t* const Connection)
+{
+	uint8_t  CSTableEntry = (Connection - ConnectionStateTable);
+	uint8_t* Link         = &ConnectionHashTable[TCP_ConnectionHash(Connection->Port, &Connection->RemoteAddress, Connection->RemotePort)];
+
+	TCP_StopTimer(Connection);
+
+	/* Unlink the connection from its hash bucket chain */
+	while (*Link != CSTableEntry)
+	  Link = &ConnectionStateTable[*Link].NextInBucket;
+
+	*Link = Connection->NextInBucket;
+
+	Connection->State        = TCP_Connection_Closed;
+	Connection->NextInBucket = FreeConnectionList;
+	FreeConnectionList       = CSTableEntry;
+}
+
+/** Determines if the port of a given connection is still open, via the connection's cached port state table entry.
+ *
+ *  \param[in] Connection  Pointer to the state table entry of the connection to check
+ *
+ *  \return Boolean \c true if the connection's port is open, \c false otherwise
+ */
+static bool TCP_IsConnectionPortOpen(const TCP_ConnectionState_t* const Connection)
+{
+	if (Connection->PortEntry == TCP_NO_PORT)
+	  return false;
+
+	return ((PortStateTable[Connection->PortEntry].Port  == Connection->Port) &&
+	        (PortStateTable[Connection->PortEntry].State == TCP_Port_Open));
+}
+
+/** Starts or restarts the timeout timer of a given connection, placing it into the timer wheel slot in which it will expire.
+ *  When the timer expires the connection is closed.
+ *
+ *  \param[in,out] Connection  Pointer to the state table entry of the connection whose timer is to be started
+ *  \param[in]     Ticks       Number of timer ticks of \ref TCP_TIMER_TICK_MS milliseconds until the timer expires
+ */
+static void TCP_StartTimer(TCP_ConnectionState_t* const Connection,
+                           uint16_t Ticks)
+{
+	uint8_t CSTableEntry = (Connection - ConnectionStateTable);
+
+	TCP_StopTimer(Connection);
+
+	if (!(Ticks))
+	  Ticks = 1;
+
+	/* Timeouts longer than a full turn of the wheel wait out the additional turns before expiring */
+	Connection->TimerSlot   = ((TimerWheelPosition + (Ticks - 1)) & (TCP_TIMER_WHEEL_SLOTS - 1));
+	Connection->TimerRounds = ((Ticks - 1) / TCP_TIMER_WHEEL_SLOTS);
+
+	Connection->NextTimer   = TimerWheel[Connection->TimerSlot];
+	TimerWheel[Connection->TimerSlot] = CSTableEntry;
+}
+
+/** Stops the timeout timer of a given connection if running, removing it from the timer wheel.
+ *
+ *  \param[in,out] Connection  Pointer to the state table entry of the connection whose timer is to be stopped
+ */
+static void TCP_StopTimer(TCP_ConnectionState_t* const Connection)
+{
+	uint8_t  CSTableEntry = (Connection - ConnectionStateTable);
+	uint8_t* Link;
+
+	if (Connection->TimerSlot == TCP_TIMER_NOT_ARMED)
+	  return;
+
+	/* Unlink the connection from its timer wheel slot chain */
+	Link = &TimerWheel[Connection->TimerSlot];
+
+	while (*Link != CSTableEntry)
+	  Link = &ConnectionStateTable[*Link].NextTimer;
+
+	*Link = Connection->NextTimer;
+
+	Connection->TimerSlot = TCP_TIMER_NOT_ARMED;
+}
+
+/** Advances the connection timer wheel by a single tick, closing each connection in the current slot whose timer has expired. */
+static void TCP_TimerTick(void)
+{
+	uint8_t* Link = &TimerWheel[TimerWheelPosition];
+
+	while (*Link != TCP_NO_CONNECTION)
+	{
+		TCP_ConnectionState_t* Connection = &ConnectionStateTable[*Link];
+
+		if (Connection->TimerRounds)
+		{
+			/* Timer expires on a later turn of the wheel, skip over it */
+			Connection->TimerRounds--;
+			Link = &Connection->NextTimer;
+		}
+		else
+		{
+			/* Timer has expired, unlink it from the slot and close the connection */
+			*Link = Connection->NextTimer;
+			Connection->TimerSlot = TCP_TIMER_NOT_ARMED;
+
+			TCP_ReleaseConnection(Connection);
+		}
+	}
 
-	return ~Checksum;
+	TimerWheelPosition = ((TimerWheelPosition + 1) & (TCP_TIMER_WHEEL_SLOTS - 1));
 }
 
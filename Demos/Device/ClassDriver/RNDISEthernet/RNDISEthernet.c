@@ -168,9 +168,17 @@ void EVENT_USB_Device_ConfigurationChanged(void)
 
 	ConfigSuccess &= RNDIS_Device_ConfigureEndpoints(&Ethernet_RNDIS_Interface);
 
+	USB_Device_EnableSOFEvents();
+
 	LEDs_SetAllLEDs(ConfigSuccess ? LEDMASK_USB_READY : LEDMASK_USB_ERROR);
 }
 
+/** Event handler for the USB device Start Of Frame event, providing the millisecond time base of the TCP connection timers. */
+void EVENT_USB_Device_StartOfFrame(void)
+{
+	TCP_MillisecondElapsed();
+}
+
 /** Event handler for the library USB Control Request reception event. */
 void EVENT_USB_Device_ControlRequest(void)
 {
@@ -41,10 +41,10 @@
 		#include <avr/pgmspace.h>
 
 		#include <LUFA/Drivers/USB/USB.h>
+		#include <LUFA/Drivers/Misc/DataflashStorage.h>
 
 		#include "../VirtualSerialMassStorage.h"
 		#include "../Descriptors.h"
-		#include "DataflashManager.h"
 		#include "Config/AppConfig.h"
 
 	/* Macros: */
@@ -72,6 +72,22 @@
 		/** Value for the DeviceType entry in the SCSI_Inquiry_Response_t enum, indicating a CD-ROM device. */
 		#define DEVICE_TYPE_CDROM   0x05
 
+		/** Total number of bytes of the storage medium, comprised of one or more Dataflash ICs. */
+		#define VIRTUAL_MEMORY_BYTES                DATAFLASH_STORAGE_BYTES
+
+		/** Block size of the device. This is kept at 512 to remain compatible with the OS despite the underlying
+		 *  storage media (Dataflash) using a different native block size. Do not change this value.
+		 */
+		#define VIRTUAL_MEMORY_BLOCK_SIZE           BLOCKDEVICE_BLOCK_SIZE
+
+		/** Total number of blocks of the virtual memory for reporting to the host as the device's total capacity. Do not
+		 *  change this value; change VIRTUAL_MEMORY_BYTES instead to alter the media size.
+		 */
+		#define VIRTUAL_MEMORY_BLOCKS               (VIRTUAL_MEMORY_BYTES / VIRTUAL_MEMORY_BLOCK_SIZE)
+
+		/** Blocks in each LUN, calculated from the total capacity divided by the total number of Logical Units in the device. */
+		#define LUN_MEDIA_BLOCKS         (VIRTUAL_MEMORY_BLOCKS / TOTAL_LUNS)
+
 	/* Function Prototypes: */
 		bool SCSI_DecodeSCSICommand(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo);
 
@@ -152,14 +152,14 @@ void SetupHardware(void)
 	USB_Init();
 
 	/* Check if the Dataflash is working, abort if not */
-	if (!(DataflashManager_CheckDataflashOperation()))
+	if (!(DataflashStorage_CheckOperation()))
 	{
 		LEDs_SetAllLEDs(LEDMASK_USB_ERROR);
 		for(;;);
 	}
 
 	/* Clear Dataflash sector protections, if enabled */
-	DataflashManager_ResetDataflashProtections();
+	DataflashStorage_ResetProtections();
 }
 
 /** Checks for changes in the position of the board joystick, sending strings to the host upon each change. */
@@ -114,9 +114,14 @@ bool SCSI_DecodeSCSICommand(void)
 		case SCSI_CMD_MODE_SENSE_6:
 			CommandSuccess = SCSI_Command_ModeSense_6();
 			break;
+		case SCSI_CMD_SYNCHRONIZE_CACHE_10:
 		case SCSI_CMD_START_STOP_UNIT:
 		case SCSI_CMD_TEST_UNIT_READY:
 		case SCSI_CMD_PREVENT_ALLOW_MEDIUM_REMOVAL:
+			/* Commit any cached written data to the Dataflash, as the host may be about to remove the media */
+			CommandSuccess = (BlockDevice_Flush(&DataflashStorage_BlockDevice) == BLOCKDEVICE_ERROR_NoError);
+			CommandBlock.DataTransferLength = 0;
+			break;
 		case SCSI_CMD_VERIFY_10:
 			/* These commands should just succeed, no handling required */
 			CommandSuccess = true;
@@ -251,7 +256,7 @@ static bool SCSI_Command_Send_Diagnostic(void)
 	}
 
 	/* Check to see if all attached Dataflash ICs are functional */
-	if (!(DataflashManager_CheckDataflashOperation()))
+	if (!(DataflashStorage_CheckOperation()))
 	{
 		/* Update SENSE key with a hardware error condition and return command fail */
 		SCSI_SET_SENSE(SCSI_SENSE_KEY_HARDWARE_ERROR,
@@ -268,7 +273,7 @@ static bool SCSI_Command_Send_Diagnostic(void)
 }
 
 /** Command processing for an issued SCSI READ (10) or WRITE (10) command. This command reads in the block start address
- *  and total number of blocks to process, then calls the appropriate low-level Dataflash routine to handle the actual
+ *  and total number of blocks to process, then calls the appropriate block device routine to handle the actual
  *  reading and writing of the data.
  *
  *  \param[in] IsDataRead  Indicates if the command is a READ (10) command or WRITE (10) command (DATA_READ or DATA_WRITE)
@@ -279,6 +284,7 @@ static bool SCSI_Command_ReadWrite_10(const bool IsDataRead)
 {
 	uint32_t BlockAddress;
 	uint16_t TotalBlocks;
+	uint8_t  ErrorCode;
 
 	/* Check if the disk is write protected or not */
 	if ((IsDataRead == DATA_WRITE) && DISK_READ_ONLY)
@@ -312,9 +318,27 @@ static bool SCSI_Command_ReadWrite_10(const bool IsDataRead)
 
 	/* Determine if the packet is a READ (10) or WRITE (10) command, call appropriate function */
 	if (IsDataRead == DATA_READ)
-	  DataflashManager_ReadBlocks(BlockAddress, TotalBlocks);
+	  ErrorCode = BlockDevice_ReadBlocks(&DataflashStorage_BlockDevice, BlockAddress, TotalBlocks, BLOCKDEVICE_ENDPOINT, &IsMassStoreReset, NULL);
 	else
-	  DataflashManager_WriteBlocks(BlockAddress, TotalBlocks);
+	  ErrorCode = BlockDevice_WriteBlocks(&DataflashStorage_BlockDevice, BlockAddress, TotalBlocks, BLOCKDEVICE_ENDPOINT, &IsMassStoreReset, NULL);
+
+	/* Check if the blocks could not be transferred, update SENSE key and return command fail if so */
+	if (ErrorCode == BLOCKDEVICE_ERROR_OutOfRange)
+	{
+		SCSI_SET_SENSE(SCSI_SENSE_KEY_ILLEGAL_REQUEST,
+		               SCSI_ASENSE_LOGICAL_BLOCK_ADDRESS_OUT_OF_RANGE,
+		               SCSI_ASENSEQ_NO_QUALIFIER);
+
+		return false;
+	}
+	else if (ErrorCode != BLOCKDEVICE_ERROR_NoError)
+	{
+		SCSI_SET_SENSE(SCSI_SENSE_KEY_HARDWARE_ERROR,
+		               SCSI_ASENSE_NO_ADDITIONAL_INFORMATION,
+		               SCSI_ASENSEQ_NO_QUALIFIER);
+
+		return false;
+	}
 
 	/* Update the bytes transferred counter and succeed the command */
 	CommandBlock.DataTransferLength -= ((uint32_t)TotalBlocks * VIRTUAL_MEMORY_BLOCK_SIZE);
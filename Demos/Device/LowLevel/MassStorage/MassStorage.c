@@ -92,14 +92,14 @@ void SetupHardware(void)
 	USB_Init();
 
 	/* Check if the Dataflash is working, abort if not */
-	if (!(DataflashManager_CheckDataflashOperation()))
+	if (!(DataflashStorage_CheckOperation()))
 	{
 		LEDs_SetAllLEDs(LEDMASK_USB_ERROR);
 		for(;;);
 	}
 
 	/* Clear Dataflash sector protections, if enabled */
-	DataflashManager_ResetDataflashProtections();
+	DataflashStorage_ResetProtections();
 }
 
 /** Event handler for the USB_Connect event. This indicates that the device is enumerating via the status LEDs. */
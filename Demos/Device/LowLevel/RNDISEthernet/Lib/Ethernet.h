@@ -43,6 +43,7 @@
 		#include "Config/AppConfig.h"
 
 		#include "EthernetProtocols.h"
+		#include "Checksum.h"
 		#include "ProtocolDecoders.h"
 		#include "ICMP.h"
 		#include "TCP.h"
@@ -104,8 +105,6 @@
 
 	/* Function Prototypes: */
 		void     Ethernet_ProcessPacket(void);
-		uint16_t Ethernet_Checksum16(void* Data,
-		                             uint16_t Bytes);
 
 #endif
 
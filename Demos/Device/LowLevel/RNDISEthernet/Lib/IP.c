@@ -102,7 +102,7 @@ int16_t IP_ProcessIPPacket(void* InDataStart,
 		IPHeaderOUT->SourceAddress      = IPHeaderIN->DestinationAddress;
 		IPHeaderOUT->DestinationAddress = IPHeaderIN->SourceAddress;
 
-		IPHeaderOUT->HeaderChecksum     = Ethernet_Checksum16(IPHeaderOUT, sizeof(IP_Header_t));
+		IPHeaderOUT->HeaderChecksum     = Checksum_Calculate(IPHeaderOUT, sizeof(IP_Header_t));
 
 		/* Return the size of the response so far */
 		return (sizeof(IP_Header_t) + RetSize);
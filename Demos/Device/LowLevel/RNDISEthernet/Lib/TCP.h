@@ -38,6 +38,7 @@
 
 	/* Includes: */
 		#include <avr/io.h>
+		#include <util/atomic.h>
 		#include <stdbool.h>
 
 		#include "EthernetProtocols.h"
@@ -49,7 +50,31 @@
 		#define MAX_OPEN_TCP_PORTS              1
 
 		/** Maximum number of TCP connections which can be sustained at the one time. */
-		#define MAX_TCP_CONNECTIONS             3
+		#define MAX_TCP_CONNECTIONS             6
+
+		/** Number of buckets in the TCP connection lookup hash table, must be a power of two. */
+		#define TCP_CONNECTION_HASH_BUCKETS     8
+
+		/** Number of slots in the TCP connection timer wheel, must be a power of two. */
+		#define TCP_TIMER_WHEEL_SLOTS           16
+
+		/** Period of each TCP connection timer wheel tick, in milliseconds. */
+		#define TCP_TIMER_TICK_MS               100
+
+		/** Number of timer ticks a connection may remain idle before it is closed. */
+		#define TCP_CONNECTION_TIMEOUT_TICKS    (30000 / TCP_TIMER_TICK_MS)
+
+		/** Number of timer ticks a finalized connection lingers in the \ref TCP_Connection_TimeWait state before it is closed. */
+		#define TCP_TIME_WAIT_TICKS             (2000 / TCP_TIMER_TICK_MS)
+
+		/** Connection state table index indicating the end of a hash bucket, free list or timer wheel slot chain. */
+		#define TCP_NO_CONNECTION               0xFF
+
+		/** Port state table index indicating a connection whose port is not in the port state table. */
+		#define TCP_NO_PORT                     0xFF
+
+		/** Timer wheel slot value indicating a connection whose timeout timer is not running. */
+		#define TCP_TIMER_NOT_ARMED             0xFF
 
 		/** TCP window size, giving the maximum number of bytes which can be buffered at the one time. */
 		#define TCP_WINDOW_SIZE                 512
@@ -166,7 +191,7 @@
 			TCP_Connection_CloseWait   = 6, /**< Closing, waiting for ACK */
 			TCP_Connection_Closing     = 7, /**< Unused */
 			TCP_Connection_LastACK     = 8, /**< Unused */
-			TCP_Connection_TimeWait    = 9, /**< Unused */
+			TCP_Connection_TimeWait    = 9, /**< Closed, waiting for any retransmitted FIN ACK */
 			TCP_Connection_Closed      = 10, /**< Connection closed in both directions */
 		};
 
@@ -199,6 +224,11 @@
 			IP_Address_t           RemoteAddress; /**< Connection protocol IP address of the host */
 			TCP_ConnectionInfo_t   Info; /**< Connection information, including application buffer */
 			uint8_t                State; /**< Current connection state, a value from the \ref TCP_ConnectionStates_t enum */
+			uint8_t                PortEntry; /**< Index of the connection's port in the port state table */
+			uint8_t                NextInBucket; /**< Index of the next connection in the same hash bucket or free list */
+			uint8_t                NextTimer; /**< Index of the next connection in the same timer wheel slot */
+			uint8_t                TimerSlot; /**< Timer wheel slot of the connection's timeout, or \c TCP_TIMER_NOT_ARMED */
+			uint8_t                TimerRounds; /**< Remaining full turns of the timer wheel before the timeout expires */
 		} TCP_ConnectionState_t;
 
 		/** Type define for a TCP port state. */
@@ -231,6 +261,7 @@
 	/* Function Prototypes: */
 		void                  TCP_Init(void);
 		void                  TCP_Task(void);
+		void                  TCP_MillisecondElapsed(void);
 		bool                  TCP_SetPortState(const uint16_t Port,
 		                                       const uint8_t State,
 		                                       void (*Handler)(TCP_ConnectionState_t*, TCP_ConnectionBuffer_t*));
@@ -250,10 +281,21 @@
 		                                           void* TCPHeaderOutStart);
 
 		#if defined(INCLUDE_FROM_TCP_C)
-			static uint16_t TCP_Checksum16(void* TCPHeaderOutStart,
-			                               const IP_Address_t* SourceAddress,
-			                               const IP_Address_t* DestinationAddress,
-			                               uint16_t TCPOutSize);
+			static uint8_t TCP_ConnectionHash(const uint16_t Port,
+			                                  const IP_Address_t* RemoteAddress,
+			                                  const uint16_t RemotePort);
+			static TCP_ConnectionState_t* TCP_FindConnection(const uint16_t Port,
+			                                                 const IP_Address_t* RemoteAddress,
+			                                                 const uint16_t RemotePort);
+			static TCP_ConnectionState_t* TCP_CreateConnection(const uint16_t Port,
+			                                                   const IP_Address_t* RemoteAddress,
+			                                                   const uint16_t RemotePort);
+			static void TCP_ReleaseConnection(TCP_ConnectionState_t* const Connection);
+			static bool TCP_IsConnectionPortOpen(const TCP_ConnectionState_t* const Connection);
+			static void TCP_StartTimer(TCP_ConnectionState_t* const Connection,
+			                           uint16_t Ticks);
+			static void TCP_StopTimer(TCP_ConnectionState_t* const Connection);
+			static void TCP_TimerTick(void);
 		#endif
 
 #endif
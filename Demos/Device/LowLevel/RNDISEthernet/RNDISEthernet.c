@@ -120,10 +120,19 @@ void EVENT_USB_Device_ConfigurationChanged(void)
 	ConfigSuccess &= Endpoint_ConfigureEndpoint(CDC_RX_EPADDR, EP_TYPE_BULK, CDC_TXRX_EPSIZE, 1);
 	ConfigSuccess &= Endpoint_ConfigureEndpoint(CDC_NOTIFICATION_EPADDR, EP_TYPE_INTERRUPT, CDC_NOTIFICATION_EPSIZE, 1);
 
+	/* Enable the Start Of Frame events, used as the millisecond time base of the TCP connection timers */
+	USB_Device_EnableSOFEvents();
+
 	/* Indicate endpoint configuration success or failure */
 	LEDs_SetAllLEDs(ConfigSuccess ? LEDMASK_USB_READY : LEDMASK_USB_ERROR);
 }
 
+/** Event handler for the USB device Start Of Frame event, providing the millisecond time base of the TCP connection timers. */
+void EVENT_USB_Device_StartOfFrame(void)
+{
+	TCP_MillisecondElapsed();
+}
+
 /** Event handler for the USB_ControlRequest event. This is used to catch and process control requests sent to
  *  the device from the USB host before passing along unhandled control requests to the library for processing
  *  internally.
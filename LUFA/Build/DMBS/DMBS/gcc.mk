@@ -59,6 +59,8 @@ else ifeq ($(ARCH), XMEGA)
    CROSS        := $(COMPILER_PATH)avr
 else ifeq ($(ARCH), UC3)
    CROSS        := $(COMPILER_PATH)avr32
+else ifeq ($(ARCH), SIM)
+   CROSS        := $(COMPILER_PATH)$(shell gcc -dumpmachine)
 else
    $(error Unsupported architecture "$(ARCH)")
 endif
@@ -114,6 +116,8 @@ ifneq ($(findstring $(ARCH), AVR8 XMEGA),)
    BASE_CC_FLAGS += -mmcu=$(MCU) -fshort-enums -fno-inline-small-functions
 else ifneq ($(findstring $(ARCH), UC3),)
    BASE_CC_FLAGS += -mpart=$(MCU:at32%=%) -masm-addr-pseudos
+else ifneq ($(findstring $(ARCH), SIM),)
+   BASE_CC_FLAGS += -fshort-wchar
 endif
 BASE_CC_FLAGS += -Wall -fno-strict-aliasing -funsigned-char -funsigned-bitfields -ffunction-sections
 BASE_CC_FLAGS += -I.
@@ -35,6 +35,8 @@ ifeq ($(ARCH), XMEGA)
    $(warning The XMEGA device support is currently EXPERIMENTAL (incomplete and/or non-functional), and is included for preview purposes only.)
 else ifeq ($(ARCH), UC3)
    $(warning The UC3 device support is currently EXPERIMENTAL (incomplete and/or non-functional), and is included for preview purposes only.)
+else ifeq ($(ARCH), SIM)
+   $(warning The SIM architecture builds a host-native simulated USB controller, and is intended for testing and profiling purposes only.)
 endif
 
 # Common LUFA C/C++ includes/definitions
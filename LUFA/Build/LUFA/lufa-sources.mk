@@ -17,7 +17,8 @@ DMBS_BUILD_PROVIDED_VARS   += LUFA_SRC_USB_DEVICE LUFA_SRC_USB_HOST    \
                               LUFA_SRC_USB LUFA_SRC_USBCLASS_DEVICE    \
                               LUFA_SRC_USBCLASS_HOST LUFA_SRC_USBCLASS \
                               LUFA_SRC_TEMPERATURE LUFA_SRC_SERIAL     \
-                              LUFA_SRC_TWI LUFA_SRC_PLATFORM
+                              LUFA_SRC_TWI LUFA_SRC_DATAFLASHSTORAGE   \
+                              LUFA_SRC_PLATFORM
 DMBS_BUILD_PROVIDED_MACROS +=
 
 SHELL = /bin/sh
@@ -52,6 +53,7 @@ LUFA_SRC_USB_DEVICE      := $(LUFA_ROOT_PATH)/Drivers/USB/Core/$(ARCH)/Device_$(
                             $(LUFA_ROOT_PATH)/Drivers/USB/Core/$(ARCH)/Endpoint_$(ARCH).c        \
                             $(LUFA_ROOT_PATH)/Drivers/USB/Core/$(ARCH)/EndpointStream_$(ARCH).c  \
                             $(LUFA_ROOT_PATH)/Drivers/USB/Core/DeviceStandardReq.c               \
+                            $(LUFA_ROOT_PATH)/Drivers/USB/Core/EndpointTransfer.c                \
                             $(LUFA_SRC_USB_COMMON)
 
 LUFA_SRC_USBCLASS_DEVICE := $(LUFA_ROOT_PATH)/Drivers/USB/Class/Device/AudioClassDevice.c        \
@@ -83,6 +85,8 @@ LUFA_SRC_SERIAL          := $(LUFA_ROOT_PATH)/Drivers/Peripheral/$(ARCH)/Serial_
 
 LUFA_SRC_TWI             := $(LUFA_ROOT_PATH)/Drivers/Peripheral/$(ARCH)/TWI_$(ARCH).c
 
+LUFA_SRC_DATAFLASHSTORAGE := $(LUFA_ROOT_PATH)/Drivers/Misc/DataflashStorage.c
+
 ifeq ($(ARCH), UC3)
    LUFA_SRC_PLATFORM     := $(LUFA_ROOT_PATH)/Platform/UC3/Exception.S   \
                             $(LUFA_ROOT_PATH)/Platform/UC3/InterruptManagement.c
@@ -96,6 +100,7 @@ LUFA_SRC_ALL_FILES   := $(LUFA_SRC_USB)            \
                         $(LUFA_SRC_TEMPERATURE)    \
                         $(LUFA_SRC_SERIAL)         \
                         $(LUFA_SRC_TWI)            \
+                        $(LUFA_SRC_DATAFLASHSTORAGE) \
                         $(LUFA_SRC_PLATFORM)
 
 endif
@@ -49,6 +49,7 @@
 
 		/* Non-USB Related Configuration Tokens: */
 //		#define DISABLE_TERMINAL_CODES
+//		#define DATAFLASH_STORAGE_WRITE_THROUGH
 
 		/* USB Class Driver Related Tokens: */
 //		#define HID_HOST_BOOT_PROTOCOL_ONLY
@@ -57,7 +58,9 @@
 //		#define HID_MAX_COLLECTIONS              {Insert Value Here}
 //		#define HID_MAX_REPORTITEMS              {Insert Value Here}
 //		#define HID_MAX_REPORT_IDS               {Insert Value Here}
+//		#define HID_PARSER_USE_ARENA
 //		#define NO_CLASS_DRIVER_AUTOFLUSH
+//		#define RNDIS_DEVICE_MAX_PACKETS_PER_TRANSFER {Insert Value Here}
 
 		/* General USB Driver Related Tokens: */
 //		#define ORDERED_EP_CONFIG
@@ -92,6 +95,7 @@
 
 		/* Non-USB Related Configuration Tokens: */
 //		#define DISABLE_TERMINAL_CODES
+//		#define DATAFLASH_STORAGE_WRITE_THROUGH
 
 		/* USB Class Driver Related Tokens: */
 //		#define HID_HOST_BOOT_PROTOCOL_ONLY
@@ -100,7 +104,9 @@
 //		#define HID_MAX_COLLECTIONS              {Insert Value Here}
 //		#define HID_MAX_REPORTITEMS              {Insert Value Here}
 //		#define HID_MAX_REPORT_IDS               {Insert Value Here}
+//		#define HID_PARSER_USE_ARENA
 //		#define NO_CLASS_DRIVER_AUTOFLUSH
+//		#define RNDIS_DEVICE_MAX_PACKETS_PER_TRANSFER {Insert Value Here}
 
 		/* General USB Driver Related Tokens: */
 //		#define USE_STATIC_OPTIONS               {Insert Value Here}
@@ -125,6 +131,7 @@
 
 		/* Non-USB Related Configuration Tokens: */
 //		#define DISABLE_TERMINAL_CODES
+//		#define DATAFLASH_STORAGE_WRITE_THROUGH
 
 		/* USB Class Driver Related Tokens: */
 //		#define HID_HOST_BOOT_PROTOCOL_ONLY
@@ -133,7 +140,9 @@
 //		#define HID_MAX_COLLECTIONS              {Insert Value Here}
 //		#define HID_MAX_REPORTITEMS              {Insert Value Here}
 //		#define HID_MAX_REPORT_IDS               {Insert Value Here}
+//		#define HID_PARSER_USE_ARENA
 //		#define NO_CLASS_DRIVER_AUTOFLUSH
+//		#define RNDIS_DEVICE_MAX_PACKETS_PER_TRANSFER {Insert Value Here}
 
 		/* General USB Driver Related Tokens: */
 //		#define ORDERED_EP_CONFIG
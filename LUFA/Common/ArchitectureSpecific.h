@@ -172,6 +172,19 @@
 				                                                     "Assertion \"%s\" failed.\r\n",            \
 				                                                     __FILE__, __func__, __LINE__, #Condition); \
 				                                        } while (0)
+			#elif (ARCH == ARCH_SIM)
+				#define JTAG_DEBUG_POINT()              __asm__ __volatile__ ("nop" ::)
+				#define JTAG_DEBUG_BREAK()              __builtin_trap()
+				#define JTAG_ASSERT(Condition)          do {                                                    \
+				                                            if (!(Condition))                                   \
+				                                              JTAG_DEBUG_BREAK();                               \
+				                                        } while (0)
+				#define STDOUT_ASSERT(Condition)        do {                                                    \
+				                                            if (!(Condition))                                   \
+				                                              printf("%s: Function \"%s\", Line %d: "           \
+				                                                     "Assertion \"%s\" failed.\r\n",            \
+				                                                     __FILE__, __func__, __LINE__, #Condition); \
+				                                        } while (0)
 			#endif
 
 	/* Disable C linkage for C++ Compilers: */
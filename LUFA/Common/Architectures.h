@@ -70,6 +70,12 @@
 			/** Selects the Atmel XMEGA AVR (ATXMEGA* chips) architecture. */
 			#define ARCH_XMEGA          2
 
+			/** Selects the host-native simulated USB controller architecture, which allows the library and its
+			 *  class drivers to be compiled and run on a development PC against a scripted USB host model for
+			 *  testing and benchmarking purposes.
+			 */
+			#define ARCH_SIM            3
+
 			#if !defined(__DOXYGEN__)
 				#define ARCH_           ARCH_AVR8
 
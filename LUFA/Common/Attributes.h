@@ -108,6 +108,14 @@
 				/** Marks a given function as deprecated, which produces a warning if the function is called. */
 				#define ATTR_DEPRECATED              __attribute__ ((deprecated))
 
+				/** Marks a function as an error if it is called, which aborts the compilation with the given message
+				 *  if any call to the function remains after optimization. This can be used to reject invalid compile
+				 *  time constant parameters to in-lined functions.
+				 *
+				 *  \param[in] Message  Error message to display if the function is called.
+				 */
+				#define ATTR_ERROR(Message)          __attribute__ ((error(Message)))
+
 				/** Marks a function as a weak reference, which can be overridden by other functions with an
 				 *  identical name (in which case the weak reference is discarded at link time).
 				 */
@@ -140,6 +140,40 @@
 			#define ARCH_LITTLE_ENDIAN
 
 			#include "Endianness.h"
+		#elif (ARCH == ARCH_SIM)
+			#include <stdio.h>
+			#include <math.h>
+
+			#define PROGMEM
+			#define PSTR(s)                  (s)
+			#define pgm_read_byte(x)         (*(const uint8_t*)(x))
+			#define pgm_read_word(x)         (*(const uint16_t*)(x))
+			#define pgm_read_dword(x)        (*(const uint32_t*)(x))
+			#define pgm_read_ptr(x)          (*(void* const*)(x))
+			#define memcmp_P(...)            memcmp(__VA_ARGS__)
+			#define memcpy_P(...)            memcpy(__VA_ARGS__)
+			#define strlen_P(...)            strlen(__VA_ARGS__)
+			#define strcpy_P(...)            strcpy(__VA_ARGS__)
+			#define strcat_P(...)            strcat(__VA_ARGS__)
+			#define strcmp_P(...)            strcmp(__VA_ARGS__)
+			#define strncmp_P(...)           strncmp(__VA_ARGS__)
+			#define printf_P(...)            printf(__VA_ARGS__)
+			#define sprintf_P(...)           sprintf(__VA_ARGS__)
+
+			#define ISR(Name, ...)           void Name (void); void Name (void)
+
+			typedef uint32_t uint_reg_t;
+
+			#if (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__))
+				#define ARCH_BIG_ENDIAN
+			#else
+				#define ARCH_LITTLE_ENDIAN
+			#endif
+
+			#include "Endianness.h"
+
+			/* Simulated global interrupt enable flag, owned by the simulated USB controller driver. */
+			extern volatile uint_reg_t SIM_GlobalInterruptState;
 		#else
 			#error Unknown device architecture specified.
 		#endif
@@ -291,6 +325,9 @@
 					while (Milliseconds--)
 					  _delay_ms(1);
 				}
+				#elif (ARCH == ARCH_SIM)
+				/* Simulated time only advances with the USB bus frame counter, delays complete immediately */
+				(void)Milliseconds;
 				#endif
 			}
 
@@ -313,6 +350,8 @@
 				return __builtin_mfsr(AVR32_SR);
 				#elif (ARCH == ARCH_XMEGA)
 				return SREG;
+				#elif (ARCH == ARCH_SIM)
+				return SIM_GlobalInterruptState;
 				#endif
 			}
 
@@ -338,6 +377,8 @@
 				  __builtin_csrf(AVR32_SR_GM_OFFSET);
 				#elif (ARCH == ARCH_XMEGA)
 				SREG = GlobalIntState;
+				#elif (ARCH == ARCH_SIM)
+				SIM_GlobalInterruptState = GlobalIntState;
 				#endif
 
 				GCC_MEMORY_BARRIER();
@@ -358,6 +399,8 @@
 				__builtin_csrf(AVR32_SR_GM_OFFSET);
 				#elif (ARCH == ARCH_XMEGA)
 				sei();
+				#elif (ARCH == ARCH_SIM)
+				SIM_GlobalInterruptState = true;
 				#endif
 
 				GCC_MEMORY_BARRIER();
@@ -378,6 +421,8 @@
 				__builtin_ssrf(AVR32_SR_GM_OFFSET);
 				#elif (ARCH == ARCH_XMEGA)
 				cli();
+				#elif (ARCH == ARCH_SIM)
+				SIM_GlobalInterruptState = false;
 				#endif
 
 				GCC_MEMORY_BARRIER();
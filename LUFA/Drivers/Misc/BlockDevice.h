@@ -0,0 +1,292 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *  \brief Generic block storage device interface.
+ *
+ *  Generic interface to a block storage device, such as the board Dataflash, for use by the Mass Storage
+ *  SCSI command handlers and file system libraries of an application.
+ */
+
+/** \ingroup Group_MiscDrivers
+ *  \defgroup Group_BlockDevice Generic Block Device Interface - LUFA/Drivers/Misc/BlockDevice.h
+ *  \brief Generic block storage device interface.
+ *
+ *  \section Sec_BlockDevice_Dependencies Module Source Dependencies
+ *  The following files must be built with any user project that uses this module:
+ *    - None
+ *
+ *  \section Sec_BlockDevice_ModDescription Module Description
+ *  Generic interface to a block storage device. Each storage back-end provides a \ref BlockDevice_t instance,
+ *  containing the size of the medium and the callbacks used to read, write, flush and trim its blocks, so that
+ *  a Mass Storage SCSI command handler or a file system can be written once and attached to any back-end. Blocks
+ *  are always \ref BLOCKDEVICE_BLOCK_SIZE bytes, regardless of the native page or sector size of the medium.
+ *
+ *  Blocks can be transferred between the device and either a RAM buffer, or the currently selected USB device
+ *  endpoint (an IN endpoint for reads, an OUT endpoint for writes) by passing \ref BLOCKDEVICE_ENDPOINT as the
+ *  buffer pointer, so that data can be streamed between the medium and the host without an intermediate copy.
+ *
+ *  A back-end may cache written data; cached data is guaranteed to be committed to the medium only once
+ *  \ref BlockDevice_Flush() has returned.
+ *
+ *  \section Sec_BlockDevice_ExampleUsage Example Usage
+ *  The following snippet is an example of how this module may be used within a typical
+ *  application.
+ *
+ *  \code
+ *      // Read the first block of the board Dataflash into a RAM buffer
+ *      uint8_t Buffer[BLOCKDEVICE_BLOCK_SIZE];
+ *      BlockDevice_ReadBlocks(&DataflashStorage_BlockDevice, 0, 1, Buffer, NULL, NULL);
+ *
+ *      // Write the next two blocks from the currently selected OUT endpoint, and commit them to the medium
+ *      Endpoint_SelectEndpoint(DATA_OUT_EPADDR);
+ *      BlockDevice_WriteBlocks(&DataflashStorage_BlockDevice, 1, 2, BLOCKDEVICE_ENDPOINT, NULL, NULL);
+ *      BlockDevice_Flush(&DataflashStorage_BlockDevice);
+ *  \endcode
+ *
+ *  @{
+ */
+
+#ifndef __BLOCK_DEVICE_H__
+#define __BLOCK_DEVICE_H__
+
+	/* Includes: */
+		#include "../../Common/Common.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			/** Size of each block of a block device, in bytes. */
+			#define BLOCKDEVICE_BLOCK_SIZE      512
+
+			/** Buffer pointer value indicating that data should be transferred to or from the currently selected
+			 *  USB device endpoint, rather than a RAM buffer.
+			 */
+			#define BLOCKDEVICE_ENDPOINT        NULL
+
+		/* Enums: */
+			/** Enum for the possible error return codes of the block device functions. */
+			enum BlockDevice_ErrorCodes_t
+			{
+				BLOCKDEVICE_ERROR_NoError        = 0, /**< Operation completed successfully. */
+				BLOCKDEVICE_ERROR_OutOfRange     = 1, /**< One or more of the requested blocks lie outside the medium. */
+				BLOCKDEVICE_ERROR_TransferFailed = 2, /**< The endpoint transfer failed or was aborted before all blocks
+				                                       *   were transferred.
+				                                       */
+				BLOCKDEVICE_ERROR_MediaFailure   = 3, /**< The storage medium failed to complete the operation. */
+				BLOCKDEVICE_ERROR_NotSupported   = 4, /**< The operation is not supported by the device. */
+				BLOCKDEVICE_ERROR_IncompleteTransfer = 5, /**< The resumable endpoint transfer returned because the endpoint would
+				                                           *   block, and should be continued once the endpoint is ready.
+				                                           */
+			};
+
+		/* Type Defines: */
+			/** \brief Block Device Interface Structure.
+			 *
+			 *  Type define for a block device back-end. Each back-end provides a single constant instance of this
+			 *  structure, which is passed to the block device functions. Each callback returns a value from the
+			 *  \ref BlockDevice_ErrorCodes_t enum, and is only called with a block range already checked to lie
+			 *  within the medium.
+			 */
+			typedef struct
+			{
+				uint32_t TotalBlocks; /**< Total number of blocks of the medium. */
+
+				/** Reads blocks from the medium into a RAM buffer, or the selected IN endpoint if the buffer
+				 *  pointer is \ref BLOCKDEVICE_ENDPOINT. The transfer should be stopped if the optional abort
+				 *  flag becomes set, and should be resumable via the optional \c BytesProcessed pointer.
+				 */
+				uint8_t (*ReadBlocks)(const uint32_t BlockAddress,
+				                      const uint16_t TotalBlocks,
+				                      uint8_t* const Buffer,
+				                      volatile bool* const AbortFlag,
+				                      uint32_t* const BytesProcessed);
+
+				/** Writes blocks to the medium from a RAM buffer, or the selected OUT endpoint if the buffer
+				 *  pointer is \ref BLOCKDEVICE_ENDPOINT. The transfer should be stopped if the optional abort
+				 *  flag becomes set, and should be resumable via the optional \c BytesProcessed pointer.
+				 */
+				uint8_t (*WriteBlocks)(const uint32_t BlockAddress,
+				                       const uint16_t TotalBlocks,
+				                       const uint8_t* const Buffer,
+				                       volatile bool* const AbortFlag,
+				                       uint32_t* const BytesProcessed);
+
+				/** Commits all cached written data to the medium. May be \c NULL if the device does not cache data. */
+				uint8_t (*Flush)(void);
+
+				/** Discards the contents of the given blocks, which may then read back as any value. May be \c NULL if
+				 *  the device does not support trimming.
+				 */
+				uint8_t (*Trim)(const uint32_t BlockAddress,
+				                const uint32_t TotalBlocks);
+			} BlockDevice_t;
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Inline Functions: */
+			static inline bool BlockDevice_IsRangeValid(const BlockDevice_t* const Device,
+			                                            const uint32_t BlockAddress,
+			                                            const uint32_t TotalBlocks) ATTR_ALWAYS_INLINE ATTR_NON_NULL_PTR_ARG(1);
+			static inline bool BlockDevice_IsRangeValid(const BlockDevice_t* const Device,
+			                                            const uint32_t BlockAddress,
+			                                            const uint32_t TotalBlocks)
+			{
+				return ((BlockAddress < Device->TotalBlocks) && (TotalBlocks <= (Device->TotalBlocks - BlockAddress)));
+			}
+	#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Inline Functions: */
+			/** Reads blocks from the given block device.
+			 *
+			 *  \param[in]     Device          Pointer to the block device to read from.
+			 *  \param[in]     BlockAddress    Address of the first block to read.
+			 *  \param[in]     TotalBlocks     Number of blocks to read.
+			 *  \param[out]    Buffer          Pointer to the destination RAM buffer, or \ref BLOCKDEVICE_ENDPOINT to write the
+			 *                                 data into the currently selected IN endpoint.
+			 *  \param[in]     AbortFlag       Optional pointer to a flag which is set when an endpoint transfer should be aborted,
+			 *                                 such as a Mass Storage interface reset flag, or \c NULL if not used.
+			 *  \param[in,out] BytesProcessed  Optional pointer to the number of bytes of an endpoint transfer already processed,
+			 *                                 or \c NULL to complete the transfer before returning. If given, the transfer is
+			 *                                 resumed from this offset and returns \ref BLOCKDEVICE_ERROR_IncompleteTransfer
+			 *                                 once the endpoint would block.
+			 *
+			 *  \return A value from the \ref BlockDevice_ErrorCodes_t enum.
+			 */
+			static inline uint8_t BlockDevice_ReadBlocks(const BlockDevice_t* const Device,
+			                                             const uint32_t BlockAddress,
+			                                             const uint16_t TotalBlocks,
+			                                             uint8_t* const Buffer,
+			                                             volatile bool* const AbortFlag,
+			                                             uint32_t* const BytesProcessed) ATTR_NON_NULL_PTR_ARG(1);
+			static inline uint8_t BlockDevice_ReadBlocks(const BlockDevice_t* const Device,
+			                                             const uint32_t BlockAddress,
+			                                             const uint16_t TotalBlocks,
+			                                             uint8_t* const Buffer,
+			                                             volatile bool* const AbortFlag,
+			                                             uint32_t* const BytesProcessed)
+			{
+				if (!(BlockDevice_IsRangeValid(Device, BlockAddress, TotalBlocks)))
+				  return BLOCKDEVICE_ERROR_OutOfRange;
+
+				return Device->ReadBlocks(BlockAddress, TotalBlocks, Buffer, AbortFlag, BytesProcessed);
+			}
+
+			/** Writes blocks to the given block device. The written data may be cached by the device until the next call
+			 *  to \ref BlockDevice_Flush().
+			 *
+			 *  \param[in]     Device          Pointer to the block device to write to.
+			 *  \param[in]     BlockAddress    Address of the first block to write.
+			 *  \param[in]     TotalBlocks     Number of blocks to write.
+			 *  \param[in]     Buffer          Pointer to the source RAM buffer, or \ref BLOCKDEVICE_ENDPOINT to read the data from
+			 *                                 the currently selected OUT endpoint.
+			 *  \param[in]     AbortFlag       Optional pointer to a flag which is set when an endpoint transfer should be aborted,
+			 *                                 such as a Mass Storage interface reset flag, or \c NULL if not used.
+			 *  \param[in,out] BytesProcessed  Optional pointer to the number of bytes of an endpoint transfer already processed,
+			 *                                 or \c NULL to complete the transfer before returning. If given, the transfer is
+			 *                                 resumed from this offset and returns \ref BLOCKDEVICE_ERROR_IncompleteTransfer
+			 *                                 once the endpoint would block.
+			 *
+			 *  \return A value from the \ref BlockDevice_ErrorCodes_t enum.
+			 */
+			static inline uint8_t BlockDevice_WriteBlocks(const BlockDevice_t* const Device,
+			                                              const uint32_t BlockAddress,
+			                                              const uint16_t TotalBlocks,
+			                                              const uint8_t* const Buffer,
+			                                              volatile bool* const AbortFlag,
+			                                              uint32_t* const BytesProcessed) ATTR_NON_NULL_PTR_ARG(1);
+			static inline uint8_t BlockDevice_WriteBlocks(const BlockDevice_t* const Device,
+			                                              const uint32_t BlockAddress,
+			                                              const uint16_t TotalBlocks,
+			                                              const uint8_t* const Buffer,
+			                                              volatile bool* const AbortFlag,
+			                                              uint32_t* const BytesProcessed)
+			{
+				if (!(BlockDevice_IsRangeValid(Device, BlockAddress, TotalBlocks)))
+				  return BLOCKDEVICE_ERROR_OutOfRange;
+
+				return Device->WriteBlocks(BlockAddress, TotalBlocks, Buffer, AbortFlag, BytesProcessed);
+			}
+
+			/** Commits all data cached by the given block device to its medium, such as in response to a SCSI
+			 *  SYNCHRONIZE CACHE command.
+			 *
+			 *  \param[in] Device  Pointer to the block device to flush.
+			 *
+			 *  \return A value from the \ref BlockDevice_ErrorCodes_t enum.
+			 */
+			static inline uint8_t BlockDevice_Flush(const BlockDevice_t* const Device) ATTR_NON_NULL_PTR_ARG(1);
+			static inline uint8_t BlockDevice_Flush(const BlockDevice_t* const Device)
+			{
+				if (Device->Flush == NULL)
+				  return BLOCKDEVICE_ERROR_NoError;
+
+				return Device->Flush();
+			}
+
+			/** Discards the contents of the given blocks of the given block device, so that the device need not preserve
+			 *  them. Trimmed blocks may read back as any value until they are next written.
+			 *
+			 *  \param[in] Device        Pointer to the block device to trim.
+			 *  \param[in] BlockAddress  Address of the first block to trim.
+			 *  \param[in] TotalBlocks   Number of blocks to trim.
+			 *
+			 *  \return A value from the \ref BlockDevice_ErrorCodes_t enum.
+			 */
+			static inline uint8_t BlockDevice_Trim(const BlockDevice_t* const Device,
+			                                       const uint32_t BlockAddress,
+			                                       const uint32_t TotalBlocks) ATTR_NON_NULL_PTR_ARG(1);
+			static inline uint8_t BlockDevice_Trim(const BlockDevice_t* const Device,
+			                                       const uint32_t BlockAddress,
+			                                       const uint32_t TotalBlocks)
+			{
+				if (!(BlockDevice_IsRangeValid(Device, BlockAddress, TotalBlocks)))
+				  return BLOCKDEVICE_ERROR_OutOfRange;
+
+				if (Device->Trim == NULL)
+				  return BLOCKDEVICE_ERROR_NotSupported;
+
+				return Device->Trim(BlockAddress, TotalBlocks);
+			}
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
+
@@ -0,0 +1,616 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#define  __INCLUDE_FROM_DATAFLASHSTORAGE_C
+#include "DataflashStorage.h"
+
+#if (DATAFLASH_TOTALCHIPS > 0)
+
+/** Dataflash page whose written data is currently held in its Dataflash IC's SRAM buffer, waiting to be programmed
+ *  into main memory, or \c DATAFLASH_STORAGE_NO_PAGE if no written data is cached.
+ */
+static uint16_t CachedPage = DATAFLASH_STORAGE_NO_PAGE;
+
+/** Mask of the Dataflash IC buffers which may still be in use by a background program or erase operation, with
+ *  one bit per buffer of each Dataflash IC as given by \c DATAFLASH_STORAGE_BUFFER_MASK().
+ */
+static uint8_t BusyBuffers;
+
+const BlockDevice_t DataflashStorage_BlockDevice =
+	{
+		.TotalBlocks = (DATAFLASH_STORAGE_BYTES / BLOCKDEVICE_BLOCK_SIZE),
+		.ReadBlocks  = DataflashStorage_BlockDevice_ReadBlocks,
+		.WriteBlocks = DataflashStorage_BlockDevice_WriteBlocks,
+		.Flush       = DataflashStorage_BlockDevice_Flush,
+		.Trim        = DataflashStorage_BlockDevice_Trim,
+	};
+
+/** Waits until the Dataflash IC containing the given page has finished any background operation which uses one of
+ *  the given buffers of the IC. No Dataflash IC may be selected when this is called.
+ *
+ *  \param[in] Page        Dataflash page whose Dataflash IC is to be checked, within the total Dataflash storage.
+ *  \param[in] BufferMask  Mask of the IC's buffers to wait for, as given by \c DATAFLASH_STORAGE_BUFFER_MASK().
+ */
+static void DataflashStorage_WaitWhileBufferBusy(const uint16_t Page,
+                                                 const uint8_t BufferMask)
+{
+	if (!(BusyBuffers & BufferMask))
+	  return;
+
+	Dataflash_SelectChipFromPage(Page);
+	Dataflash_WaitWhileBusy();
+	Dataflash_DeselectChip();
+
+	/* The IC is now idle, so none of its buffers are in use */
+	BusyBuffers &= ~DATAFLASH_STORAGE_BUFFER_MASK(Page, DATAFLASH_STORAGE_ALL_BUFFERS);
+}
+
+/** Starts programming the cached page from its Dataflash buffer into main memory, if a page is cached. Programming
+ *  continues in the background, while other Dataflash buffers and ICs are accessed.
+ */
+static void DataflashStorage_CommitPage(void)
+{
+	uint16_t Page = CachedPage;
+
+	if (Page == DATAFLASH_STORAGE_NO_PAGE)
+	  return;
+
+	/* Only one program operation can be performed by each Dataflash IC at a time */
+	DataflashStorage_WaitWhileBufferBusy(Page, DATAFLASH_STORAGE_BUFFER_MASK(Page, DATAFLASH_STORAGE_ALL_BUFFERS));
+
+	Dataflash_SelectChipFromPage(Page);
+	Dataflash_SendByte(DATAFLASH_STORAGE_BUFFER(Page) ? DF_CMD_BUFF2TOMAINMEMWITHERASE : DF_CMD_BUFF1TOMAINMEMWITHERASE);
+	Dataflash_SendAddressBytes(Page, 0);
+	Dataflash_DeselectChip();
+
+	BusyBuffers |= DATAFLASH_STORAGE_BUFFER_MASK(Page, (1 << DATAFLASH_STORAGE_BUFFER(Page)));
+	CachedPage   = DATAFLASH_STORAGE_NO_PAGE;
+}
+
+/** Selects the Dataflash IC containing the given page, and starts a main memory page read from the given byte
+ *  within the page. The transfer of the first data byte is started before returning.
+ *
+ *  \param[in] Page      Dataflash page to read, within the total Dataflash storage.
+ *  \param[in] PageByte  Starting byte within the page.
+ */
+static void DataflashStorage_BeginPageRead(const uint16_t Page,
+                                           const uint16_t PageByte)
+{
+	/* Newer data for the page may still be held in the Dataflash buffer, commit it so that it can be read */
+	if (Page == CachedPage)
+	  DataflashStorage_CommitPage();
+
+	DataflashStorage_WaitWhileBufferBusy(Page, DATAFLASH_STORAGE_BUFFER_MASK(Page, DATAFLASH_STORAGE_ALL_BUFFERS));
+
+	Dataflash_SelectChipFromPage(Page);
+
+	/* Main memory page reads bypass the Dataflash's internal buffers, and so can be clocked out immediately */
+	Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
+	Dataflash_SendAddressBytes(Page, PageByte);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+
+	DataflashStorage_StartReceive();
+}
+
+/** Completes the transfer of the read-ahead data byte started by the last read, and deselects the Dataflash. */
+static void DataflashStorage_EndPageRead(void)
+{
+	#if defined(DATAFLASH_STORAGE_PIPELINED_SPI)
+	DataflashStorage_FinishReceive();
+	#endif
+
+	Dataflash_DeselectChip();
+}
+
+/** Selects the Dataflash IC containing the given page, and starts a write into the page's Dataflash buffer from the
+ *  given byte within the page. If the page is not already cached and the write will not replace the entire page, the
+ *  existing page contents are first loaded into the buffer so that the remainder of the page is preserved.
+ *
+ *  \param[in] Page      Dataflash page to write, within the total Dataflash storage.
+ *  \param[in] PageByte  Starting byte within the page.
+ *  \param[in] Length    Total number of bytes remaining to be written, including those of later pages.
+ */
+static void DataflashStorage_BeginPageWrite(const uint16_t Page,
+                                            const uint16_t PageByte,
+                                            const uint32_t Length)
+{
+	uint8_t Buffer = DATAFLASH_STORAGE_BUFFER(Page);
+
+	if (Page != CachedPage)
+	{
+		/* Only a single page is cached, start programming the previously cached page */
+		DataflashStorage_CommitPage();
+
+		if (PageByte || (Length < DATAFLASH_PAGE_SIZE))
+		{
+			/* Copy the page's current contents to the Dataflash buffer, once the IC is idle */
+			DataflashStorage_WaitWhileBufferBusy(Page, DATAFLASH_STORAGE_BUFFER_MASK(Page, DATAFLASH_STORAGE_ALL_BUFFERS));
+
+			Dataflash_SelectChipFromPage(Page);
+			Dataflash_SendByte(Buffer ? DF_CMD_MAINMEMTOBUFF2 : DF_CMD_MAINMEMTOBUFF1);
+			Dataflash_SendAddressBytes(Page, 0);
+			Dataflash_WaitWhileBusy();
+			Dataflash_DeselectChip();
+		}
+		else
+		{
+			/* Wait only if the buffer is still being programmed into another page, the other buffer may be busy */
+			DataflashStorage_WaitWhileBufferBusy(Page, DATAFLASH_STORAGE_BUFFER_MASK(Page, (1 << Buffer)));
+		}
+
+		CachedPage = Page;
+	}
+
+	Dataflash_SelectChipFromPage(Page);
+	Dataflash_SendByte(Buffer ? DF_CMD_BUFF2WRITE : DF_CMD_BUFF1WRITE);
+	Dataflash_SendAddressBytes(0, PageByte);
+}
+
+/** Completes the transfer of the last data byte written and deselects the Dataflash, then starts programming the
+ *  cached page if the write has reached the end of the page.
+ *
+ *  \param[in] PageByte  Byte within the page following the last byte written.
+ */
+static void DataflashStorage_EndPageWrite(const uint16_t PageByte)
+{
+	DataflashStorage_FinishSend();
+	Dataflash_DeselectChip();
+
+	if (PageByte == DATAFLASH_PAGE_SIZE)
+	  DataflashStorage_CommitPage();
+}
+
+void DataflashStorage_ReadToBuffer(const uint32_t Address,
+                                   uint32_t Length,
+                                   uint8_t* Buffer)
+{
+	uint16_t CurrPage     = (Address / DATAFLASH_PAGE_SIZE);
+	uint16_t CurrPageByte = (Address % DATAFLASH_PAGE_SIZE);
+
+	DataflashStorage_BeginPageRead(CurrPage, CurrPageByte);
+
+	while (Length--)
+	{
+		/* Check if end of Dataflash page reached, start reading the next page if so */
+		if (CurrPageByte == DATAFLASH_PAGE_SIZE)
+		{
+			CurrPageByte = 0;
+
+			DataflashStorage_EndPageRead();
+			DataflashStorage_BeginPageRead(++CurrPage, 0);
+		}
+
+		/* Collect the received byte and start the next transfer before storing it */
+		uint8_t Byte = DataflashStorage_FinishReceive();
+		DataflashStorage_StartReceive();
+
+		*(Buffer++) = Byte;
+		CurrPageByte++;
+	}
+
+	DataflashStorage_EndPageRead();
+}
+
+void DataflashStorage_WriteFromBuffer(const uint32_t Address,
+                                      uint32_t Length,
+                                      const uint8_t* Buffer)
+{
+	uint16_t CurrPage     = (Address / DATAFLASH_PAGE_SIZE);
+	uint16_t CurrPageByte = (Address % DATAFLASH_PAGE_SIZE);
+
+	DataflashStorage_BeginPageWrite(CurrPage, CurrPageByte, Length);
+
+	while (Length)
+	{
+		/* Check if end of Dataflash page reached, start writing the next page if so */
+		if (CurrPageByte == DATAFLASH_PAGE_SIZE)
+		{
+			CurrPageByte = 0;
+
+			DataflashStorage_EndPageWrite(DATAFLASH_PAGE_SIZE);
+			DataflashStorage_BeginPageWrite(++CurrPage, 0, Length);
+		}
+
+		DataflashStorage_StartSend(*(Buffer++));
+
+		CurrPageByte++;
+		Length--;
+	}
+
+	DataflashStorage_EndPageWrite(CurrPageByte);
+
+	#if defined(DATAFLASH_STORAGE_WRITE_THROUGH)
+	DataflashStorage_Flush();
+	#endif
+}
+
+#if defined(USB_CAN_BE_DEVICE)
+uint8_t DataflashStorage_ReadToEndpoint(uint32_t Address,
+                                        uint32_t Length,
+                                        volatile bool* const AbortFlag,
+                                        uint32_t* const BytesProcessed)
+{
+	uint32_t BytesInTransfer = 0;
+	uint8_t  ErrorCode;
+
+	if (BytesProcessed != NULL)
+	{
+		Address += *BytesProcessed;
+		Length  -= *BytesProcessed;
+	}
+
+	uint16_t CurrPage     = (Address / DATAFLASH_PAGE_SIZE);
+	uint16_t CurrPageByte = (Address % DATAFLASH_PAGE_SIZE);
+
+	/* Don't wait on the endpoint if there is no data left to transfer */
+	if (!(Length))
+	  return ENDPOINT_RWSTREAM_NoError;
+
+	/* Wait until endpoint is ready before continuing */
+	if ((ErrorCode = Endpoint_WaitUntilReady()))
+	  return ErrorCode;
+
+	DataflashStorage_BeginPageRead(CurrPage, CurrPageByte);
+
+	while (Length)
+	{
+		/* Check if the endpoint is currently full */
+		if (!(Endpoint_IsReadWriteAllowed()))
+		{
+			/* Clear the endpoint bank to send its contents to the host */
+			Endpoint_ClearIN();
+
+			/* If the transfer can be resumed later, return rather than waiting for the host to free a bank */
+			if ((BytesProcessed != NULL) && !(Endpoint_IsINReady()))
+			{
+				ErrorCode = ENDPOINT_RWSTREAM_IncompleteTransfer;
+				break;
+			}
+
+			/* Wait until the endpoint is ready for more data, while the next Dataflash byte is read */
+			if ((ErrorCode = Endpoint_WaitUntilReady()))
+			  break;
+		}
+
+		/* Check if end of Dataflash page reached, start reading the next page if so */
+		if (CurrPageByte == DATAFLASH_PAGE_SIZE)
+		{
+			CurrPageByte = 0;
+
+			DataflashStorage_EndPageRead();
+			DataflashStorage_BeginPageRead(++CurrPage, 0);
+		}
+
+		/* Read one 16-byte chunk of data from the Dataflash, overlapping each SPI transfer with the endpoint write */
+		for (uint8_t ByteNum = 0; ByteNum < 16; ByteNum++)
+		{
+			uint8_t Byte = DataflashStorage_FinishReceive();
+			DataflashStorage_StartReceive();
+
+			Endpoint_Write_8(Byte);
+		}
+
+		CurrPageByte    += 16;
+		Length          -= 16;
+		BytesInTransfer += 16;
+
+		/* Check if the current transfer is being aborted */
+		if ((AbortFlag != NULL) && *AbortFlag)
+		{
+			ErrorCode = ENDPOINT_RWSTREAM_IncompleteTransfer;
+			break;
+		}
+	}
+
+	/* If the endpoint is full, send its contents to the host */
+	if (!(ErrorCode) && !(Endpoint_IsReadWriteAllowed()))
+	  Endpoint_ClearIN();
+
+	DataflashStorage_EndPageRead();
+
+	if (BytesProcessed != NULL)
+	  *BytesProcessed += BytesInTransfer;
+
+	return ErrorCode;
+}
+
+uint8_t DataflashStorage_WriteFromEndpoint(uint32_t Address,
+                                           uint32_t Length,
+                                           volatile bool* const AbortFlag,
+                                           uint32_t* const BytesProcessed)
+{
+	uint32_t BytesInTransfer = 0;
+	uint8_t  ErrorCode;
+
+	if (BytesProcessed != NULL)
+	{
+		Address += *BytesProcessed;
+		Length  -= *BytesProcessed;
+	}
+
+	uint16_t CurrPage     = (Address / DATAFLASH_PAGE_SIZE);
+	uint16_t CurrPageByte = (Address % DATAFLASH_PAGE_SIZE);
+
+	/* Don't wait on the endpoint if there is no data left to transfer */
+	if (!(Length))
+	  return ENDPOINT_RWSTREAM_NoError;
+
+	/* Wait until endpoint is ready before continuing */
+	if ((ErrorCode = Endpoint_WaitUntilReady()))
+	  return ErrorCode;
+
+	DataflashStorage_BeginPageWrite(CurrPage, CurrPageByte, Length);
+
+	while (Length)
+	{
+		/* Check if the endpoint is currently empty */
+		if (!(Endpoint_IsReadWriteAllowed()))
+		{
+			/* Clear the current endpoint bank */
+			Endpoint_ClearOUT();
+
+			/* If the transfer can be resumed later, return rather than waiting for the host to send another packet */
+			if ((BytesProcessed != NULL) && !(Endpoint_IsOUTReceived()))
+			{
+				ErrorCode = ENDPOINT_RWSTREAM_IncompleteTransfer;
+				break;
+			}
+
+			/* Wait until the host has sent another packet, while the last Dataflash byte is written */
+			if ((ErrorCode = Endpoint_WaitUntilReady()))
+			  break;
+		}
+
+		/* Check if end of Dataflash page reached, start writing the next page if so */
+		if (CurrPageByte == DATAFLASH_PAGE_SIZE)
+		{
+			CurrPageByte = 0;
+
+			DataflashStorage_EndPageWrite(DATAFLASH_PAGE_SIZE);
+			DataflashStorage_BeginPageWrite(++CurrPage, 0, Length);
+		}
+
+		/* Write one 16-byte chunk of data to the Dataflash, overlapping each SPI transfer with the endpoint read */
+		for (uint8_t ByteNum = 0; ByteNum < 16; ByteNum++)
+		  DataflashStorage_StartSend(Endpoint_Read_8());
+
+		CurrPageByte    += 16;
+		Length          -= 16;
+		BytesInTransfer += 16;
+
+		/* Check if the current transfer is being aborted */
+		if ((AbortFlag != NULL) && *AbortFlag)
+		{
+			ErrorCode = ENDPOINT_RWSTREAM_IncompleteTransfer;
+			break;
+		}
+	}
+
+	/* If the endpoint is empty, clear it ready for the next packet from the host */
+	if (!(ErrorCode) && !(Endpoint_IsReadWriteAllowed()))
+	  Endpoint_ClearOUT();
+
+	DataflashStorage_EndPageWrite(CurrPageByte);
+
+	#if defined(DATAFLASH_STORAGE_WRITE_THROUGH)
+	DataflashStorage_Flush();
+	#endif
+
+	if (BytesProcessed != NULL)
+	  *BytesProcessed += BytesInTransfer;
+
+	return ErrorCode;
+}
+#endif
+
+void DataflashStorage_Flush(void)
+{
+	DataflashStorage_CommitPage();
+
+	/* Consecutive pages are interleaved across the Dataflash ICs, so the first pages select each IC in turn */
+	for (uint8_t ChipPage = 0; ChipPage < DATAFLASH_TOTALCHIPS; ChipPage++)
+	  DataflashStorage_WaitWhileBufferBusy(ChipPage, DATAFLASH_STORAGE_BUFFER_MASK(ChipPage, DATAFLASH_STORAGE_ALL_BUFFERS));
+}
+
+void DataflashStorage_Erase(const uint32_t Address,
+                            const uint32_t Length)
+{
+	uint32_t StartPage = ((Address + (DATAFLASH_PAGE_SIZE - 1)) / DATAFLASH_PAGE_SIZE);
+	uint32_t EndPage   = ((Address + Length) / DATAFLASH_PAGE_SIZE);
+
+	for (uint32_t Page = StartPage; Page < EndPage; Page++)
+	{
+		/* Any cached data for the page is being erased, so discard it */
+		if (Page == CachedPage)
+		  CachedPage = DATAFLASH_STORAGE_NO_PAGE;
+
+		DataflashStorage_WaitWhileBufferBusy(Page, DATAFLASH_STORAGE_BUFFER_MASK(Page, DATAFLASH_STORAGE_ALL_BUFFERS));
+
+		Dataflash_SelectChipFromPage(Page);
+		Dataflash_SendByte(DF_CMD_PAGEERASE);
+		Dataflash_SendAddressBytes(Page, 0);
+		Dataflash_DeselectChip();
+
+		BusyBuffers |= DATAFLASH_STORAGE_BUFFER_MASK(Page, DATAFLASH_STORAGE_ALL_BUFFERS);
+	}
+}
+
+void DataflashStorage_ResetProtections(void)
+{
+	DataflashStorage_Flush();
+
+	/* Select first Dataflash chip, send the read status register command */
+	Dataflash_SelectChip(DATAFLASH_CHIP1);
+	Dataflash_SendByte(DF_CMD_GETSTATUS);
+
+	/* Check if sector protection is enabled */
+	if (Dataflash_ReceiveByte() & DF_STATUS_SECTORPROTECTION_ON)
+	{
+		Dataflash_ToggleSelectedChipCS();
+
+		/* Send the commands to disable sector protection */
+		Dataflash_SendByte(DF_CMD_SECTORPROTECTIONOFF[0]);
+		Dataflash_SendByte(DF_CMD_SECTORPROTECTIONOFF[1]);
+		Dataflash_SendByte(DF_CMD_SECTORPROTECTIONOFF[2]);
+		Dataflash_SendByte(DF_CMD_SECTORPROTECTIONOFF[3]);
+	}
+
+	/* Select second Dataflash chip (if present on selected board), send read status register command */
+	#if (DATAFLASH_TOTALCHIPS == 2)
+	Dataflash_SelectChip(DATAFLASH_CHIP2);
+	Dataflash_SendByte(DF_CMD_GETSTATUS);
+
+	/* Check if sector protection is enabled */
+	if (Dataflash_ReceiveByte() & DF_STATUS_SECTORPROTECTION_ON)
+	{
+		Dataflash_ToggleSelectedChipCS();
+
+		/* Send the commands to disable sector protection */
+		Dataflash_SendByte(DF_CMD_SECTORPROTECTIONOFF[0]);
+		Dataflash_SendByte(DF_CMD_SECTORPROTECTIONOFF[1]);
+		Dataflash_SendByte(DF_CMD_SECTORPROTECTIONOFF[2]);
+		Dataflash_SendByte(DF_CMD_SECTORPROTECTIONOFF[3]);
+	}
+	#endif
+
+	/* Deselect current Dataflash chip */
+	Dataflash_DeselectChip();
+}
+
+bool DataflashStorage_CheckOperation(void)
+{
+	uint8_t ReturnByte;
+
+	/* Wait for any background operations to complete, the cached page is left in the Dataflash buffer */
+	for (uint8_t ChipPage = 0; ChipPage < DATAFLASH_TOTALCHIPS; ChipPage++)
+	  DataflashStorage_WaitWhileBufferBusy(ChipPage, DATAFLASH_STORAGE_BUFFER_MASK(ChipPage, DATAFLASH_STORAGE_ALL_BUFFERS));
+
+	/* Test first Dataflash IC is present and responding to commands */
+	Dataflash_SelectChip(DATAFLASH_CHIP1);
+	Dataflash_SendByte(DF_CMD_READMANUFACTURERDEVICEINFO);
+	ReturnByte = Dataflash_ReceiveByte();
+	Dataflash_DeselectChip();
+
+	/* If returned data is invalid, fail the command */
+	if (ReturnByte != DF_MANUFACTURER_ATMEL)
+	  return false;
+
+	#if (DATAFLASH_TOTALCHIPS == 2)
+	/* Test second Dataflash IC is present and responding to commands */
+	Dataflash_SelectChip(DATAFLASH_CHIP2);
+	Dataflash_SendByte(DF_CMD_READMANUFACTURERDEVICEINFO);
+	ReturnByte = Dataflash_ReceiveByte();
+	Dataflash_DeselectChip();
+
+	/* If returned data is invalid, fail the command */
+	if (ReturnByte != DF_MANUFACTURER_ATMEL)
+	  return false;
+	#endif
+
+	return true;
+}
+
+static uint8_t DataflashStorage_BlockDevice_ReadBlocks(const uint32_t BlockAddress,
+                                                       const uint16_t TotalBlocks,
+                                                       uint8_t* const Buffer,
+                                                       volatile bool* const AbortFlag,
+                                                       uint32_t* const BytesProcessed)
+{
+	uint32_t Address = (BlockAddress * BLOCKDEVICE_BLOCK_SIZE);
+	uint32_t Length  = ((uint32_t)TotalBlocks * BLOCKDEVICE_BLOCK_SIZE);
+
+	#if defined(USB_CAN_BE_DEVICE)
+	if (Buffer == BLOCKDEVICE_ENDPOINT)
+	{
+		uint8_t ErrorCode = DataflashStorage_ReadToEndpoint(Address, Length, AbortFlag, BytesProcessed);
+
+		if ((ErrorCode == ENDPOINT_RWSTREAM_IncompleteTransfer) && ((AbortFlag == NULL) || !(*AbortFlag)))
+		  return BLOCKDEVICE_ERROR_IncompleteTransfer;
+		else if (ErrorCode)
+		  return BLOCKDEVICE_ERROR_TransferFailed;
+
+		return BLOCKDEVICE_ERROR_NoError;
+	}
+	#else
+	if (Buffer == BLOCKDEVICE_ENDPOINT)
+	  return BLOCKDEVICE_ERROR_NotSupported;
+	#endif
+
+	DataflashStorage_ReadToBuffer(Address, Length, Buffer);
+	return BLOCKDEVICE_ERROR_NoError;
+}
+
+static uint8_t DataflashStorage_BlockDevice_WriteBlocks(const uint32_t BlockAddress,
+                                                        const uint16_t TotalBlocks,
+                                                        const uint8_t* const Buffer,
+                                                        volatile bool* const AbortFlag,
+                                                        uint32_t* const BytesProcessed)
+{
+	uint32_t Address = (BlockAddress * BLOCKDEVICE_BLOCK_SIZE);
+	uint32_t Length  = ((uint32_t)TotalBlocks * BLOCKDEVICE_BLOCK_SIZE);
+
+	#if defined(USB_CAN_BE_DEVICE)
+	if (Buffer == BLOCKDEVICE_ENDPOINT)
+	{
+		uint8_t ErrorCode = DataflashStorage_WriteFromEndpoint(Address, Length, AbortFlag, BytesProcessed);
+
+		if ((ErrorCode == ENDPOINT_RWSTREAM_IncompleteTransfer) && ((AbortFlag == NULL) || !(*AbortFlag)))
+		  return BLOCKDEVICE_ERROR_IncompleteTransfer;
+		else if (ErrorCode)
+		  return BLOCKDEVICE_ERROR_TransferFailed;
+
+		return BLOCKDEVICE_ERROR_NoError;
+	}
+	#else
+	if (Buffer == BLOCKDEVICE_ENDPOINT)
+	  return BLOCKDEVICE_ERROR_NotSupported;
+	#endif
+
+	DataflashStorage_WriteFromBuffer(Address, Length, Buffer);
+	return BLOCKDEVICE_ERROR_NoError;
+}
+
+static uint8_t DataflashStorage_BlockDevice_Flush(void)
+{
+	DataflashStorage_Flush();
+	return BLOCKDEVICE_ERROR_NoError;
+}
+
+static uint8_t DataflashStorage_BlockDevice_Trim(const uint32_t BlockAddress,
+                                                 const uint32_t TotalBlocks)
+{
+	DataflashStorage_Erase((BlockAddress * BLOCKDEVICE_BLOCK_SIZE), (TotalBlocks * BLOCKDEVICE_BLOCK_SIZE));
+	return BLOCKDEVICE_ERROR_NoError;
+}
+
+#endif
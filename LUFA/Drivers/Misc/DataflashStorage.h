@@ -0,0 +1,322 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *  \brief Board Dataflash storage manager, for reading and writing the board Dataflash IC(s) as a block device.
+ *
+ *  Board Dataflash storage manager, for reading and writing the board Dataflash IC(s) as a single linear
+ *  address space or as a generic block device.
+ */
+
+/** \ingroup Group_MiscDrivers
+ *  \defgroup Group_DataflashStorage Dataflash Storage Manager - LUFA/Drivers/Misc/DataflashStorage.h
+ *  \brief Board Dataflash storage manager, for reading and writing the board Dataflash IC(s) as a block device.
+ *
+ *  \section Sec_DataflashStorage_Dependencies Module Source Dependencies
+ *  The following files must be built with any user project that uses this module:
+ *    - LUFA/Drivers/Misc/DataflashStorage.c <i>(Makefile source module name: LUFA_SRC_DATAFLASHSTORAGE)</i>
+ *
+ *  \section Sec_DataflashStorage_ModDescription Module Description
+ *  Storage manager for the board Dataflash IC(s). This presents the main memory of all the Dataflash ICs mounted
+ *  on the selected board as a single linear byte address space, and provides routines to read and write it from
+ *  either a RAM buffer or directly from the currently selected device endpoint, crossing Dataflash page and IC
+ *  boundaries as needed. The storage is also available as the generic block device \ref DataflashStorage_BlockDevice,
+ *  for use with code written against the \ref Group_BlockDevice.
+ *
+ *  Data is read directly from the Dataflash main memory array, which (unlike a main memory to buffer transfer)
+ *  requires no internal busy period before data can be clocked out. The transfer of each byte to or from the
+ *  Dataflash is overlapped with the transfer of the adjacent byte to or from its source or destination, so that on
+ *  boards where the Dataflash is attached to the AVR8 hardware SPI peripheral the SPI bus and the USB endpoint bank
+ *  are accessed in parallel, and a transfer proceeds at close to the SPI clock rate. On other boards each byte is
+ *  transferred in turn through the board Dataflash driver.
+ *
+ *  Written data is collected in the Dataflash ICs' internal SRAM buffers, which act as a write-back cache of the
+ *  most recently written page; the page is only erased and programmed once it has been completely written, or
+ *  when the cache is flushed via \ref DataflashStorage_Flush(), so that sequentially written blocks smaller than
+ *  a page cost a single page program cycle even when they are written by separate commands. Programming of each page
+ *  continues in the background while the next page is written into the Dataflash's other buffer. If the
+ *  \c DATAFLASH_STORAGE_WRITE_THROUGH compile time token is defined, the cache is flushed at the end of each write.
+ *
+ *  The board Dataflash driver must be initialized via \ref Dataflash_Init() before this module is used.
+ *
+ *  \section Sec_DataflashStorage_ExampleUsage Example Usage
+ *  The following snippet is an example of how this module may be used within a typical
+ *  application.
+ *
+ *  \code
+ *      // Initialize the board Dataflash driver before first use
+ *      Dataflash_Init();
+ *      DataflashStorage_ResetProtections();
+ *
+ *      // Read the first 512 bytes of the Dataflash into a RAM buffer
+ *      uint8_t Buffer[512];
+ *      DataflashStorage_ReadToBuffer(0, sizeof(Buffer), Buffer);
+ *
+ *      // Stream the next 4096 bytes of the Dataflash to the host via the selected IN endpoint
+ *      Endpoint_SelectEndpoint(DATA_IN_EPADDR);
+ *      DataflashStorage_ReadToEndpoint(512, 4096, NULL, NULL);
+ *
+ *      // Modify and write back the first 512 bytes, then commit them to the Dataflash
+ *      Buffer[0] ^= 0xFF;
+ *      DataflashStorage_WriteFromBuffer(0, sizeof(Buffer), Buffer);
+ *      DataflashStorage_Flush();
+ *  \endcode
+ *
+ *  @{
+ */
+
+#ifndef __DATAFLASH_STORAGE_H__
+#define __DATAFLASH_STORAGE_H__
+
+	/* Includes: */
+		#include "../../Common/Common.h"
+		#include "../USB/USB.h"
+		#include "../Board/Dataflash.h"
+		#include "BlockDevice.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks: */
+		#if (DATAFLASH_PAGE_SIZE % 16)
+			#error Dataflash page size must be a multiple of 16 bytes.
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			/** Total number of bytes of storage in the board Dataflash IC(s). */
+			#define DATAFLASH_STORAGE_BYTES     ((uint32_t)DATAFLASH_PAGES * DATAFLASH_PAGE_SIZE * DATAFLASH_TOTALCHIPS)
+
+		/* External Variables: */
+			/** Block device interface to the board Dataflash IC(s), for use with the \ref Group_BlockDevice. The block
+			 *  device's trim callback erases all Dataflash pages lying entirely within the trimmed blocks.
+			 */
+			extern const BlockDevice_t DataflashStorage_BlockDevice;
+
+		/* Function Prototypes: */
+			/** Reads a block of data from the board Dataflash IC(s) into the given RAM buffer.
+			 *
+			 *  \param[in]  Address  Starting byte address of the data to read, within the total Dataflash storage.
+			 *  \param[in]  Length   Number of bytes to read.
+			 *  \param[out] Buffer   Pointer to the destination RAM buffer.
+			 */
+			void DataflashStorage_ReadToBuffer(const uint32_t Address,
+			                                   uint32_t Length,
+			                                   uint8_t* Buffer) ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Writes a block of data from the given RAM buffer to the board Dataflash IC(s). The data of the last
+			 *  page written may be cached until the next call to \ref DataflashStorage_Flush().
+			 *
+			 *  \param[in] Address  Starting byte address of the data to write, within the total Dataflash storage.
+			 *  \param[in] Length   Number of bytes to write.
+			 *  \param[in] Buffer   Pointer to the source RAM buffer.
+			 */
+			void DataflashStorage_WriteFromBuffer(const uint32_t Address,
+			                                      uint32_t Length,
+			                                      const uint8_t* Buffer) ATTR_NON_NULL_PTR_ARG(3);
+
+			#if defined(USB_CAN_BE_DEVICE) || defined(__DOXYGEN__)
+			/** Reads a block of data from the board Dataflash IC(s) into the currently selected device IN endpoint,
+			 *  sending each endpoint bank to the host as it is filled. A partially filled final bank is left in
+			 *  the endpoint for the caller to send, so that further data may be appended to it.
+			 *
+			 *  \pre The endpoint bank size and the length of the data to read must both be a multiple of 16 bytes.
+			 *
+			 *  \param[in]     Address         Starting byte address of the data to read, within the total Dataflash storage.
+			 *  \param[in]     Length          Number of bytes to read.
+			 *  \param[in]     AbortFlag       Optional pointer to a flag which is set when the transfer should be aborted,
+			 *                                 such as a Mass Storage interface reset flag, or \c NULL if not used.
+			 *  \param[in,out] BytesProcessed  Optional pointer to a location holding the number of bytes already transferred,
+			 *                                 or \c NULL to transfer all the data before returning. If given, the transfer is
+			 *                                 resumed from this offset, and returns once the endpoint would block.
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum, or \ref ENDPOINT_RWSTREAM_IncompleteTransfer
+			 *          if the transfer was aborted via the given abort flag or is to be resumed.
+			 */
+			uint8_t DataflashStorage_ReadToEndpoint(uint32_t Address,
+			                                        uint32_t Length,
+			                                        volatile bool* const AbortFlag,
+			                                        uint32_t* const BytesProcessed);
+
+			/** Writes a block of data from the currently selected device OUT endpoint to the board Dataflash IC(s),
+			 *  clearing each endpoint bank as it is emptied. The data of the last page written may be cached until
+			 *  the next call to \ref DataflashStorage_Flush().
+			 *
+			 *  \pre The endpoint bank size and the length of the data to write must both be a multiple of 16 bytes.
+			 *
+			 *  \param[in]     Address         Starting byte address of the data to write, within the total Dataflash storage.
+			 *  \param[in]     Length          Number of bytes to write.
+			 *  \param[in]     AbortFlag       Optional pointer to a flag which is set when the transfer should be aborted,
+			 *                                 such as a Mass Storage interface reset flag, or \c NULL if not used.
+			 *  \param[in,out] BytesProcessed  Optional pointer to a location holding the number of bytes already transferred,
+			 *                                 or \c NULL to transfer all the data before returning. If given, the transfer is
+			 *                                 resumed from this offset, and returns once the endpoint would block.
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum, or \ref ENDPOINT_RWSTREAM_IncompleteTransfer
+			 *          if the transfer was aborted via the given abort flag or is to be resumed.
+			 */
+			uint8_t DataflashStorage_WriteFromEndpoint(uint32_t Address,
+			                                           uint32_t Length,
+			                                           volatile bool* const AbortFlag,
+			                                           uint32_t* const BytesProcessed);
+			#endif
+
+			/** Commits any cached written data to the board Dataflash IC(s), and waits until all the Dataflash ICs
+			 *  have finished programming.
+			 */
+			void DataflashStorage_Flush(void);
+
+			/** Erases all Dataflash pages which lie entirely within the given address range, so that they read back
+			 *  as 0xFF. Partially covered pages at either end of the range are left unchanged.
+			 *
+			 *  \param[in] Address  Starting byte address of the range to erase, within the total Dataflash storage.
+			 *  \param[in] Length   Number of bytes in the range to erase.
+			 */
+			void DataflashStorage_Erase(const uint32_t Address,
+			                            const uint32_t Length);
+
+			/** Disables the sector write protection of the board Dataflash IC(s), if enabled. */
+			void DataflashStorage_ResetProtections(void);
+
+			/** Performs a simple test on the board Dataflash IC(s) to ensure that they are present and responding.
+			 *
+			 *  \return Boolean \c true if all Dataflash ICs are working, \c false otherwise.
+			 */
+			bool DataflashStorage_CheckOperation(void) ATTR_WARN_UNUSED_RESULT;
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#if ((BOARD == BOARD_USBKEY) || (BOARD == BOARD_STK525) || (BOARD == BOARD_STK526) || \
+			     (BOARD == BOARD_XPLAIN) || (BOARD == BOARD_XPLAIN_REV1) || (BOARD == BOARD_EVK527))
+				#define DATAFLASH_STORAGE_PIPELINED_SPI
+			#endif
+
+			#define DATAFLASH_STORAGE_NO_PAGE   0xFFFF
+
+			#define DATAFLASH_STORAGE_BUFFER(Page)                  (((Page) / DATAFLASH_TOTALCHIPS) & 0x01)
+			#define DATAFLASH_STORAGE_BUFFER_MASK(Page, Buffers)    ((Buffers) << (((Page) % DATAFLASH_TOTALCHIPS) * 2))
+			#define DATAFLASH_STORAGE_ALL_BUFFERS                   0x03
+
+		/* Inline Functions: */
+			#if defined(__INCLUDE_FROM_DATAFLASHSTORAGE_C)
+				#if defined(DATAFLASH_STORAGE_PIPELINED_SPI)
+				static inline void DataflashStorage_StartReceive(void) ATTR_ALWAYS_INLINE;
+				static inline void DataflashStorage_StartReceive(void)
+				{
+					SPDR = 0x00;
+				}
+
+				static inline uint8_t DataflashStorage_FinishReceive(void) ATTR_ALWAYS_INLINE;
+				static inline uint8_t DataflashStorage_FinishReceive(void)
+				{
+					while (!(SPSR & (1 << SPIF)));
+					return SPDR;
+				}
+
+				static inline void DataflashStorage_StartSend(const uint8_t Byte) ATTR_ALWAYS_INLINE;
+				static inline void DataflashStorage_StartSend(const uint8_t Byte)
+				{
+					while (!(SPSR & (1 << SPIF)));
+					SPDR = Byte;
+				}
+
+				static inline void DataflashStorage_FinishSend(void) ATTR_ALWAYS_INLINE;
+				static inline void DataflashStorage_FinishSend(void)
+				{
+					while (!(SPSR & (1 << SPIF)));
+				}
+				#else
+				static inline void DataflashStorage_StartReceive(void) ATTR_ALWAYS_INLINE;
+				static inline void DataflashStorage_StartReceive(void)
+				{
+
+				}
+
+				static inline uint8_t DataflashStorage_FinishReceive(void) ATTR_ALWAYS_INLINE;
+				static inline uint8_t DataflashStorage_FinishReceive(void)
+				{
+					return Dataflash_ReceiveByte();
+				}
+
+				static inline void DataflashStorage_StartSend(const uint8_t Byte) ATTR_ALWAYS_INLINE;
+				static inline void DataflashStorage_StartSend(const uint8_t Byte)
+				{
+					Dataflash_SendByte(Byte);
+				}
+
+				static inline void DataflashStorage_FinishSend(void) ATTR_ALWAYS_INLINE;
+				static inline void DataflashStorage_FinishSend(void)
+				{
+
+				}
+				#endif
+			#endif
+
+		/* Function Prototypes: */
+			#if defined(__INCLUDE_FROM_DATAFLASHSTORAGE_C)
+				static void DataflashStorage_WaitWhileBufferBusy(const uint16_t Page,
+				                                                 const uint8_t BufferMask);
+				static void DataflashStorage_CommitPage(void);
+				static void DataflashStorage_BeginPageRead(const uint16_t Page,
+				                                           const uint16_t PageByte);
+				static void DataflashStorage_EndPageRead(void);
+				static void DataflashStorage_BeginPageWrite(const uint16_t Page,
+				                                            const uint16_t PageByte,
+				                                            const uint32_t Length);
+				static void DataflashStorage_EndPageWrite(const uint16_t PageByte);
+
+				static uint8_t DataflashStorage_BlockDevice_ReadBlocks(const uint32_t BlockAddress,
+				                                                       const uint16_t TotalBlocks,
+				                                                       uint8_t* const Buffer,
+				                                                       volatile bool* const AbortFlag,
+				                                                       uint32_t* const BytesProcessed);
+				static uint8_t DataflashStorage_BlockDevice_WriteBlocks(const uint32_t BlockAddress,
+				                                                        const uint16_t TotalBlocks,
+				                                                        const uint8_t* const Buffer,
+				                                                        volatile bool* const AbortFlag,
+				                                                        uint32_t* const BytesProcessed);
+				static uint8_t DataflashStorage_BlockDevice_Flush(void);
+				static uint8_t DataflashStorage_BlockDevice_Trim(const uint32_t BlockAddress,
+				                                                 const uint32_t TotalBlocks);
+			#endif
+	#endif
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
+
@@ -57,6 +57,17 @@
  *  or deletions) must not overlap. If there is possibility of two or more of the same kind of
  *  operating occurring at the same point in time, atomic (mutex) locking should be used.
  *
+ *  The buffer is tracked by a pair of free-running storage and retrieval indexes, each of which is
+ *  only ever written by one side of the buffer. As each index is no wider than a native register of
+ *  the target, a single producer and a single consumer never need to disable global interrupts to
+ *  safely share a buffer. As a consequence, the size of each buffer is limited to \ref RING_BUFFER_MAX_SIZE
+ *  bytes, which is 128 bytes on architectures with 8-bit registers (AVR8 and XMEGA).
+ *
+ *  In addition to the byte-wide insertion and removal functions, blocks of data may be moved in and out
+ *  of a buffer in bulk, either by copying via \ref RingBuffer_InsertBlock() and \ref RingBuffer_RemoveBlock(),
+ *  or in-place via the contiguous span functions such as \ref RingBuffer_GetReadSpan() and
+ *  \ref RingBuffer_CommitRead().
+ *
  *  \section Sec_RingBuff_ExampleUsage Example Usage
  *  The following snippet is an example of how this module may be used within a typical
  *  application.
@@ -76,15 +87,24 @@
  *      RingBuffer_Insert(&Buffer, 'L');
  *      RingBuffer_Insert(&Buffer, 'O');
  *
+ *      // Insert a block of data into the buffer
+ *      RingBuffer_InsertBlock(&Buffer, (const uint8_t*)" WORLD", 6);
+ *
  *      // Cache the number of stored bytes in the buffer
  *      uint16_t BufferCount = RingBuffer_GetCount(&Buffer);
  *
  *      // Printer stored data length
  *      printf("Buffer Length: %d, Buffer Data: \r\n", BufferCount);
  *
- *      // Print contents of the buffer one character at a time
- *      while (BufferCount--)
- *        putc(RingBuffer_Remove(&Buffer));
+ *      // Print contents of the buffer one contiguous span at a time
+ *      uint8_t* Span;
+ *      uint16_t SpanLength;
+ *
+ *      while ((SpanLength = RingBuffer_GetReadSpan(&Buffer, &Span)) != 0)
+ *      {
+ *          fwrite(Span, 1, SpanLength, stdout);
+ *          RingBuffer_CommitRead(&Buffer, SpanLength);
+ *      }
  *  \endcode
  *
  *  @{
@@ -101,6 +121,12 @@
 			extern "C" {
 		#endif
 
+	/* Macros: */
+		/** Maximum size of a ring buffer's underlying storage array, in bytes. The free-running storage and retrieval
+		 *  indexes count up to twice the buffer size, and so must fit into a native register of the target.
+		 */
+		#define RING_BUFFER_MAX_SIZE         ((sizeof(uint_reg_t) == 1) ? 128 : 16384)
+
 	/* Type Defines: */
 		/** \brief Ring Buffer Management Structure.
 		 *
@@ -109,49 +135,80 @@
 		 */
 		typedef struct
 		{
-			uint8_t* In; /**< Current storage location in the circular buffer. */
-			uint8_t* Out; /**< Current retrieval location in the circular buffer. */
-			uint8_t* Start; /**< Pointer to the start of the buffer's underlying storage array. */
-			uint8_t* End; /**< Pointer to the end of the buffer's underlying storage array. */
-			uint16_t Size; /**< Size of the buffer's underlying storage array. */
-			uint16_t Count; /**< Number of bytes currently stored in the buffer. */
+			uint8_t*            Start; /**< Pointer to the start of the buffer's underlying storage array. */
+			uint16_t            Size; /**< Size of the buffer's underlying storage array. */
+			volatile uint_reg_t In; /**< Free-running storage index, modulo twice the buffer size. */
+			volatile uint_reg_t Out; /**< Free-running retrieval index, modulo twice the buffer size. */
 		} RingBuffer_t;
 
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Function Prototypes: */
+			void RingBuffer_SizeExceedsMaximum(void) ATTR_ERROR("Ring buffer size exceeds RING_BUFFER_MAX_SIZE.");
+
+		/* Inline Functions: */
+			static inline uint16_t RingBuffer_IndexToOffset(RingBuffer_t* const Buffer,
+			                                                const uint_reg_t Index) ATTR_WARN_UNUSED_RESULT ATTR_ALWAYS_INLINE;
+			static inline uint16_t RingBuffer_IndexToOffset(RingBuffer_t* const Buffer,
+			                                                const uint_reg_t Index)
+			{
+				return (Index >= Buffer->Size) ? (Index - Buffer->Size) : Index;
+			}
+
+			static inline uint_reg_t RingBuffer_AdvanceIndex(RingBuffer_t* const Buffer,
+			                                                 const uint_reg_t Index,
+			                                                 const uint16_t Amount) ATTR_WARN_UNUSED_RESULT ATTR_ALWAYS_INLINE;
+			static inline uint_reg_t RingBuffer_AdvanceIndex(RingBuffer_t* const Buffer,
+			                                                 const uint_reg_t Index,
+			                                                 const uint16_t Amount)
+			{
+				uint16_t NewIndex = ((uint16_t)Index + Amount);
+
+				if (NewIndex >= ((uint16_t)Buffer->Size << 1))
+				  NewIndex -= ((uint16_t)Buffer->Size << 1);
+
+				return NewIndex;
+			}
+	#endif
+
 	/* Inline Functions: */
 		/** Initializes a ring buffer ready for use. Buffers must be initialized via this function
 		 *  before any operations are called upon them. Already initialized buffers may be reset
 		 *  by re-initializing them using this function.
 		 *
+		 *  \note Buffers must be no larger than \ref RING_BUFFER_MAX_SIZE bytes. A larger compile time constant size
+		 *        produces a compilation error.
+		 *
 		 *  \param[out] Buffer   Pointer to a ring buffer structure to initialize.
 		 *  \param[out] DataPtr  Pointer to a global array that will hold the data stored into the ring buffer.
 		 *  \param[out] Size     Maximum number of bytes that can be stored in the underlying data array.
 		 */
 		static inline void RingBuffer_InitBuffer(RingBuffer_t* Buffer,
 		                                         uint8_t* const DataPtr,
-		                                         const uint16_t Size) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+		                                         const uint16_t Size) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2) ATTR_ALWAYS_INLINE;
 		static inline void RingBuffer_InitBuffer(RingBuffer_t* Buffer,
 		                                         uint8_t* const DataPtr,
 		                                         const uint16_t Size)
 		{
+			if (GCC_IS_COMPILE_CONST(Size) && (Size > RING_BUFFER_MAX_SIZE))
+			  RingBuffer_SizeExceedsMaximum();
+
 			GCC_FORCE_POINTER_ACCESS(Buffer);
 
 			uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
 			GlobalInterruptDisable();
 
-			Buffer->In     = DataPtr;
-			Buffer->Out    = DataPtr;
-			Buffer->Start  = &DataPtr[0];
-			Buffer->End    = &DataPtr[Size];
+			Buffer->Start  = DataPtr;
 			Buffer->Size   = Size;
-			Buffer->Count  = 0;
+			Buffer->In     = 0;
+			Buffer->Out    = 0;
 
 			SetGlobalInterruptMask(CurrentGlobalInt);
 		}
 
 		/** Retrieves the current number of bytes stored in a particular buffer. This value is computed
-		 *  by entering an atomic lock on the buffer, so that the buffer cannot be modified while the
-		 *  computation takes place. This value should be cached when reading out the contents of the buffer,
-		 *  so that as small a time as possible is spent in an atomic lock.
+		 *  from a snapshot of the buffer's storage and retrieval indexes, without disabling interrupts.
+		 *  This value should be cached when reading out the contents of the buffer.
 		 *
 		 *  \note The value returned by this function is guaranteed to only be the minimum number of bytes
 		 *        stored in the given buffer; this value may change as other threads write new data, thus
@@ -165,19 +222,17 @@
 		static inline uint16_t RingBuffer_GetCount(RingBuffer_t* const Buffer) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
 		static inline uint16_t RingBuffer_GetCount(RingBuffer_t* const Buffer)
 		{
-			uint16_t Count;
-
-			uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
-			GlobalInterruptDisable();
-
-			Count = Buffer->Count;
+			uint_reg_t In  = Buffer->In;
+			uint_reg_t Out = Buffer->Out;
 
-			SetGlobalInterruptMask(CurrentGlobalInt);
-			return Count;
+			if (In >= Out)
+			  return (In - Out);
+			else
+			  return (((uint16_t)Buffer->Size << 1) - Out + In);
 		}
 
-		/** Retrieves the free space in a particular buffer. This value is computed by entering an atomic lock
-		 *  on the buffer, so that the buffer cannot be modified while the computation takes place.
+		/** Retrieves the free space in a particular buffer. This value is computed from a snapshot of the
+		 *  buffer's storage and retrieval indexes, without disabling interrupts.
 		 *
 		 *  \note The value returned by this function is guaranteed to only be the maximum number of bytes
 		 *        free in the given buffer; this value may change as other threads write new data, thus
@@ -194,13 +249,12 @@
 			return (Buffer->Size - RingBuffer_GetCount(Buffer));
 		}
 
-		/** Atomically determines if the specified ring buffer contains any data. This should
-		 *  be tested before removing data from the buffer, to ensure that the buffer does not
-		 *  underflow.
+		/** Determines if the specified ring buffer contains any data. This should be tested before
+		 *  removing data from the buffer, to ensure that the buffer does not underflow.
 		 *
 		 *  If the data is to be removed in a loop, store the total number of bytes stored in the
 		 *  buffer (via a call to the \ref RingBuffer_GetCount() function) in a temporary variable
-		 *  to reduce the time spent in atomicity locks.
+		 *  to reduce the number of index snapshots taken.
 		 *
 		 *  \param[in,out] Buffer  Pointer to a ring buffer structure to insert into.
 		 *
@@ -209,12 +263,11 @@
 		static inline bool RingBuffer_IsEmpty(RingBuffer_t* const Buffer) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
 		static inline bool RingBuffer_IsEmpty(RingBuffer_t* const Buffer)
 		{
-			return (RingBuffer_GetCount(Buffer) == 0);
+			return (Buffer->In == Buffer->Out);
 		}
 
-		/** Atomically determines if the specified ring buffer contains any free space. This should
-		 *  be tested before storing data to the buffer, to ensure that no data is lost due to a
-		 *  buffer overrun.
+		/** Determines if the specified ring buffer contains any free space. This should be tested
+		 *  before storing data to the buffer, to ensure that no data is lost due to a buffer overrun.
 		 *
 		 *  \param[in,out] Buffer  Pointer to a ring buffer structure to insert into.
 		 *
@@ -242,17 +295,12 @@
 		{
 			GCC_FORCE_POINTER_ACCESS(Buffer);
 
-			*Buffer->In = Data;
+			uint_reg_t In = Buffer->In;
 
-			if (++Buffer->In == Buffer->End)
-			  Buffer->In = Buffer->Start;
+			Buffer->Start[RingBuffer_IndexToOffset(Buffer, In)] = Data;
+			GCC_MEMORY_BARRIER();
 
-			uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
-			GlobalInterruptDisable();
-
-			Buffer->Count++;
-
-			SetGlobalInterruptMask(CurrentGlobalInt);
+			Buffer->In = RingBuffer_AdvanceIndex(Buffer, In, 1);
 		}
 
 		/** Removes an element from the ring buffer.
@@ -270,17 +318,12 @@
 		{
 			GCC_FORCE_POINTER_ACCESS(Buffer);
 
-			uint8_t Data = *Buffer->Out;
+			uint_reg_t Out = Buffer->Out;
 
-			if (++Buffer->Out == Buffer->End)
-			  Buffer->Out = Buffer->Start;
+			uint8_t Data = Buffer->Start[RingBuffer_IndexToOffset(Buffer, Out)];
+			GCC_MEMORY_BARRIER();
 
-			uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
-			GlobalInterruptDisable();
-
-			Buffer->Count--;
-
-			SetGlobalInterruptMask(CurrentGlobalInt);
+			Buffer->Out = RingBuffer_AdvanceIndex(Buffer, Out, 1);
 
 			return Data;
 		}
@@ -294,7 +337,169 @@
 		static inline uint8_t RingBuffer_Peek(RingBuffer_t* const Buffer) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
 		static inline uint8_t RingBuffer_Peek(RingBuffer_t* const Buffer)
 		{
-			return *Buffer->Out;
+			return Buffer->Start[RingBuffer_IndexToOffset(Buffer, Buffer->Out)];
+		}
+
+		/** Retrieves a pointer to the largest contiguous span of free space in the ring buffer, starting at the
+		 *  current storage location. Data may be written directly into the span, and then made available to the
+		 *  consumer via a call to \ref RingBuffer_CommitWrite(). As the span may end at the end of the buffer's
+		 *  underlying storage array, the free space may be split into two spans.
+		 *
+		 *  \warning Only the execution thread which inserts into the buffer may call this function.
+		 *
+		 *  \param[in,out] Buffer  Pointer to a ring buffer structure to insert into.
+		 *  \param[out]    Span    Location where the pointer to the start of the free span is to be stored.
+		 *
+		 *  \return Number of bytes which may be written into the span, zero if the buffer is full.
+		 */
+		static inline uint16_t RingBuffer_GetWriteSpan(RingBuffer_t* const Buffer,
+		                                               uint8_t** const Span) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+		static inline uint16_t RingBuffer_GetWriteSpan(RingBuffer_t* const Buffer,
+		                                               uint8_t** const Span)
+		{
+			uint16_t Offset = RingBuffer_IndexToOffset(Buffer, Buffer->In);
+
+			*Span = &Buffer->Start[Offset];
+			return MIN(RingBuffer_GetFreeCount(Buffer), (Buffer->Size - Offset));
+		}
+
+		/** Commits data written into a span retrieved via \ref RingBuffer_GetWriteSpan(), making it available
+		 *  for removal from the buffer.
+		 *
+		 *  \warning Only the execution thread which inserts into the buffer may call this function.
+		 *
+		 *  \param[in,out] Buffer  Pointer to a ring buffer structure to insert into.
+		 *  \param[in]     Length  Number of bytes written into the span, no larger than the span's length.
+		 */
+		static inline void RingBuffer_CommitWrite(RingBuffer_t* const Buffer,
+		                                          const uint16_t Length) ATTR_NON_NULL_PTR_ARG(1);
+		static inline void RingBuffer_CommitWrite(RingBuffer_t* const Buffer,
+		                                          const uint16_t Length)
+		{
+			GCC_MEMORY_BARRIER();
+
+			Buffer->In = RingBuffer_AdvanceIndex(Buffer, Buffer->In, Length);
+		}
+
+		/** Retrieves a pointer to the largest contiguous span of stored data in the ring buffer, starting at the
+		 *  current retrieval location. Data may be read directly from the span, and then released back to the
+		 *  producer via a call to \ref RingBuffer_CommitRead(). As the span may end at the end of the buffer's
+		 *  underlying storage array, the stored data may be split into two spans.
+		 *
+		 *  \warning Only the execution thread which removes from the buffer may call this function.
+		 *
+		 *  \param[in,out] Buffer  Pointer to a ring buffer structure to retrieve from.
+		 *  \param[out]    Span    Location where the pointer to the start of the stored data span is to be stored.
+		 *
+		 *  \return Number of bytes which may be read from the span, zero if the buffer is empty.
+		 */
+		static inline uint16_t RingBuffer_GetReadSpan(RingBuffer_t* const Buffer,
+		                                              uint8_t** const Span) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+		static inline uint16_t RingBuffer_GetReadSpan(RingBuffer_t* const Buffer,
+		                                              uint8_t** const Span)
+		{
+			uint16_t Offset = RingBuffer_IndexToOffset(Buffer, Buffer->Out);
+
+			*Span = &Buffer->Start[Offset];
+			return MIN(RingBuffer_GetCount(Buffer), (Buffer->Size - Offset));
+		}
+
+		/** Releases data read from a span retrieved via \ref RingBuffer_GetReadSpan(), freeing the space for
+		 *  further insertions into the buffer.
+		 *
+		 *  \warning Only the execution thread which removes from the buffer may call this function.
+		 *
+		 *  \param[in,out] Buffer  Pointer to a ring buffer structure to retrieve from.
+		 *  \param[in]     Length  Number of bytes read from the span, no larger than the span's length.
+		 */
+		static inline void RingBuffer_CommitRead(RingBuffer_t* const Buffer,
+		                                         const uint16_t Length) ATTR_NON_NULL_PTR_ARG(1);
+		static inline void RingBuffer_CommitRead(RingBuffer_t* const Buffer,
+		                                         const uint16_t Length)
+		{
+			GCC_MEMORY_BARRIER();
+
+			Buffer->Out = RingBuffer_AdvanceIndex(Buffer, Buffer->Out, Length);
+		}
+
+		/** Inserts a block of data into the ring buffer, up to the amount of free space currently available.
+		 *
+		 *  \warning Only one execution thread (main program thread or an ISR) may insert into a single buffer
+		 *           otherwise data corruption may occur. Insertion and removal may occur from different execution
+		 *           threads.
+		 *
+		 *  \param[in,out] Buffer  Pointer to a ring buffer structure to insert into.
+		 *  \param[in]     Data    Pointer to the data to insert into the buffer.
+		 *  \param[in]     Length  Number of bytes to insert into the buffer.
+		 *
+		 *  \return Number of bytes inserted into the buffer, which may be less than the requested length.
+		 */
+		static inline uint16_t RingBuffer_InsertBlock(RingBuffer_t* const Buffer,
+		                                              const uint8_t* Data,
+		                                              uint16_t Length) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+		static inline uint16_t RingBuffer_InsertBlock(RingBuffer_t* const Buffer,
+		                                              const uint8_t* Data,
+		                                              uint16_t Length)
+		{
+			uint16_t BytesInserted = 0;
+
+			while (Length)
+			{
+				uint8_t* Span;
+				uint16_t SpanLength = MIN(RingBuffer_GetWriteSpan(Buffer, &Span), Length);
+
+				if (!(SpanLength))
+				  break;
+
+				memcpy(Span, Data, SpanLength);
+				RingBuffer_CommitWrite(Buffer, SpanLength);
+
+				Data          += SpanLength;
+				Length        -= SpanLength;
+				BytesInserted += SpanLength;
+			}
+
+			return BytesInserted;
+		}
+
+		/** Removes a block of data from the ring buffer, up to the amount of data currently stored.
+		 *
+		 *  \warning Only one execution thread (main program thread or an ISR) may remove from a single buffer
+		 *           otherwise data corruption may occur. Insertion and removal may occur from different execution
+		 *           threads.
+		 *
+		 *  \param[in,out] Buffer  Pointer to a ring buffer structure to retrieve from.
+		 *  \param[out]    Data    Pointer to the location where the removed data is to be stored.
+		 *  \param[in]     Length  Maximum number of bytes to remove from the buffer.
+		 *
+		 *  \return Number of bytes removed from the buffer, which may be less than the requested length.
+		 */
+		static inline uint16_t RingBuffer_RemoveBlock(RingBuffer_t* const Buffer,
+		                                              uint8_t* Data,
+		                                              uint16_t Length) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+		static inline uint16_t RingBuffer_RemoveBlock(RingBuffer_t* const Buffer,
+		                                              uint8_t* Data,
+		                                              uint16_t Length)
+		{
+			uint16_t BytesRemoved = 0;
+
+			while (Length)
+			{
+				uint8_t* Span;
+				uint16_t SpanLength = MIN(RingBuffer_GetReadSpan(Buffer, &Span), Length);
+
+				if (!(SpanLength))
+				  break;
+
+				memcpy(Data, Span, SpanLength);
+				RingBuffer_CommitRead(Buffer, SpanLength);
+
+				Data         += SpanLength;
+				Length       -= SpanLength;
+				BytesRemoved += SpanLength;
+			}
+
+			return BytesRemoved;
 		}
 
 	/* Disable C linkage for C++ Compilers: */
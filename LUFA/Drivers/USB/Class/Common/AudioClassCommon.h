@@ -688,7 +688,9 @@
 		{
 			USB_Descriptor_Endpoint_t Endpoint; /**< Standard endpoint descriptor describing the audio endpoint. */
 
-			uint8_t                   Refresh; /**< Always set to zero for Audio class devices. */
+			uint8_t                   Refresh; /**< Always set to zero for Audio class data endpoints. For synchronization (rate feedback)
+			                                    *   endpoints, the interval between feedback updates, as a power of two number of frames.
+			                                    */
 			uint8_t                   SyncEndpointNumber; /**< Endpoint address to send synchronization information to, if needed (zero otherwise). */
 		} ATTR_PACKED USB_Audio_Descriptor_StreamEndpoint_Std_t;
 
@@ -721,7 +723,9 @@
 			                     *   ISOCHRONOUS type.
 			                     */
 
-			uint8_t  bRefresh; /**< Always set to zero for Audio class devices. */
+			uint8_t  bRefresh; /**< Always set to zero for Audio class data endpoints. For synchronization (rate feedback)
+			                    *   endpoints, the interval between feedback updates, as a power of two number of frames.
+			                    */
 			uint8_t  bSynchAddress; /**< Endpoint address to send synchronization information to, if needed (zero otherwise). */
 		} ATTR_PACKED USB_Audio_StdDescriptor_StreamEndpoint_Std_t;
 
@@ -30,19 +30,106 @@
 
 #define  __INCLUDE_FROM_USB_DRIVER
 #define  __INCLUDE_FROM_HID_DRIVER
+#define  __INCLUDE_FROM_HIDPARSER_C
 #include "HIDParser.h"
 
 uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
                              uint16_t ReportSize,
                              HID_ReportInfo_t* const ParserData)
+{
+	#if defined(HID_PARSER_USE_ARENA)
+	HID_ParserTables_t Tables        = {NULL, NULL, NULL, NULL, 0, 0, 0, 0};
+	void*              Arena         = ParserData->Arena;
+	uint16_t           ArenaSize     = ParserData->ArenaSize;
+	uint16_t           ArenaRequired = 0;
+	uint8_t            ErrorCode;
+
+	/* Measure the report first, so that each table can be allocated from the arena with the exact number of entries required */
+	ErrorCode = HID_ParseReport(ReportData, ReportSize, ParserData, &Tables, true);
+
+	ParserData->TotalReportItems   = 0;
+	ParserData->TotalDeviceReports = 0;
+
+	if (ErrorCode == HID_PARSE_Successful)
+	{
+		/* Tables are allocated in order of decreasing alignment, so that no padding is required between them */
+		uint16_t CollectionsOffset = (Tables.MaxReportItems * sizeof(HID_ReportItem_t));
+		uint16_t ReportIDsOffset   = CollectionsOffset + (Tables.MaxCollections * sizeof(HID_CollectionPath_t));
+		uint16_t UsagesOffset      = ReportIDsOffset   + (Tables.MaxReportIDs   * sizeof(HID_ReportSizeInfo_t));
+
+		ArenaRequired = UsagesOffset + (Tables.MaxUsages * sizeof(uint16_t));
+
+		if ((Arena == NULL) || (ArenaSize < ArenaRequired))
+		{
+			ErrorCode = HID_PARSE_InsufficientArena;
+		}
+		else
+		{
+			Tables.ReportItems     = (HID_ReportItem_t*)Arena;
+			Tables.CollectionPaths = (HID_CollectionPath_t*)((uint8_t*)Arena + CollectionsOffset);
+			Tables.ReportIDSizes   = (HID_ReportSizeInfo_t*)((uint8_t*)Arena + ReportIDsOffset);
+			Tables.UsageList       = (uint16_t*)((uint8_t*)Arena + UsagesOffset);
+
+			ErrorCode = HID_ParseReport(ReportData, ReportSize, ParserData, &Tables, false);
+		}
+	}
+
+	ParserData->ReportItems     = Tables.ReportItems;
+	ParserData->CollectionPaths = Tables.CollectionPaths;
+	ParserData->ReportIDSizes   = Tables.ReportIDSizes;
+	ParserData->Arena           = Arena;
+	ParserData->ArenaSize       = ArenaSize;
+	ParserData->ArenaRequired   = ArenaRequired;
+
+	return ErrorCode;
+	#else
+	uint16_t           UsageList[HID_USAGE_STACK_DEPTH];
+	HID_ParserTables_t Tables =
+		{
+			.ReportItems     = ParserData->ReportItems,
+			.CollectionPaths = ParserData->CollectionPaths,
+			.ReportIDSizes   = ParserData->ReportIDSizes,
+			.UsageList       = UsageList,
+			.MaxReportItems  = HID_MAX_REPORTITEMS,
+			.MaxCollections  = HID_MAX_COLLECTIONS,
+			.MaxReportIDs    = HID_MAX_REPORT_IDS,
+			.MaxUsages       = HID_USAGE_STACK_DEPTH,
+		};
+
+	return HID_ParseReport(ReportData, ReportSize, ParserData, &Tables, false);
+	#endif
+}
+
+static uint8_t HID_ParseReport(const uint8_t* ReportData,
+                               uint16_t ReportSize,
+                               HID_ReportInfo_t* const ParserData,
+                               HID_ParserTables_t* const Tables,
+                               const bool Measure)
 {
 	HID_StateTable_t      StateTable[HID_STATETABLE_STACK_DEPTH];
 	HID_StateTable_t*     CurrStateTable     = &StateTable[0];
 	HID_CollectionPath_t* CurrCollectionPath = NULL;
-	HID_ReportSizeInfo_t* CurrReportIDInfo   = &ParserData->ReportIDSizes[0];
-	uint16_t              UsageList[HID_USAGE_STACK_DEPTH];
+	HID_ReportSizeInfo_t  MeasuredReportIDInfo;
+	HID_ReportSizeInfo_t* CurrReportIDInfo   = (Measure ? &MeasuredReportIDInfo : &Tables->ReportIDSizes[0]);
 	uint8_t               UsageListSize      = 0;
+	uint8_t               MaxUsageListSize   = 0;
 	HID_MinMax_t          UsageMinMax        = {0, 0};
+	uint8_t               CollectionDepth    = 0;
+	uint8_t               TotalCollections   = 0;
+
+	#if defined(HID_PARSER_USE_ARENA)
+	uint8_t               MeasuredReportIDs[256 / 8];
+
+	memset(MeasuredReportIDs, 0x00, sizeof(MeasuredReportIDs));
+	#endif
+
+	if (Measure)
+	{
+		Tables->MaxReportItems = 0xFF;
+		Tables->MaxCollections = 0xFF;
+		Tables->MaxReportIDs   = 0xFF;
+		Tables->MaxUsages      = 0xFF;
+	}
 
 	memset(ParserData,       0x00, sizeof(HID_ReportInfo_t));
 	memset(CurrStateTable,   0x00, sizeof(HID_StateTable_t));
@@ -61,6 +148,9 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 		switch (HIDReportItem & HID_RI_DATA_SIZE_MASK)
 		{
 			case HID_RI_DATA_BITS_32:
+				if (ReportSize < 4)
+				  return HID_PARSE_MalformedReport;
+
 				ReportItemData  = (((uint32_t)ReportData[3] << 24) | ((uint32_t)ReportData[2] << 16) |
 			                       ((uint16_t)ReportData[1] << 8)  | ReportData[0]);
 				ReportSize     -= 4;
@@ -68,12 +158,18 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 				break;
 
 			case HID_RI_DATA_BITS_16:
+				if (ReportSize < 2)
+				  return HID_PARSE_MalformedReport;
+
 				ReportItemData  = (((uint16_t)ReportData[1] << 8) | (ReportData[0]));
 				ReportSize     -= 2;
 				ReportData     += 2;
 				break;
 
 			case HID_RI_DATA_BITS_8:
+				if (ReportSize < 1)
+				  return HID_PARSE_MalformedReport;
+
 				ReportItemData  = ReportData[0];
 				ReportSize     -= 1;
 				ReportData     += 1;
@@ -102,6 +198,16 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 				  return HID_PARSE_HIDStackUnderflow;
 
 				CurrStateTable--;
+
+				/* The restored state may refer to a different report, whose size must then be accumulated instead */
+				if (!(Measure) && ParserData->UsingReportIDs)
+				{
+					HID_ReportSizeInfo_t* RestoredReportIDInfo = HID_FindReportSizeInfo(ParserData, Tables, CurrStateTable->ReportID);
+
+					if (RestoredReportIDInfo != NULL)
+					  CurrReportIDInfo = RestoredReportIDInfo;
+				}
+
 				break;
 
 			case HID_RI_USAGE_PAGE(0):
@@ -110,6 +216,8 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 
 			case HID_RI_LOGICAL_MINIMUM(0):
 				CurrStateTable->Attributes.Logical.Minimum  = ReportItemData;
+				CurrStateTable->Attributes.LogicalMinimumSize = (((HIDReportItem & HID_RI_DATA_SIZE_MASK) == HID_RI_DATA_BITS_32) ?
+				                                                 4 : (HIDReportItem & HID_RI_DATA_SIZE_MASK));
 				break;
 
 			case HID_RI_LOGICAL_MAXIMUM(0):
@@ -143,25 +251,35 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 			case HID_RI_REPORT_ID(0):
 				CurrStateTable->ReportID                    = ReportItemData;
 
-				if (ParserData->UsingReportIDs)
+				if (Measure)
 				{
-					CurrReportIDInfo = NULL;
+					#if defined(HID_PARSER_USE_ARENA)
+					/* Only the number of unique report IDs is needed when measuring, which is tracked in a bitmap so that
+					 * no report size table is required; the first ID re-uses the initial report size entry */
+					uint8_t* ReportIDMapByte = &MeasuredReportIDs[CurrStateTable->ReportID / 8];
+					uint8_t  ReportIDMapMask = (1 << (CurrStateTable->ReportID % 8));
 
-					for (uint8_t i = 0; i < ParserData->TotalDeviceReports; i++)
+					if (ParserData->UsingReportIDs && !(*ReportIDMapByte & ReportIDMapMask))
 					{
-						if (ParserData->ReportIDSizes[i].ReportID == CurrStateTable->ReportID)
-						{
-							CurrReportIDInfo = &ParserData->ReportIDSizes[i];
-							break;
-						}
+						if (ParserData->TotalDeviceReports == Tables->MaxReportIDs)
+						  return HID_PARSE_InsufficientReportIDItems;
+
+						ParserData->TotalDeviceReports++;
 					}
 
+					*ReportIDMapByte |= ReportIDMapMask;
+					#endif
+				}
+				else if (ParserData->UsingReportIDs)
+				{
+					CurrReportIDInfo = HID_FindReportSizeInfo(ParserData, Tables, CurrStateTable->ReportID);
+
 					if (CurrReportIDInfo == NULL)
 					{
-						if (ParserData->TotalDeviceReports == HID_MAX_REPORT_IDS)
+						if (ParserData->TotalDeviceReports == Tables->MaxReportIDs)
 						  return HID_PARSE_InsufficientReportIDItems;
 
-						CurrReportIDInfo = &ParserData->ReportIDSizes[ParserData->TotalDeviceReports++];
+						CurrReportIDInfo = &Tables->ReportIDSizes[ParserData->TotalDeviceReports++];
 						memset(CurrReportIDInfo, 0x00, sizeof(HID_ReportSizeInfo_t));
 					}
 				}
@@ -172,13 +290,17 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 				break;
 
 			case HID_RI_USAGE(0):
-				if (UsageListSize == HID_USAGE_STACK_DEPTH)
+				if (UsageListSize == Tables->MaxUsages)
 				  return HID_PARSE_UsageListOverflow;
 
 				if ((HIDReportItem & HID_RI_DATA_SIZE_MASK) == HID_RI_DATA_BITS_32)
 				  CurrStateTable->Attributes.Usage.Page = (ReportItemData >> 16);
 
-				UsageList[UsageListSize++] = ReportItemData;
+				if (!(Measure))
+				  Tables->UsageList[UsageListSize] = ReportItemData;
+
+				UsageListSize++;
+				MaxUsageListSize = MAX(MaxUsageListSize, UsageListSize);
 				break;
 
 			case HID_RI_USAGE_MINIMUM(0):
@@ -190,51 +312,71 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 				break;
 
 			case HID_RI_COLLECTION(0):
-				if (CurrCollectionPath == NULL)
+			{
+				/* Root collections always re-use the first collection path, while each nested collection is given a new one */
+				uint8_t CollectionIndex = 0;
+
+				if (CollectionDepth)
 				{
-					CurrCollectionPath = &ParserData->CollectionPaths[0];
+					if (TotalCollections == Tables->MaxCollections)
+					  return HID_PARSE_InsufficientCollectionPaths;
+
+					CollectionIndex = TotalCollections++;
 				}
-				else
+				else if (!(TotalCollections))
 				{
-					HID_CollectionPath_t* ParentCollectionPath = CurrCollectionPath;
+					if (!(Tables->MaxCollections))
+					  return HID_PARSE_InsufficientCollectionPaths;
 
-					CurrCollectionPath = &ParserData->CollectionPaths[1];
+					TotalCollections = 1;
+				}
 
-					while (CurrCollectionPath->Parent != NULL)
-					{
-						if (CurrCollectionPath == &ParserData->CollectionPaths[HID_MAX_COLLECTIONS - 1])
-						  return HID_PARSE_InsufficientCollectionPaths;
+				CollectionDepth++;
 
-						CurrCollectionPath++;
-					}
+				if (!(Measure))
+				{
+					HID_CollectionPath_t* ParentCollectionPath = CurrCollectionPath;
 
-					CurrCollectionPath->Parent = ParentCollectionPath;
-				}
+					CurrCollectionPath = &Tables->CollectionPaths[CollectionIndex];
+					memset(CurrCollectionPath, 0x00, sizeof(HID_CollectionPath_t));
 
-				CurrCollectionPath->Type       = ReportItemData;
-				CurrCollectionPath->Usage.Page = CurrStateTable->Attributes.Usage.Page;
+					CurrCollectionPath->Parent     = ParentCollectionPath;
+					CurrCollectionPath->Type       = ReportItemData;
+					CurrCollectionPath->Usage.Page = CurrStateTable->Attributes.Usage.Page;
+				}
 
 				if (UsageListSize)
 				{
-					CurrCollectionPath->Usage.Usage = UsageList[0];
+					if (!(Measure))
+					{
+						CurrCollectionPath->Usage.Usage = Tables->UsageList[0];
 
-					for (uint8_t i = 1; i < UsageListSize; i++)
-					  UsageList[i - 1] = UsageList[i];
+						for (uint8_t i = 1; i < UsageListSize; i++)
+						  Tables->UsageList[i - 1] = Tables->UsageList[i];
+					}
 
 					UsageListSize--;
 				}
 				else if (UsageMinMax.Minimum <= UsageMinMax.Maximum)
 				{
-					CurrCollectionPath->Usage.Usage = UsageMinMax.Minimum++;
+					if (!(Measure))
+					  CurrCollectionPath->Usage.Usage = UsageMinMax.Minimum;
+
+					UsageMinMax.Minimum++;
 				}
 
 				break;
+			}
 
 			case HID_RI_END_COLLECTION(0):
-				if (CurrCollectionPath == NULL)
+				if (!(CollectionDepth))
 				  return HID_PARSE_UnexpectedEndCollection;
 
-				CurrCollectionPath = CurrCollectionPath->Parent;
+				CollectionDepth--;
+
+				if (!(Measure))
+				  CurrCollectionPath = CurrCollectionPath->Parent;
+
 				break;
 
 			case HID_RI_INPUT(0):
@@ -254,10 +396,13 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 
 					if (UsageListSize)
 					{
-						NewReportItem.Attributes.Usage.Usage = UsageList[0];
+						if (!(Measure))
+						{
+							NewReportItem.Attributes.Usage.Usage = Tables->UsageList[0];
 
-						for (uint8_t i = 1; i < UsageListSize; i++)
-						  UsageList[i - 1] = UsageList[i];
+							for (uint8_t i = 1; i < UsageListSize; i++)
+							  Tables->UsageList[i - 1] = Tables->UsageList[i];
+						}
 
 						UsageListSize--;
 					}
@@ -277,18 +422,31 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 
 					NewReportItem.BitOffset = CurrReportIDInfo->ReportSizeBits[NewReportItem.ItemType];
 
+					/* Report sizes are only tracked per report ID when not measuring the report */
+					if (!(Measure) && ((uint16_t)(NewReportItem.BitOffset + CurrStateTable->Attributes.BitSize) < NewReportItem.BitOffset))
+					  return HID_PARSE_MalformedReport;
+
 					CurrReportIDInfo->ReportSizeBits[NewReportItem.ItemType] += CurrStateTable->Attributes.BitSize;
 
 					ParserData->LargestReportSizeBits = MAX(ParserData->LargestReportSizeBits, CurrReportIDInfo->ReportSizeBits[NewReportItem.ItemType]);
 
-					if (ParserData->TotalReportItems == HID_MAX_REPORTITEMS)
+					/* Constant items are never stored; when measuring, all other items are counted as the filter is not run */
+					if (ReportItemData & HID_IOF_CONSTANT)
+					  continue;
+
+					if (!(Measure) && !(CALLBACK_HIDParser_FilterHIDReportItem(&NewReportItem)))
+					  continue;
+
+					if (ParserData->TotalReportItems == Tables->MaxReportItems)
 					  return HID_PARSE_InsufficientReportItems;
 
-					memcpy(&ParserData->ReportItems[ParserData->TotalReportItems],
-					       &NewReportItem, sizeof(HID_ReportItem_t));
+					if (!(Measure))
+					{
+						memcpy(&Tables->ReportItems[ParserData->TotalReportItems],
+						       &NewReportItem, sizeof(HID_ReportItem_t));
+					}
 
-					if (!(ReportItemData & HID_IOF_CONSTANT) && CALLBACK_HIDParser_FilterHIDReportItem(&NewReportItem))
-					  ParserData->TotalReportItems++;
+					ParserData->TotalReportItems++;
 				}
 
 				break;
@@ -305,12 +463,46 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 		}
 	}
 
+	if (Measure)
+	{
+		Tables->MaxReportItems = ParserData->TotalReportItems;
+		Tables->MaxCollections = TotalCollections;
+		Tables->MaxReportIDs   = ParserData->TotalDeviceReports;
+		Tables->MaxUsages      = MaxUsageListSize;
+
+		return HID_PARSE_Successful;
+	}
+
 	if (!(ParserData->TotalReportItems))
 	  return HID_PARSE_NoUnfilteredReportItems;
 
 	return HID_PARSE_Successful;
 }
 
+static bool HID_IsLogicalMinimumNegative(const HID_ReportItem_Attributes_t* const Attributes)
+{
+	/* The logical minimum is a signed value of the size of its descriptor item, and so must be sign extended from it */
+	if (Attributes->LogicalMinimumSize == 1)
+	  return ((int8_t)Attributes->Logical.Minimum < 0);
+	else if (Attributes->LogicalMinimumSize == 2)
+	  return ((int16_t)Attributes->Logical.Minimum < 0);
+	else
+	  return ((int32_t)Attributes->Logical.Minimum < 0);
+}
+
+static HID_ReportSizeInfo_t* HID_FindReportSizeInfo(HID_ReportInfo_t* const ParserData,
+                                                    HID_ParserTables_t* const Tables,
+                                                    const uint8_t ReportID)
+{
+	for (uint8_t i = 0; i < ParserData->TotalDeviceReports; i++)
+	{
+		if (Tables->ReportIDSizes[i].ReportID == ReportID)
+		  return &Tables->ReportIDSizes[i];
+	}
+
+	return NULL;
+}
+
 bool USB_GetHIDReportItemInfo(const uint8_t* ReportData,
                               HID_ReportItem_t* const ReportItem)
 {
@@ -376,7 +568,7 @@ uint16_t USB_GetHIDReportSize(HID_ReportInfo_t* const ParserData,
                               const uint8_t ReportID,
                               const uint8_t ReportType)
 {
-	for (uint8_t i = 0; i < HID_MAX_REPORT_IDS; i++)
+	for (uint8_t i = 0; i < ParserData->TotalDeviceReports; i++)
 	{
 		uint16_t ReportSizeBits = ParserData->ReportIDSizes[i].ReportSizeBits[ReportType];
 
@@ -387,3 +579,143 @@ uint16_t USB_GetHIDReportSize(HID_ReportInfo_t* const ParserData,
 	return 0;
 }
 
+uint8_t USB_CompileHIDReportPlan(const HID_ReportInfo_t* const ParserData,
+                                 const uint8_t ReportType,
+                                 HID_ExtractionPlan_t* const Plan)
+{
+	Plan->TotalFields = 0;
+	Plan->TotalGroups = 0;
+
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+	{
+		const HID_ReportItem_t* ReportItem = &ParserData->ReportItems[ItemIndex];
+
+		if ((ReportItem->ItemType != ReportType) || !(ReportItem->Attributes.BitSize))
+		  continue;
+
+		if (Plan->TotalFields == HID_MAX_REPORTITEMS)
+		  return HID_PARSE_InsufficientReportItems;
+
+		uint8_t BitSize = MIN(ReportItem->Attributes.BitSize, 32);
+		uint8_t Shift   = (ReportItem->BitOffset % 8);
+
+		/* Insert the new field after any existing fields with a lower or equal report ID, keeping the fields sorted by report
+		 * ID and (as the parsed items are already in report order) then by bit offset */
+		uint8_t FieldIndex = Plan->TotalFields;
+
+		while (FieldIndex && (ParserData->ReportItems[Plan->Fields[FieldIndex - 1].ItemIndex].ReportID > ReportItem->ReportID))
+		{
+			Plan->Fields[FieldIndex] = Plan->Fields[FieldIndex - 1];
+			FieldIndex--;
+		}
+
+		HID_ExtractionField_t* NewField = &Plan->Fields[FieldIndex];
+
+		NewField->ByteOffset = (ReportItem->BitOffset / 8);
+		NewField->Shift      = Shift;
+		NewField->ByteCount  = ((Shift + BitSize + 7) / 8);
+		NewField->Mask       = (BitSize == 32) ? 0xFFFFFFFF : (((uint32_t)1 << BitSize) - 1);
+		NewField->Flags      = HID_IsLogicalMinimumNegative(&ReportItem->Attributes) ? HID_FIELD_SIGNED : 0;
+		NewField->ItemIndex  = ItemIndex;
+
+		Plan->TotalFields++;
+	}
+
+	if (!(Plan->TotalFields))
+	  return HID_PARSE_NoUnfilteredReportItems;
+
+	for (uint8_t FieldIndex = 0; FieldIndex < Plan->TotalFields; FieldIndex++)
+	{
+		uint8_t ReportID = ParserData->ReportItems[Plan->Fields[FieldIndex].ItemIndex].ReportID;
+
+		if (!(Plan->TotalGroups) || (Plan->Groups[Plan->TotalGroups - 1].ReportID != ReportID))
+		{
+			if (Plan->TotalGroups == HID_MAX_REPORT_IDS)
+			  return HID_PARSE_InsufficientReportIDItems;
+
+			HID_ExtractionGroup_t* NewGroup = &Plan->Groups[Plan->TotalGroups++];
+
+			NewGroup->ReportID    = ReportID;
+			NewGroup->FirstField  = FieldIndex;
+			NewGroup->TotalFields = 0;
+		}
+
+		Plan->Groups[Plan->TotalGroups - 1].TotalFields++;
+	}
+
+	return HID_PARSE_Successful;
+}
+
+uint8_t USB_ExtractHIDReportFields(HID_ReportInfo_t* const ParserData,
+                                   const HID_ExtractionPlan_t* const Plan,
+                                   const uint8_t* ReportData)
+{
+	const HID_ExtractionGroup_t* Group = NULL;
+
+	if (ParserData->UsingReportIDs)
+	{
+		for (uint8_t i = 0; i < Plan->TotalGroups; i++)
+		{
+			if (Plan->Groups[i].ReportID == ReportData[0])
+			{
+				Group = &Plan->Groups[i];
+				break;
+			}
+		}
+
+		ReportData++;
+	}
+	else if (Plan->TotalGroups)
+	{
+		Group = &Plan->Groups[0];
+	}
+
+	if (Group == NULL)
+	  return 0;
+
+	const HID_ExtractionField_t* Field = &Plan->Fields[Group->FirstField];
+
+	for (uint8_t FieldsRem = Group->TotalFields; FieldsRem; FieldsRem--)
+	{
+		const uint8_t* FieldData = &ReportData[Field->ByteOffset];
+		uint32_t       Value;
+
+		/* Assemble only the bytes spanned by the field into a single word, so that the field is never read past the end
+		 * of the report and can be extracted with a single shift and mask */
+		switch (Field->ByteCount)
+		{
+			case 1:
+				Value = FieldData[0];
+				break;
+			case 2:
+				Value = (((uint16_t)FieldData[1] << 8) | FieldData[0]);
+				break;
+			case 3:
+				Value = (((uint32_t)FieldData[2] << 16) | ((uint16_t)FieldData[1] << 8) | FieldData[0]);
+				break;
+			default:
+				Value = (((uint32_t)FieldData[3] << 24) | ((uint32_t)FieldData[2] << 16) |
+				         ((uint16_t)FieldData[1] << 8)  | FieldData[0]);
+				break;
+		}
+
+		Value >>= Field->Shift;
+
+		if (Field->ByteCount > 4)
+		  Value |= ((uint32_t)FieldData[4] << (32 - Field->Shift));
+
+		Value &= Field->Mask;
+
+		if ((Field->Flags & HID_FIELD_SIGNED) && (Value & ~(Field->Mask >> 1)))
+		  Value |= ~Field->Mask;
+
+		HID_ReportItem_t* ReportItem = &ParserData->ReportItems[Field->ItemIndex];
+
+		ReportItem->PreviousValue = ReportItem->Value;
+		ReportItem->Value         = Value;
+
+		Field++;
+	}
+
+	return Group->TotalFields;
+}
@@ -60,6 +60,12 @@
  *  This module also contains routines for the processing of data in an actual HID report, using the parsed report
  *  descriptor data as a guide for the encoding.
  *
+ *  Where many reports must be processed, the parsed report items may additionally be compiled into a
+ *  \ref HID_ExtractionPlan_t via \ref USB_CompileHIDReportPlan(). The plan holds a compact, precomputed
+ *  description of each field in a report, grouped by report ID, so that \ref USB_ExtractHIDReportFields() can
+ *  update the values of all report items present in a received report in a single pass, rather than searching
+ *  for and extracting each item bit by bit via \ref USB_GetHIDReportItemInfo().
+ *
  *  @{
  */
 
@@ -130,6 +136,11 @@
 			#define HID_MAX_REPORT_IDS            10
 		#endif
 
+		/** Flag for \ref HID_ExtractionField_t::Flags, indicating that the field's value should be sign-extended
+		 *  to 32 bits once extracted, as the field's logical minimum is negative.
+		 */
+		#define HID_FIELD_SIGNED                  (1 << 0)
+
 		/** Returns the value a given HID report item (once its value has been fetched via \ref USB_GetHIDReportItemInfo())
 		 *  left-aligned to the given data type. This allows for signed data to be interpreted correctly, by shifting the data
 		 *  leftwards until the data's sign bit is in the correct position.
@@ -155,6 +166,8 @@
 				HID_PARSE_UsageListOverflow           = 6, /**< More than \ref HID_USAGE_STACK_DEPTH usages listed in a row. */
 				HID_PARSE_InsufficientReportIDItems   = 7, /**< More than \ref HID_MAX_REPORT_IDS report IDs in the device. */
 				HID_PARSE_NoUnfilteredReportItems     = 8, /**< All report items from the device were filtered by the filtering callback routine. */
+				HID_PARSE_InsufficientArena           = 9, /**< The parser arena is too small for the report, see \c HID_PARSER_USE_ARENA. */
+				HID_PARSE_MalformedReport             = 10, /**< An item is truncated, or a report exceeds 65535 bits. */
 			};
 
 		/* Type Defines: */
@@ -212,6 +225,8 @@
 				HID_Unit_t   Unit;     /**< Unit type and exponent of the report item. */
 				HID_MinMax_t Logical;  /**< Logical minimum and maximum of the report item. */
 				HID_MinMax_t Physical; /**< Physical minimum and maximum of the report item. */
+
+				uint8_t      LogicalMinimumSize; /**< Size in bytes of the logical minimum's data in the report descriptor. */
 			} HID_ReportItem_Attributes_t;
 
 			/** \brief HID Parser Report Item Details Structure.
@@ -249,28 +264,110 @@
 			/** \brief HID Parser State Structure.
 			 *
 			 *  Type define for a complete processed HID report, including all report item data and collections.
+			 *
+			 *  When the \c HID_PARSER_USE_ARENA compile time token is defined, the report item, collection and report size
+			 *  tables are not stored in the structure itself, but are instead allocated from a caller supplied memory arena
+			 *  and sized to the exact requirements of the processed HID report. The \c Arena and \c ArenaSize members must
+			 *  then be set before each call to \ref USB_ProcessHIDReport().
 			 */
 			typedef struct
 			{
 				uint8_t              TotalReportItems; /**< Total number of report items stored in the \c ReportItems array. */
+				#if defined(HID_PARSER_USE_ARENA) && !defined(__DOXYGEN__)
+				HID_ReportItem_t*     ReportItems;
+				HID_CollectionPath_t* CollectionPaths;
+				#else
 				HID_ReportItem_t     ReportItems[HID_MAX_REPORTITEMS]; /**< Report items array, including all IN, OUT
 			                                                            *   and FEATURE items.
 				                                                        */
 				HID_CollectionPath_t CollectionPaths[HID_MAX_COLLECTIONS]; /**< All collection items, referenced
 				                                                            *   by the report items.
 				                                                            */
+				#endif
 				uint8_t              TotalDeviceReports; /**< Number of reports within the HID interface */
+				#if defined(HID_PARSER_USE_ARENA) && !defined(__DOXYGEN__)
+				HID_ReportSizeInfo_t* ReportIDSizes;
+				#else
 				HID_ReportSizeInfo_t ReportIDSizes[HID_MAX_REPORT_IDS]; /**< Report sizes for each report in the interface */
+				#endif
 				uint16_t             LargestReportSizeBits; /**< Largest report that the attached device will generate, in bits */
 				bool                 UsingReportIDs; /**< Indicates if the device has at least one REPORT ID
 				                                      *   element in its HID report descriptor.
 				                                      */
+				#if defined(HID_PARSER_USE_ARENA) || defined(__DOXYGEN__)
+				void*                Arena; /**< Memory arena the parser tables are allocated from, set by the user application
+				                             *   before processing a report. The arena must be aligned as for a \ref HID_ReportItem_t
+				                             *   and must remain allocated for as long as the processed report is in use.
+				                             *
+				                             *   \note Only present when the \c HID_PARSER_USE_ARENA token is defined.
+				                             */
+				uint16_t             ArenaSize; /**< Size in bytes of the \c Arena buffer, set by the user application. This may
+				                                 *   be set to zero to only measure the arena size a report requires.
+				                                 *
+				                                 *   \note Only present when the \c HID_PARSER_USE_ARENA token is defined.
+				                                 */
+				uint16_t             ArenaRequired; /**< Exact number of arena bytes required to process the last report,
+				                                     *   set by \ref USB_ProcessHIDReport().
+				                                     *
+				                                     *   \note Only present when the \c HID_PARSER_USE_ARENA token is defined.
+				                                     */
+				#endif
 			} HID_ReportInfo_t;
 
+			/** \brief HID Parser Extraction Plan Field Structure.
+			 *
+			 *  Type define for a single precomputed field of a \ref HID_ExtractionPlan_t, describing where the field's
+			 *  data is located in the report (excluding any report ID prefix byte) and how it is to be extracted.
+			 */
+			typedef struct
+			{
+				uint16_t ByteOffset; /**< Offset of the first byte containing the field's data. */
+				uint8_t  Shift;      /**< Number of bits the field's data is shifted within its first byte. */
+				uint8_t  ByteCount;  /**< Total number of bytes spanned by the field's data. */
+				uint32_t Mask;       /**< Mask of the field's value bits, once shifted down. */
+				uint8_t  Flags;      /**< Mask of \c HID_FIELD_* flags for the field. */
+				uint8_t  ItemIndex;  /**< Index of the field's item within the \ref HID_ReportInfo_t ReportItems array. */
+			} HID_ExtractionField_t;
+
+			/** \brief HID Parser Extraction Plan Report Group Structure.
+			 *
+			 *  Type define for the group of fields of a \ref HID_ExtractionPlan_t belonging to a single report ID.
+			 */
+			typedef struct
+			{
+				uint8_t ReportID;    /**< Report ID of the group's fields, or 0x00 if the device has only one report. */
+				uint8_t FirstField;  /**< Index of the group's first field within the plan's Fields array. */
+				uint8_t TotalFields; /**< Total number of fields in the group. */
+			} HID_ExtractionGroup_t;
+
+			/** \brief HID Parser Extraction Plan Structure.
+			 *
+			 *  Type define for a compiled field extraction plan, built from a processed HID report via
+			 *  \ref USB_CompileHIDReportPlan(). Fields are sorted by report ID and then by their position in the report.
+			 */
+			typedef struct
+			{
+				uint8_t               TotalFields; /**< Total number of fields stored in the \c Fields array. */
+				HID_ExtractionField_t Fields[HID_MAX_REPORTITEMS]; /**< Precomputed fields, grouped by report ID. */
+				uint8_t               TotalGroups; /**< Total number of report groups stored in the \c Groups array. */
+				HID_ExtractionGroup_t Groups[HID_MAX_REPORT_IDS]; /**< Report groups, one per report ID containing fields. */
+			} HID_ExtractionPlan_t;
+
 		/* Function Prototypes: */
 			/** Function to process a given HID report returned from an attached device, and store it into a given
 			 *  \ref HID_ReportInfo_t structure.
 			 *
+			 *  When the \c HID_PARSER_USE_ARENA compile time token is defined, the report is first measured to determine the
+			 *  exact number of report items, collections, report IDs and stacked usages it contains, and the total arena size
+			 *  required is stored into the structure's \c ArenaRequired member. If the given arena is too small (or its size is
+			 *  zero) the function returns \ref HID_PARSE_InsufficientArena without invoking the filter callback, otherwise the
+			 *  tables are allocated from the arena and the report is processed into them. Applications may therefore call this
+			 *  function once with a zero \c ArenaSize to measure a report, allocate an arena of the reported size, and then call
+			 *  it again to process the report.
+			 *
+			 *  \note In arena mode, the arena size accounts for every non-constant report item, as the filter callback is only
+			 *        invoked when the report is actually processed.
+			 *
 			 *  \param[in]  ReportData  Buffer containing the device's HID report table.
 			 *  \param[in]  ReportSize  Size in bytes of the HID report table.
 			 *  \param[out] ParserData  Pointer to a \ref HID_ReportInfo_t instance for the parser output.
@@ -324,7 +421,43 @@
 			 */
 			uint16_t USB_GetHIDReportSize(HID_ReportInfo_t* const ParserData,
 			                              const uint8_t ReportID,
-			                              const uint8_t ReportType) ATTR_CONST ATTR_NON_NULL_PTR_ARG(1);
+			                              const uint8_t ReportType) ATTR_PURE ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Compiles the report items of a given type from a processed HID report into a field extraction plan, for later
+			 *  use with \ref USB_ExtractHIDReportFields(). The plan references the report items by their index, and thus must be
+			 *  recompiled if the given \ref HID_ReportInfo_t structure is reprocessed.
+			 *
+			 *  A field is marked as signed via the \ref HID_FIELD_SIGNED flag if its logical minimum is negative.
+			 *
+			 *  \note A plan holds at most \ref HID_MAX_REPORTITEMS fields, even when the parser tables are allocated from an
+			 *        arena via the \c HID_PARSER_USE_ARENA compile time token.
+			 *
+			 *  \param[in]  ParserData  Pointer to a \ref HID_ReportInfo_t instance containing the parser output.
+			 *  \param[in]  ReportType  Type of the report items to compile, a value from the \ref HID_ReportItemTypes_t enum.
+			 *  \param[out] Plan        Pointer to a \ref HID_ExtractionPlan_t instance for the compiled plan.
+			 *
+			 *  \return A value in the \ref HID_Parse_ErrorCodes_t enum.
+			 */
+			uint8_t USB_CompileHIDReportPlan(const HID_ReportInfo_t* const ParserData,
+			                                 const uint8_t ReportType,
+			                                 HID_ExtractionPlan_t* const Plan) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Extracts the values of all report items contained in the given HID report, using a plan previously compiled via
+			 *  \ref USB_CompileHIDReportPlan(). The value of each extracted item is stored into the \c Value member of its
+			 *  \ref HID_ReportItem_t structure, after its previous value is copied to the \c PreviousValue member, exactly as if
+			 *  \ref USB_GetHIDReportItemInfo() had been called on each item. Values of signed fields are sign-extended to 32 bits,
+			 *  which does not alter the result of \ref HID_ALIGN_DATA().
+			 *
+			 *  \param[in,out] ParserData  Pointer to the \ref HID_ReportInfo_t instance the plan was compiled from.
+			 *  \param[in]     Plan        Pointer to the compiled \ref HID_ExtractionPlan_t plan.
+			 *  \param[in]     ReportData  Buffer containing a report of the compiled type from an attached device.
+			 *
+			 *  \return Number of report items updated, zero if the report's ID is not contained in the plan.
+			 */
+			uint8_t USB_ExtractHIDReportFields(HID_ReportInfo_t* const ParserData,
+			                                   const HID_ExtractionPlan_t* const Plan,
+			                                   const uint8_t* ReportData) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2)
+			                                                              ATTR_NON_NULL_PTR_ARG(3);
 
 			/** Callback routine for the HID Report Parser. This callback <b>must</b> be implemented by the user code when
 			 *  the parser is used, to determine what report IN, OUT and FEATURE item's information is stored into the user
@@ -351,6 +484,31 @@
 				 uint8_t                     ReportCount;
 				 uint8_t                     ReportID;
 			} HID_StateTable_t;
+
+			typedef struct
+			{
+				HID_ReportItem_t*     ReportItems;
+				HID_CollectionPath_t* CollectionPaths;
+				HID_ReportSizeInfo_t* ReportIDSizes;
+				uint16_t*             UsageList;
+				uint8_t               MaxReportItems;
+				uint8_t               MaxCollections;
+				uint8_t               MaxReportIDs;
+				uint8_t               MaxUsages;
+			} HID_ParserTables_t;
+
+		/* Function Prototypes: */
+			#if defined(__INCLUDE_FROM_HIDPARSER_C)
+				static uint8_t HID_ParseReport(const uint8_t* ReportData,
+				                               uint16_t ReportSize,
+				                               HID_ReportInfo_t* const ParserData,
+				                               HID_ParserTables_t* const Tables,
+				                               const bool Measure);
+				static bool HID_IsLogicalMinimumNegative(const HID_ReportItem_Attributes_t* const Attributes) ATTR_PURE;
+				static HID_ReportSizeInfo_t* HID_FindReportSizeInfo(HID_ReportInfo_t* const ParserData,
+				                                                    HID_ParserTables_t* const Tables,
+				                                                    const uint8_t ReportID);
+			#endif
 	#endif
 
 	/* Disable C linkage for C++ Compilers: */
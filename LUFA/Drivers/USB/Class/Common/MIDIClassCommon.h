@@ -352,6 +352,62 @@
 			uint8_t  Data3; /**< Third byte of data in the MIDI event. */
 		} ATTR_PACKED MIDI_EventPacket_t;
 
+	/* Inline Functions: */
+		/** Adds the next byte of a MIDI System Exclusive (SysEx) byte stream to a partially built USB MIDI event packet,
+		 *  splitting the stream into \ref MIDI_COMMAND_SYSEX_START_3BYTE events of three bytes each, terminated by a
+		 *  \ref MIDI_COMMAND_SYSEX_END_1BYTE, \ref MIDI_COMMAND_SYSEX_END_2BYTE or \ref MIDI_COMMAND_SYSEX_END_3BYTE
+		 *  event once the end of the message (a \c 0xF7 byte) is reached. Unused data bytes of a terminating event are
+		 *  cleared to zero.
+		 *
+		 *  \param[in,out] Event         Pointer to the event packet being built.
+		 *  \param[in,out] EventBytes    Pointer to the number of stream bytes already stored in \c Event, which should be
+		 *                               zero when starting a new stream. This is reset to zero when an event is completed.
+		 *  \param[in]     VirtualCable  Index of the virtual MIDI cable the SysEx stream is sent through.
+		 *  \param[in]     DataByte      Next byte of the SysEx stream to add.
+		 *
+		 *  \return Boolean \c true if \c Event is now complete and ready to be sent, \c false otherwise.
+		 */
+		static inline bool MIDI_AddSysExByte(MIDI_EventPacket_t* const Event,
+		                                     uint8_t* const EventBytes,
+		                                     const uint8_t VirtualCable,
+		                                     const uint8_t DataByte) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+		static inline bool MIDI_AddSysExByte(MIDI_EventPacket_t* const Event,
+		                                     uint8_t* const EventBytes,
+		                                     const uint8_t VirtualCable,
+		                                     const uint8_t DataByte)
+		{
+			switch ((*EventBytes)++)
+			{
+				case 0:
+					Event->Data1 = DataByte;
+					Event->Data2 = 0;
+					Event->Data3 = 0;
+					break;
+				case 1:
+					Event->Data2 = DataByte;
+					break;
+				default:
+					Event->Data3 = DataByte;
+					break;
+			}
+
+			if (DataByte == 0xF7)
+			  Event->Event = MIDI_EVENT(VirtualCable, MIDI_COMMAND_SYSEX_END_1BYTE + ((*EventBytes - 1) << 4));
+			else if (*EventBytes == 3)
+			  Event->Event = MIDI_EVENT(VirtualCable, MIDI_COMMAND_SYSEX_START_3BYTE);
+			else
+			  return false;
+
+			*EventBytes = 0;
+			return true;
+		}
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define MIDI_SYSEX_STREAM_BATCH_EVENTS   16
+	#endif
+
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
 			}
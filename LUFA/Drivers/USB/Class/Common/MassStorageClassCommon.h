@@ -114,6 +114,9 @@
 		/** SCSI Command Code for a VERIFY (10) command. */
 		#define SCSI_CMD_VERIFY_10                             0x2F
 
+		/** SCSI Command Code for a SYNCHRONIZE CACHE (10) command. */
+		#define SCSI_CMD_SYNCHRONIZE_CACHE_10                  0x35
+
 		/** SCSI Command Code for a MODE SENSE (6) command. */
 		#define SCSI_CMD_MODE_SENSE_6                          0x1A
 
@@ -72,6 +72,10 @@ void Audio_Device_ProcessControlRequest(USB_ClassInfo_Audio_Device_t* const Audi
 				Endpoint_ClearStatusStage();
 
 				AudioInterfaceInfo->State.InterfaceEnabled = ((USB_ControlRequest.wValue & 0xFF) != 0);
+
+				Audio_Device_ResetFIFO(AudioInterfaceInfo->Config.OUTSampleFIFO);
+				Audio_Device_ResetFIFO(AudioInterfaceInfo->Config.INSampleFIFO);
+
 				EVENT_Audio_Device_StreamStartStop(AudioInterfaceInfo);
 			}
 
@@ -176,8 +180,12 @@ bool Audio_Device_ConfigureEndpoints(USB_ClassInfo_Audio_Device_t* const AudioIn
 {
 	memset(&AudioInterfaceInfo->State, 0x00, sizeof(AudioInterfaceInfo->State));
 
-	AudioInterfaceInfo->Config.DataINEndpoint.Type  = EP_TYPE_ISOCHRONOUS;
-	AudioInterfaceInfo->Config.DataOUTEndpoint.Type = EP_TYPE_ISOCHRONOUS;
+	Audio_Device_ResetFIFO(AudioInterfaceInfo->Config.OUTSampleFIFO);
+	Audio_Device_ResetFIFO(AudioInterfaceInfo->Config.INSampleFIFO);
+
+	AudioInterfaceInfo->Config.DataINEndpoint.Type     = EP_TYPE_ISOCHRONOUS;
+	AudioInterfaceInfo->Config.DataOUTEndpoint.Type    = EP_TYPE_ISOCHRONOUS;
+	AudioInterfaceInfo->Config.FeedbackINEndpoint.Type = EP_TYPE_ISOCHRONOUS;
 
 	if (!(Endpoint_ConfigureEndpointTable(&AudioInterfaceInfo->Config.DataINEndpoint, 1)))
 	  return false;
@@ -185,9 +193,168 @@ bool Audio_Device_ConfigureEndpoints(USB_ClassInfo_Audio_Device_t* const AudioIn
 	if (!(Endpoint_ConfigureEndpointTable(&AudioInterfaceInfo->Config.DataOUTEndpoint, 1)))
 	  return false;
 
+	if (!(Endpoint_ConfigureEndpointTable(&AudioInterfaceInfo->Config.FeedbackINEndpoint, 1)))
+	  return false;
+
 	return true;
 }
 
+void Audio_Device_USBTask(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+{
+	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(AudioInterfaceInfo->State.InterfaceEnabled))
+	  return;
+
+	if (AudioInterfaceInfo->Config.OUTSampleFIFO != NULL)
+	  Audio_Device_DrainOUTEndpoint(AudioInterfaceInfo);
+
+	if (AudioInterfaceInfo->Config.INSampleFIFO != NULL)
+	  Audio_Device_FillINEndpoint(AudioInterfaceInfo);
+
+	if (AudioInterfaceInfo->Config.FeedbackINEndpoint.Address)
+	{
+		Endpoint_SelectEndpoint(AudioInterfaceInfo->Config.FeedbackINEndpoint.Address);
+
+		if (Endpoint_IsINReady())
+		{
+			uint32_t FeedbackValue = Audio_Device_GetFeedbackValue(AudioInterfaceInfo);
+
+			Endpoint_Write_16_LE(FeedbackValue);
+			Endpoint_Write_8(FeedbackValue >> 16);
+			Endpoint_ClearIN();
+		}
+	}
+}
+
+static void Audio_Device_ResetFIFO(Audio_SampleFIFO_t* const FIFO)
+{
+	if (FIFO == NULL)
+	  return;
+
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	FIFO->In          = 0;
+	FIFO->Out         = 0;
+	FIFO->Primed      = false;
+	FIFO->FillAverage = ((uint32_t)(FIFO->Size / 2) << AUDIO_FEEDBACK_FILTER_SHIFT);
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+}
+
+static uint16_t Audio_Device_GetFIFOCount(Audio_SampleFIFO_t* const FIFO)
+{
+	uint16_t Count;
+
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	Count = (FIFO->In - FIFO->Out);
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+
+	return Count;
+}
+
+static void Audio_Device_DrainOUTEndpoint(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+{
+	Audio_SampleFIFO_t* FIFO = AudioInterfaceInfo->Config.OUTSampleFIFO;
+
+	Endpoint_SelectEndpoint(AudioInterfaceInfo->Config.DataOUTEndpoint.Address);
+
+	if (!(Endpoint_IsOUTReceived()))
+	  return;
+
+	uint16_t PacketLength = Endpoint_BytesInEndpoint();
+	uint16_t FIFOCount    = Audio_Device_GetFIFOCount(FIFO);
+
+	/* Low-pass filter the fill level at this fixed point of each frame for the rate feedback, as the instantaneous
+	 * fill level rises by a whole packet each time one is stored and falls as the application reads samples out */
+	FIFO->FillAverage += (FIFOCount - (FIFO->FillAverage >> AUDIO_FEEDBACK_FILTER_SHIFT));
+
+	if (PacketLength <= (FIFO->Size - FIFOCount))
+	{
+		uint16_t In          = FIFO->In;
+		uint16_t Offset      = (In & (FIFO->Size - 1));
+		uint16_t FirstLength = MIN(PacketLength, (FIFO->Size - Offset));
+
+		Endpoint_Read_Stream_LE(&FIFO->Buffer[Offset], FirstLength, NULL);
+
+		if (PacketLength > FirstLength)
+		  Endpoint_Read_Stream_LE(FIFO->Buffer, (PacketLength - FirstLength), NULL);
+
+		uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+		GlobalInterruptDisable();
+
+		FIFO->In = (In + PacketLength);
+
+		SetGlobalInterruptMask(CurrentGlobalInt);
+
+		if ((FIFOCount + PacketLength) >= (FIFO->Size / 2))
+		  FIFO->Primed = true;
+	}
+
+	Endpoint_ClearOUT();
+}
+
+static void Audio_Device_FillINEndpoint(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+{
+	Audio_SampleFIFO_t* FIFO = AudioInterfaceInfo->Config.INSampleFIFO;
+
+	Endpoint_SelectEndpoint(AudioInterfaceInfo->Config.DataINEndpoint.Address);
+
+	if (!(Endpoint_IsINReady()))
+	  return;
+
+	uint16_t PacketLength = MIN(Audio_Device_GetFIFOCount(FIFO), AudioInterfaceInfo->Config.DataINEndpoint.Size);
+	PacketLength -= (PacketLength % FIFO->SampleFrameSize);
+
+	if (!(PacketLength))
+	  return;
+
+	uint16_t Out         = FIFO->Out;
+	uint16_t Offset      = (Out & (FIFO->Size - 1));
+	uint16_t FirstLength = MIN(PacketLength, (FIFO->Size - Offset));
+
+	Endpoint_Write_Stream_LE(&FIFO->Buffer[Offset], FirstLength, NULL);
+
+	if (PacketLength > FirstLength)
+	  Endpoint_Write_Stream_LE(FIFO->Buffer, (PacketLength - FirstLength), NULL);
+
+	Endpoint_ClearIN();
+
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	FIFO->Out = (Out + PacketLength);
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+}
+
+static uint32_t Audio_Device_GetFeedbackValue(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+{
+	Audio_SampleFIFO_t* FIFO = AudioInterfaceInfo->Config.OUTSampleFIFO;
+
+	/* Nominal samples per 1ms USB frame, in 10.14 fixed point format */
+	uint32_t FeedbackValue = ((AudioInterfaceInfo->Config.SampleFrequency << AUDIO_FEEDBACK_FRACTION_BITS) / 1000);
+
+	if (FIFO != NULL)
+	{
+		/* Request more samples per frame while the filtered FIFO fill level is below half full, and fewer while it is above,
+		 * keeping the fractional sample frames of the filtered level */
+		int32_t FillError = ((((int32_t)(FIFO->Size / 2) << AUDIO_FEEDBACK_FILTER_SHIFT) - (int32_t)FIFO->FillAverage) /
+		                     FIFO->SampleFrameSize);
+
+		if (FillError > (AUDIO_FEEDBACK_MAX_FILL_ERROR << AUDIO_FEEDBACK_FILTER_SHIFT))
+		  FillError = (AUDIO_FEEDBACK_MAX_FILL_ERROR << AUDIO_FEEDBACK_FILTER_SHIFT);
+		else if (FillError < -(AUDIO_FEEDBACK_MAX_FILL_ERROR << AUDIO_FEEDBACK_FILTER_SHIFT))
+		  FillError = -(AUDIO_FEEDBACK_MAX_FILL_ERROR << AUDIO_FEEDBACK_FILTER_SHIFT);
+
+		FeedbackValue += (FillError * (1 << (AUDIO_FEEDBACK_FRACTION_BITS - AUDIO_FEEDBACK_GAIN_SHIFT - AUDIO_FEEDBACK_FILTER_SHIFT)));
+	}
+
+	return FeedbackValue;
+}
+
 void Audio_Device_Event_Stub(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
 {
 
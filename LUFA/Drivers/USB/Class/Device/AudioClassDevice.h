@@ -69,6 +69,35 @@
 
 	/* Public Interface - May be used in end-application: */
 		/* Type Defines: */
+			/** \brief Audio Class Device Mode Sample FIFO Structure.
+			 *
+			 *  Sample FIFO structure, used to buffer the audio samples of a streaming endpoint in RAM between the main program
+			 *  loop and the application's sample timer ISR. For the streaming OUT endpoint, \ref Audio_Device_USBTask() drains
+			 *  each received isochronous packet into the FIFO and the ISR reads samples from it; for the streaming IN endpoint,
+			 *  the ISR writes samples into the FIFO and \ref Audio_Device_USBTask() sends them to the host. The ISR thus never
+			 *  accesses the USB endpoints.
+			 *
+			 *  An instance of this structure should be made for each streaming endpoint that is to be buffered, and referenced
+			 *  from the \c OUTSampleFIFO or \c INSampleFIFO element of the Audio interface's configuration.
+			 */
+			typedef struct
+			{
+				uint8_t*          Buffer; /**< Pointer to the FIFO's sample storage buffer. */
+				uint16_t          Size; /**< Size of the FIFO's storage buffer in bytes, which must be a power of two. */
+				uint8_t           SampleFrameSize; /**< Size in bytes of a single sample frame (one sample of each audio channel)
+				                                    *   in the stream.
+				                                    */
+
+				volatile uint16_t In; /**< Total number of bytes stored into the FIFO, modulo 65536. Managed by the class driver. */
+				volatile uint16_t Out; /**< Total number of bytes removed from the FIFO, modulo 65536. Managed by the class driver. */
+				volatile bool     Primed; /**< Indicates if an OUT stream FIFO has been filled to half its size since it was last
+				                           *   emptied, and so may be read by the application. Managed by the class driver.
+				                           */
+				uint32_t          FillAverage; /**< Low-pass filtered fill level of an OUT stream FIFO in fixed point, sampled as each
+				                                *   packet is received from the host. Managed by the class driver.
+				                                */
+			} Audio_SampleFIFO_t;
+
 			/** \brief Audio Class Device Mode Configuration and State Structure.
 			 *
 			 *  Class state structure. An instance of this structure should be made for each Audio interface
@@ -88,6 +117,23 @@
 
 					USB_Endpoint_Table_t DataINEndpoint; /**< Data IN endpoint configuration table. */
 					USB_Endpoint_Table_t DataOUTEndpoint; /**< Data OUT endpoint configuration table. */
+					USB_Endpoint_Table_t FeedbackINEndpoint; /**< Asynchronous rate feedback IN endpoint configuration table for the
+					                                          *   data OUT endpoint, or an address of zero if the interface has no
+					                                          *   feedback endpoint.
+					                                          */
+
+					Audio_SampleFIFO_t*  OUTSampleFIFO; /**< Sample FIFO the data OUT endpoint's packets are drained into by
+					                                     *   \ref Audio_Device_USBTask(), or \c NULL if the OUT stream is not buffered.
+					                                     */
+					Audio_SampleFIFO_t*  INSampleFIFO; /**< Sample FIFO the data IN endpoint's packets are filled from by
+					                                    *   \ref Audio_Device_USBTask(), or \c NULL if the IN stream is not buffered.
+					                                    */
+
+					uint32_t SampleFrequency; /**< Nominal sampling frequency of the data OUT endpoint in Hz, used as the centre
+					                           *   value of the rate feedback sent to the host through \c FeedbackINEndpoint.
+					                           *   This may be updated by the application when the host selects a new sampling
+					                           *   frequency.
+					                           */
 				} Config; /**< Config data for the USB class interface within the device. All elements in this section
 				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
 				           */
@@ -119,6 +165,23 @@
 			 */
 			void Audio_Device_ProcessControlRequest(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
 
+			/** General management task for a given Audio class interface, required for the correct operation of the interface. This should
+			 *  be called frequently in the main program loop, before the master USB management task \ref USB_USBTask().
+			 *
+			 *  While the streaming interface is enabled, this drains each packet received on the data OUT endpoint into the interface's
+			 *  OUT sample FIFO and fills the data IN endpoint with the whole sample frames held in the interface's IN sample FIFO, if
+			 *  these FIFOs are set in the interface's configuration. If the interface has a feedback endpoint, the current rate feedback
+			 *  value is also sent to the host each time the feedback endpoint is ready; this is the nominal number of samples per USB
+			 *  frame given by the \c SampleFrequency configuration value, corrected according to how far the OUT sample FIFO's fill
+			 *  level is from half full. The fill level is sampled just before each received packet is stored, and low-pass filtered
+			 *  so that the feedback does not follow the packet-sized steps of the FIFO's fill level within each frame.
+			 *
+			 *  \note A received OUT packet which does not fit into the free space of the OUT sample FIFO is discarded.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 */
+			void Audio_Device_USBTask(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
 			/** Audio class driver callback for the setting and retrieval of streaming endpoint properties. This callback must be implemented
 			 *  in the user application to handle property manipulations on streaming audio endpoints.
 			 *
@@ -186,18 +249,6 @@
 			void EVENT_Audio_Device_StreamStartStop(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo);
 
 		/* Inline Functions: */
-			/** General management task for a given Audio class interface, required for the correct operation of the interface. This should
-			 *  be called frequently in the main program loop, before the master USB management task \ref USB_USBTask().
-			 *
-			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
-			 */
-			static inline void Audio_Device_USBTask(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
-			                                        ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
-			static inline void Audio_Device_USBTask(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
-			{
-				(void)AudioInterfaceInfo;
-			}
-
 			/** Determines if the given audio interface is ready for a sample to be read from it, and selects the streaming
 			 *  OUT endpoint ready for reading.
 			 *
@@ -373,10 +424,209 @@
 				  Endpoint_ClearIN();
 			}
 
+			/** Determines if the given audio interface's OUT sample FIFO holds a complete sample frame to be read. This does not
+			 *  access the USB endpoints, and so may be called from the application's sample timer ISR. Once the FIFO has been
+			 *  emptied, no further samples are reported until \ref Audio_Device_USBTask() has refilled it to half its size.
+			 *
+			 *  \pre The interface's configuration must reference an OUT sample FIFO.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 *
+			 *  \return Boolean \c true if the given Audio interface has a sample frame to be read, \c false otherwise.
+			 */
+			static inline bool Audio_Device_IsFIFOSampleReceived(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			                                                     ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
+			static inline bool Audio_Device_IsFIFOSampleReceived(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			{
+				Audio_SampleFIFO_t* FIFO = AudioInterfaceInfo->Config.OUTSampleFIFO;
+
+				if (!(FIFO->Primed))
+				  return false;
+
+				if ((uint16_t)(FIFO->In - FIFO->Out) < FIFO->SampleFrameSize)
+				{
+					FIFO->Primed = false;
+					return false;
+				}
+
+				return true;
+			}
+
+			/** Determines if the given audio interface's IN sample FIFO has space for the next sample frame to be written. This
+			 *  does not access the USB endpoints, and so may be called from the application's sample timer ISR.
+			 *
+			 *  \pre The interface's configuration must reference an IN sample FIFO.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 *
+			 *  \return Boolean \c true if the given Audio interface is ready to accept the next sample frame, \c false otherwise.
+			 */
+			static inline bool Audio_Device_IsReadyForNextFIFOSample(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			                                                         ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
+			static inline bool Audio_Device_IsReadyForNextFIFOSample(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			{
+				Audio_SampleFIFO_t* FIFO = AudioInterfaceInfo->Config.INSampleFIFO;
+
+				if ((USB_DeviceState != DEVICE_STATE_Configured) || !(AudioInterfaceInfo->State.InterfaceEnabled))
+				  return false;
+
+				return ((uint16_t)(FIFO->Size - (uint16_t)(FIFO->In - FIFO->Out)) >= FIFO->SampleFrameSize);
+			}
+
+			/** Reads the next 8-bit audio sample from the given audio interface's OUT sample FIFO.
+			 *
+			 *  \pre This should be preceded by a call to the \ref Audio_Device_IsFIFOSampleReceived() function to ensure that
+			 *       a sample frame is available in the FIFO.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 *
+			 *  \return  Signed 8-bit audio sample from the audio interface.
+			 */
+			static inline int8_t Audio_Device_ReadFIFOSample8(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			                                                  ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
+			static inline int8_t Audio_Device_ReadFIFOSample8(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			{
+				Audio_SampleFIFO_t* FIFO = AudioInterfaceInfo->Config.OUTSampleFIFO;
+				uint16_t            Out  = FIFO->Out;
+				int8_t              Sample;
+
+				Sample = FIFO->Buffer[Out++ & (FIFO->Size - 1)];
+
+				FIFO->Out = Out;
+				return Sample;
+			}
+
+			/** Reads the next 16-bit audio sample from the given audio interface's OUT sample FIFO.
+			 *
+			 *  \pre This should be preceded by a call to the \ref Audio_Device_IsFIFOSampleReceived() function to ensure that
+			 *       a sample frame is available in the FIFO.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 *
+			 *  \return  Signed 16-bit audio sample from the audio interface.
+			 */
+			static inline int16_t Audio_Device_ReadFIFOSample16(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			                                                    ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
+			static inline int16_t Audio_Device_ReadFIFOSample16(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			{
+				Audio_SampleFIFO_t* FIFO = AudioInterfaceInfo->Config.OUTSampleFIFO;
+				uint16_t            Out  = FIFO->Out;
+				uint16_t            Sample;
+
+				Sample  = FIFO->Buffer[Out++ & (FIFO->Size - 1)];
+				Sample |= ((uint16_t)FIFO->Buffer[Out++ & (FIFO->Size - 1)] << 8);
+
+				FIFO->Out = Out;
+				return (int16_t)Sample;
+			}
+
+			/** Reads the next 24-bit audio sample from the given audio interface's OUT sample FIFO.
+			 *
+			 *  \pre This should be preceded by a call to the \ref Audio_Device_IsFIFOSampleReceived() function to ensure that
+			 *       a sample frame is available in the FIFO.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 *
+			 *  \return Signed 24-bit audio sample from the audio interface.
+			 */
+			static inline int32_t Audio_Device_ReadFIFOSample24(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			                                                    ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
+			static inline int32_t Audio_Device_ReadFIFOSample24(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			{
+				Audio_SampleFIFO_t* FIFO = AudioInterfaceInfo->Config.OUTSampleFIFO;
+				uint16_t            Out  = FIFO->Out;
+				uint32_t            Sample;
+
+				Sample  = FIFO->Buffer[Out++ & (FIFO->Size - 1)];
+				Sample |= ((uint32_t)FIFO->Buffer[Out++ & (FIFO->Size - 1)] << 8);
+				Sample |= ((uint32_t)FIFO->Buffer[Out++ & (FIFO->Size - 1)] << 16);
+
+				FIFO->Out = Out;
+				return (int32_t)Sample;
+			}
+
+			/** Writes the next 8-bit audio sample to the given audio interface's IN sample FIFO.
+			 *
+			 *  \pre This should be preceded by a call to the \ref Audio_Device_IsReadyForNextFIFOSample() function to ensure
+			 *       that the FIFO has space for the next sample frame.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 *  \param[in]     Sample              Signed 8-bit audio sample.
+			 */
+			static inline void Audio_Device_WriteFIFOSample8(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                                 const int8_t Sample) ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
+			static inline void Audio_Device_WriteFIFOSample8(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                                 const int8_t Sample)
+			{
+				Audio_SampleFIFO_t* FIFO = AudioInterfaceInfo->Config.INSampleFIFO;
+				uint16_t            In   = FIFO->In;
+
+				FIFO->Buffer[In++ & (FIFO->Size - 1)] = Sample;
+
+				FIFO->In = In;
+			}
+
+			/** Writes the next 16-bit audio sample to the given audio interface's IN sample FIFO.
+			 *
+			 *  \pre This should be preceded by a call to the \ref Audio_Device_IsReadyForNextFIFOSample() function to ensure
+			 *       that the FIFO has space for the next sample frame.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 *  \param[in]     Sample              Signed 16-bit audio sample.
+			 */
+			static inline void Audio_Device_WriteFIFOSample16(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                                  const int16_t Sample) ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
+			static inline void Audio_Device_WriteFIFOSample16(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                                  const int16_t Sample)
+			{
+				Audio_SampleFIFO_t* FIFO = AudioInterfaceInfo->Config.INSampleFIFO;
+				uint16_t            In   = FIFO->In;
+
+				FIFO->Buffer[In++ & (FIFO->Size - 1)] = Sample;
+				FIFO->Buffer[In++ & (FIFO->Size - 1)] = (Sample >> 8);
+
+				FIFO->In = In;
+			}
+
+			/** Writes the next 24-bit audio sample to the given audio interface's IN sample FIFO.
+			 *
+			 *  \pre This should be preceded by a call to the \ref Audio_Device_IsReadyForNextFIFOSample() function to ensure
+			 *       that the FIFO has space for the next sample frame.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 *  \param[in]     Sample              Signed 24-bit audio sample.
+			 */
+			static inline void Audio_Device_WriteFIFOSample24(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                                  const int32_t Sample) ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
+			static inline void Audio_Device_WriteFIFOSample24(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                                  const int32_t Sample)
+			{
+				Audio_SampleFIFO_t* FIFO = AudioInterfaceInfo->Config.INSampleFIFO;
+				uint16_t            In   = FIFO->In;
+
+				FIFO->Buffer[In++ & (FIFO->Size - 1)] = Sample;
+				FIFO->Buffer[In++ & (FIFO->Size - 1)] = (Sample >> 8);
+				FIFO->Buffer[In++ & (FIFO->Size - 1)] = (Sample >> 16);
+
+				FIFO->In = In;
+			}
+
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define AUDIO_FEEDBACK_FRACTION_BITS     14
+			#define AUDIO_FEEDBACK_GAIN_SHIFT        6
+			#define AUDIO_FEEDBACK_MAX_FILL_ERROR    (1 << AUDIO_FEEDBACK_GAIN_SHIFT)
+			#define AUDIO_FEEDBACK_FILTER_SHIFT      3
+
 		/* Function Prototypes: */
 			#if defined(__INCLUDE_FROM_AUDIO_DEVICE_C)
+				static void Audio_Device_ResetFIFO(Audio_SampleFIFO_t* const FIFO);
+				static uint16_t Audio_Device_GetFIFOCount(Audio_SampleFIFO_t* const FIFO) ATTR_NON_NULL_PTR_ARG(1);
+				static void Audio_Device_DrainOUTEndpoint(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+				static void Audio_Device_FillINEndpoint(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+				static uint32_t Audio_Device_GetFeedbackValue(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
 				void Audio_Device_Event_Stub(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo);
 
 				void EVENT_Audio_Device_StreamStartStop(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
@@ -284,6 +284,58 @@ int16_t CDC_Device_ReceiveByte(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInf
 	return ReceivedByte;
 }
 
+uint16_t CDC_Device_SendSpan(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo,
+                            const void* const Buffer,
+                            const uint16_t Length)
+{
+	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
+	  return 0;
+
+	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataINEndpoint.Address);
+
+	if (!(Endpoint_IsINReady()))
+	  return 0;
+
+	/* A full bank is left for CDC_Device_Flush() to send with its terminating ZLP, unless more data follows it */
+	if (!(Endpoint_IsReadWriteAllowed()))
+	{
+		Endpoint_ClearIN();
+
+		if (!(Endpoint_IsINReady()))
+		  return 0;
+	}
+
+	uint16_t BytesToSend = MIN(Length, (CDCInterfaceInfo->Config.DataINEndpoint.Size - Endpoint_BytesInEndpoint()));
+
+	if (Endpoint_Write_Stream_LE(Buffer, BytesToSend, NULL) != ENDPOINT_RWSTREAM_NoError)
+	  return 0;
+
+	return BytesToSend;
+}
+
+uint16_t CDC_Device_ReceiveSpan(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo,
+                                void* const Buffer,
+                                const uint16_t Length)
+{
+	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
+	  return 0;
+
+	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataOUTEndpoint.Address);
+
+	if (!(Endpoint_IsOUTReceived()))
+	  return 0;
+
+	uint16_t BytesToReceive = MIN(Length, Endpoint_BytesInEndpoint());
+
+	if (Endpoint_Read_Stream_LE(Buffer, BytesToReceive, NULL) != ENDPOINT_RWSTREAM_NoError)
+	  return 0;
+
+	if (!(Endpoint_BytesInEndpoint()))
+	  Endpoint_ClearOUT();
+
+	return BytesToReceive;
+}
+
 void CDC_Device_SendControlLineStateChange(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
 {
 	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
@@ -302,6 +302,45 @@
 			 */
 			int16_t CDC_Device_ReceiveByte(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
 
+			/** Sends as much of the given contiguous block of data to the attached USB host as will fit into the free space of the
+			 *  current IN endpoint bank, without waiting for the host. The data is copied directly into the endpoint bank. A full bank is
+			 *  sent to the host once more data is sent after it, otherwise it is sent on the next call to \ref CDC_Device_Flush() along
+			 *  with the zero length packet terminating the transfer; partially filled banks are sent on the next call to
+			 *  \ref CDC_Device_Flush().
+			 *  This allows an application to drain a buffer (such as a span retrieved via \ref RingBuffer_GetReadSpan()) straight into the
+			 *  endpoint, dequeuing only the number of bytes actually accepted.
+			 *
+			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or
+			 *       the call will fail.
+			 *
+			 *  \param[in,out] CDCInterfaceInfo  Pointer to a structure containing a CDC Class configuration and state.
+			 *  \param[in]     Buffer            Pointer to a buffer containing the data to send to the device.
+			 *  \param[in]     Length            Length of the data to send to the host.
+			 *
+			 *  \return Number of bytes written into the endpoint bank, zero if the endpoint is busy or the host is not connected.
+			 */
+			uint16_t CDC_Device_SendSpan(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo,
+			                             const void* const Buffer,
+			                             const uint16_t Length) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Reads as much received data from the host into the given contiguous buffer as is available in the current OUT endpoint
+			 *  bank, up to the given length, without waiting for the host. The data is copied directly out of the endpoint bank, and
+			 *  the bank is released back to the USB controller once it has been completely read. This allows an application to fill a
+			 *  buffer (such as a span retrieved via \ref RingBuffer_GetWriteSpan()) straight from the endpoint.
+			 *
+			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or
+			 *       the call will fail.
+			 *
+			 *  \param[in,out] CDCInterfaceInfo  Pointer to a structure containing a CDC Class configuration and state.
+			 *  \param[out]    Buffer            Pointer to a buffer where the received data is to be stored.
+			 *  \param[in]     Length            Maximum number of bytes to read into the buffer.
+			 *
+			 *  \return Number of bytes read from the endpoint bank, zero if no data was received or the host is not connected.
+			 */
+			uint16_t CDC_Device_ReceiveSpan(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo,
+			                                void* const Buffer,
+			                                const uint16_t Length) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
 			/** Flushes any data waiting to be sent, ensuring that the send buffer is cleared.
 			 *
 			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or
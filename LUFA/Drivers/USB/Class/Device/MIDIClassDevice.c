@@ -85,6 +85,61 @@ uint8_t MIDI_Device_SendEventPacket(USB_ClassInfo_MIDI_Device_t* const MIDIInter
 	return ENDPOINT_RWSTREAM_NoError;
 }
 
+uint8_t MIDI_Device_SendEventPackets(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
+                                     const MIDI_EventPacket_t* const Events,
+                                     const uint16_t TotalEvents)
+{
+	if (USB_DeviceState != DEVICE_STATE_Configured)
+	  return ENDPOINT_RWSTREAM_DeviceDisconnected;
+
+	uint8_t ErrorCode;
+
+	Endpoint_SelectEndpoint(MIDIInterfaceInfo->Config.DataINEndpoint.Address);
+
+	if ((ErrorCode = Endpoint_Write_Stream_LE(Events, (TotalEvents * sizeof(MIDI_EventPacket_t)), NULL)) != ENDPOINT_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	if (!(Endpoint_IsReadWriteAllowed()))
+	  Endpoint_ClearIN();
+
+	return ENDPOINT_RWSTREAM_NoError;
+}
+
+uint8_t MIDI_Device_SendSysExStream(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
+                                    const uint8_t VirtualCable,
+                                    const void* const Buffer,
+                                    uint16_t Length)
+{
+	const uint8_t*     DataStream  = (const uint8_t*)Buffer;
+	MIDI_EventPacket_t Events[MIDI_SYSEX_STREAM_BATCH_EVENTS];
+	uint8_t            TotalEvents = 0;
+	uint8_t            ErrorCode;
+
+	while (Length--)
+	{
+		if (!(MIDI_AddSysExByte(&MIDIInterfaceInfo->State.SysExEvent, &MIDIInterfaceInfo->State.SysExEventBytes,
+		                        VirtualCable, *(DataStream++))))
+		{
+			continue;
+		}
+
+		Events[TotalEvents++] = MIDIInterfaceInfo->State.SysExEvent;
+
+		if (TotalEvents == MIDI_SYSEX_STREAM_BATCH_EVENTS)
+		{
+			if ((ErrorCode = MIDI_Device_SendEventPackets(MIDIInterfaceInfo, Events, TotalEvents)) != ENDPOINT_RWSTREAM_NoError)
+			  return ErrorCode;
+
+			TotalEvents = 0;
+		}
+	}
+
+	if (TotalEvents)
+	  return MIDI_Device_SendEventPackets(MIDIInterfaceInfo, Events, TotalEvents);
+
+	return ENDPOINT_RWSTREAM_NoError;
+}
+
 uint8_t MIDI_Device_Flush(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo)
 {
 	if (USB_DeviceState != DEVICE_STATE_Configured)
@@ -127,5 +182,28 @@ bool MIDI_Device_ReceiveEventPacket(USB_ClassInfo_MIDI_Device_t* const MIDIInter
 	return true;
 }
 
+uint16_t MIDI_Device_ReceiveEventPackets(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
+                                         MIDI_EventPacket_t* const Events,
+                                         const uint16_t MaxEvents)
+{
+	if (USB_DeviceState != DEVICE_STATE_Configured)
+	  return 0;
+
+	Endpoint_SelectEndpoint(MIDIInterfaceInfo->Config.DataOUTEndpoint.Address);
+
+	if (!(Endpoint_IsOUTReceived()))
+	  return 0;
+
+	uint16_t TotalEvents = MIN(MaxEvents, (Endpoint_BytesInEndpoint() / sizeof(MIDI_EventPacket_t)));
+
+	if (TotalEvents)
+	  Endpoint_Read_Stream_LE(Events, (TotalEvents * sizeof(MIDI_EventPacket_t)), NULL);
+
+	if (Endpoint_BytesInEndpoint() < sizeof(MIDI_EventPacket_t))
+	  Endpoint_ClearOUT();
+
+	return TotalEvents;
+}
+
 #endif
 
@@ -92,27 +92,41 @@ void MS_Device_USBTask(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
 	if (USB_DeviceState != DEVICE_STATE_Configured)
 	  return;
 
-	Endpoint_SelectEndpoint(MSInterfaceInfo->Config.DataOUTEndpoint.Address);
-
-	if (Endpoint_IsOUTReceived())
+	switch (MSInterfaceInfo->State.TaskState)
 	{
-		if (MS_Device_ReadInCommandBlock(MSInterfaceInfo))
-		{
-			if (MSInterfaceInfo->State.CommandBlock.Flags & MS_COMMAND_DIR_DATA_IN)
-			  Endpoint_SelectEndpoint(MSInterfaceInfo->Config.DataINEndpoint.Address);
+		case MS_DEVICE_TASK_ReadCommandBlock:
+			Endpoint_SelectEndpoint(MSInterfaceInfo->Config.DataOUTEndpoint.Address);
+
+			if (Endpoint_IsOUTReceived() && MS_Device_ReadInCommandBlock(MSInterfaceInfo))
+			{
+				MSInterfaceInfo->State.IsDataPhasePending = false;
+				MSInterfaceInfo->State.DataBytesProcessed = 0;
 
-			bool SCSICommandResult = CALLBACK_MS_Device_SCSICommandReceived(MSInterfaceInfo);
+				MS_Device_ProcessCommand(MSInterfaceInfo);
+			}
+
+			break;
+		case MS_DEVICE_TASK_DataPhase:
+			if (MSInterfaceInfo->State.CommandBlock.Flags & MS_COMMAND_DIR_DATA_IN)
+			{
+				Endpoint_SelectEndpoint(MSInterfaceInfo->Config.DataINEndpoint.Address);
 
-			MSInterfaceInfo->State.CommandStatus.Status              = (SCSICommandResult) ? MS_SCSI_COMMAND_Pass : MS_SCSI_COMMAND_Fail;
-			MSInterfaceInfo->State.CommandStatus.Signature           = CPU_TO_LE32(MS_CSW_SIGNATURE);
-			MSInterfaceInfo->State.CommandStatus.Tag                 = MSInterfaceInfo->State.CommandBlock.Tag;
-			MSInterfaceInfo->State.CommandStatus.DataTransferResidue = MSInterfaceInfo->State.CommandBlock.DataTransferLength;
+				if (!(Endpoint_IsINReady()))
+				  break;
+			}
+			else
+			{
+				Endpoint_SelectEndpoint(MSInterfaceInfo->Config.DataOUTEndpoint.Address);
 
-			if (!(SCSICommandResult) && (le32_to_cpu(MSInterfaceInfo->State.CommandStatus.DataTransferResidue)))
-			  Endpoint_StallTransaction();
+				if (!(Endpoint_IsOUTReceived()))
+				  break;
+			}
 
+			MS_Device_ProcessCommand(MSInterfaceInfo);
+			break;
+		case MS_DEVICE_TASK_SendCommandStatus:
 			MS_Device_ReturnCommandStatus(MSInterfaceInfo);
-		}
+			break;
 	}
 
 	if (MSInterfaceInfo->State.IsMassStoreReset)
@@ -127,10 +141,41 @@ void MS_Device_USBTask(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
 		Endpoint_ClearStall();
 		Endpoint_ResetDataToggle();
 
-		MSInterfaceInfo->State.IsMassStoreReset = false;
+		MSInterfaceInfo->State.IsMassStoreReset   = false;
+		MSInterfaceInfo->State.IsDataPhasePending = false;
+		MSInterfaceInfo->State.TaskState          = MS_DEVICE_TASK_ReadCommandBlock;
 	}
 }
 
+static void MS_Device_ProcessCommand(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
+{
+	if (MSInterfaceInfo->State.CommandBlock.Flags & MS_COMMAND_DIR_DATA_IN)
+	  Endpoint_SelectEndpoint(MSInterfaceInfo->Config.DataINEndpoint.Address);
+	else
+	  Endpoint_SelectEndpoint(MSInterfaceInfo->Config.DataOUTEndpoint.Address);
+
+	bool SCSICommandResult = CALLBACK_MS_Device_SCSICommandReceived(MSInterfaceInfo);
+
+	if (MSInterfaceInfo->State.IsDataPhasePending)
+	{
+		MSInterfaceInfo->State.TaskState = MS_DEVICE_TASK_DataPhase;
+		return;
+	}
+
+	MSInterfaceInfo->State.CommandStatus.Status              = (SCSICommandResult) ? MS_SCSI_COMMAND_Pass : MS_SCSI_COMMAND_Fail;
+	MSInterfaceInfo->State.CommandStatus.Signature           = CPU_TO_LE32(MS_CSW_SIGNATURE);
+	MSInterfaceInfo->State.CommandStatus.Tag                 = MSInterfaceInfo->State.CommandBlock.Tag;
+	MSInterfaceInfo->State.CommandStatus.DataTransferResidue = MSInterfaceInfo->State.CommandBlock.DataTransferLength;
+
+	if (!(SCSICommandResult) && (le32_to_cpu(MSInterfaceInfo->State.CommandStatus.DataTransferResidue)))
+	  Endpoint_StallTransaction();
+
+	MSInterfaceInfo->State.TaskState            = MS_DEVICE_TASK_SendCommandStatus;
+	MSInterfaceInfo->State.StatusBytesProcessed = 0;
+
+	MS_Device_ReturnCommandStatus(MSInterfaceInfo);
+}
+
 static bool MS_Device_ReadInCommandBlock(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
 {
 	uint16_t BytesProcessed;
@@ -177,38 +222,23 @@ static void MS_Device_ReturnCommandStatus(USB_ClassInfo_MS_Device_t* const MSInt
 {
 	Endpoint_SelectEndpoint(MSInterfaceInfo->Config.DataOUTEndpoint.Address);
 
-	while (Endpoint_IsStalled())
-	{
-		#if !defined(INTERRUPT_CONTROL_ENDPOINT)
-		USB_USBTask();
-		#endif
-
-		if (MSInterfaceInfo->State.IsMassStoreReset)
-		  return;
-	}
+	if (Endpoint_IsStalled())
+	  return;
 
 	Endpoint_SelectEndpoint(MSInterfaceInfo->Config.DataINEndpoint.Address);
 
-	while (Endpoint_IsStalled())
-	{
-		#if !defined(INTERRUPT_CONTROL_ENDPOINT)
-		USB_USBTask();
-		#endif
-
-		if (MSInterfaceInfo->State.IsMassStoreReset)
-		  return;
-	}
+	if (Endpoint_IsStalled() || !(Endpoint_IsINReady()))
+	  return;
 
-	uint16_t BytesProcessed = 0;
-	while (Endpoint_Write_Stream_LE(&MSInterfaceInfo->State.CommandStatus,
-	                                sizeof(MS_CommandStatusWrapper_t), &BytesProcessed) ==
-	                                ENDPOINT_RWSTREAM_IncompleteTransfer)
+	if (Endpoint_Write_Stream_LE(&MSInterfaceInfo->State.CommandStatus, sizeof(MS_CommandStatusWrapper_t),
+	                             &MSInterfaceInfo->State.StatusBytesProcessed) == ENDPOINT_RWSTREAM_IncompleteTransfer)
 	{
-		if (MSInterfaceInfo->State.IsMassStoreReset)
-		  return;
+		return;
 	}
 
 	Endpoint_ClearIN();
+
+	MSInterfaceInfo->State.TaskState = MS_DEVICE_TASK_ReadCommandBlock;
 }
 
 #endif
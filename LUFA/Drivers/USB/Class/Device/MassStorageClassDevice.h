@@ -47,6 +47,14 @@
  *  \section Sec_USBClassMSDevice_ModDescription Module Description
  *  Device Mode USB Class driver framework interface, for the Mass Storage USB Class driver.
  *
+ *  By default the data phase of each received SCSI command is processed entirely within the
+ *  \ref CALLBACK_MS_Device_SCSICommandReceived() callback. Applications with large transfers, such as composite devices
+ *  which must continue to service their other interfaces, may instead process the data phase incrementally by setting
+ *  the \c IsDataPhasePending flag of the interface state from within the callback and returning once the data endpoint
+ *  would block, typically after a resumable stream function has returned \ref ENDPOINT_RWSTREAM_IncompleteTransfer. The
+ *  callback is then called again from \ref MS_Device_USBTask() each time the data endpoint is ready, until the flag is
+ *  cleared. The command status is likewise sent without blocking once the host has cleared any stalled endpoints.
+ *
  *  @{
  */
 
@@ -99,6 +107,17 @@
 					volatile bool IsMassStoreReset; /**< Flag indicating that the host has requested that the Mass Storage interface be reset
 											         *   and that all current Mass Storage operations should immediately abort.
 											         */
+					bool IsDataPhasePending; /**< Flag which may be set by the \ref CALLBACK_MS_Device_SCSICommandReceived() callback to
+					                          *   indicate that the data phase of the current command has not yet completed. While set,
+					                          *   the callback is called again for the same command each time the command's data endpoint
+					                          *   is ready, until it clears the flag and returns the command's final result.
+					                          */
+					uint32_t DataBytesProcessed; /**< Number of bytes of the current command's data phase processed so far, for use with
+					                              *   the resumable \c BytesProcessed parameter of the stream functions. This is reset to
+					                              *   zero for each new command.
+					                              */
+					uint8_t  TaskState; /**< Current command processing state of the interface, for internal use only. */
+					uint16_t StatusBytesProcessed; /**< Number of bytes of the command status sent so far, for internal use only. */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 				          *   are reset to their defaults when the interface is enumerated.
 				          */
@@ -134,6 +153,9 @@
 			 *  for the processing of the received SCSI command from the host. The SCSI command is available in the CommandBlock structure
 			 *  inside the Mass Storage class state structure passed as a parameter to the callback function.
 			 *
+			 *  If the callback sets the \c IsDataPhasePending flag of the class state structure, its return value is ignored and it
+			 *  will be called again for the same command once the data endpoint is ready, until the flag is cleared.
+			 *
 			 *  \param[in,out] MSInterfaceInfo  Pointer to a structure containing a Mass Storage Class configuration and state.
 			 *
 			 *  \return Boolean \c true if the SCSI command was successfully processed, \c false otherwise.
@@ -142,8 +164,17 @@
 
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
+		/* Enums: */
+			enum MS_Device_TaskStates_t
+			{
+				MS_DEVICE_TASK_ReadCommandBlock  = 0,
+				MS_DEVICE_TASK_DataPhase         = 1,
+				MS_DEVICE_TASK_SendCommandStatus = 2,
+			};
+
 		/* Function Prototypes: */
 			#if defined(__INCLUDE_FROM_MASSSTORAGE_DEVICE_C)
+				static void MS_Device_ProcessCommand(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
 				static void MS_Device_ReturnCommandStatus(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
 				static bool MS_Device_ReadInCommandBlock(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
 			#endif
@@ -161,6 +161,13 @@ void RNDIS_Device_USBTask(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo
 
 		RNDISInterfaceInfo->State.ResponseReady = false;
 	}
+
+	#if !defined(NO_CLASS_DRIVER_AUTOFLUSH)
+	Endpoint_SelectEndpoint(RNDISInterfaceInfo->Config.DataINEndpoint.Address);
+
+	if (Endpoint_IsINReady())
+	  RNDIS_Device_Flush(RNDISInterfaceInfo);
+	#endif
 }
 
 void RNDIS_Device_ProcessRNDISControlMessage(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
@@ -180,6 +187,11 @@ void RNDIS_Device_ProcessRNDISControlMessage(USB_ClassInfo_RNDIS_Device_t* const
 			RNDIS_Initialize_Complete_t* INITIALIZE_Response =
 			               (RNDIS_Initialize_Complete_t*)RNDISInterfaceInfo->Config.MessageBuffer;
 
+			RNDISInterfaceInfo->State.HostMaxTransferSize = le32_to_cpu(INITIALIZE_Message->MaxTransferSize);
+			RNDISInterfaceInfo->State.PendingTransferSize = 0;
+			RNDISInterfaceInfo->State.PacketBytesRemaining = 0;
+			RNDISInterfaceInfo->State.PacketPaddingLength  = 0;
+
 			INITIALIZE_Response->MessageType            = CPU_TO_LE32(REMOTE_NDIS_INITIALIZE_CMPLT);
 			INITIALIZE_Response->MessageLength          = CPU_TO_LE32(sizeof(RNDIS_Initialize_Complete_t));
 			INITIALIZE_Response->RequestId              = INITIALIZE_Message->RequestId;
@@ -189,9 +201,9 @@ void RNDIS_Device_ProcessRNDISControlMessage(USB_ClassInfo_RNDIS_Device_t* const
 			INITIALIZE_Response->MinorVersion           = CPU_TO_LE32(REMOTE_NDIS_VERSION_MINOR);
 			INITIALIZE_Response->DeviceFlags            = CPU_TO_LE32(REMOTE_NDIS_DF_CONNECTIONLESS);
 			INITIALIZE_Response->Medium                 = CPU_TO_LE32(REMOTE_NDIS_MEDIUM_802_3);
-			INITIALIZE_Response->MaxPacketsPerTransfer  = CPU_TO_LE32(1);
-			INITIALIZE_Response->MaxTransferSize        = CPU_TO_LE32(sizeof(RNDIS_Packet_Message_t) + ETHERNET_FRAME_SIZE_MAX);
-			INITIALIZE_Response->PacketAlignmentFactor  = CPU_TO_LE32(0);
+			INITIALIZE_Response->MaxPacketsPerTransfer  = CPU_TO_LE32(RNDIS_DEVICE_MAX_PACKETS_PER_TRANSFER);
+			INITIALIZE_Response->MaxTransferSize        = CPU_TO_LE32(RNDIS_DEVICE_MAX_PACKETS_PER_TRANSFER * RNDIS_DEVICE_MAX_MESSAGE_LENGTH);
+			INITIALIZE_Response->PacketAlignmentFactor  = CPU_TO_LE32(RNDIS_DEVICE_PACKET_ALIGNMENT_FACTOR);
 			INITIALIZE_Response->AFListOffset           = CPU_TO_LE32(0);
 			INITIALIZE_Response->AFListSize             = CPU_TO_LE32(0);
 
@@ -440,68 +452,264 @@ uint8_t RNDIS_Device_ReadPacket(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfa
                                 void* Buffer,
                                 uint16_t* const PacketLength)
 {
+	uint8_t ErrorCode;
+
+	if ((ErrorCode = RNDIS_Device_ReadPacketHeader(RNDISInterfaceInfo, PacketLength)) != ENDPOINT_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	if (*PacketLength > ETHERNET_FRAME_SIZE_MAX)
+	{
+		*PacketLength = 0;
+		RNDIS_Device_DiscardPacketData(RNDISInterfaceInfo);
+
+		return RNDIS_ERROR_LOGICAL_CMD_FAILED;
+	}
+
+	return RNDIS_Device_ReadPacketData(RNDISInterfaceInfo, Buffer, *PacketLength);
+}
+
+uint8_t RNDIS_Device_ReadPacketHeader(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
+                                      uint16_t* const PacketLength)
+{
+	uint8_t ErrorCode;
+
 	if ((USB_DeviceState != DEVICE_STATE_Configured) ||
 	    (RNDISInterfaceInfo->State.CurrRNDISState != RNDIS_Data_Initialized))
 	{
 		return ENDPOINT_RWSTREAM_DeviceDisconnected;
 	}
 
-	Endpoint_SelectEndpoint(RNDISInterfaceInfo->Config.DataOUTEndpoint.Address);
-
 	*PacketLength = 0;
 
+	/* Skip over the remainder of the previous packet if it was not completely read */
+	if ((ErrorCode = RNDIS_Device_DiscardPacketData(RNDISInterfaceInfo)) != ENDPOINT_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	Endpoint_SelectEndpoint(RNDISInterfaceInfo->Config.DataOUTEndpoint.Address);
+
 	if (!(Endpoint_IsOUTReceived()))
 		return ENDPOINT_RWSTREAM_NoError;
 
+	/* Discard a zero length packet or alignment padding at the end of a multiple packet transfer, as each message
+	   within a transfer is aligned so that a message header never starts in the last few bytes of a full bank */
+	if (Endpoint_BytesInEndpoint() < (1 << RNDIS_DEVICE_PACKET_ALIGNMENT_FACTOR))
+	{
+		Endpoint_ClearOUT();
+		return ENDPOINT_RWSTREAM_NoError;
+	}
+
 	RNDIS_Packet_Message_t RNDISPacketHeader;
-	Endpoint_Read_Stream_LE(&RNDISPacketHeader, sizeof(RNDIS_Packet_Message_t), NULL);
 
-	if (le32_to_cpu(RNDISPacketHeader.DataLength) > ETHERNET_FRAME_SIZE_MAX)
+	if ((ErrorCode = Endpoint_Read_Stream_LE(&RNDISPacketHeader, sizeof(RNDIS_Packet_Message_t),
+	                                         NULL)) != ENDPOINT_RWSTREAM_NoError)
+	{
+		return ErrorCode;
+	}
+
+	uint32_t MessageLength = le32_to_cpu(RNDISPacketHeader.MessageLength);
+	uint32_t DataOffset    = (le32_to_cpu(RNDISPacketHeader.DataOffset) + sizeof(RNDIS_Message_Header_t));
+	uint32_t DataLength    = le32_to_cpu(RNDISPacketHeader.DataLength);
+
+	if ((DataLength > UINT16_MAX) || (DataOffset < sizeof(RNDIS_Packet_Message_t)) ||
+	    ((DataOffset + DataLength) > MessageLength))
 	{
 		Endpoint_StallTransaction();
 
 		return RNDIS_ERROR_LOGICAL_CMD_FAILED;
 	}
 
-	*PacketLength = (uint16_t)le32_to_cpu(RNDISPacketHeader.DataLength);
+	if (DataOffset > sizeof(RNDIS_Packet_Message_t))
+	  Endpoint_Discard_Stream(DataOffset - sizeof(RNDIS_Packet_Message_t), NULL);
+
+	*PacketLength = (uint16_t)DataLength;
 
-	Endpoint_Read_Stream_LE(Buffer, *PacketLength, NULL);
-	Endpoint_ClearOUT();
+	RNDISInterfaceInfo->State.PacketBytesRemaining = (uint16_t)DataLength;
+	RNDISInterfaceInfo->State.PacketPaddingLength  = (MessageLength - (DataOffset + DataLength));
+
+	if (!(DataLength))
+	  RNDIS_Device_CompletePacket(RNDISInterfaceInfo);
+
+	return ENDPOINT_RWSTREAM_NoError;
+}
+
+uint8_t RNDIS_Device_ReadPacketData(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
+                                    void* Buffer,
+                                    uint16_t Length)
+{
+	uint8_t ErrorCode;
+
+	if ((USB_DeviceState != DEVICE_STATE_Configured) ||
+	    (RNDISInterfaceInfo->State.CurrRNDISState != RNDIS_Data_Initialized))
+	{
+		return ENDPOINT_RWSTREAM_DeviceDisconnected;
+	}
+
+	Length = MIN(Length, RNDISInterfaceInfo->State.PacketBytesRemaining);
+
+	if (!(Length))
+	  return ENDPOINT_RWSTREAM_NoError;
+
+	Endpoint_SelectEndpoint(RNDISInterfaceInfo->Config.DataOUTEndpoint.Address);
+
+	if ((ErrorCode = Endpoint_Read_Stream_LE(Buffer, Length, NULL)) != ENDPOINT_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	RNDISInterfaceInfo->State.PacketBytesRemaining -= Length;
+
+	if (!(RNDISInterfaceInfo->State.PacketBytesRemaining))
+	  RNDIS_Device_CompletePacket(RNDISInterfaceInfo);
 
 	return ENDPOINT_RWSTREAM_NoError;
 }
 
+uint8_t RNDIS_Device_DiscardPacketData(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+{
+	uint8_t ErrorCode;
+
+	if ((USB_DeviceState != DEVICE_STATE_Configured) ||
+	    (RNDISInterfaceInfo->State.CurrRNDISState != RNDIS_Data_Initialized))
+	{
+		return ENDPOINT_RWSTREAM_DeviceDisconnected;
+	}
+
+	if (!(RNDISInterfaceInfo->State.PacketBytesRemaining))
+	  return ENDPOINT_RWSTREAM_NoError;
+
+	Endpoint_SelectEndpoint(RNDISInterfaceInfo->Config.DataOUTEndpoint.Address);
+
+	if ((ErrorCode = Endpoint_Discard_Stream(RNDISInterfaceInfo->State.PacketBytesRemaining, NULL)) != ENDPOINT_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	RNDISInterfaceInfo->State.PacketBytesRemaining = 0;
+	RNDIS_Device_CompletePacket(RNDISInterfaceInfo);
+
+	return ENDPOINT_RWSTREAM_NoError;
+}
+
+static void RNDIS_Device_CompletePacket(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+{
+	if (RNDISInterfaceInfo->State.PacketPaddingLength)
+	  Endpoint_Discard_Stream(RNDISInterfaceInfo->State.PacketPaddingLength, NULL);
+
+	RNDISInterfaceInfo->State.PacketPaddingLength = 0;
+
+	/* Only release the endpoint bank once all the messages within it have been read */
+	if (!(Endpoint_BytesInEndpoint()))
+	  Endpoint_ClearOUT();
+}
+
 uint8_t RNDIS_Device_SendPacket(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
                                 void* Buffer,
                                 const uint16_t PacketLength)
 {
 	uint8_t ErrorCode;
 
+	RNDIS_Packet_Message_t RNDISPacketHeader;
+
+	if ((ErrorCode = RNDIS_Device_BeginPacketMessage(RNDISInterfaceInfo, &RNDISPacketHeader,
+	                                                 PacketLength)) != ENDPOINT_RWSTREAM_NoError)
+	{
+		return ErrorCode;
+	}
+
+	Endpoint_Write_Stream_LE(&RNDISPacketHeader, sizeof(RNDIS_Packet_Message_t), NULL);
+	Endpoint_Write_Stream_LE(Buffer, PacketLength, NULL);
+
+	#if (RNDIS_DEVICE_MAX_PACKETS_PER_TRANSFER == 1)
+	return RNDIS_Device_Flush(RNDISInterfaceInfo);
+	#else
+	return ENDPOINT_RWSTREAM_NoError;
+	#endif
+}
+
+uint8_t RNDIS_Device_SendPacketMessage(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
+                                       RNDIS_Packet_Message_t* const Message,
+                                       const uint16_t PacketLength)
+{
+	uint8_t ErrorCode;
+
+	if ((ErrorCode = RNDIS_Device_BeginPacketMessage(RNDISInterfaceInfo, Message,
+	                                                 PacketLength)) != ENDPOINT_RWSTREAM_NoError)
+	{
+		return ErrorCode;
+	}
+
+	Endpoint_Write_Stream_LE(Message, (sizeof(RNDIS_Packet_Message_t) + PacketLength), NULL);
+
+	#if (RNDIS_DEVICE_MAX_PACKETS_PER_TRANSFER == 1)
+	return RNDIS_Device_Flush(RNDISInterfaceInfo);
+	#else
+	return ENDPOINT_RWSTREAM_NoError;
+	#endif
+}
+
+static uint8_t RNDIS_Device_BeginPacketMessage(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
+                                               RNDIS_Packet_Message_t* const Message,
+                                               const uint16_t PacketLength)
+{
+	uint8_t  ErrorCode;
+	uint32_t MessageLength = (sizeof(RNDIS_Packet_Message_t) + PacketLength);
+
 	if ((USB_DeviceState != DEVICE_STATE_Configured) ||
 	    (RNDISInterfaceInfo->State.CurrRNDISState != RNDIS_Data_Initialized))
 	{
 		return ENDPOINT_RWSTREAM_DeviceDisconnected;
 	}
 
+	/* End the current transfer first if the host cannot receive this packet as part of it */
+	if ((RNDISInterfaceInfo->State.PendingTransferSize + MessageLength) > RNDISInterfaceInfo->State.HostMaxTransferSize)
+	{
+		if ((ErrorCode = RNDIS_Device_Flush(RNDISInterfaceInfo)) != ENDPOINT_READYWAIT_NoError)
+		  return ErrorCode;
+	}
+
 	Endpoint_SelectEndpoint(RNDISInterfaceInfo->Config.DataINEndpoint.Address);
 
 	if ((ErrorCode = Endpoint_WaitUntilReady()) != ENDPOINT_READYWAIT_NoError)
 	  return ErrorCode;
 
-	RNDIS_Packet_Message_t RNDISPacketHeader;
+	memset(Message, 0, sizeof(RNDIS_Packet_Message_t));
 
-	memset(&RNDISPacketHeader, 0, sizeof(RNDIS_Packet_Message_t));
+	Message->MessageType   = CPU_TO_LE32(REMOTE_NDIS_PACKET_MSG);
+	Message->MessageLength = cpu_to_le32(MessageLength);
+	Message->DataOffset    = CPU_TO_LE32(sizeof(RNDIS_Packet_Message_t) - sizeof(RNDIS_Message_Header_t));
+	Message->DataLength    = cpu_to_le32(PacketLength);
 
-	RNDISPacketHeader.MessageType   = CPU_TO_LE32(REMOTE_NDIS_PACKET_MSG);
-	RNDISPacketHeader.MessageLength = cpu_to_le32(sizeof(RNDIS_Packet_Message_t) + PacketLength);
-	RNDISPacketHeader.DataOffset    = CPU_TO_LE32(sizeof(RNDIS_Packet_Message_t) - sizeof(RNDIS_Message_Header_t));
-	RNDISPacketHeader.DataLength    = cpu_to_le32(PacketLength);
+	RNDISInterfaceInfo->State.PendingTransferSize += MessageLength;
+
+	return ENDPOINT_RWSTREAM_NoError;
+}
+
+uint8_t RNDIS_Device_Flush(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+{
+	if ((USB_DeviceState != DEVICE_STATE_Configured) ||
+	    (RNDISInterfaceInfo->State.CurrRNDISState != RNDIS_Data_Initialized))
+	{
+		return ENDPOINT_RWSTREAM_DeviceDisconnected;
+	}
+
+	uint8_t ErrorCode;
+
+	Endpoint_SelectEndpoint(RNDISInterfaceInfo->Config.DataINEndpoint.Address);
+
+	if (!(RNDISInterfaceInfo->State.PendingTransferSize))
+	  return ENDPOINT_READYWAIT_NoError;
+
+	RNDISInterfaceInfo->State.PendingTransferSize = 0;
+
+	bool BankFull = !(Endpoint_IsReadWriteAllowed());
 
-	Endpoint_Write_Stream_LE(&RNDISPacketHeader, sizeof(RNDIS_Packet_Message_t), NULL);
-	Endpoint_Write_Stream_LE(Buffer, PacketLength, NULL);
 	Endpoint_ClearIN();
 
-	return ENDPOINT_RWSTREAM_NoError;
+	if (BankFull)
+	{
+		if ((ErrorCode = Endpoint_WaitUntilReady()) != ENDPOINT_READYWAIT_NoError)
+		  return ErrorCode;
+
+		Endpoint_ClearIN();
+	}
+
+	return ENDPOINT_READYWAIT_NoError;
 }
 
 #endif
@@ -68,6 +68,17 @@
 		#endif
 
 	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			#if !defined(RNDIS_DEVICE_MAX_PACKETS_PER_TRANSFER) || defined(__DOXYGEN__)
+				/** Maximum number of RNDIS packet messages the host may combine into a single transfer to the device. Batching
+				 *  several small frames (such as TCP acknowledgements) into one transfer reduces the per-packet transfer overhead
+				 *  on the bus. By default this is set to 8 packets, but this can be overridden by defining
+				 *  \c RNDIS_DEVICE_MAX_PACKETS_PER_TRANSFER to another value in the user project makefile, passing the define
+				 *  to the compiler using the -D compiler switch. A value of 1 restores single packet transfers.
+				 */
+				#define RNDIS_DEVICE_MAX_PACKETS_PER_TRANSFER  8
+			#endif
+
 		/* Type Defines: */
 			/** \brief RNDIS Class Device Mode Configuration and State Structure.
 			 *
@@ -99,6 +110,16 @@
 					bool     ResponseReady; /**< Internal flag indicating if a RNDIS message is waiting to be returned to the host. */
 					uint8_t  CurrRNDISState; /**< Current RNDIS state of the adapter, a value from the \ref RNDIS_States_t enum. */
 					uint32_t CurrPacketFilter; /**< Current packet filter mode, used internally by the class driver. */
+					uint32_t HostMaxTransferSize; /**< Maximum size in bytes of a single transfer the host can receive, as given
+					                               *   by the host when the adapter is initialized.
+					                               */
+					uint32_t PendingTransferSize; /**< Size in bytes of the packet messages written to the data IN endpoint which
+					                               *   have not yet been flushed to the host as a complete transfer.
+					                               */
+					uint16_t PacketBytesRemaining; /**< Number of bytes of the current received packet's data which have not yet
+					                                *   been read or discarded by the application.
+					                                */
+					uint32_t PacketPaddingLength; /**< Number of padding bytes following the current received packet's data. */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 				          *   are reset to their defaults when the interface is enumerated.
 				          */
@@ -141,7 +162,9 @@
 			bool RNDIS_Device_IsPacketReceived(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
 
 			/** Retrieves the next pending packet from the device, discarding the remainder of the RNDIS packet header to leave
-			 *  only the packet contents for processing by the device in the nominated buffer.
+			 *  only the packet contents for processing by the device in the nominated buffer. Packets larger than
+			 *  \ref ETHERNET_FRAME_SIZE_MAX bytes are discarded; use \ref RNDIS_Device_ReadPacketHeader() to receive packets
+			 *  incrementally into a buffer of another size.
 			 *
 			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or the
 			 *       call will fail.
@@ -156,7 +179,59 @@
 											void* Buffer,
 											uint16_t* const PacketLength) ATTR_NON_NULL_PTR_ARG(1);
 
-			/** Sends the given packet to the attached RNDIS device, after adding a RNDIS packet message header.
+			/** Reads the RNDIS packet message header of the next pending packet, leaving the packet contents in the data OUT
+			 *  endpoint to be read in by the application in one or more parts via \ref RNDIS_Device_ReadPacketData(). This allows
+			 *  the headers at the start of a packet to be examined as soon as they are received, so that packets which are not of
+			 *  interest to the application can be skipped via \ref RNDIS_Device_DiscardPacketData() without being copied into
+			 *  a buffer. Any unread data of the previous packet is discarded.
+			 *
+			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] RNDISInterfaceInfo  Pointer to a structure containing an RNDIS Class configuration and state.
+			 *  \param[out]    PacketLength        Pointer to where the length in bytes of the packet is to be stored, zero if no packet
+			 *                                     was received.
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t RNDIS_Device_ReadPacketHeader(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
+			                                      uint16_t* const PacketLength) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Reads the next part of the contents of the packet whose header was read via \ref RNDIS_Device_ReadPacketHeader().
+			 *  Once the last byte of the packet has been read, the packet is completed and the next packet may be read.
+			 *
+			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] RNDISInterfaceInfo  Pointer to a structure containing an RNDIS Class configuration and state.
+			 *  \param[out]    Buffer              Pointer to a buffer where the packet data is to be written to.
+			 *  \param[in]     Length              Number of bytes to read, limited to the number of unread bytes in the packet.
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t RNDIS_Device_ReadPacketData(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
+			                                    void* Buffer,
+			                                    uint16_t Length) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Discards the unread remainder of the packet whose header was read via \ref RNDIS_Device_ReadPacketHeader(),
+			 *  without copying it out of the data OUT endpoint.
+			 *
+			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] RNDISInterfaceInfo  Pointer to a structure containing an RNDIS Class configuration and state.
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t RNDIS_Device_DiscardPacketData(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Sends the given packet to the attached RNDIS host, after adding a RNDIS packet message header. Packets are
+			 *  queued in the data IN endpoint bank and combined into a single transfer, which is only completed when the
+			 *  host's maximum transfer size would be exceeded, or the \ref RNDIS_Device_Flush() function is called to
+			 *  flush the pending packets to the host. This allows several small frames to be sent in one transfer. If
+			 *  the \c NO_CLASS_DRIVER_AUTOFLUSH compile time token is not defined, pending packets are automatically
+			 *  flushed each time \ref RNDIS_Device_USBTask() is called. If \c RNDIS_DEVICE_MAX_PACKETS_PER_TRANSFER is
+			 *  set to 1, each packet is instead sent to the host immediately, as in previous releases.
 			 *
 			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or the
 			 *       call will fail.
@@ -171,10 +246,43 @@
 											void* Buffer,
 											const uint16_t PacketLength) ATTR_NON_NULL_PTR_ARG(1);
 
+			/** Sends the given packet to the attached RNDIS host, in the same manner as \ref RNDIS_Device_SendPacket(). The packet
+			 *  must be stored immediately after space for a \ref RNDIS_Packet_Message_t header, which is filled in place so that the
+			 *  complete packet message can be written to the data IN endpoint as a single contiguous stream. This avoids a separate
+			 *  header copy when the application reserves space for the header in front of its packet buffer.
+			 *
+			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] RNDISInterfaceInfo  Pointer to a structure containing an RNDIS Class configuration and state.
+			 *  \param[in,out] Message             Pointer to the packet message header space, immediately followed by the packet data.
+			 *  \param[in]     PacketLength        Length in bytes of the packet to send, excluding the packet message header.
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t RNDIS_Device_SendPacketMessage(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
+			                                       RNDIS_Packet_Message_t* const Message,
+			                                       const uint16_t PacketLength) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Flushes any packets waiting to be sent, completing the current transfer to the host.
+			 *
+			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or
+			 *       the call will fail.
+			 *
+			 *  \param[in,out] RNDISInterfaceInfo  Pointer to a structure containing an RNDIS Class configuration and state.
+			 *
+			 *  \return A value from the \ref Endpoint_WaitUntilReady_ErrorCodes_t enum.
+			 */
+			uint8_t RNDIS_Device_Flush(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
 		/* Macros: */
 			#define RNDIS_DEVICE_MIN_MESSAGE_BUFFER_LENGTH  sizeof(AdapterSupportedOIDList) + sizeof(RNDIS_Query_Complete_t)
+			#define RNDIS_DEVICE_PACKET_ALIGNMENT_FACTOR    2
+			#define RNDIS_DEVICE_MAX_MESSAGE_LENGTH         ((sizeof(RNDIS_Packet_Message_t) + ETHERNET_FRAME_SIZE_MAX + \
+			                                                 (1 << RNDIS_DEVICE_PACKET_ALIGNMENT_FACTOR) - 1) & \
+			                                                 ~((1 << RNDIS_DEVICE_PACKET_ALIGNMENT_FACTOR) - 1))
 
 		/* Function Prototypes: */
 		#if defined(__INCLUDE_FROM_RNDIS_DEVICE_C)
@@ -192,6 +300,11 @@
 			                                        const void* SetData,
                                                     const uint16_t SetSize) ATTR_NON_NULL_PTR_ARG(1)
 			                                        ATTR_NON_NULL_PTR_ARG(3);
+			static void RNDIS_Device_CompletePacket(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+			static uint8_t RNDIS_Device_BeginPacketMessage(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
+			                                               RNDIS_Packet_Message_t* const Message,
+			                                               const uint16_t PacketLength) ATTR_NON_NULL_PTR_ARG(1)
+			                                               ATTR_NON_NULL_PTR_ARG(2);
 		#endif
 
 	#endif
@@ -199,6 +199,67 @@ uint8_t MIDI_Host_SendEventPacket(USB_ClassInfo_MIDI_Host_t* const MIDIInterface
 	return PIPE_RWSTREAM_NoError;
 }
 
+uint8_t MIDI_Host_SendEventPackets(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo,
+                                   const MIDI_EventPacket_t* const Events,
+                                   const uint16_t TotalEvents)
+{
+	if ((USB_HostState != HOST_STATE_Configured) || !(MIDIInterfaceInfo->State.IsActive))
+	  return PIPE_RWSTREAM_DeviceDisconnected;
+
+	uint8_t ErrorCode;
+
+	Pipe_SelectPipe(MIDIInterfaceInfo->Config.DataOUTPipe.Address);
+	Pipe_Unfreeze();
+
+	if ((ErrorCode = Pipe_Write_Stream_LE(Events, (TotalEvents * sizeof(MIDI_EventPacket_t)), NULL)) != PIPE_RWSTREAM_NoError)
+	{
+		Pipe_Freeze();
+		return ErrorCode;
+	}
+
+	if (!(Pipe_IsReadWriteAllowed()))
+	  Pipe_ClearOUT();
+
+	Pipe_Freeze();
+
+	return PIPE_RWSTREAM_NoError;
+}
+
+uint8_t MIDI_Host_SendSysExStream(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo,
+                                  const uint8_t VirtualCable,
+                                  const void* const Buffer,
+                                  uint16_t Length)
+{
+	const uint8_t*     DataStream  = (const uint8_t*)Buffer;
+	MIDI_EventPacket_t Events[MIDI_SYSEX_STREAM_BATCH_EVENTS];
+	uint8_t            TotalEvents = 0;
+	uint8_t            ErrorCode;
+
+	while (Length--)
+	{
+		if (!(MIDI_AddSysExByte(&MIDIInterfaceInfo->State.SysExEvent, &MIDIInterfaceInfo->State.SysExEventBytes,
+		                        VirtualCable, *(DataStream++))))
+		{
+			continue;
+		}
+
+		Events[TotalEvents++] = MIDIInterfaceInfo->State.SysExEvent;
+
+		if (TotalEvents == MIDI_SYSEX_STREAM_BATCH_EVENTS)
+		{
+			if ((ErrorCode = MIDI_Host_SendEventPackets(MIDIInterfaceInfo, Events, TotalEvents)) != PIPE_RWSTREAM_NoError)
+			  return ErrorCode;
+
+			TotalEvents = 0;
+		}
+	}
+
+	if (TotalEvents)
+	  return MIDI_Host_SendEventPackets(MIDIInterfaceInfo, Events, TotalEvents);
+
+	return PIPE_RWSTREAM_NoError;
+}
+
 bool MIDI_Host_ReceiveEventPacket(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo,
                                   MIDI_EventPacket_t* const Event)
 {
@@ -227,5 +288,33 @@ bool MIDI_Host_ReceiveEventPacket(USB_ClassInfo_MIDI_Host_t* const MIDIInterface
 	return DataReady;
 }
 
+uint16_t MIDI_Host_ReceiveEventPackets(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo,
+                                       MIDI_EventPacket_t* const Events,
+                                       const uint16_t MaxEvents)
+{
+	if ((USB_HostState != HOST_STATE_Configured) || !(MIDIInterfaceInfo->State.IsActive))
+	  return 0;
+
+	uint16_t TotalEvents = 0;
+
+	Pipe_SelectPipe(MIDIInterfaceInfo->Config.DataINPipe.Address);
+	Pipe_Unfreeze();
+
+	if (Pipe_IsINReceived())
+	{
+		TotalEvents = MIN(MaxEvents, (Pipe_BytesInPipe() / sizeof(MIDI_EventPacket_t)));
+
+		if (TotalEvents)
+		  Pipe_Read_Stream_LE(Events, (TotalEvents * sizeof(MIDI_EventPacket_t)), NULL);
+
+		if (Pipe_BytesInPipe() < sizeof(MIDI_EventPacket_t))
+		  Pipe_ClearIN();
+	}
+
+	Pipe_Freeze();
+
+	return TotalEvents;
+}
+
 #endif
 
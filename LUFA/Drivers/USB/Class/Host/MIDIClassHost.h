@@ -91,6 +91,9 @@
 					                    *   Configured state.
 					                    */
 					uint8_t  InterfaceNumber; /**< Interface index of the MIDI interface within the attached device. */
+
+					MIDI_EventPacket_t SysExEvent; /**< Partially built SysEx event held over between calls to \ref MIDI_Host_SendSysExStream(). */
+					uint8_t            SysExEventBytes; /**< Number of SysEx stream bytes currently stored in \c SysExEvent. */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 						  *   <b>may</b> be set to initial values, but may also be ignored to default to sane values when
 						  *   the interface is enumerated.
@@ -144,6 +147,47 @@
 			uint8_t MIDI_Host_SendEventPacket(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo,
 			                                  MIDI_EventPacket_t* const Event) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 
+			/** Sends an array of MIDI event packets to the device in a single pipe stream transfer, rather than one event at a
+			 *  time as with \ref MIDI_Host_SendEventPacket(). Events are queued into the pipe bank until either the pipe bank is
+			 *  full or \ref MIDI_Host_Flush() is called, with each full pipe bank being sent to the device as it is filled.
+			 *
+			 *  \pre This function must only be called when the Host state machine is in the \ref HOST_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] MIDIInterfaceInfo  Pointer to a structure containing a MIDI Class configuration and state.
+			 *  \param[in]     Events             Pointer to an array of populated \ref MIDI_EventPacket_t structures to send.
+			 *  \param[in]     TotalEvents        Number of events in the \c Events array.
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t MIDI_Host_SendEventPackets(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo,
+			                                   const MIDI_EventPacket_t* const Events,
+			                                   const uint16_t TotalEvents) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Sends a stream of MIDI System Exclusive (SysEx) bytes to the device, split into SysEx event packets via
+			 *  \ref MIDI_AddSysExByte(). The stream may be given in one call or split across several calls of any length,
+			 *  with a partial trailing event being held in the interface state until the next call; the final event is sent once
+			 *  the terminating \c 0xF7 byte of the message is given. Events are sent in batches via
+			 *  \ref MIDI_Host_SendEventPackets().
+			 *
+			 *  \note Only one SysEx stream may be in progress on a MIDI interface at any one time.
+			 *
+			 *  \pre This function must only be called when the Host state machine is in the \ref HOST_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] MIDIInterfaceInfo  Pointer to a structure containing a MIDI Class configuration and state.
+			 *  \param[in]     VirtualCable       Index of the virtual MIDI cable the SysEx stream is to be sent through.
+			 *  \param[in]     Buffer             Pointer to the SysEx stream bytes to send, including the leading \c 0xF0 and
+			 *                                    trailing \c 0xF7 bytes of the message.
+			 *  \param[in]     Length             Number of stream bytes to send from \c Buffer.
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t MIDI_Host_SendSysExStream(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo,
+			                                  const uint8_t VirtualCable,
+			                                  const void* const Buffer,
+			                                  uint16_t Length) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
 			/** Flushes the MIDI send buffer, sending any queued MIDI events to the device. This should be called to override the
 			 *  \ref MIDI_Host_SendEventPacket() function's packing behavior, to flush queued events. Events are queued into the
 			 *  pipe bank until either the pipe bank is full, or \ref MIDI_Host_Flush() is called. This allows for multiple MIDI
@@ -168,6 +212,24 @@
 			bool MIDI_Host_ReceiveEventPacket(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo,
 			                                  MIDI_EventPacket_t* const Event) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 
+			/** Receives as many MIDI event packets from the device as are available in the current pipe bank in a single pipe
+			 *  stream transfer, up to the given maximum, rather than one event at a time as with \ref MIDI_Host_ReceiveEventPacket().
+			 *  The pipe bank is released once all events within it have been read.
+			 *
+			 *  \pre This function must only be called when the Host state machine is in the \ref HOST_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] MIDIInterfaceInfo  Pointer to a structure containing a MIDI Class configuration and state.
+			 *  \param[out]    Events             Pointer to an array of \ref MIDI_EventPacket_t structures where the received MIDI
+			 *                                    events are to be placed.
+			 *  \param[in]     MaxEvents          Maximum number of events to store into the \c Events array.
+			 *
+			 *  \return Number of MIDI event packets received and stored into \c Events.
+			 */
+			uint16_t MIDI_Host_ReceiveEventPackets(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo,
+			                                       MIDI_EventPacket_t* const Events,
+			                                       const uint16_t MaxEvents) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
 		/* Function Prototypes: */
@@ -283,7 +283,12 @@ uint8_t RNDIS_Host_InitializeDevice(USB_ClassInfo_RNDIS_Host_t* const RNDISInter
 	if (InitMessageResponse.Status != CPU_TO_LE32(REMOTE_NDIS_STATUS_SUCCESS))
 	  return RNDIS_ERROR_LOGICAL_CMD_FAILED;
 
-	RNDISInterfaceInfo->State.DeviceMaxPacketSize = le32_to_cpu(InitMessageResponse.MaxTransferSize);
+	RNDISInterfaceInfo->State.DeviceMaxPacketSize         = le32_to_cpu(InitMessageResponse.MaxTransferSize);
+	RNDISInterfaceInfo->State.DeviceMaxPacketsPerTransfer = MIN(le32_to_cpu(InitMessageResponse.MaxPacketsPerTransfer), UINT8_MAX);
+	RNDISInterfaceInfo->State.DevicePacketAlignmentFactor = MIN(le32_to_cpu(InitMessageResponse.PacketAlignmentFactor),
+	                                                            RNDIS_HOST_MAX_PACKET_ALIGNMENT_FACTOR);
+	RNDISInterfaceInfo->State.PendingPackets              = 0;
+	RNDISInterfaceInfo->State.PendingTransferSize         = 0;
 
 	return HOST_SENDCONTROL_Successful;
 }
@@ -422,13 +427,20 @@ uint8_t RNDIS_Host_ReadPacket(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceIn
 		return ErrorCode;
 	}
 
+	uint32_t MessageLength = le32_to_cpu(DeviceMessage.MessageLength);
+	uint32_t DataOffset    = (le32_to_cpu(DeviceMessage.DataOffset) + sizeof(RNDIS_Message_Header_t));
+
 	*PacketLength = (uint16_t)le32_to_cpu(DeviceMessage.DataLength);
 
-	Pipe_Discard_Stream(le32_to_cpu(DeviceMessage.DataOffset) -
-	                    (sizeof(RNDIS_Packet_Message_t) - sizeof(RNDIS_Message_Header_t)),
-	                    NULL);
+	if (DataOffset > sizeof(RNDIS_Packet_Message_t))
+	  Pipe_Discard_Stream(DataOffset - sizeof(RNDIS_Packet_Message_t), NULL);
+
+	if (*PacketLength)
+	  Pipe_Read_Stream_LE(Buffer, *PacketLength, NULL);
 
-	Pipe_Read_Stream_LE(Buffer, *PacketLength, NULL);
+	/* Skip any alignment padding after the packet data, so that the next message in the transfer can be read */
+	if (MessageLength > (DataOffset + *PacketLength))
+	  Pipe_Discard_Stream(MessageLength - (DataOffset + *PacketLength), NULL);
 
 	if (!(Pipe_BytesInPipe()))
 	  Pipe_ClearIN();
@@ -442,21 +454,16 @@ uint8_t RNDIS_Host_SendPacket(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceIn
                               void* Buffer,
                               const uint16_t PacketLength)
 {
-	uint8_t ErrorCode;
-
-	if ((USB_HostState != HOST_STATE_Configured) || !(RNDISInterfaceInfo->State.IsActive))
-	  return PIPE_READYWAIT_DeviceDisconnected;
+	uint8_t  ErrorCode;
+	uint16_t PaddingLength;
 
 	RNDIS_Packet_Message_t DeviceMessage;
 
-	memset(&DeviceMessage, 0, sizeof(RNDIS_Packet_Message_t));
-	DeviceMessage.MessageType   = CPU_TO_LE32(REMOTE_NDIS_PACKET_MSG);
-	DeviceMessage.MessageLength = CPU_TO_LE32(sizeof(RNDIS_Packet_Message_t) + PacketLength);
-	DeviceMessage.DataOffset    = CPU_TO_LE32(sizeof(RNDIS_Packet_Message_t) - sizeof(RNDIS_Message_Header_t));
-	DeviceMessage.DataLength    = cpu_to_le32(PacketLength);
-
-	Pipe_SelectPipe(RNDISInterfaceInfo->Config.DataOUTPipe.Address);
-	Pipe_Unfreeze();
+	if ((ErrorCode = RNDIS_Host_BeginPacketMessage(RNDISInterfaceInfo, &DeviceMessage, PacketLength,
+	                                               &PaddingLength)) != PIPE_RWSTREAM_NoError)
+	{
+		return ErrorCode;
+	}
 
 	if ((ErrorCode = Pipe_Write_Stream_LE(&DeviceMessage, sizeof(RNDIS_Packet_Message_t),
 	                                      NULL)) != PIPE_RWSTREAM_NoError)
@@ -465,12 +472,122 @@ uint8_t RNDIS_Host_SendPacket(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceIn
 	}
 
 	Pipe_Write_Stream_LE(Buffer, PacketLength, NULL);
-	Pipe_ClearOUT();
+
+	if (PaddingLength)
+	  Pipe_Null_Stream(PaddingLength, NULL);
+
+	Pipe_Freeze();
+
+	return PIPE_RWSTREAM_NoError;
+}
+
+uint8_t RNDIS_Host_SendPacketMessage(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo,
+                                     RNDIS_Packet_Message_t* const Message,
+                                     const uint16_t PacketLength)
+{
+	uint8_t  ErrorCode;
+	uint16_t PaddingLength;
+
+	if ((ErrorCode = RNDIS_Host_BeginPacketMessage(RNDISInterfaceInfo, Message, PacketLength,
+	                                               &PaddingLength)) != PIPE_RWSTREAM_NoError)
+	{
+		return ErrorCode;
+	}
+
+	if ((ErrorCode = Pipe_Write_Stream_LE(Message, (sizeof(RNDIS_Packet_Message_t) + PacketLength),
+	                                      NULL)) != PIPE_RWSTREAM_NoError)
+	{
+		return ErrorCode;
+	}
+
+	if (PaddingLength)
+	  Pipe_Null_Stream(PaddingLength, NULL);
 
 	Pipe_Freeze();
 
 	return PIPE_RWSTREAM_NoError;
 }
 
+static uint8_t RNDIS_Host_BeginPacketMessage(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo,
+                                             RNDIS_Packet_Message_t* const Message,
+                                             const uint16_t PacketLength,
+                                             uint16_t* const PaddingLength)
+{
+	uint8_t ErrorCode;
+
+	if ((USB_HostState != HOST_STATE_Configured) || !(RNDISInterfaceInfo->State.IsActive))
+	  return PIPE_READYWAIT_DeviceDisconnected;
+
+	uint32_t MessageLength = (sizeof(RNDIS_Packet_Message_t) + PacketLength);
+
+	*PaddingLength = 0;
+
+	/* Pad each message to the device's alignment if it accepts more than one packet per transfer, so that the next message
+	   in the transfer starts on an aligned boundary */
+	if (RNDISInterfaceInfo->State.DeviceMaxPacketsPerTransfer > 1)
+	{
+		uint8_t AlignmentMask = ((1 << RNDISInterfaceInfo->State.DevicePacketAlignmentFactor) - 1);
+
+		*PaddingLength = ((AlignmentMask + 1 - (MessageLength & AlignmentMask)) & AlignmentMask);
+		MessageLength += *PaddingLength;
+	}
+
+	/* End the current transfer first if the device cannot receive this packet as part of it */
+	if (RNDISInterfaceInfo->State.PendingPackets &&
+	    ((RNDISInterfaceInfo->State.PendingPackets >= RNDISInterfaceInfo->State.DeviceMaxPacketsPerTransfer) ||
+	     ((RNDISInterfaceInfo->State.PendingTransferSize + MessageLength) > RNDISInterfaceInfo->State.DeviceMaxPacketSize)))
+	{
+		if ((ErrorCode = RNDIS_Host_Flush(RNDISInterfaceInfo)) != PIPE_READYWAIT_NoError)
+		  return ErrorCode;
+	}
+
+	memset(Message, 0, sizeof(RNDIS_Packet_Message_t));
+	Message->MessageType   = CPU_TO_LE32(REMOTE_NDIS_PACKET_MSG);
+	Message->MessageLength = cpu_to_le32(MessageLength);
+	Message->DataOffset    = CPU_TO_LE32(sizeof(RNDIS_Packet_Message_t) - sizeof(RNDIS_Message_Header_t));
+	Message->DataLength    = cpu_to_le32(PacketLength);
+
+	RNDISInterfaceInfo->State.PendingPackets++;
+	RNDISInterfaceInfo->State.PendingTransferSize += MessageLength;
+
+	Pipe_SelectPipe(RNDISInterfaceInfo->Config.DataOUTPipe.Address);
+	Pipe_Unfreeze();
+
+	return PIPE_RWSTREAM_NoError;
+}
+
+uint8_t RNDIS_Host_Flush(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo)
+{
+	if ((USB_HostState != HOST_STATE_Configured) || !(RNDISInterfaceInfo->State.IsActive))
+	  return PIPE_READYWAIT_DeviceDisconnected;
+
+	uint8_t ErrorCode;
+
+	if (!(RNDISInterfaceInfo->State.PendingPackets))
+	  return PIPE_READYWAIT_NoError;
+
+	RNDISInterfaceInfo->State.PendingPackets      = 0;
+	RNDISInterfaceInfo->State.PendingTransferSize = 0;
+
+	Pipe_SelectPipe(RNDISInterfaceInfo->Config.DataOUTPipe.Address);
+	Pipe_Unfreeze();
+
+	bool BankFull = !(Pipe_IsReadWriteAllowed());
+
+	Pipe_ClearOUT();
+
+	if (BankFull)
+	{
+		if ((ErrorCode = Pipe_WaitUntilReady()) != PIPE_READYWAIT_NoError)
+		  return ErrorCode;
+
+		Pipe_ClearOUT();
+	}
+
+	Pipe_Freeze();
+
+	return PIPE_READYWAIT_NoError;
+}
+
 #endif
 
@@ -97,6 +97,18 @@
 					uint8_t ControlInterfaceNumber; /**< Interface index of the RNDIS control interface within the attached device. */
 
 					uint32_t DeviceMaxPacketSize; /**< Maximum size of a packet which can be buffered by the attached RNDIS device. */
+					uint8_t  DeviceMaxPacketsPerTransfer; /**< Maximum number of packets the attached RNDIS device can receive in a
+					                                       *   single transfer.
+					                                       */
+					uint8_t  DevicePacketAlignmentFactor; /**< Power of two alignment required by the attached RNDIS device for each
+					                                       *   packet within a multiple packet transfer.
+					                                       */
+					uint8_t  PendingPackets; /**< Number of packets written to the data OUT pipe which have not yet been flushed to the
+					                          *   device as a complete transfer.
+					                          */
+					uint32_t PendingTransferSize; /**< Size in bytes of the packets written to the data OUT pipe which have not yet
+					                               *   been flushed to the device as a complete transfer.
+					                               */
 
 					uint32_t RequestID; /**< Request ID counter to give a unique ID for each command/response pair. */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
@@ -210,7 +222,11 @@
 			                              uint16_t* const PacketLength) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2)
 			                              ATTR_NON_NULL_PTR_ARG(3);
 
-			/** Sends the given packet to the attached RNDIS device, after adding a RNDIS packet message header.
+			/** Sends the given packet to the attached RNDIS device, after adding a RNDIS packet message header. Packets are
+			 *  queued in the data OUT pipe bank and combined into a single transfer, which is only completed when the device's
+			 *  maximum transfer size or packet count would be exceeded, or the \ref RNDIS_Host_Flush() function is called to
+			 *  flush the pending packets to the device. If the \c NO_CLASS_DRIVER_AUTOFLUSH compile time token is not defined,
+			 *  pending packets are automatically flushed each time \ref RNDIS_Host_USBTask() is called.
 			 *
 			 *  \pre This function must only be called when the Host state machine is in the \ref HOST_STATE_Configured state or the
 			 *       call will fail.
@@ -225,6 +241,35 @@
 			                              void* Buffer,
 			                              const uint16_t PacketLength) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 
+			/** Sends the given packet to the attached RNDIS device, in the same manner as \ref RNDIS_Host_SendPacket(). The packet
+			 *  must be stored immediately after space for a \ref RNDIS_Packet_Message_t header, which is filled in place so that the
+			 *  complete packet message can be written to the data OUT pipe as a single contiguous stream. This avoids a separate
+			 *  header copy when the application reserves space for the header in front of its packet buffer.
+			 *
+			 *  \pre This function must only be called when the Host state machine is in the \ref HOST_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] RNDISInterfaceInfo  Pointer to a structure containing an RNDIS Class host configuration and state.
+			 *  \param[in,out] Message             Pointer to the packet message header space, immediately followed by the packet data.
+			 *  \param[in]     PacketLength        Length in bytes of the packet to send, excluding the packet message header.
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t RNDIS_Host_SendPacketMessage(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo,
+			                                     RNDIS_Packet_Message_t* const Message,
+			                                     const uint16_t PacketLength) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Flushes any packets waiting to be sent, completing the current transfer to the device.
+			 *
+			 *  \pre This function must only be called when the Host state machine is in the \ref HOST_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] RNDISInterfaceInfo  Pointer to a structure containing an RNDIS Class host configuration and state.
+			 *
+			 *  \return A value from the \ref Pipe_WaitUntilReady_ErrorCodes_t enum.
+			 */
+			uint8_t RNDIS_Host_Flush(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
 		/* Inline Functions: */
 			/** General management task for a given RNDIS host class interface, required for the correct operation of the interface. This should
 			 *  be called frequently in the main program loop, before the master USB management task \ref USB_USBTask().
@@ -234,11 +279,18 @@
 			static inline void RNDIS_Host_USBTask(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
 			static inline void RNDIS_Host_USBTask(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo)
 			{
+				#if !defined(NO_CLASS_DRIVER_AUTOFLUSH)
+				RNDIS_Host_Flush(RNDISInterfaceInfo);
+				#else
 				(void)RNDISInterfaceInfo;
+				#endif
 			}
 
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define RNDIS_HOST_MAX_PACKET_ALIGNMENT_FACTOR  7
+
 		/* Function Prototypes: */
 			#if defined(__INCLUDE_FROM_RNDIS_HOST_C)
 				static uint8_t RNDIS_SendEncapsulatedCommand(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo,
@@ -249,6 +301,11 @@
 				                                             void* Buffer,
 				                                             const uint16_t Length) ATTR_NON_NULL_PTR_ARG(1)
 				                                             ATTR_NON_NULL_PTR_ARG(2);
+				static uint8_t RNDIS_Host_BeginPacketMessage(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo,
+				                                             RNDIS_Packet_Message_t* const Message,
+				                                             const uint16_t PacketLength,
+				                                             uint16_t* const PaddingLength) ATTR_NON_NULL_PTR_ARG(1)
+				                                             ATTR_NON_NULL_PTR_ARG(2) ATTR_NON_NULL_PTR_ARG(4);
 
 				static uint8_t DCOMP_RNDIS_Host_NextRNDISControlInterface(void* const CurrentDescriptor)
 				                                                          ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
@@ -106,6 +106,12 @@
 				return (MaskVal << EPSIZE0);
 			}
 
+			static inline uint16_t Endpoint_GetBankSize(void) ATTR_WARN_UNUSED_RESULT ATTR_ALWAYS_INLINE;
+			static inline uint16_t Endpoint_GetBankSize(void)
+			{
+				return (8 << ((UECFG1X & (0x07 << EPSIZE0)) >> EPSIZE0));
+			}
+
 		/* Function Prototypes: */
 			void Endpoint_ClearEndpoints(void);
 			bool Endpoint_ConfigureEndpoint_Prv(const uint8_t Number,
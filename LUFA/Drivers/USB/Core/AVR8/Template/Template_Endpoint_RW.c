@@ -68,10 +68,35 @@ uint8_t TEMPLATE_FUNC_NAME (TEMPLATE_BUFFER_TYPE const Buffer,
 		}
 		else
 		{
-			TEMPLATE_TRANSFER_BYTE(DataStream);
-			TEMPLATE_BUFFER_MOVE(DataStream, 1);
-			Length--;
-			BytesInTransfer++;
+			/* Determine how much of the current bank can be transferred up front, so that the bank status need
+			 * only be checked once per packet rather than once per byte */
+			uint16_t BytesInBank = MIN(Length, TEMPLATE_BYTES_IN_BANK());
+
+			if (!(BytesInBank))
+			  BytesInBank = 1;
+
+			Length          -= BytesInBank;
+			BytesInTransfer += BytesInBank;
+
+			while (BytesInBank >= 8)
+			{
+				TEMPLATE_TRANSFER_BYTE(DataStream); TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				TEMPLATE_TRANSFER_BYTE(DataStream); TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				TEMPLATE_TRANSFER_BYTE(DataStream); TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				TEMPLATE_TRANSFER_BYTE(DataStream); TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				TEMPLATE_TRANSFER_BYTE(DataStream); TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				TEMPLATE_TRANSFER_BYTE(DataStream); TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				TEMPLATE_TRANSFER_BYTE(DataStream); TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				TEMPLATE_TRANSFER_BYTE(DataStream); TEMPLATE_BUFFER_MOVE(DataStream, 1);
+
+				BytesInBank -= 8;
+			}
+
+			while (BytesInBank--)
+			{
+				TEMPLATE_TRANSFER_BYTE(DataStream);
+				TEMPLATE_BUFFER_MOVE(DataStream, 1);
+			}
 		}
 	}
 
@@ -81,6 +106,7 @@ uint8_t TEMPLATE_FUNC_NAME (TEMPLATE_BUFFER_TYPE const Buffer,
 #undef TEMPLATE_FUNC_NAME
 #undef TEMPLATE_BUFFER_TYPE
 #undef TEMPLATE_TRANSFER_BYTE
+#undef TEMPLATE_BYTES_IN_BANK
 #undef TEMPLATE_CLEAR_ENDPOINT
 #undef TEMPLATE_BUFFER_OFFSET
 #undef TEMPLATE_BUFFER_MOVE
@@ -0,0 +1,265 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#define  __INCLUDE_FROM_USB_DRIVER
+#include "USBMode.h"
+
+#if defined(USB_CAN_BE_DEVICE) && !defined(CONTROL_ONLY_DEVICE)
+
+#define  __INCLUDE_FROM_ENDPOINTTRANSFER_C
+#include "EndpointTransfer.h"
+#include "EndpointStream.h"
+#include "USBTask.h"
+
+static USB_Endpoint_Transfer_t* Endpoint_PendingTransfers;
+
+uint8_t Endpoint_SubmitTransfer(USB_Endpoint_Transfer_t* const Transfer)
+{
+	for (USB_Endpoint_Transfer_t* PendingTransfer = Endpoint_PendingTransfers; PendingTransfer != NULL;
+	     PendingTransfer = PendingTransfer->State.NextTransfer)
+	{
+		if (PendingTransfer->Config.Endpoint->Address == Transfer->Config.Endpoint->Address)
+		  return ENDPOINT_TRANSFER_EndpointBusy;
+	}
+
+	Transfer->State.BytesTransferred = 0;
+	Transfer->State.Status           = ENDPOINT_TRANSFER_Pending;
+	Transfer->State.SegmentLength    = 0;
+	Transfer->State.ZLPPending       = ((Transfer->Config.Flags & ENDPOINT_TRANSFER_FLAG_SEND_ZLP) && !(Transfer->Config.Length));
+	Transfer->State.NextTransfer     = Endpoint_PendingTransfers;
+
+	Endpoint_PendingTransfers = Transfer;
+
+	return ENDPOINT_TRANSFER_Pending;
+}
+
+void Endpoint_CancelTransfer(USB_Endpoint_Transfer_t* const Transfer)
+{
+	if (Transfer->State.Status != ENDPOINT_TRANSFER_Pending)
+	  return;
+
+	#if defined(ENDPOINT_TRANSFER_USE_DMA)
+	if (Transfer->State.SegmentLength)
+	{
+		uint8_t PrevEndpoint = Endpoint_GetCurrentEndpoint();
+
+		Endpoint_SelectEndpoint(Transfer->Config.Endpoint->Address);
+		Endpoint_AbortTransferDMA_PRV(Transfer);
+		Endpoint_SelectEndpoint(PrevEndpoint);
+	}
+	#endif
+
+	Endpoint_RemoveTransfer(Transfer);
+	Transfer->State.Status = ENDPOINT_TRANSFER_Cancelled;
+}
+
+void Endpoint_ProcessTransfers(void)
+{
+	uint8_t                   PrevEndpoint         = Endpoint_GetCurrentEndpoint();
+	USB_Endpoint_Transfer_t*  Transfer             = Endpoint_PendingTransfers;
+	USB_Endpoint_Transfer_t*  FinishedTransfers    = NULL;
+	USB_Endpoint_Transfer_t** FinishedTransferLink = &FinishedTransfers;
+
+	while (Transfer != NULL)
+	{
+		USB_Endpoint_Transfer_t* NextTransfer = Transfer->State.NextTransfer;
+		uint8_t                  Status       = ENDPOINT_TRANSFER_Pending;
+
+		Endpoint_SelectEndpoint(Transfer->Config.Endpoint->Address);
+
+		if (USB_DeviceState != DEVICE_STATE_Configured)
+		  Status = ENDPOINT_TRANSFER_DeviceDisconnected;
+		else if (Endpoint_IsStalled())
+		  Status = ENDPOINT_TRANSFER_EndpointStalled;
+		else if (Endpoint_ProcessTransfer(Transfer))
+		  Status = ENDPOINT_TRANSFER_Complete;
+
+		if (Status != ENDPOINT_TRANSFER_Pending)
+		{
+			#if defined(ENDPOINT_TRANSFER_USE_DMA)
+			if (Transfer->State.SegmentLength)
+			  Endpoint_AbortTransferDMA_PRV(Transfer);
+			#endif
+
+			Endpoint_RemoveTransfer(Transfer);
+			Transfer->State.Status = Status;
+
+			/* Queue the finished transfer's callback until the pending list walk is complete, as the callback may
+			 * submit or cancel other transfers */
+			Transfer->State.NextTransfer = NULL;
+			*FinishedTransferLink        = Transfer;
+			FinishedTransferLink         = &Transfer->State.NextTransfer;
+		}
+
+		Transfer = NextTransfer;
+	}
+
+	while (FinishedTransfers != NULL)
+	{
+		Transfer          = FinishedTransfers;
+		FinishedTransfers = Transfer->State.NextTransfer;
+
+		if (Transfer->Config.CompletionCallback != NULL)
+		{
+			Endpoint_SelectEndpoint(Transfer->Config.Endpoint->Address);
+			Transfer->Config.CompletionCallback(Transfer);
+		}
+	}
+
+	Endpoint_SelectEndpoint(PrevEndpoint);
+}
+
+static void Endpoint_RemoveTransfer(USB_Endpoint_Transfer_t* const Transfer)
+{
+	USB_Endpoint_Transfer_t** TransferLink = &Endpoint_PendingTransfers;
+
+	while (*TransferLink != NULL)
+	{
+		if (*TransferLink == Transfer)
+		{
+			*TransferLink = Transfer->State.NextTransfer;
+			break;
+		}
+
+		TransferLink = &(*TransferLink)->State.NextTransfer;
+	}
+}
+
+/** Advances the given transfer on the currently selected endpoint, by waiting for any DMA segment in flight to
+ *  finish, then starting the next DMA segment if possible, or otherwise copying the next packet with the CPU.
+ *
+ *  \param[in,out] Transfer  Pointer to the transfer to advance.
+ *
+ *  \return Boolean \c true if the transfer has finished, \c false otherwise.
+ */
+static bool Endpoint_ProcessTransfer(USB_Endpoint_Transfer_t* const Transfer)
+{
+	uint16_t PacketSize = Transfer->Config.Endpoint->Size;
+	uint8_t* Buffer     = (uint8_t*)Transfer->Config.Buffer;
+
+	#if defined(ENDPOINT_TRANSFER_USE_DMA)
+	if (Transfer->State.SegmentLength)
+	{
+		uint16_t SegmentBytes;
+
+		if (!(Endpoint_IsTransferDMAComplete_PRV(Transfer, &SegmentBytes)))
+		  return false;
+
+		bool ShortSegment = (SegmentBytes < Transfer->State.SegmentLength);
+
+		Transfer->State.BytesTransferred += SegmentBytes;
+		Transfer->State.SegmentLength     = 0;
+
+		if (Transfer->Config.Endpoint->Address & ENDPOINT_DIR_IN)
+		{
+			/* IN segments start on an empty bank, so the segment's final packet was full if it was a whole number of packets */
+			if (Transfer->State.BytesTransferred == Transfer->Config.Length)
+			  Transfer->State.ZLPPending = ((Transfer->Config.Flags & ENDPOINT_TRANSFER_FLAG_SEND_ZLP) && !(SegmentBytes % PacketSize));
+		}
+		else if (ShortSegment)
+		{
+			return true;
+		}
+	}
+	#endif
+
+	uint16_t BytesRemaining = (Transfer->Config.Length - Transfer->State.BytesTransferred);
+
+	if (Transfer->Config.Endpoint->Address & ENDPOINT_DIR_IN)
+	{
+		if (!(Endpoint_IsINReady()))
+		  return false;
+
+		if (!(BytesRemaining))
+		{
+			if (Transfer->State.ZLPPending)
+			{
+				Endpoint_ClearIN();
+				Transfer->State.ZLPPending = false;
+			}
+
+			return true;
+		}
+
+		#if defined(ENDPOINT_TRANSFER_USE_DMA)
+		if ((Transfer->State.SegmentLength = Endpoint_StartTransferDMA_PRV(Transfer)))
+		  return false;
+		#endif
+
+		/* Top up the current bank, which may already hold data written via the other endpoint functions */
+		uint16_t BytesInPacket = MIN(BytesRemaining, (PacketSize - Endpoint_BytesInEndpoint()));
+
+		Endpoint_Write_Stream_LE(&Buffer[Transfer->State.BytesTransferred], BytesInPacket, NULL);
+		Transfer->State.BytesTransferred += BytesInPacket;
+
+		bool PacketFull = (Endpoint_BytesInEndpoint() == PacketSize);
+
+		/* A ZLP is only needed if the final packet of the transfer, including any data already in the bank, was full */
+		if (BytesInPacket == BytesRemaining)
+		  Transfer->State.ZLPPending = ((Transfer->Config.Flags & ENDPOINT_TRANSFER_FLAG_SEND_ZLP) && PacketFull);
+
+		if (PacketFull || (BytesInPacket == BytesRemaining))
+		  Endpoint_ClearIN();
+
+		return ((BytesInPacket == BytesRemaining) && !(Transfer->State.ZLPPending));
+	}
+	else
+	{
+		if (!(Endpoint_IsOUTReceived()))
+		  return false;
+
+		uint16_t BytesInBank   = Endpoint_BytesInEndpoint();
+		uint16_t BytesInPacket = MIN(BytesRemaining, BytesInBank);
+
+		Endpoint_Read_Stream_LE(&Buffer[Transfer->State.BytesTransferred], BytesInPacket, NULL);
+		Transfer->State.BytesTransferred += BytesInPacket;
+
+		/* Any bytes which do not fit into the transfer buffer are left in the bank for the application */
+		if (BytesInPacket != BytesInBank)
+		  return true;
+
+		if ((BytesInBank < PacketSize) || (BytesInPacket == BytesRemaining))
+		{
+			Endpoint_ClearOUT();
+			return true;
+		}
+
+		#if defined(ENDPOINT_TRANSFER_USE_DMA)
+		/* The drained bank is handed straight back to the controller, pointed at the transfer buffer if possible */
+		if ((Transfer->State.SegmentLength = Endpoint_StartTransferDMA_PRV(Transfer)))
+		  return false;
+		#endif
+
+		Endpoint_ClearOUT();
+		return false;
+	}
+}
+
+#endif
@@ -0,0 +1,226 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *  \brief Asynchronous endpoint transfer management.
+ *  \copydetails Group_EndpointTransfer
+ *
+ *  \note This file should not be included directly. It is automatically included as needed by the USB driver
+ *        dispatch header located in LUFA/Drivers/USB/USB.h.
+ */
+
+/** \ingroup Group_EndpointRW
+ *  \defgroup Group_EndpointTransfer Asynchronous Endpoint Transfers
+ *  \brief Asynchronous endpoint transfer management.
+ *
+ *  Functions, macros, variables, enums and types related to the queuing of complete transfers to and from
+ *  device endpoints, which are moved in the background while the application continues to run.
+ *
+ *  A transfer is described by a \ref USB_Endpoint_Transfer_t structure, which is submitted via
+ *  \ref Endpoint_SubmitTransfer() and then advanced by each call to \ref Endpoint_ProcessTransfers(). Once the
+ *  transfer finishes its optional completion callback is run, and its status may also be polled via
+ *  \ref Endpoint_IsTransferComplete().
+ *
+ *  Each call to \ref Endpoint_ProcessTransfers() copies at most one packet per transfer, so that class drivers and
+ *  applications may use the same code on all architectures. On architectures whose USB controller can move endpoint
+ *  data by DMA (the XMEGA and UC3 architectures), the experimental \c USE_ENDPOINT_TRANSFER_DMA compile time token
+ *  instead moves the bulk of each transfer directly between the transfer buffer and the USB controller, without the
+ *  CPU copying each packet.
+ *
+ *  \note While a transfer is pending, its buffer and transfer structure must remain valid and must not be
+ *        altered by the application, and the endpoint must not be accessed via the other endpoint functions.
+ *
+ *  @{
+ */
+
+#ifndef __ENDPOINT_TRANSFER_H__
+#define __ENDPOINT_TRANSFER_H__
+
+	/* Includes: */
+		#include "../../../Common/Common.h"
+		#include "USBMode.h"
+		#include "Endpoint.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks: */
+		#if !defined(__INCLUDE_FROM_USB_DRIVER)
+			#error Do not include this file directly. Include LUFA/Drivers/USB/USB.h instead.
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			/** Transfer flag for the \c Config.Flags element of a \ref USB_Endpoint_Transfer_t, indicating that an IN transfer whose length is a
+			 *  whole number of packets should be terminated by a zero length packet, so that the host can detect the end
+			 *  of the transfer. An IN transfer of zero bytes with this flag set sends a single zero length packet.
+			 */
+			#define ENDPOINT_TRANSFER_FLAG_SEND_ZLP     (1 << 0)
+
+		/* Enums: */
+			/** Enum for the possible status codes of an endpoint transfer, and the return codes of
+			 *  \ref Endpoint_SubmitTransfer().
+			 */
+			enum Endpoint_TransferStatus_t
+			{
+				ENDPOINT_TRANSFER_Complete           = 0, /**< Transfer completed successfully. */
+				ENDPOINT_TRANSFER_EndpointStalled    = 1, /**< The endpoint was stalled during the transfer by the host or device. */
+				ENDPOINT_TRANSFER_DeviceDisconnected = 2, /**< Device was disconnected from the host, or left the configured
+				                                           *   state, during the transfer.
+				                                           */
+				ENDPOINT_TRANSFER_Cancelled          = 3, /**< Transfer was cancelled via \ref Endpoint_CancelTransfer(). */
+				ENDPOINT_TRANSFER_Pending            = 4, /**< Transfer has been submitted and has not yet finished. */
+				ENDPOINT_TRANSFER_EndpointBusy       = 5, /**< Returned by \ref Endpoint_SubmitTransfer() when the transfer
+				                                           *   could not be submitted, as another transfer is already pending
+				                                           *   on the same endpoint.
+				                                           */
+			};
+
+		/* Type Defines: */
+			/** Type define for an asynchronous endpoint transfer. The \c Config section must be filled out by the
+			 *  application before the transfer is submitted; the \c State section is managed by the library and may
+			 *  only be read by the application.
+			 */
+			typedef struct USB_Endpoint_Transfer
+			{
+				struct
+				{
+					const USB_Endpoint_Table_t* Endpoint; /**< Endpoint to transfer data on. The endpoint address direction
+					                                       *   sets the direction of the transfer, and the endpoint size
+					                                       *   the size of each packet.
+					                                       */
+					void*                       Buffer; /**< Buffer to send the data from, or to store received data to. */
+					uint16_t                    Length; /**< Number of bytes to send or the maximum number of bytes to receive. */
+					uint8_t                     Flags; /**< Mask of \c ENDPOINT_TRANSFER_FLAG_* flags for the transfer. */
+
+					void (*CompletionCallback)(struct USB_Endpoint_Transfer* const Transfer); /**< Optional function to run
+					                                                                           *   from \ref Endpoint_ProcessTransfers()
+					                                                                           *   once the transfer finishes,
+					                                                                           *   or \c NULL if not used.
+					                                                                           */
+				} Config; /**< Config data for the transfer, set by the user application. */
+
+				struct
+				{
+					uint16_t BytesTransferred; /**< Number of bytes sent or received so far. An OUT transfer ends early
+					                            *   when the host sends a short packet.
+					                            */
+					uint8_t  Status; /**< Current status of the transfer, a value from the \ref Endpoint_TransferStatus_t enum. */
+
+					uint16_t SegmentLength; /**< Number of bytes currently handed to the USB controller for DMA. */
+					bool     ZLPPending; /**< Indicates a terminating zero length packet remains to be sent. */
+
+					struct USB_Endpoint_Transfer* NextTransfer; /**< Next transfer in the pending transfer list, or in the list of
+					                                             *   finished transfers awaiting their completion callbacks.
+					                                             */
+				} State; /**< State data for the transfer, managed by the library. */
+			} USB_Endpoint_Transfer_t;
+
+		/* Function Prototypes: */
+			/** Submits the given transfer for processing in the background by \ref Endpoint_ProcessTransfers(). The
+			 *  transfer's \c Config section must be filled out first; its \c State section is reset by this function.
+			 *
+			 *  Only a single transfer may be pending on each endpoint address at any one time.
+			 *
+			 *  \param[in,out] Transfer  Pointer to the transfer to submit.
+			 *
+			 *  \return \ref ENDPOINT_TRANSFER_Pending if the transfer was submitted, or \ref ENDPOINT_TRANSFER_EndpointBusy
+			 *          if another transfer is already pending on the same endpoint.
+			 */
+			uint8_t Endpoint_SubmitTransfer(USB_Endpoint_Transfer_t* const Transfer) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Cancels a pending transfer, setting its status to \ref ENDPOINT_TRANSFER_Cancelled. The transfer's
+			 *  completion callback is not run. Any packet already handed to the USB controller for an IN transfer is
+			 *  abandoned, and the bytes received so far of an OUT transfer are left in the transfer buffer.
+			 *
+			 *  \param[in,out] Transfer  Pointer to the transfer to cancel.
+			 */
+			void Endpoint_CancelTransfer(USB_Endpoint_Transfer_t* const Transfer) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Advances all pending transfers, running the completion callback of each transfer which finishes. This
+			 *  should be called frequently in the main program loop, in the same manner as the class driver
+			 *  \c *_USBTask() functions.
+			 *
+			 *  Completion callbacks are run once every pending transfer has been advanced, and so may freely submit or
+			 *  cancel transfers.
+			 *
+			 *  Any pending transfers are ended with \ref ENDPOINT_TRANSFER_DeviceDisconnected if the device leaves the
+			 *  configured state.
+			 *
+			 *  \note This routine preserves the currently selected endpoint.
+			 */
+			void Endpoint_ProcessTransfers(void);
+
+		/* Inline Functions: */
+			/** Determines if the given transfer has finished, either successfully or with an error.
+			 *
+			 *  \param[in] Transfer  Pointer to the transfer to check.
+			 *
+			 *  \return Boolean \c true if the transfer is no longer pending, \c false otherwise.
+			 */
+			static inline bool Endpoint_IsTransferComplete(const USB_Endpoint_Transfer_t* const Transfer)
+			                                               ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
+			static inline bool Endpoint_IsTransferComplete(const USB_Endpoint_Transfer_t* const Transfer)
+			{
+				return (Transfer->State.Status != ENDPOINT_TRANSFER_Pending);
+			}
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#if (((ARCH == ARCH_XMEGA) || (ARCH == ARCH_UC3)) && defined(USE_ENDPOINT_TRANSFER_DMA))
+				#define ENDPOINT_TRANSFER_USE_DMA
+			#endif
+
+		/* Function Prototypes: */
+			#if defined(__INCLUDE_FROM_ENDPOINTTRANSFER_C)
+				static bool Endpoint_ProcessTransfer(USB_Endpoint_Transfer_t* const Transfer);
+				static void Endpoint_RemoveTransfer(USB_Endpoint_Transfer_t* const Transfer);
+			#endif
+
+			#if defined(ENDPOINT_TRANSFER_USE_DMA)
+				uint16_t Endpoint_StartTransferDMA_PRV(USB_Endpoint_Transfer_t* const Transfer);
+				bool     Endpoint_IsTransferDMAComplete_PRV(USB_Endpoint_Transfer_t* const Transfer,
+				                                            uint16_t* const BytesTransferred);
+				void     Endpoint_AbortTransferDMA_PRV(USB_Endpoint_Transfer_t* const Transfer);
+			#endif
+	#endif
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
+
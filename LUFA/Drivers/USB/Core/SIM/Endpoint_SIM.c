@@ -0,0 +1,262 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#include "../../../../Common/Common.h"
+#if (ARCH == ARCH_SIM)
+
+#define  __INCLUDE_FROM_USB_DRIVER
+#include "../USBMode.h"
+
+#if defined(USB_CAN_BE_DEVICE)
+
+#include "../Endpoint.h"
+
+#if !defined(FIXED_CONTROL_ENDPOINT_SIZE)
+uint8_t USB_Device_ControlEndpointSize = ENDPOINT_CONTROLEP_DEFAULT_SIZE;
+#endif
+
+Endpoint_FIFOPair_t USB_Endpoint_FIFOs[ENDPOINT_TOTAL_ENDPOINTS];
+
+uint8_t             USB_Endpoint_SelectedEndpoint;
+Endpoint_FIFO_t*    USB_Endpoint_SelectedFIFO;
+
+bool Endpoint_IsINReady(void)
+{
+	Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint | ENDPOINT_DIR_IN);
+
+	if (USB_Endpoint_SelectedFIFO->BanksQueued < USB_Endpoint_SelectedFIFO->TotalBanks)
+	  return true;
+
+	USB_Sim_ServiceBus();
+
+	return (USB_Endpoint_SelectedFIFO->BanksQueued < USB_Endpoint_SelectedFIFO->TotalBanks);
+}
+
+bool Endpoint_IsOUTReceived(void)
+{
+	Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint & ~ENDPOINT_DIR_IN);
+
+	if (!(USB_Endpoint_SelectedFIFO->BanksQueued))
+	  USB_Sim_ServiceBus();
+
+	return ((USB_Endpoint_SelectedFIFO->BanksQueued &&
+	         !(USB_Endpoint_SelectedFIFO->Flags & ENDPOINT_SIM_FLAG_SETUP)) ? true : false);
+}
+
+bool Endpoint_IsSETUPReceived(void)
+{
+	Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint & ~ENDPOINT_DIR_IN);
+
+	if (!(USB_Endpoint_SelectedFIFO->Flags & ENDPOINT_SIM_FLAG_SETUP))
+	  USB_Sim_ServiceBus();
+
+	return ((USB_Endpoint_SelectedFIFO->Flags & ENDPOINT_SIM_FLAG_SETUP) ? true : false);
+}
+
+void Endpoint_ClearSETUP(void)
+{
+	Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint & ~ENDPOINT_DIR_IN);
+	USB_Endpoint_SelectedFIFO->Flags      &= ~ENDPOINT_SIM_FLAG_SETUP;
+	USB_Endpoint_SelectedFIFO->BanksQueued = 0;
+	USB_Endpoint_SelectedFIFO->Position    = 0;
+
+	Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint | ENDPOINT_DIR_IN);
+	USB_Endpoint_SelectedFIFO->Position    = 0;
+}
+
+void Endpoint_ClearIN(void)
+{
+	Endpoint_FIFO_t* FIFO = USB_Endpoint_SelectedFIFO;
+
+	FIFO->Banks[FIFO->DeviceBank].Length = FIFO->Position;
+	FIFO->Position = 0;
+	FIFO->BanksQueued++;
+
+	if (++FIFO->DeviceBank == FIFO->TotalBanks)
+	  FIFO->DeviceBank = 0;
+}
+
+void Endpoint_ClearOUT(void)
+{
+	Endpoint_FIFO_t* FIFO = USB_Endpoint_SelectedFIFO;
+
+	FIFO->Position = 0;
+
+	if (!(FIFO->BanksQueued))
+	  return;
+
+	FIFO->BanksQueued--;
+
+	if (++FIFO->DeviceBank == FIFO->TotalBanks)
+	  FIFO->DeviceBank = 0;
+}
+
+void Endpoint_StallTransaction(void)
+{
+	USB_Endpoint_SelectedFIFO->Flags |= ENDPOINT_SIM_FLAG_STALLED;
+
+	if (USB_Endpoint_SelectedFIFO->Type == EP_TYPE_CONTROL)
+	{
+		Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint ^ ENDPOINT_DIR_IN);
+		USB_Endpoint_SelectedFIFO->Flags |= ENDPOINT_SIM_FLAG_STALLED;
+	}
+}
+
+void Endpoint_ResetEndpoint(const uint8_t Address)
+{
+	Endpoint_FIFOPair_t* EndpointFIFOPair = &USB_Endpoint_FIFOs[Address & ENDPOINT_EPNUM_MASK];
+	Endpoint_FIFO_t*     FIFO             = (Address & ENDPOINT_DIR_IN) ? &EndpointFIFOPair->IN : &EndpointFIFOPair->OUT;
+
+	FIFO->Position    = 0;
+	FIFO->DeviceBank  = 0;
+	FIFO->HostBank    = 0;
+	FIFO->BanksQueued = 0;
+	FIFO->Flags      &= ~ENDPOINT_SIM_FLAG_SETUP;
+}
+
+bool Endpoint_ConfigureEndpointTable(const USB_Endpoint_Table_t* const Table,
+                                     const uint8_t Entries)
+{
+	for (uint8_t i = 0; i < Entries; i++)
+	{
+		if (!(Table[i].Address))
+		  continue;
+
+		if (!(Endpoint_ConfigureEndpoint(Table[i].Address, Table[i].Type, Table[i].Size, Table[i].Banks)))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool Endpoint_ConfigureEndpoint_PRV(const uint8_t Address,
+                                    const uint8_t Type,
+                                    const uint16_t Size,
+                                    const uint8_t Banks)
+{
+	Endpoint_SelectEndpoint(Address);
+	Endpoint_ResetEndpoint(Address);
+
+	USB_Endpoint_SelectedFIFO->Type       = Type;
+	USB_Endpoint_SelectedFIFO->Size       = Size;
+	USB_Endpoint_SelectedFIFO->TotalBanks = Banks;
+	USB_Endpoint_SelectedFIFO->Flags      = ENDPOINT_SIM_FLAG_CONFIGURED;
+
+	return true;
+}
+
+void Endpoint_ClearEndpoints(void)
+{
+	for (uint8_t EPNum = 0; EPNum < ENDPOINT_TOTAL_ENDPOINTS; EPNum++)
+	{
+		Endpoint_ResetEndpoint(EPNum);
+		Endpoint_ResetEndpoint(EPNum | ENDPOINT_DIR_IN);
+
+		USB_Endpoint_FIFOs[EPNum].OUT.Flags = 0;
+		USB_Endpoint_FIFOs[EPNum].IN.Flags  = 0;
+	}
+}
+
+void Endpoint_ClearStatusStage(void)
+{
+	if (USB_ControlRequest.bmRequestType & REQDIR_DEVICETOHOST)
+	{
+		while (!(Endpoint_IsOUTReceived()))
+		{
+			if (USB_DeviceState == DEVICE_STATE_Unattached)
+			  return;
+		}
+
+		Endpoint_ClearOUT();
+	}
+	else
+	{
+		while (!(Endpoint_IsINReady()))
+		{
+			if (USB_DeviceState == DEVICE_STATE_Unattached)
+			  return;
+		}
+
+		Endpoint_ClearIN();
+	}
+}
+
+#if !defined(CONTROL_ONLY_DEVICE)
+uint8_t Endpoint_WaitUntilReady(void)
+{
+	#if (USB_STREAM_TIMEOUT_MS < 0xFF)
+	uint8_t  TimeoutMSRem = USB_STREAM_TIMEOUT_MS;
+	#else
+	uint16_t TimeoutMSRem = USB_STREAM_TIMEOUT_MS;
+	#endif
+
+	uint16_t PreviousFrameNumber = USB_Device_GetFrameNumber();
+
+	for (;;)
+	{
+		if (Endpoint_GetEndpointDirection() == ENDPOINT_DIR_IN)
+		{
+			if (Endpoint_IsINReady())
+			  return ENDPOINT_READYWAIT_NoError;
+		}
+		else
+		{
+			if (Endpoint_IsOUTReceived())
+			  return ENDPOINT_READYWAIT_NoError;
+		}
+
+		uint8_t USB_DeviceState_LCL = USB_DeviceState;
+
+		if (USB_DeviceState_LCL == DEVICE_STATE_Unattached)
+		  return ENDPOINT_READYWAIT_DeviceDisconnected;
+		else if (USB_DeviceState_LCL == DEVICE_STATE_Suspended)
+		  return ENDPOINT_READYWAIT_BusSuspended;
+		else if (Endpoint_IsStalled())
+		  return ENDPOINT_READYWAIT_EndpointStalled;
+
+		uint16_t CurrentFrameNumber = USB_Device_GetFrameNumber();
+
+		if (CurrentFrameNumber != PreviousFrameNumber)
+		{
+			PreviousFrameNumber = CurrentFrameNumber;
+
+			if (!(TimeoutMSRem--))
+			  return ENDPOINT_READYWAIT_Timeout;
+		}
+	}
+}
+#endif
+
+#endif
+
+#endif
+
@@ -0,0 +1,453 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#include "../../../../Common/Common.h"
+#if (ARCH == ARCH_SIM)
+
+#define  __INCLUDE_FROM_USB_DRIVER
+#define  __INCLUDE_FROM_USB_CONTROLLER_C
+#include "../USBController.h"
+
+#if !defined(USE_STATIC_OPTIONS)
+volatile uint8_t USB_Options;
+#endif
+
+volatile uint_reg_t  SIM_GlobalInterruptState;
+
+USB_Sim_Controller_t USB_Sim_Controller;
+
+enum USB_Sim_ControlStages_t
+{
+	USB_SIM_STAGE_Idle,
+	USB_SIM_STAGE_Setup,
+	USB_SIM_STAGE_DataIN,
+	USB_SIM_STAGE_DataOUT,
+	USB_SIM_STAGE_StatusIN,
+	USB_SIM_STAGE_StatusOUT,
+	USB_SIM_STAGE_StatusOUTAck,
+};
+
+static const USB_Sim_HostModel_t* USB_Sim_HostModel;
+static bool                       USB_Sim_InServiceBus;
+
+static USB_Request_Header_t       USB_Sim_ControlRequest;
+static uint8_t*                   USB_Sim_ControlData;
+static uint16_t                   USB_Sim_ControlTransferred;
+static uint8_t                    USB_Sim_ControlStage;
+static uint8_t                    USB_Sim_ControlStatus;
+
+void USB_Init(
+               #if defined(USE_STATIC_OPTIONS)
+               void
+               #else
+               const uint8_t Options
+               #endif
+               )
+{
+	#if !defined(USE_STATIC_OPTIONS)
+	USB_Options = Options;
+	#endif
+
+	USB_IsInitialized = true;
+
+	USB_ResetInterface();
+}
+
+void USB_Disable(void)
+{
+	USB_INT_DisableAllInterrupts();
+	USB_INT_ClearAllInterrupts();
+
+	USB_Detach();
+	USB_Controller_Disable();
+
+	USB_IsInitialized = false;
+}
+
+void USB_ResetInterface(void)
+{
+	USB_Device_SetDeviceAddress(0);
+	USB_Device_EnableDeviceAddress(0);
+
+	USB_INT_DisableAllInterrupts();
+	USB_INT_ClearAllInterrupts();
+
+	USB_Controller_Reset();
+	USB_Init_Device();
+
+	if (USB_Sim_Controller.VBUS)
+	{
+		USB_INT_Raise(USB_INT_VBUSTI);
+		USB_Sim_DispatchInterrupts();
+	}
+}
+
+#if defined(USB_CAN_BE_DEVICE)
+static void USB_Init_Device(void)
+{
+	USB_DeviceState                 = DEVICE_STATE_Unattached;
+	USB_Device_ConfigurationNumber  = 0;
+
+	#if !defined(NO_DEVICE_REMOTE_WAKEUP)
+	USB_Device_RemoteWakeupEnabled  = false;
+	#endif
+
+	#if !defined(NO_DEVICE_SELF_POWER)
+	USB_Device_CurrentlySelfPowered = false;
+	#endif
+
+	#if !defined(FIXED_CONTROL_ENDPOINT_SIZE)
+	USB_Descriptor_Device_t* DeviceDescriptorPtr;
+
+	#if defined(ARCH_HAS_MULTI_ADDRESS_SPACE) && \
+	    !(defined(USE_FLASH_DESCRIPTORS) || defined(USE_EEPROM_DESCRIPTORS) || defined(USE_RAM_DESCRIPTORS))
+	uint8_t DescriptorAddressSpace;
+
+	if (CALLBACK_USB_GetDescriptor((DTYPE_Device << 8), 0, (void*)&DeviceDescriptorPtr, &DescriptorAddressSpace) != NO_DESCRIPTOR)
+	  USB_Device_ControlEndpointSize = DeviceDescriptorPtr->Endpoint0Size;
+	#else
+	if (CALLBACK_USB_GetDescriptor((DTYPE_Device << 8), 0, (void*)&DeviceDescriptorPtr) != NO_DESCRIPTOR)
+	  USB_Device_ControlEndpointSize = DeviceDescriptorPtr->Endpoint0Size;
+	#endif
+	#endif
+
+	if (USB_Options & USB_DEVICE_OPT_LOWSPEED)
+	  USB_Device_SetLowSpeed();
+	else
+	  USB_Device_SetFullSpeed();
+
+	Endpoint_ClearEndpoints();
+	Endpoint_ConfigureEndpoint(ENDPOINT_CONTROLEP, EP_TYPE_CONTROL,
+							   USB_Device_ControlEndpointSize, 1);
+
+	USB_INT_Enable(USB_INT_VBUSTI);
+	USB_INT_Enable(USB_INT_SUSPI);
+	USB_INT_Enable(USB_INT_EORSTI);
+
+	USB_Attach();
+}
+#endif
+
+void USB_Sim_SetHostModel(const USB_Sim_HostModel_t* const HostModel)
+{
+	USB_Sim_HostModel = HostModel;
+}
+
+static void USB_Sim_AbortControlRequest(void)
+{
+	if (USB_Sim_ControlStage != USB_SIM_STAGE_Idle)
+	{
+		USB_Sim_ControlStage  = USB_SIM_STAGE_Idle;
+		USB_Sim_ControlStatus = USB_SIM_CONTROL_Aborted;
+	}
+}
+
+void USB_Sim_Connect(void)
+{
+	USB_Sim_Controller.VBUS      = true;
+	USB_Sim_Controller.Suspended = false;
+
+	USB_INT_Raise(USB_INT_VBUSTI);
+	USB_Sim_DispatchInterrupts();
+}
+
+void USB_Sim_Disconnect(void)
+{
+	USB_Sim_Controller.VBUS      = false;
+	USB_Sim_Controller.Suspended = false;
+
+	USB_Sim_AbortControlRequest();
+
+	USB_INT_Raise(USB_INT_VBUSTI);
+	USB_Sim_DispatchInterrupts();
+}
+
+void USB_Sim_BusReset(void)
+{
+	if (!(USB_Sim_Controller.VBUS) || !(USB_Sim_Controller.Attached))
+	  return;
+
+	USB_Sim_Controller.Suspended = false;
+
+	USB_Sim_AbortControlRequest();
+
+	USB_INT_Raise(USB_INT_EORSTI);
+	USB_Sim_DispatchInterrupts();
+}
+
+void USB_Sim_Suspend(void)
+{
+	if (!(USB_Sim_Controller.VBUS) || USB_Sim_Controller.Suspended)
+	  return;
+
+	USB_Sim_Controller.Suspended = true;
+
+	USB_INT_Raise(USB_INT_SUSPI);
+	USB_Sim_DispatchInterrupts();
+}
+
+void USB_Sim_Resume(void)
+{
+	if (!(USB_Sim_Controller.Suspended))
+	  return;
+
+	USB_Sim_Controller.Suspended = false;
+
+	USB_INT_Raise(USB_INT_WAKEUPI);
+	USB_Sim_DispatchInterrupts();
+}
+
+bool USB_Sim_SubmitControlRequest(const USB_Request_Header_t* const Request,
+                                  void* const Data)
+{
+	if ((USB_Sim_ControlStage != USB_SIM_STAGE_Idle) || !(USB_Sim_Controller.VBUS) || !(USB_Sim_Controller.Attached))
+	  return false;
+
+	USB_Sim_ControlRequest     = *Request;
+	USB_Sim_ControlData        = (uint8_t*)Data;
+	USB_Sim_ControlTransferred = 0;
+	USB_Sim_ControlStage       = USB_SIM_STAGE_Setup;
+	USB_Sim_ControlStatus      = USB_SIM_CONTROL_Pending;
+
+	return true;
+}
+
+uint8_t USB_Sim_GetControlStatus(void)
+{
+	return USB_Sim_ControlStatus;
+}
+
+uint16_t USB_Sim_GetControlBytesTransferred(void)
+{
+	return USB_Sim_ControlTransferred;
+}
+
+void USB_Sim_ServiceBus(void)
+{
+	if (USB_Sim_InServiceBus)
+	  return;
+
+	USB_Sim_InServiceBus = true;
+
+	if (USB_Sim_Controller.Enabled && USB_Sim_Controller.Attached &&
+	    USB_Sim_Controller.VBUS && !(USB_Sim_Controller.Suspended))
+	{
+		USB_Sim_Controller.FrameNumber = ((USB_Sim_Controller.FrameNumber + 1) & 0x07FF);
+		USB_INT_Raise(USB_INT_SOFI);
+
+		if (USB_Sim_HostModel && USB_Sim_HostModel->StartOfFrame)
+		  USB_Sim_HostModel->StartOfFrame(USB_Sim_Controller.FrameNumber);
+
+		USB_Sim_ServiceControlEndpoint();
+		USB_Sim_ServiceDataEndpoints();
+	}
+
+	USB_Sim_DispatchInterrupts();
+
+	USB_Sim_InServiceBus = false;
+}
+
+static void USB_Sim_ServiceControlEndpoint(void)
+{
+	Endpoint_FIFO_t* OUTFIFO = &USB_Endpoint_FIFOs[ENDPOINT_CONTROLEP].OUT;
+	Endpoint_FIFO_t* INFIFO  = &USB_Endpoint_FIFOs[ENDPOINT_CONTROLEP].IN;
+
+	if (USB_Sim_ControlStage == USB_SIM_STAGE_Idle)
+	  return;
+
+	if (USB_Sim_ControlStage == USB_SIM_STAGE_Setup)
+	{
+		/* SETUP packets are always accepted, and clear any pending stall or data on the control endpoint */
+		memcpy(OUTFIFO->Banks[0].Data, &USB_Sim_ControlRequest, sizeof(USB_Request_Header_t));
+		OUTFIFO->Banks[0].Length = sizeof(USB_Request_Header_t);
+		OUTFIFO->DeviceBank      = 0;
+		OUTFIFO->HostBank        = 0;
+		OUTFIFO->Position        = 0;
+		OUTFIFO->BanksQueued     = 1;
+		OUTFIFO->Flags           = ((OUTFIFO->Flags & ~ENDPOINT_SIM_FLAG_STALLED) | ENDPOINT_SIM_FLAG_SETUP);
+
+		INFIFO->DeviceBank       = 0;
+		INFIFO->HostBank         = 0;
+		INFIFO->Position         = 0;
+		INFIFO->BanksQueued      = 0;
+		INFIFO->Flags           &= ~ENDPOINT_SIM_FLAG_STALLED;
+
+		if (!(USB_Sim_ControlRequest.wLength))
+		  USB_Sim_ControlStage = USB_SIM_STAGE_StatusIN;
+		else if (USB_Sim_ControlRequest.bmRequestType & REQDIR_DEVICETOHOST)
+		  USB_Sim_ControlStage = USB_SIM_STAGE_DataIN;
+		else
+		  USB_Sim_ControlStage = USB_SIM_STAGE_DataOUT;
+
+		return;
+	}
+
+	if ((OUTFIFO->Flags | INFIFO->Flags) & ENDPOINT_SIM_FLAG_STALLED)
+	{
+		USB_Sim_ControlStage  = USB_SIM_STAGE_Idle;
+		USB_Sim_ControlStatus = USB_SIM_CONTROL_Stalled;
+		return;
+	}
+
+	/* The host cannot start the next stage until the device has acknowledged the SETUP packet */
+	if (OUTFIFO->Flags & ENDPOINT_SIM_FLAG_SETUP)
+	  return;
+
+	switch (USB_Sim_ControlStage)
+	{
+		case USB_SIM_STAGE_DataIN:
+			if (INFIFO->BanksQueued)
+			{
+				uint16_t PacketLength = INFIFO->Banks[INFIFO->HostBank].Length;
+				uint16_t BytesToCopy  = MIN(PacketLength, (USB_Sim_ControlRequest.wLength - USB_Sim_ControlTransferred));
+
+				if (USB_Sim_ControlData)
+				  memcpy(&USB_Sim_ControlData[USB_Sim_ControlTransferred], INFIFO->Banks[INFIFO->HostBank].Data, BytesToCopy);
+
+				USB_Sim_ControlTransferred += BytesToCopy;
+
+				INFIFO->BanksQueued--;
+				INFIFO->HostBank = 0;
+
+				if ((PacketLength < INFIFO->Size) || (USB_Sim_ControlTransferred == USB_Sim_ControlRequest.wLength))
+				  USB_Sim_ControlStage = USB_SIM_STAGE_StatusOUT;
+			}
+
+			break;
+		case USB_SIM_STAGE_DataOUT:
+			if (!(OUTFIFO->BanksQueued))
+			{
+				uint16_t BytesToSend = MIN(OUTFIFO->Size, (USB_Sim_ControlRequest.wLength - USB_Sim_ControlTransferred));
+
+				if (USB_Sim_ControlData)
+				  memcpy(OUTFIFO->Banks[0].Data, &USB_Sim_ControlData[USB_Sim_ControlTransferred], BytesToSend);
+				else
+				  memset(OUTFIFO->Banks[0].Data, 0x00, BytesToSend);
+
+				OUTFIFO->Banks[0].Length = BytesToSend;
+				OUTFIFO->BanksQueued     = 1;
+
+				USB_Sim_ControlTransferred += BytesToSend;
+
+				if (USB_Sim_ControlTransferred == USB_Sim_ControlRequest.wLength)
+				  USB_Sim_ControlStage = USB_SIM_STAGE_StatusIN;
+			}
+
+			break;
+		case USB_SIM_STAGE_StatusIN:
+			if (INFIFO->BanksQueued && !(OUTFIFO->BanksQueued))
+			{
+				INFIFO->BanksQueued--;
+				INFIFO->HostBank = 0;
+
+				USB_Sim_ControlStage  = USB_SIM_STAGE_Idle;
+				USB_Sim_ControlStatus = USB_SIM_CONTROL_Complete;
+			}
+
+			break;
+		case USB_SIM_STAGE_StatusOUT:
+			if (!(OUTFIFO->BanksQueued))
+			{
+				OUTFIFO->Banks[0].Length = 0;
+				OUTFIFO->BanksQueued     = 1;
+
+				USB_Sim_ControlStage = USB_SIM_STAGE_StatusOUTAck;
+			}
+
+			break;
+		case USB_SIM_STAGE_StatusOUTAck:
+			if (!(OUTFIFO->BanksQueued))
+			{
+				USB_Sim_ControlStage  = USB_SIM_STAGE_Idle;
+				USB_Sim_ControlStatus = USB_SIM_CONTROL_Complete;
+			}
+
+			break;
+	}
+}
+
+static void USB_Sim_ServiceDataEndpoints(void)
+{
+	if (!(USB_Sim_HostModel))
+	  return;
+
+	for (uint8_t EPNum = 1; EPNum < ENDPOINT_TOTAL_ENDPOINTS; EPNum++)
+	{
+		Endpoint_FIFO_t* INFIFO  = &USB_Endpoint_FIFOs[EPNum].IN;
+		Endpoint_FIFO_t* OUTFIFO = &USB_Endpoint_FIFOs[EPNum].OUT;
+
+		if (((INFIFO->Flags & (ENDPOINT_SIM_FLAG_CONFIGURED | ENDPOINT_SIM_FLAG_STALLED)) == ENDPOINT_SIM_FLAG_CONFIGURED) &&
+		    INFIFO->BanksQueued && USB_Sim_HostModel->INPacketReceived)
+		{
+			Endpoint_Bank_t* Bank = &INFIFO->Banks[INFIFO->HostBank];
+
+			USB_Sim_HostModel->INPacketReceived((EPNum | ENDPOINT_DIR_IN), Bank->Data, Bank->Length);
+
+			INFIFO->BanksQueued--;
+
+			if (++INFIFO->HostBank == INFIFO->TotalBanks)
+			  INFIFO->HostBank = 0;
+		}
+
+		if (((OUTFIFO->Flags & (ENDPOINT_SIM_FLAG_CONFIGURED | ENDPOINT_SIM_FLAG_STALLED)) == ENDPOINT_SIM_FLAG_CONFIGURED) &&
+		    (OUTFIFO->BanksQueued < OUTFIFO->TotalBanks) && USB_Sim_HostModel->OUTPacketRequested)
+		{
+			Endpoint_Bank_t* Bank = &OUTFIFO->Banks[OUTFIFO->HostBank];
+
+			int16_t PacketLength = USB_Sim_HostModel->OUTPacketRequested(EPNum, Bank->Data, OUTFIFO->Size);
+
+			if (PacketLength >= 0)
+			{
+				Bank->Length = MIN((uint16_t)PacketLength, OUTFIFO->Size);
+
+				OUTFIFO->BanksQueued++;
+
+				if (++OUTFIFO->HostBank == OUTFIFO->TotalBanks)
+				  OUTFIFO->HostBank = 0;
+			}
+		}
+	}
+}
+
+static void USB_Sim_DispatchInterrupts(void)
+{
+	if (!(SIM_GlobalInterruptState) || !(USB_INT_IsPending()))
+	  return;
+
+	uint8_t PrevSelectedEndpoint = Endpoint_GetCurrentEndpoint();
+
+	GlobalInterruptDisable();
+	USB_GEN_vect();
+	GlobalInterruptEnable();
+
+	Endpoint_SelectEndpoint(PrevSelectedEndpoint);
+}
+
+#endif
@@ -0,0 +1,390 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2021.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2021  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *  \brief USB Controller definitions for the simulated USB controller.
+ *  \copydetails Group_USBManagement_SIM
+ *
+ *  \note This file should not be included directly. It is automatically included as needed by the USB driver
+ *        dispatch header located in LUFA/Drivers/USB/USB.h.
+ */
+
+/** \ingroup Group_USBManagement
+ *  \defgroup Group_USBManagement_SIM USB Interface Management (SIM)
+ *  \brief USB Controller definitions for the simulated USB controller.
+ *
+ *  Functions, macros, variables, enums and types related to the setup and management of the USB interface,
+ *  and of the scripted USB host model which drives the simulated bus.
+ *
+ *  The simulated controller allows the unmodified USB core and class drivers to be compiled natively for a
+ *  development PC (with \c ARCH set to \c SIM), so that they can be exercised and profiled without hardware.
+ *  The bus is advanced one frame at a time by \ref USB_Sim_ServiceBus(), which the endpoint management
+ *  functions call automatically whenever the device polls an endpoint that is not yet ready. Within each
+ *  frame the host model completes at most one packet per endpoint direction, and performs control transfers
+ *  queued via \ref USB_Sim_SubmitControlRequest() on the default control endpoint.
+ *
+ *  \note The simulated controller supports USB Device mode only; the host mode drivers are not available for
+ *        this architecture, and defining \c USB_HOST_ONLY produces a compilation error.
+ *
+ *  <b>Example Usage:</b>
+ *  \code
+ *  static void HostModel_INPacket(const uint8_t Address, const uint8_t* const Data, const uint16_t Length)
+ *  {
+ *      // Consume data sent by the device on an IN endpoint
+ *  }
+ *
+ *  static int16_t HostModel_OUTPacket(const uint8_t Address, uint8_t* const Data, const uint16_t MaxLength)
+ *  {
+ *      // Fill Data with up to MaxLength bytes for an OUT endpoint, or return -1 to NAK
+ *      return -1;
+ *  }
+ *
+ *  static const USB_Sim_HostModel_t HostModel =
+ *      {
+ *          .INPacketReceived   = HostModel_INPacket,
+ *          .OUTPacketRequested = HostModel_OUTPacket,
+ *      };
+ *
+ *  USB_Init();
+ *  GlobalInterruptEnable();
+ *
+ *  USB_Sim_SetHostModel(&HostModel);
+ *  USB_Sim_Connect();
+ *  USB_Sim_BusReset();
+ *
+ *  USB_Request_Header_t SetConfig = {.bmRequestType = (REQDIR_HOSTTODEVICE | REQTYPE_STANDARD | REQREC_DEVICE),
+ *                                    .bRequest = REQ_SetConfiguration, .wValue = 1};
+ *  USB_Sim_SubmitControlRequest(&SetConfig, NULL);
+ *
+ *  while (USB_Sim_GetControlStatus() == USB_SIM_CONTROL_Pending)
+ *  {
+ *      USB_USBTask();
+ *      USB_Sim_ServiceBus();
+ *  }
+ *  \endcode
+ *
+ *  @{
+ */
+
+#ifndef __USBCONTROLLER_SIM_H__
+#define __USBCONTROLLER_SIM_H__
+
+	/* Includes: */
+		#include "../../../../Common/Common.h"
+		#include "../USBMode.h"
+		#include "../Events.h"
+		#include "../USBTask.h"
+		#include "../USBInterrupt.h"
+		#include "../StdRequestType.h"
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Type Defines: */
+			typedef struct
+			{
+				bool     Enabled;
+				bool     Attached;
+				bool     VBUS;
+				bool     Suspended;
+				bool     LowSpeed;
+				uint8_t  Address;
+				uint16_t FrameNumber;
+			} USB_Sim_Controller_t;
+
+		/* External Variables: */
+			extern USB_Sim_Controller_t USB_Sim_Controller;
+	#endif
+
+	/* Includes: */
+		#if defined(USB_CAN_BE_DEVICE) || defined(__DOXYGEN__)
+			#include "../Device.h"
+			#include "../Endpoint.h"
+			#include "../DeviceStandardReq.h"
+			#include "../EndpointStream.h"
+		#endif
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks and Defines: */
+		#if !defined(__INCLUDE_FROM_USB_DRIVER)
+			#error Do not include this file directly. Include LUFA/Drivers/USB/USB.h instead.
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			#if !defined(USB_STREAM_TIMEOUT_MS) || defined(__DOXYGEN__)
+				/** Constant for the maximum software timeout period of the USB data stream transfer functions
+				 *  (both control and standard) when in either device or host mode. If the next packet of a stream
+				 *  is not received or acknowledged within this time period, the stream function will fail.
+				 *
+				 *  On the simulated controller, this period is measured in simulated bus frames.
+				 *
+				 *  This value may be overridden in the user project makefile as the value of the
+				 *  \ref USB_STREAM_TIMEOUT_MS token, and passed to the compiler using the -D switch.
+				 */
+				#define USB_STREAM_TIMEOUT_MS       100
+			#endif
+
+		/* Enums: */
+			/** Enum for the possible states of a control transfer submitted to the simulated host model via
+			 *  \ref USB_Sim_SubmitControlRequest().
+			 */
+			enum USB_Sim_ControlStatus_t
+			{
+				USB_SIM_CONTROL_Idle     = 0, /**< No control transfer has been submitted. */
+				USB_SIM_CONTROL_Pending  = 1, /**< Control transfer is currently in progress. */
+				USB_SIM_CONTROL_Complete = 2, /**< Control transfer completed, including its status stage. */
+				USB_SIM_CONTROL_Stalled  = 3, /**< Control transfer was stalled by the device. */
+				USB_SIM_CONTROL_Aborted  = 4, /**< Control transfer was aborted by a bus reset or disconnection. */
+			};
+
+		/* Type Defines: */
+			/** Type define for the scripted USB host model which drives the simulated bus. Any of the callback
+			 *  members may be \c NULL, in which case the host NAKs all traffic of that type.
+			 */
+			typedef struct
+			{
+				/** Called at the start of every simulated bus frame, before any packets are exchanged.
+				 *
+				 *  \param[in] FrameNumber  Number of the frame which is starting.
+				 */
+				void    (*StartOfFrame)(const uint16_t FrameNumber);
+
+				/** Called when the device has committed a packet on a non-control IN endpoint.
+				 *
+				 *  \param[in] Address  Address of the endpoint the packet was sent on.
+				 *  \param[in] Data     Pointer to the packet data.
+				 *  \param[in] Length   Length of the packet in bytes, zero for a zero length packet.
+				 */
+				void    (*INPacketReceived)(const uint8_t Address,
+				                            const uint8_t* const Data,
+				                            const uint16_t Length);
+
+				/** Called when a non-control OUT endpoint of the device has a free bank available.
+				 *
+				 *  \param[in]  Address    Address of the endpoint the packet will be sent on.
+				 *  \param[out] Data       Buffer to fill with the packet data.
+				 *  \param[in]  MaxLength  Maximum packet size of the endpoint.
+				 *
+				 *  \return Length of the packet to send in bytes, or a negative value if no packet should be sent.
+				 */
+				int16_t (*OUTPacketRequested)(const uint8_t Address,
+				                              uint8_t* const Data,
+				                              const uint16_t MaxLength);
+			} USB_Sim_HostModel_t;
+
+		/* Inline Functions: */
+			/** Detaches the device from the USB bus. This has the effect of removing the device from any
+			 *  attached host, ceasing USB communications. If no host is present, this prevents any host from
+			 *  enumerating the device once attached until \ref USB_Attach() is called.
+			 */
+			static inline void USB_Detach(void) ATTR_ALWAYS_INLINE;
+			static inline void USB_Detach(void)
+			{
+				USB_Sim_Controller.Attached = false;
+			}
+
+			/** Attaches the device to the USB bus. This announces the device's presence to any attached
+			 *  USB host, starting the enumeration process. If no host is present, attaching the device
+			 *  will allow for enumeration once a host is connected to the device.
+			 */
+			static inline void USB_Attach(void) ATTR_ALWAYS_INLINE;
+			static inline void USB_Attach(void)
+			{
+				USB_Sim_Controller.Attached = true;
+			}
+
+		/* Function Prototypes: */
+			/** Main function to initialize and start the USB interface. Once active, the USB interface will
+			 *  allow for device connection to a host when in device mode.
+			 *
+			 *  As the USB library relies on interrupts for the device enumeration process, the user must enable
+			 *  global interrupts before or shortly after this function is called, otherwise simulated bus events
+			 *  will remain pending.
+			 *
+			 *  Calling this function when the USB interface is already initialized will cause a complete USB
+			 *  interface reset and re-enumeration.
+			 *
+			 *  \param[in] Options  Mask indicating the options which should be used when initializing the USB
+			 *                      interface to control the USB interface's behavior. This should be a
+			 *                      \c USB_DEVICE_OPT_* mask to set the device mode speed.
+			 *
+			 *  \note To reduce the FLASH requirements of the library if only fixed settings are required,
+			 *        the options may be set statically. To statically set the USB options, pass in the
+			 *        \c USE_STATIC_OPTIONS token, defined to the appropriate options masks. When the options
+			 *        are statically set, this parameter does not exist in the function prototype.
+			 *
+			 *  \see \ref Group_Device for the \c USB_DEVICE_OPT_* masks.
+			 */
+			void USB_Init(
+			               #if !defined(USE_STATIC_OPTIONS) || defined(__DOXYGEN__)
+			               const uint8_t Options
+			               #else
+			               void
+			               #endif
+			               );
+
+			/** Shuts down the USB interface. This turns off the USB interface after deallocating all USB FIFO
+			 *  memory, endpoints and pipes. When turned off, no USB functionality can be used until the interface
+			 *  is restarted with the \ref USB_Init() function.
+			 */
+			void USB_Disable(void);
+
+			/** Resets the interface, when already initialized. This will re-enumerate the device if already connected
+			 *  to a host.
+			 */
+			void USB_ResetInterface(void);
+
+			/** \name Simulated Host Model */
+			/**@{*/
+
+			/** Sets the scripted host model which exchanges data with the device's non-control endpoints.
+			 *
+			 *  \param[in] HostModel  Pointer to the host model callbacks, or \c NULL to NAK all endpoint traffic.
+			 */
+			void USB_Sim_SetHostModel(const USB_Sim_HostModel_t* const HostModel);
+
+			/** Simulates the application of VBUS to the device, raising a connection event. */
+			void USB_Sim_Connect(void);
+
+			/** Simulates the removal of VBUS from the device, raising a disconnection event and aborting
+			 *  any pending control transfer.
+			 */
+			void USB_Sim_Disconnect(void);
+
+			/** Simulates a USB bus reset issued by the host, aborting any pending control transfer. */
+			void USB_Sim_BusReset(void);
+
+			/** Simulates the host suspending the USB bus. No further frames are generated until the bus is resumed. */
+			void USB_Sim_Suspend(void);
+
+			/** Simulates the host resuming a suspended USB bus. */
+			void USB_Sim_Resume(void);
+
+			/** Submits a control transfer to the default control endpoint of the device. The transfer is performed
+			 *  over subsequent simulated bus frames, and its progress may be checked via \ref USB_Sim_GetControlStatus().
+			 *
+			 *  \param[in]     Request  Pointer to the request header to send in the SETUP stage.
+			 *  \param[in,out] Data     Pointer to the data stage buffer, of at least \c wLength bytes. Data is read from
+			 *                          this buffer for host-to-device requests, and written to it for device-to-host
+			 *                          requests. May be \c NULL if the request has no data stage.
+			 *
+			 *  \return Boolean \c true if the request was queued, \c false if a control transfer is already pending
+			 *          or the device is not attached to the simulated bus.
+			 */
+			bool USB_Sim_SubmitControlRequest(const USB_Request_Header_t* const Request,
+			                                  void* const Data) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Retrieves the status of the last control transfer submitted via \ref USB_Sim_SubmitControlRequest().
+			 *
+			 *  \return A value from the \ref USB_Sim_ControlStatus_t enum.
+			 */
+			uint8_t USB_Sim_GetControlStatus(void) ATTR_WARN_UNUSED_RESULT;
+
+			/** Retrieves the number of bytes exchanged in the data stage of the last control transfer submitted via
+			 *  \ref USB_Sim_SubmitControlRequest().
+			 *
+			 *  \return Number of data stage bytes transferred.
+			 */
+			uint16_t USB_Sim_GetControlBytesTransferred(void) ATTR_WARN_UNUSED_RESULT;
+
+			/** Advances the simulated bus by one frame. Each frame raises a Start Of Frame event, advances any
+			 *  pending control transfer by one packet, exchanges at most one packet per non-control endpoint
+			 *  direction with the host model and finally dispatches any pending USB interrupts.
+			 *
+			 *  This is called automatically by the endpoint management functions when the device polls an endpoint
+			 *  that is not yet ready, but may also be called directly by the application's main loop. Nested calls
+			 *  made from within host model callbacks or USB event handlers are ignored.
+			 */
+			void USB_Sim_ServiceBus(void);
+			/**@}*/
+
+		/* Global Variables: */
+			/** Indicates the mode that the USB interface is currently initialized to. As the simulated controller
+			 *  supports device mode only, this always evaluates to \ref USB_MODE_Device.
+			 */
+			#define USB_CurrentMode USB_MODE_Device
+
+			#if !defined(USE_STATIC_OPTIONS) || defined(__DOXYGEN__)
+				/** Indicates the current USB options that the USB interface was initialized with when \ref USB_Init()
+				 *  was called. This value will be one of the \c USB_MODE_* masks defined elsewhere in this module.
+				 *
+				 *  \attention This variable should be treated as read-only in the user application, and never manually
+				 *             changed in value.
+				 */
+				extern volatile uint8_t USB_Options;
+			#elif defined(USE_STATIC_OPTIONS)
+				#define USB_Options USE_STATIC_OPTIONS
+			#endif
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Function Prototypes: */
+			#if defined(__INCLUDE_FROM_USB_CONTROLLER_C)
+				static void USB_Init_Device(void);
+				static void USB_Sim_ServiceControlEndpoint(void);
+				static void USB_Sim_ServiceDataEndpoints(void);
+				static void USB_Sim_DispatchInterrupts(void);
+			#endif
+
+		/* Inline Functions: */
+			static inline void USB_Controller_Enable(void) ATTR_ALWAYS_INLINE;
+			static inline void USB_Controller_Enable(void)
+			{
+				USB_Sim_Controller.Enabled = true;
+			}
+
+			static inline void USB_Controller_Disable(void) ATTR_ALWAYS_INLINE;
+			static inline void USB_Controller_Disable(void)
+			{
+				USB_Sim_Controller.Enabled = false;
+			}
+
+			static inline void USB_Controller_Reset(void) ATTR_ALWAYS_INLINE;
+			static inline void USB_Controller_Reset(void)
+			{
+				USB_Sim_Controller.Enabled     = true;
+				USB_Sim_Controller.Suspended   = false;
+				USB_Sim_Controller.FrameNumber = 0;
+			}
+	#endif
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
+
@@ -37,6 +37,7 @@
 #if defined(USB_CAN_BE_DEVICE)
 
 #include "../Endpoint.h"
+#include "../EndpointTransfer.h"
 
 #if !defined(FIXED_CONTROL_ENDPOINT_SIZE)
 uint8_t USB_Device_ControlEndpointSize = ENDPOINT_CONTROLEP_DEFAULT_SIZE;
@@ -191,6 +192,76 @@ uint8_t Endpoint_WaitUntilReady(void)
 }
 #endif
 
+#if !defined(CONTROL_ONLY_DEVICE) && defined(ENDPOINT_TRANSFER_USE_DMA)
+uint16_t Endpoint_StartTransferDMA_PRV(USB_Endpoint_Transfer_t* const Transfer)
+{
+	uint8_t  EndpointNumber = USB_Endpoint_SelectedEndpoint;
+	uint16_t PacketSize     = Transfer->Config.Endpoint->Size;
+	uint16_t SegmentLength  = (Transfer->Config.Length - Transfer->State.BytesTransferred);
+	uint32_t DMAControl     = (ENDPOINT_DMA_CONTROL_CH_EN | ENDPOINT_DMA_CONTROL_BURST_LOCK_EN);
+
+	/* Only the non-control endpoints of the USBB controller have a DMA channel */
+	if ((EndpointNumber < ENDPOINT_DMA_FIRST_ENDPOINT) || (EndpointNumber > ENDPOINT_DMA_LAST_ENDPOINT))
+	  return 0;
+
+	if (Transfer->Config.Endpoint->Address & ENDPOINT_DIR_IN)
+	{
+		/* A partially filled bank must be completed and sent by the CPU first */
+		if (USB_Endpoint_FIFOPos[EndpointNumber] != &AVR32_USBB_SLAVE[EndpointNumber * ENDPOINT_HSB_ADDRESS_SPACE_SIZE])
+		  return 0;
+
+		/* Send the final short packet once the end of the buffer is reached */
+		DMAControl |= ENDPOINT_DMA_CONTROL_DMAEND_EN;
+	}
+	else
+	{
+		/* The controller always stores a whole received packet, so only whole packets can be received directly */
+		SegmentLength -= (SegmentLength % PacketSize);
+
+		if (!(SegmentLength))
+		  return 0;
+
+		/* End the segment early if the host ends the transfer with a short packet */
+		DMAControl |= (ENDPOINT_DMA_CONTROL_END_TR_EN | ENDPOINT_DMA_CONTROL_BUFF_CLOSE_IN_EN);
+
+		/* Release the bank just drained by the CPU, so that the controller can fill it for the DMA channel */
+		Endpoint_ClearOUT();
+	}
+
+	ENDPOINT_DMA_CHANNEL(EndpointNumber).Address = (uintptr_t)&((uint8_t*)Transfer->Config.Buffer)[Transfer->State.BytesTransferred];
+	ENDPOINT_DMA_CHANNEL(EndpointNumber).Control = (DMAControl | ((uint32_t)SegmentLength << ENDPOINT_DMA_CONTROL_CH_BYTE_LENGTH_SHIFT));
+
+	return SegmentLength;
+}
+
+bool Endpoint_IsTransferDMAComplete_PRV(USB_Endpoint_Transfer_t* const Transfer,
+                                        uint16_t* const BytesTransferred)
+{
+	uint8_t  EndpointNumber = USB_Endpoint_SelectedEndpoint;
+	uint32_t DMAStatus      = ENDPOINT_DMA_CHANNEL(EndpointNumber).Status;
+
+	if (DMAStatus & ENDPOINT_DMA_STATUS_CH_EN)
+	  return false;
+
+	*BytesTransferred = (Transfer->State.SegmentLength - (uint16_t)(DMAStatus >> ENDPOINT_DMA_STATUS_CH_BYTE_CNT_SHIFT));
+
+	USB_Endpoint_FIFOPos[EndpointNumber] = &AVR32_USBB_SLAVE[EndpointNumber * ENDPOINT_HSB_ADDRESS_SPACE_SIZE];
+	return true;
+}
+
+void Endpoint_AbortTransferDMA_PRV(USB_Endpoint_Transfer_t* const Transfer)
+{
+	uint8_t EndpointNumber = USB_Endpoint_SelectedEndpoint;
+
+	ENDPOINT_DMA_CHANNEL(EndpointNumber).Control = 0;
+
+	if (Transfer->Config.Endpoint->Address & ENDPOINT_DIR_IN)
+	  Endpoint_AbortPendingIN();
+
+	USB_Endpoint_FIFOPos[EndpointNumber] = &AVR32_USBB_SLAVE[EndpointNumber * ENDPOINT_HSB_ADDRESS_SPACE_SIZE];
+}
+#endif
+
 #endif
 
 #endif
@@ -92,6 +92,30 @@
 		/* Macros: */
 			#define ENDPOINT_HSB_ADDRESS_SPACE_SIZE            (64 * 1024UL)
 
+			#define ENDPOINT_DMA_FIRST_ENDPOINT                1
+			#define ENDPOINT_DMA_LAST_ENDPOINT                 6
+
+			#define ENDPOINT_DMA_CONTROL_CH_EN                 (1UL << 0)
+			#define ENDPOINT_DMA_CONTROL_BUFF_CLOSE_IN_EN      (1UL << 2)
+			#define ENDPOINT_DMA_CONTROL_DMAEND_EN             (1UL << 3)
+			#define ENDPOINT_DMA_CONTROL_END_TR_EN             (1UL << 4)
+			#define ENDPOINT_DMA_CONTROL_BURST_LOCK_EN         (1UL << 8)
+			#define ENDPOINT_DMA_CONTROL_CH_BYTE_LENGTH_SHIFT  16
+
+			#define ENDPOINT_DMA_STATUS_CH_EN                  (1UL << 0)
+			#define ENDPOINT_DMA_STATUS_CH_BYTE_CNT_SHIFT      16
+
+			#define ENDPOINT_DMA_CHANNEL(EndpointNumber)       (((volatile Endpoint_DMAChannel_t*)&AVR32_USBB.uddma1_nextdesc)[(EndpointNumber) - 1])
+
+		/* Type Defines: */
+			typedef struct
+			{
+				uint32_t NextDescriptor;
+				uint32_t Address;
+				uint32_t Control;
+				uint32_t Status;
+			} Endpoint_DMAChannel_t;
+
 		/* Inline Functions: */
 			static inline uint32_t Endpoint_BytesToEPSizeMask(const uint16_t Bytes) ATTR_WARN_UNUSED_RESULT ATTR_CONST
 			                                                                        ATTR_ALWAYS_INLINE;
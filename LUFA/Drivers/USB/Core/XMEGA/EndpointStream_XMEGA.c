@@ -116,6 +116,7 @@ uint8_t Endpoint_Null_Stream(uint16_t Length,
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr += Amount
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_8(*BufferPtr)
+#define  TEMPLATE_TRANSFER_BLOCK(BufferPtr, FIFOPtr, Amount)  memcpy(FIFOPtr, BufferPtr, Amount)
 #include "Template/Template_Endpoint_RW.c"
 
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Stream_BE
@@ -132,6 +133,7 @@ uint8_t Endpoint_Null_Stream(uint16_t Length,
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr += Amount
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         *BufferPtr = Endpoint_Read_8()
+#define  TEMPLATE_TRANSFER_BLOCK(BufferPtr, FIFOPtr, Amount)  memcpy(BufferPtr, FIFOPtr, Amount)
 #include "Template/Template_Endpoint_RW.c"
 
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Read_Stream_BE
@@ -149,6 +151,7 @@ uint8_t Endpoint_Null_Stream(uint16_t Length,
 	#define  TEMPLATE_BUFFER_OFFSET(Length)            0
 	#define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr += Amount
 	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_8(pgm_read_byte(BufferPtr))
+	#define  TEMPLATE_TRANSFER_BLOCK(BufferPtr, FIFOPtr, Amount)  memcpy_P(FIFOPtr, BufferPtr, Amount)
 	#include "Template/Template_Endpoint_RW.c"
 
 	#define  TEMPLATE_FUNC_NAME                        Endpoint_Write_PStream_BE
@@ -167,6 +170,7 @@ uint8_t Endpoint_Null_Stream(uint16_t Length,
 	#define  TEMPLATE_BUFFER_OFFSET(Length)            0
 	#define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr += Amount
 	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_8(eeprom_read_byte(BufferPtr))
+	#define  TEMPLATE_TRANSFER_BLOCK(BufferPtr, FIFOPtr, Amount)  eeprom_read_block(FIFOPtr, BufferPtr, Amount)
 	#include "Template/Template_Endpoint_RW.c"
 
 	#define  TEMPLATE_FUNC_NAME                        Endpoint_Write_EStream_BE
@@ -183,6 +187,7 @@ uint8_t Endpoint_Null_Stream(uint16_t Length,
 	#define  TEMPLATE_BUFFER_OFFSET(Length)            0
 	#define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr += Amount
 	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         eeprom_update_byte(BufferPtr, Endpoint_Read_8())
+	#define  TEMPLATE_TRANSFER_BLOCK(BufferPtr, FIFOPtr, Amount)  eeprom_update_block(FIFOPtr, BufferPtr, Amount)
 	#include "Template/Template_Endpoint_RW.c"
 
 	#define  TEMPLATE_FUNC_NAME                        Endpoint_Read_EStream_BE
@@ -37,6 +37,7 @@
 #if defined(USB_CAN_BE_DEVICE)
 
 #include "../Endpoint.h"
+#include "../EndpointTransfer.h"
 
 #if !defined(FIXED_CONTROL_ENDPOINT_SIZE)
 uint8_t USB_Device_ControlEndpointSize = ENDPOINT_CONTROLEP_DEFAULT_SIZE;
@@ -48,20 +49,65 @@ volatile uint8_t          USB_Endpoint_SelectedEndpoint;
 volatile USB_EP_t*        USB_Endpoint_SelectedHandle;
 volatile Endpoint_FIFO_t* USB_Endpoint_SelectedFIFO;
 
+/* The endpoint STATUS registers are also written by the USB controller, so flags are cleared and set using the
+ * XMEGA atomic load-and-clear/load-and-set instructions to avoid losing flags set by the controller for the other
+ * ping-pong bank during a read-modify-write. */
+static inline void Endpoint_ClearStatusFlags(uint8_t Mask)
+{
+	__asm__ __volatile__ ("lac Z, %0" : "+r" (Mask) : "z" (&USB_Endpoint_SelectedHandle->STATUS) : "memory");
+}
+
+static inline void Endpoint_SetStatusFlags(uint8_t Mask)
+{
+	__asm__ __volatile__ ("las Z, %0" : "+r" (Mask) : "z" (&USB_Endpoint_SelectedHandle->STATUS) : "memory");
+}
+
+/* When ping-pong banking is used, the second bank's data pointer and byte count are held in the descriptor of the
+ * opposite direction of the same endpoint number, while the flags for both banks remain in the first descriptor. */
+static inline volatile USB_EP_t* Endpoint_GetBankHandle(void)
+{
+	uint8_t EndpointNumber = (USB_Endpoint_SelectedEndpoint & ENDPOINT_EPNUM_MASK);
+
+	if (!(USB_Endpoint_FIFOs[EndpointNumber].Bank))
+	  return USB_Endpoint_SelectedHandle;
+
+	if (USB_Endpoint_SelectedEndpoint & ENDPOINT_DIR_IN)
+	  return &((USB_EndpointTable_t*)USB.EPPTR)->Endpoints[EndpointNumber].OUT;
+	else
+	  return &((USB_EndpointTable_t*)USB.EPPTR)->Endpoints[EndpointNumber].IN;
+}
+
+static void Endpoint_NextBank(void)
+{
+	Endpoint_FIFOPair_t* EndpointFIFOPair = &USB_Endpoint_FIFOs[USB_Endpoint_SelectedEndpoint & ENDPOINT_EPNUM_MASK];
+
+	if (!(EndpointFIFOPair->PingPong))
+	  return;
+
+	EndpointFIFOPair->Bank ^= 1;
+	Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint);
+}
+
 bool Endpoint_IsINReady(void)
 {
 	Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint | ENDPOINT_DIR_IN);
 
-	return ((USB_Endpoint_SelectedHandle->STATUS & USB_EP_BUSNACK0_bm) ? true : false);
+	uint8_t BankFreeMask = USB_Endpoint_FIFOs[USB_Endpoint_SelectedEndpoint & ENDPOINT_EPNUM_MASK].Bank ?
+	                       USB_EP_BUSNACK1_bm : USB_EP_BUSNACK0_bm;
+
+	return ((USB_Endpoint_SelectedHandle->STATUS & BankFreeMask) ? true : false);
 }
 
 bool Endpoint_IsOUTReceived(void)
 {
 	Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint & ~ENDPOINT_DIR_IN);
 
-	if (USB_Endpoint_SelectedHandle->STATUS & USB_EP_TRNCOMPL0_bm)
+	uint8_t BankFullMask = USB_Endpoint_FIFOs[USB_Endpoint_SelectedEndpoint & ENDPOINT_EPNUM_MASK].Bank ?
+	                       USB_EP_TRNCOMPL1_bm : USB_EP_TRNCOMPL0_bm;
+
+	if (USB_Endpoint_SelectedHandle->STATUS & BankFullMask)
 	{
-		USB_Endpoint_SelectedFIFO->Length = USB_Endpoint_SelectedHandle->CNT;
+		USB_Endpoint_SelectedFIFO->Length = Endpoint_GetBankHandle()->CNT;
 		return true;
 	}
 
@@ -95,36 +141,74 @@ void Endpoint_ClearSETUP(void)
 
 void Endpoint_ClearIN(void)
 {
-	USB_Endpoint_SelectedHandle->CNT     = USB_Endpoint_SelectedFIFO->Position;
-	USB_Endpoint_SelectedHandle->STATUS &= ~(USB_EP_TRNCOMPL0_bm | USB_EP_BUSNACK0_bm | USB_EP_OVF_bm);
-	USB_Endpoint_SelectedFIFO->Position  = 0;
+	Endpoint_GetBankHandle()->CNT = USB_Endpoint_SelectedFIFO->Position;
+
+	if (USB_Endpoint_FIFOs[USB_Endpoint_SelectedEndpoint & ENDPOINT_EPNUM_MASK].Bank)
+	  Endpoint_ClearStatusFlags(USB_EP_TRNCOMPL1_bm | USB_EP_BUSNACK1_bm | USB_EP_OVF_bm);
+	else
+	  Endpoint_ClearStatusFlags(USB_EP_TRNCOMPL0_bm | USB_EP_BUSNACK0_bm | USB_EP_OVF_bm);
+
+	USB_Endpoint_SelectedFIFO->Position = 0;
+	Endpoint_NextBank();
 }
 
 void Endpoint_ClearOUT(void)
 {
-	USB_Endpoint_SelectedHandle->STATUS &= ~(USB_EP_TRNCOMPL0_bm | USB_EP_BUSNACK0_bm | USB_EP_OVF_bm);
-	USB_Endpoint_SelectedFIFO->Position  = 0;
+	if (USB_Endpoint_FIFOs[USB_Endpoint_SelectedEndpoint & ENDPOINT_EPNUM_MASK].Bank)
+	  Endpoint_ClearStatusFlags(USB_EP_TRNCOMPL1_bm | USB_EP_BUSNACK1_bm | USB_EP_OVF_bm);
+	else
+	  Endpoint_ClearStatusFlags(USB_EP_TRNCOMPL0_bm | USB_EP_BUSNACK0_bm | USB_EP_OVF_bm);
+
+	USB_Endpoint_SelectedFIFO->Position = 0;
+	Endpoint_NextBank();
 }
 
-void Endpoint_StallTransaction(void)
+void Endpoint_AbortPendingIN(void)
 {
-	USB_Endpoint_SelectedHandle->CTRL |= USB_EP_STALL_bm;
+	Endpoint_FIFOPair_t* EndpointFIFOPair = &USB_Endpoint_FIFOs[USB_Endpoint_SelectedEndpoint & ENDPOINT_EPNUM_MASK];
 
-	if ((USB_Endpoint_SelectedHandle->CTRL & USB_EP_TYPE_gm) == USB_EP_TYPE_CONTROL_gc)
+	Endpoint_SetStatusFlags(EndpointFIFOPair->PingPong ? (USB_EP_BUSNACK0_bm | USB_EP_BUSNACK1_bm) : USB_EP_BUSNACK0_bm);
+
+	/* Resume filling from whichever bank the controller will transmit from next */
+	if (EndpointFIFOPair->PingPong)
 	{
-		Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint ^ ENDPOINT_DIR_IN);
-		USB_Endpoint_SelectedHandle->CTRL |= USB_EP_STALL_bm;
+		EndpointFIFOPair->Bank = ((USB_Endpoint_SelectedHandle->STATUS & USB_EP_BANK_bm) ? 1 : 0);
+		Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint);
 	}
+
+	USB_Endpoint_SelectedFIFO->Position = 0;
 }
 
-uint8_t Endpoint_Read_8(void)
+void Endpoint_ResetEndpoint(const uint8_t Address)
 {
-	return USB_Endpoint_SelectedFIFO->Data[USB_Endpoint_SelectedFIFO->Position++];
+	Endpoint_FIFOPair_t* EndpointFIFOPair = &USB_Endpoint_FIFOs[Address & ENDPOINT_EPNUM_MASK];
+
+	if ((Address & ENDPOINT_DIR_IN) || EndpointFIFOPair->PingPong)
+	  EndpointFIFOPair->IN.Position  = 0;
+
+	if (!(Address & ENDPOINT_DIR_IN) || EndpointFIFOPair->PingPong)
+	  EndpointFIFOPair->OUT.Position = 0;
+
+	/* Resume from whichever bank the controller will use next, reselecting the current endpoint in case its bank changed */
+	if (EndpointFIFOPair->PingPong)
+	{
+		uint8_t PrevEndpoint = Endpoint_GetCurrentEndpoint();
+
+		Endpoint_SelectEndpoint(Address);
+		EndpointFIFOPair->Bank = ((USB_Endpoint_SelectedHandle->STATUS & USB_EP_BANK_bm) ? 1 : 0);
+		Endpoint_SelectEndpoint(PrevEndpoint);
+	}
 }
 
-void Endpoint_Write_8(const uint8_t Data)
+void Endpoint_StallTransaction(void)
 {
-	USB_Endpoint_SelectedFIFO->Data[USB_Endpoint_SelectedFIFO->Position++] = Data;
+	USB_Endpoint_SelectedHandle->CTRL |= USB_EP_STALL_bm;
+
+	if ((USB_Endpoint_SelectedHandle->CTRL & USB_EP_TYPE_gm) == USB_EP_TYPE_CONTROL_gc)
+	{
+		Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint ^ ENDPOINT_DIR_IN);
+		USB_Endpoint_SelectedHandle->CTRL |= USB_EP_STALL_bm;
+	}
 }
 
 void Endpoint_SelectEndpoint(const uint8_t Address)
@@ -136,16 +220,15 @@ void Endpoint_SelectEndpoint(const uint8_t Address)
 	Endpoint_FIFOPair_t* EndpointFIFOPair = &USB_Endpoint_FIFOs[EndpointNumber];
 	USB_EndpointTable_t* EndpointTable    = (USB_EndpointTable_t*)USB.EPPTR;
 
+	/* The second ping-pong bank's data lives in the opposite direction's FIFO */
+	bool UseINFIFO = ((Address & ENDPOINT_DIR_IN) ? true : false) ^ EndpointFIFOPair->Bank;
+
 	if (Address & ENDPOINT_DIR_IN)
-	{
-		USB_Endpoint_SelectedFIFO   = &EndpointFIFOPair->IN;
-		USB_Endpoint_SelectedHandle = &EndpointTable->Endpoints[EndpointNumber].IN;
-	}
+	  USB_Endpoint_SelectedHandle = &EndpointTable->Endpoints[EndpointNumber].IN;
 	else
-	{
-		USB_Endpoint_SelectedFIFO   = &EndpointFIFOPair->OUT;
-		USB_Endpoint_SelectedHandle = &EndpointTable->Endpoints[EndpointNumber].OUT;
-	}
+	  USB_Endpoint_SelectedHandle = &EndpointTable->Endpoints[EndpointNumber].OUT;
+
+	USB_Endpoint_SelectedFIFO = (UseINFIFO ? &EndpointFIFOPair->IN : &EndpointFIFOPair->OUT);
 }
 
 bool Endpoint_ConfigureEndpointTable(const USB_Endpoint_Table_t* const Table,
@@ -169,10 +252,43 @@ bool Endpoint_ConfigureEndpoint_PRV(const uint8_t Address,
                                     const uint8_t Config,
                                     const uint8_t Size)
 {
+	Endpoint_FIFOPair_t* EndpointFIFOPair = &USB_Endpoint_FIFOs[Address & ENDPOINT_EPNUM_MASK];
+	USB_EndpointTable_t* EndpointTable    = (USB_EndpointTable_t*)USB.EPPTR;
+	bool                 PingPong         = ((Config & USB_EP_PINGPONG_bm) ? true : false);
+	uint8_t              INBanksFree      = (PingPong ? (USB_EP_BUSNACK0_bm | USB_EP_BUSNACK1_bm) : USB_EP_BUSNACK0_bm);
+
+	volatile USB_EP_t* OppositeHandle = (Address & ENDPOINT_DIR_IN) ? &EndpointTable->Endpoints[Address & ENDPOINT_EPNUM_MASK].OUT :
+	                                                                  &EndpointTable->Endpoints[Address & ENDPOINT_EPNUM_MASK].IN;
+
+	/* A double banked endpoint uses the opposite direction's descriptor as its second bank, so cannot share its
+	 * endpoint number with a configured endpoint of the opposite direction */
+	if ((PingPong && ((OppositeHandle->CTRL & USB_EP_TYPE_gm) != USB_EP_TYPE_DISABLE_gc)) ||
+	    (OppositeHandle->CTRL & USB_EP_PINGPONG_bm))
+	{
+		return false;
+	}
+
+	EndpointFIFOPair->Bank     = 0;
+	EndpointFIFOPair->PingPong = PingPong;
+
+	if (PingPong)
+	{
+		/* Second bank, using the opposite direction's descriptor and FIFO */
+		Endpoint_SelectEndpoint(Address ^ ENDPOINT_DIR_IN);
+
+		USB_Endpoint_SelectedHandle->CTRL    = 0;
+		USB_Endpoint_SelectedHandle->STATUS  = 0;
+		USB_Endpoint_SelectedHandle->CNT     = 0;
+		USB_Endpoint_SelectedHandle->DATAPTR = (intptr_t)USB_Endpoint_SelectedFIFO->Data;
+
+		USB_Endpoint_SelectedFIFO->Length    = (Address & ENDPOINT_DIR_IN) ? Size : 0;
+		USB_Endpoint_SelectedFIFO->Position  = 0;
+	}
+
 	Endpoint_SelectEndpoint(Address);
 
 	USB_Endpoint_SelectedHandle->CTRL    = 0;
-	USB_Endpoint_SelectedHandle->STATUS  = (Address & ENDPOINT_DIR_IN) ? USB_EP_BUSNACK0_bm : 0;
+	USB_Endpoint_SelectedHandle->STATUS  = (Address & ENDPOINT_DIR_IN) ? INBanksFree : 0;
 	USB_Endpoint_SelectedHandle->CTRL    = Config;
 	USB_Endpoint_SelectedHandle->CNT     = 0;
 	USB_Endpoint_SelectedHandle->DATAPTR = (intptr_t)USB_Endpoint_SelectedFIFO->Data;
@@ -189,6 +305,9 @@ void Endpoint_ClearEndpoints(void)
 	{
 		((USB_EndpointTable_t*)USB.EPPTR)->Endpoints[EPNum].IN.CTRL  = 0;
 		((USB_EndpointTable_t*)USB.EPPTR)->Endpoints[EPNum].OUT.CTRL = 0;
+
+		USB_Endpoint_FIFOs[EPNum].Bank     = 0;
+		USB_Endpoint_FIFOs[EPNum].PingPong = false;
 	}
 }
 
@@ -262,6 +381,91 @@ uint8_t Endpoint_WaitUntilReady(void)
 }
 #endif
 
+#if !defined(CONTROL_ONLY_DEVICE) && defined(ENDPOINT_TRANSFER_USE_DMA)
+/* Returns the currently selected endpoint from a multi-packet transfer to its RAM FIFO */
+static inline void Endpoint_EndTransferDMA(void)
+{
+	USB_Endpoint_SelectedHandle->CTRL   &= ~USB_EP_MULTIPKT_bm;
+	USB_Endpoint_SelectedHandle->DATAPTR = (intptr_t)USB_Endpoint_SelectedFIFO->Data;
+	USB_Endpoint_SelectedHandle->CNT     = 0;
+	USB_Endpoint_SelectedHandle->AUXDATA = 0;
+
+	USB_Endpoint_SelectedFIFO->Position  = 0;
+
+	if (!(USB_Endpoint_SelectedEndpoint & ENDPOINT_DIR_IN))
+	{
+		USB_Endpoint_SelectedFIFO->Length = 0;
+		Endpoint_ClearStatusFlags(USB_EP_TRNCOMPL0_bm | USB_EP_BUSNACK0_bm | USB_EP_OVF_bm);
+	}
+	else
+	{
+		Endpoint_ClearStatusFlags(USB_EP_TRNCOMPL0_bm);
+	}
+}
+
+uint16_t Endpoint_StartTransferDMA_PRV(USB_Endpoint_Transfer_t* const Transfer)
+{
+	uint16_t PacketSize     = Transfer->Config.Endpoint->Size;
+	uint16_t BytesRemaining = (Transfer->Config.Length - Transfer->State.BytesTransferred);
+	uint16_t SegmentLength  = MIN(BytesRemaining, (ENDPOINT_MULTIPACKET_MAX_BYTES - (ENDPOINT_MULTIPACKET_MAX_BYTES % PacketSize)));
+
+	/* Ping-pong endpoints alternate between two descriptors, and so are left to the CPU copy path */
+	if (USB_Endpoint_FIFOs[USB_Endpoint_SelectedEndpoint & ENDPOINT_EPNUM_MASK].PingPong)
+	  return 0;
+
+	if (USB_Endpoint_SelectedEndpoint & ENDPOINT_DIR_IN)
+	{
+		/* A partially filled bank must be completed and sent from the FIFO first */
+		if (USB_Endpoint_SelectedFIFO->Position)
+		  return 0;
+
+		USB_Endpoint_SelectedHandle->CNT     = SegmentLength;
+		USB_Endpoint_SelectedHandle->AUXDATA = 0;
+	}
+	else
+	{
+		/* The controller always stores a whole received packet, so only whole packets can be received directly */
+		SegmentLength -= (SegmentLength % PacketSize);
+
+		if (!(SegmentLength))
+		  return 0;
+
+		USB_Endpoint_SelectedHandle->CNT     = 0;
+		USB_Endpoint_SelectedHandle->AUXDATA = SegmentLength;
+	}
+
+	USB_Endpoint_SelectedHandle->DATAPTR = (intptr_t)&((uint8_t*)Transfer->Config.Buffer)[Transfer->State.BytesTransferred];
+	USB_Endpoint_SelectedHandle->CTRL   |= USB_EP_MULTIPKT_bm;
+
+	Endpoint_ClearStatusFlags(USB_EP_TRNCOMPL0_bm | USB_EP_BUSNACK0_bm | USB_EP_OVF_bm);
+
+	return SegmentLength;
+}
+
+bool Endpoint_IsTransferDMAComplete_PRV(USB_Endpoint_Transfer_t* const Transfer,
+                                        uint16_t* const BytesTransferred)
+{
+	if (!(USB_Endpoint_SelectedHandle->STATUS & USB_EP_TRNCOMPL0_bm))
+	  return false;
+
+	if (USB_Endpoint_SelectedEndpoint & ENDPOINT_DIR_IN)
+	  *BytesTransferred = Transfer->State.SegmentLength;
+	else
+	  *BytesTransferred = USB_Endpoint_SelectedHandle->CNT;
+
+	Endpoint_EndTransferDMA();
+	return true;
+}
+
+void Endpoint_AbortTransferDMA_PRV(USB_Endpoint_Transfer_t* const Transfer)
+{
+	(void)Transfer;
+
+	Endpoint_SetStatusFlags(USB_EP_BUSNACK0_bm);
+	Endpoint_EndTransferDMA();
+}
+#endif
+
 #endif
 
 #endif
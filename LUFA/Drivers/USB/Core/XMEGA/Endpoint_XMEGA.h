@@ -106,6 +106,9 @@
 
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define ENDPOINT_MULTIPACKET_MAX_BYTES          1023
+
 		/* Type Defines: */
 			typedef struct
 			{
@@ -119,6 +122,9 @@
 			{
 				Endpoint_FIFO_t OUT;
 				Endpoint_FIFO_t IN;
+
+				uint8_t         Bank; /**< Ping-pong bank currently owned by the CPU, alternating between 0 and 1. */
+				bool            PingPong; /**< Indicates if the endpoint uses both hardware banks. */
 			} Endpoint_FIFOPair_t;
 
 		/* External Variables: */
@@ -213,6 +219,12 @@
 			 *        it is automatically configured by the library internally.
 			 *        \n\n
 			 *
+			 *  \note When two banks are requested, the XMEGA USB controller uses the descriptor of the opposite
+			 *        direction of the same endpoint number as the second bank. A double banked endpoint therefore
+			 *        occupies its endpoint number in both directions, and configuration fails if the opposite
+			 *        direction is already in use. Control endpoints are always single banked.
+			 *        \n\n
+			 *
 			 *  \note This routine will automatically select the specified endpoint.
 			 *
 			 *  \return Boolean \c true if the configuration succeeded, \c false otherwise.
@@ -231,8 +243,10 @@
 				if ((Address & ENDPOINT_EPNUM_MASK) >= ENDPOINT_TOTAL_ENDPOINTS)
 				  return false;
 
-				// TODO - Fix once limitations are lifted
-				EPConfigMask &= ~USB_EP_PINGPONG_bm;
+				/* Control endpoints use both directions, so cannot borrow the opposite direction as a second bank */
+				if (Type == EP_TYPE_CONTROL)
+				  EPConfigMask &= ~USB_EP_PINGPONG_bm;
+
 				if (Size > 64)
 				  return false;
 
@@ -282,20 +296,6 @@
 				return USB_Endpoint_SelectedEndpoint;
 			}
 
-			/** Resets the endpoint bank FIFO. This clears all the endpoint banks and resets the USB controller's
-			 *  data In and Out pointers to the bank's contents.
-			 *
-			 *  \param[in] Address  Endpoint address whose FIFO buffers are to be reset.
-			 */
-			static inline void Endpoint_ResetEndpoint(const uint8_t Address) ATTR_ALWAYS_INLINE;
-			static inline void Endpoint_ResetEndpoint(const uint8_t Address)
-			{
-				if (Address & ENDPOINT_DIR_IN)
-				  USB_Endpoint_FIFOs[Address & ENDPOINT_EPNUM_MASK].IN.Position  = 0;
-				else
-				  USB_Endpoint_FIFOs[Address & ENDPOINT_EPNUM_MASK].OUT.Position = 0;
-			}
-
 			/** Determines if the currently selected endpoint is enabled, but not necessarily configured.
 			 *
 			 * \return Boolean \c true if the currently selected endpoint is enabled, \c false otherwise.
@@ -313,10 +313,17 @@
 			 *
 			 *  \ingroup Group_EndpointPacketManagement_XMEGA
 			 */
-			static inline void Endpoint_AbortPendingIN(void)
-			{
-				USB_Endpoint_SelectedHandle->STATUS |= USB_EP_BUSNACK0_bm;
-			}
+			void Endpoint_AbortPendingIN(void);
+
+			/** Resets the endpoint bank FIFO. This clears all the endpoint banks and resets the USB controller's
+			 *  data In and Out pointers to the bank's contents. For double banked endpoints, the bank used next by
+			 *  the CPU is resynchronized with the bank the USB controller will use next.
+			 *
+			 *  \note This routine preserves the currently selected endpoint.
+			 *
+			 *  \param[in] Address  Endpoint address whose FIFO buffers are to be reset.
+			 */
+			void Endpoint_ResetEndpoint(const uint8_t Address);
 
 			/** Determines if the currently selected endpoint may be read from (if data is waiting in the endpoint
 			 *  bank and the endpoint is an OUT direction, or if the bank is not yet full if the endpoint is an IN
@@ -450,7 +457,11 @@
 			 *
 			 *  \return Next byte in the currently selected endpoint's FIFO buffer.
 			 */
-			uint8_t Endpoint_Read_8(void) ATTR_WARN_UNUSED_RESULT;
+			static inline uint8_t Endpoint_Read_8(void) ATTR_WARN_UNUSED_RESULT ATTR_ALWAYS_INLINE;
+			static inline uint8_t Endpoint_Read_8(void)
+			{
+				return USB_Endpoint_SelectedFIFO->Data[USB_Endpoint_SelectedFIFO->Position++];
+			}
 
 			/** Writes one byte to the currently selected endpoint's bank, for IN direction endpoints.
 			 *
@@ -458,7 +469,11 @@
 			 *
 			 *  \param[in] Data  Data to write into the the currently selected endpoint's FIFO buffer.
 			 */
-			void Endpoint_Write_8(const uint8_t Data);
+			static inline void Endpoint_Write_8(const uint8_t Data) ATTR_ALWAYS_INLINE;
+			static inline void Endpoint_Write_8(const uint8_t Data)
+			{
+				USB_Endpoint_SelectedFIFO->Data[USB_Endpoint_SelectedFIFO->Position++] = Data;
+			}
 
 			/** Discards one byte from the currently selected endpoint's bank, for OUT direction endpoints.
 			 *
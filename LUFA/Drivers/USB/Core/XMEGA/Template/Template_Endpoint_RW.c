@@ -68,10 +68,26 @@ uint8_t TEMPLATE_FUNC_NAME (TEMPLATE_BUFFER_TYPE const Buffer,
 		}
 		else
 		{
-			TEMPLATE_TRANSFER_BYTE(DataStream);
-			TEMPLATE_BUFFER_MOVE(DataStream, 1);
-			Length--;
-			BytesInTransfer++;
+			/* The endpoint bank is a plain RAM buffer, so transfer everything that fits into the current bank at once
+			 * rather than rechecking the bank status for each byte */
+			uint8_t  BankPosition = USB_Endpoint_SelectedFIFO->Position;
+			uint16_t BytesInBank  = MIN(Length, (uint8_t)(USB_Endpoint_SelectedFIFO->Length - BankPosition));
+
+			Length          -= BytesInBank;
+			BytesInTransfer += BytesInBank;
+
+			#if defined(TEMPLATE_TRANSFER_BLOCK)
+			TEMPLATE_TRANSFER_BLOCK(DataStream, (uint8_t*)&USB_Endpoint_SelectedFIFO->Data[BankPosition], BytesInBank);
+			TEMPLATE_BUFFER_MOVE(DataStream, BytesInBank);
+
+			USB_Endpoint_SelectedFIFO->Position = (BankPosition + BytesInBank);
+			#else
+			while (BytesInBank--)
+			{
+				TEMPLATE_TRANSFER_BYTE(DataStream);
+				TEMPLATE_BUFFER_MOVE(DataStream, 1);
+			}
+			#endif
 		}
 	}
 
@@ -81,6 +97,7 @@ uint8_t TEMPLATE_FUNC_NAME (TEMPLATE_BUFFER_TYPE const Buffer,
 #undef TEMPLATE_FUNC_NAME
 #undef TEMPLATE_BUFFER_TYPE
 #undef TEMPLATE_TRANSFER_BYTE
+#undef TEMPLATE_TRANSFER_BLOCK
 #undef TEMPLATE_CLEAR_ENDPOINT
 #undef TEMPLATE_BUFFER_OFFSET
 #undef TEMPLATE_BUFFER_MOVE
@@ -45,6 +45,7 @@
  *  The following files must be built with any user project that uses this module:
  *    - LUFA/Drivers/USB/Core/ConfigDescriptors.c <i>(Makefile source module name: LUFA_SRC_USB)</i>
  *    - LUFA/Drivers/USB/Core/DeviceStandardReq.c <i>(Makefile source module name: LUFA_SRC_USB)</i>
+ *    - LUFA/Drivers/USB/Core/EndpointTransfer.c <i>(Makefile source module name: LUFA_SRC_USB)</i>
  *    - LUFA/Drivers/USB/Core/Events.c <i>(Makefile source module name: LUFA_SRC_USB)</i>
  *    - LUFA/Drivers/USB/Core/HostStandardReq.c <i>(Makefile source module name: LUFA_SRC_USB)</i>
  *    - LUFA/Drivers/USB/Core/USBTask.c <i>(Makefile source module name: LUFA_SRC_USB)</i>
@@ -402,6 +403,7 @@
 			#include "Core/Endpoint.h"
 			#include "Core/DeviceStandardReq.h"
 			#include "Core/EndpointStream.h"
+			#include "Core/EndpointTransfer.h"
 		#endif
 
 		#if defined(USB_CAN_BE_BOTH) || defined(__DOXYGEN__)
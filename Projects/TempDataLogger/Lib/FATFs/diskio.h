@@ -11,7 +11,8 @@ extern "C" {
 
 #include "integer.h"
 
-#include "../DataflashManager.h"
+#include <LUFA/Drivers/Misc/DataflashStorage.h>
+#include "../../TempDataLogger.h"
 
 
 /* Status of Disk Functions */
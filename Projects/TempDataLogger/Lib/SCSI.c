@@ -116,9 +116,14 @@ bool SCSI_DecodeSCSICommand(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
 		case SCSI_CMD_MODE_SENSE_6:
 			CommandSuccess = SCSI_Command_ModeSense_6(MSInterfaceInfo);
 			break;
+		case SCSI_CMD_SYNCHRONIZE_CACHE_10:
 		case SCSI_CMD_START_STOP_UNIT:
 		case SCSI_CMD_TEST_UNIT_READY:
 		case SCSI_CMD_PREVENT_ALLOW_MEDIUM_REMOVAL:
+			/* Commit any cached written data to the Dataflash, as the host may be about to remove the media */
+			CommandSuccess = (BlockDevice_Flush(&DataflashStorage_BlockDevice) == BLOCKDEVICE_ERROR_NoError);
+			MSInterfaceInfo->State.CommandBlock.DataTransferLength = 0;
+			break;
 		case SCSI_CMD_VERIFY_10:
 			/* These commands should just succeed, no handling required */
 			CommandSuccess = true;
@@ -249,7 +254,7 @@ static bool SCSI_Command_Send_Diagnostic(USB_ClassInfo_MS_Device_t* const MSInte
 	}
 
 	/* Check to see if all attached Dataflash ICs are functional */
-	if (!(DataflashManager_CheckDataflashOperation()))
+	if (!(DataflashStorage_CheckOperation()))
 	{
 		/* Update SENSE key with a hardware error condition and return command fail */
 		SCSI_SET_SENSE(SCSI_SENSE_KEY_HARDWARE_ERROR,
@@ -266,8 +271,9 @@ static bool SCSI_Command_Send_Diagnostic(USB_ClassInfo_MS_Device_t* const MSInte
 }
 
 /** Command processing for an issued SCSI READ (10) or WRITE (10) command. This command reads in the block start address
- *  and total number of blocks to process, then calls the appropriate low-level Dataflash routine to handle the actual
- *  reading and writing of the data.
+ *  and total number of blocks to process, then calls the appropriate block device routine to handle the actual
+ *  reading and writing of the data. The data is transferred incrementally; this is called again for the same command
+ *  each time the data endpoint is ready, until the transfer completes.
  *
  *  \param[in] MSInterfaceInfo  Pointer to the Mass Storage class interface structure that the command is associated with
  *  \param[in] IsDataRead  Indicates if the command is a READ (10) command or WRITE (10) command (DATA_READ or DATA_WRITE)
@@ -279,6 +285,7 @@ static bool SCSI_Command_ReadWrite_10(USB_ClassInfo_MS_Device_t* const MSInterfa
 {
 	uint32_t BlockAddress;
 	uint16_t TotalBlocks;
+	uint8_t  ErrorCode;
 
 	/* Check if the disk is write protected or not */
 	if ((IsDataRead == DATA_WRITE) && DISK_READ_ONLY)
@@ -310,9 +317,35 @@ static bool SCSI_Command_ReadWrite_10(USB_ClassInfo_MS_Device_t* const MSInterfa
 
 	/* Determine if the packet is a READ (10) or WRITE (10) command, call appropriate function */
 	if (IsDataRead == DATA_READ)
-	  DataflashManager_ReadBlocks(MSInterfaceInfo, BlockAddress, TotalBlocks);
+	  ErrorCode = BlockDevice_ReadBlocks(&DataflashStorage_BlockDevice, BlockAddress, TotalBlocks, BLOCKDEVICE_ENDPOINT,
+	                                     &MSInterfaceInfo->State.IsMassStoreReset, &MSInterfaceInfo->State.DataBytesProcessed);
 	else
-	  DataflashManager_WriteBlocks(MSInterfaceInfo, BlockAddress, TotalBlocks);
+	  ErrorCode = BlockDevice_WriteBlocks(&DataflashStorage_BlockDevice, BlockAddress, TotalBlocks, BLOCKDEVICE_ENDPOINT,
+	                                      &MSInterfaceInfo->State.IsMassStoreReset, &MSInterfaceInfo->State.DataBytesProcessed);
+
+	/* If the endpoint would block, keep the data phase pending so that the transfer is resumed when the endpoint is ready */
+	MSInterfaceInfo->State.IsDataPhasePending = (ErrorCode == BLOCKDEVICE_ERROR_IncompleteTransfer);
+
+	if (MSInterfaceInfo->State.IsDataPhasePending)
+	  return true;
+
+	/* Check if the blocks could not be transferred, update SENSE key and return command fail if so */
+	if (ErrorCode == BLOCKDEVICE_ERROR_OutOfRange)
+	{
+		SCSI_SET_SENSE(SCSI_SENSE_KEY_ILLEGAL_REQUEST,
+		               SCSI_ASENSE_LOGICAL_BLOCK_ADDRESS_OUT_OF_RANGE,
+		               SCSI_ASENSEQ_NO_QUALIFIER);
+
+		return false;
+	}
+	else if (ErrorCode != BLOCKDEVICE_ERROR_NoError)
+	{
+		SCSI_SET_SENSE(SCSI_SENSE_KEY_HARDWARE_ERROR,
+		               SCSI_ASENSE_NO_ADDITIONAL_INFORMATION,
+		               SCSI_ASENSEQ_NO_QUALIFIER);
+
+		return false;
+	}
 
 	/* Update the bytes transferred counter and succeed the command */
 	MSInterfaceInfo->State.CommandBlock.DataTransferLength -= ((uint32_t)TotalBlocks * VIRTUAL_MEMORY_BLOCK_SIZE);
@@ -216,14 +216,14 @@ void SetupHardware(void)
 	TIMSK1  = (1 << OCIE1A);
 
 	/* Check if the Dataflash is working, abort if not */
-	if (!(DataflashManager_CheckDataflashOperation()))
+	if (!(DataflashStorage_CheckOperation()))
 	{
 		LEDs_SetAllLEDs(LEDMASK_USB_ERROR);
 		for(;;);
 	}
 
 	/* Clear Dataflash sector protections, if enabled */
-	DataflashManager_ResetDataflashProtections();
+	DataflashStorage_ResetProtections();
 }
 
 /** Event handler for the library USB Connection event. */
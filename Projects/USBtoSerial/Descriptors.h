@@ -55,7 +55,16 @@
 		#define CDC_NOTIFICATION_EPSIZE        8
 
 		/** Size in bytes of the CDC data IN and OUT endpoints. */
-		#define CDC_TXRX_EPSIZE                16
+		#if defined(USB_SERIES_2_AVR)
+			#define CDC_TXRX_EPSIZE            16
+		#else
+			#define CDC_TXRX_EPSIZE            64
+		#endif
+
+		/** Number of hardware banks used by the CDC data IN and OUT endpoints, so that one bank can be filled or emptied
+		 *  while the other is being transferred to or from the host.
+		 */
+		#define CDC_TXRX_EPBANKS               2
 
 	/* Type Defines: */
 		/** Type define for the device configuration descriptor structure. This must be defined in the
@@ -61,13 +61,13 @@ USB_ClassInfo_CDC_Device_t VirtualSerial_CDC_Interface =
 					{
 						.Address                = CDC_TX_EPADDR,
 						.Size                   = CDC_TXRX_EPSIZE,
-						.Banks                  = 1,
+						.Banks                  = CDC_TXRX_EPBANKS,
 					},
 				.DataOUTEndpoint                =
 					{
 						.Address                = CDC_RX_EPADDR,
 						.Size                   = CDC_TXRX_EPSIZE,
-						.Banks                  = 1,
+						.Banks                  = CDC_TXRX_EPBANKS,
 					},
 				.NotificationEndpoint           =
 					{
@@ -94,44 +94,18 @@ int main(void)
 
 	for (;;)
 	{
-		/* Only try to read in bytes from the CDC interface if the transmit buffer is not full */
-		if (!(RingBuffer_IsFull(&USBtoUSART_Buffer)))
-		{
-			int16_t ReceivedByte = CDC_Device_ReceiveByte(&VirtualSerial_CDC_Interface);
-
-			/* Store received byte into the USART transmit buffer */
-			if (!(ReceivedByte < 0))
-			  RingBuffer_Insert(&USBtoUSART_Buffer, ReceivedByte);
-		}
-
-		uint16_t BufferCount = RingBuffer_GetCount(&USARTtoUSB_Buffer);
-		if (BufferCount)
-		{
-			Endpoint_SelectEndpoint(VirtualSerial_CDC_Interface.Config.DataINEndpoint.Address);
-
-			/* Check if a packet is already enqueued to the host - if so, we shouldn't try to send more data
-			 * until it completes as there is a chance nothing is listening and a lengthy timeout could occur */
-			if (Endpoint_IsINReady())
-			{
-				/* Never send more than one bank size less one byte to the host at a time, so that we don't block
-				 * while a Zero Length Packet (ZLP) to terminate the transfer is sent if the host isn't listening */
-				uint8_t BytesToSend = MIN(BufferCount, (CDC_TXRX_EPSIZE - 1));
-
-				/* Read bytes from the USART receive buffer into the USB IN endpoint */
-				while (BytesToSend--)
-				{
-					/* Try to send the next byte of data to the host, abort if there is an error without dequeuing */
-					if (CDC_Device_SendByte(&VirtualSerial_CDC_Interface,
-											RingBuffer_Peek(&USARTtoUSB_Buffer)) != ENDPOINT_READYWAIT_NoError)
-					{
-						break;
-					}
-
-					/* Dequeue the already sent byte from the buffer now we have confirmed that no transmission error occurred */
-					RingBuffer_Remove(&USARTtoUSB_Buffer);
-				}
-			}
-		}
+		uint8_t* BufferSpan;
+		uint16_t SpanLength;
+
+		/* Read received bytes from the CDC interface directly into the free space of the USART transmit buffer */
+		if ((SpanLength = RingBuffer_GetWriteSpan(&USBtoUSART_Buffer, &BufferSpan)) != 0)
+		  RingBuffer_CommitWrite(&USBtoUSART_Buffer, CDC_Device_ReceiveSpan(&VirtualSerial_CDC_Interface, BufferSpan, SpanLength));
+
+		/* Write bytes from the USART receive buffer directly into the USB IN endpoint, dequeuing only the bytes the
+		 * endpoint accepted - if all endpoint banks are still waiting to be read by the host nothing is written, so
+		 * that a lengthy timeout cannot occur if nothing is listening */
+		if ((SpanLength = RingBuffer_GetReadSpan(&USARTtoUSB_Buffer, &BufferSpan)) != 0)
+		  RingBuffer_CommitRead(&USARTtoUSB_Buffer, CDC_Device_SendSpan(&VirtualSerial_CDC_Interface, BufferSpan, SpanLength));
 
 		/* Load the next byte from the USART transmit buffer into the USART if transmit buffer space is available */
 		if (Serial_IsSendReady() && !(RingBuffer_IsEmpty(&USBtoUSART_Buffer)))
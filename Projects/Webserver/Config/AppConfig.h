@@ -47,6 +47,8 @@
 	#define ENABLE_DHCP_SERVER
 	#define ENABLE_TELNET_SERVER
 	#define MAX_URI_LENGTH                50
+	#define HTTP_SECTOR_CACHE_SECTORS     2
+	#define HTTP_KEEPALIVE_TIMEOUT        5
 
 	#define DEVICE_IP_ADDRESS             (uint8_t[]){ 10,   0,   0,   2}
 	#define DEVICE_NETMASK                (uint8_t[]){255, 255, 255,   0}
@@ -60,6 +62,7 @@
 	#define UIP_CONF_MAX_CONNECTIONS      3
 	#define UIP_CONF_MAX_LISTENPORTS      5
 	#define UIP_CONF_BUFFER_SIZE          1514
+	#define UIP_CONF_BUFFER_HEADROOM      44
 	#define UIP_CONF_LL_802154            0
 	#define UIP_CONF_LL_80211             0
 	#define UIP_CONF_ROUTER               0
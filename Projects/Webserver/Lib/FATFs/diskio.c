@@ -41,7 +41,9 @@ DRESULT disk_read (
 	BYTE count		/* Number of sectors to read (1..128) */
 )
 {
-	DataflashManager_ReadBlocks_RAM(sector, count, buff);
+	if (BlockDevice_ReadBlocks(&DataflashStorage_BlockDevice, sector, count, buff, NULL, NULL) != BLOCKDEVICE_ERROR_NoError)
+	  return RES_ERROR;
+
 	return RES_OK;
 }
 
@@ -58,7 +60,9 @@ DRESULT disk_write (
 	BYTE count			/* Number of sectors to write (1..128) */
 )
 {
-	DataflashManager_WriteBlocks_RAM(sector, count, buff);
+	if (BlockDevice_WriteBlocks(&DataflashStorage_BlockDevice, sector, count, buff, NULL, NULL) != BLOCKDEVICE_ERROR_NoError)
+	  return RES_ERROR;
+
 	return RES_OK;
 }
 #endif /* _READONLY */
@@ -12,7 +12,7 @@ extern "C" {
 #include "integer.h"
 #include "ff.h"
 
-#include "../DataflashManager.h"
+#include <LUFA/Drivers/Misc/DataflashStorage.h>
 
 
 /* Status of Disk Functions */
@@ -37,14 +37,31 @@
 #define  INCLUDE_FROM_HTTPSERVERAPP_C
 #include "HTTPServerApp.h"
 
-/** HTTP server response header, for transmission before the page contents. This indicates to the host that a page exists at the
- *  given location, and gives extra connection information.
+/** HTTP server response header for persistent connections, for transmission before the page contents. This indicates to the
+ *  host that a page exists at the given location, and gives extra connection information. The file length and MIME type are
+ *  appended to the header when the response is sent.
  */
-const char PROGMEM HTTP200Header[] = "HTTP/1.1 200 OK\r\n"
-                                     "Server: LUFA " LUFA_VERSION_STRING "\r\n"
-                                     "Connection: close\r\n"
-                                     "MIME-version: 1.0\r\n"
-                                     "Content-Type: ";
+const char PROGMEM HTTP200KeepAliveHeader[] = "HTTP/1.1 200 OK\r\n"
+                                              "Server: LUFA " LUFA_VERSION_STRING "\r\n"
+                                              "Connection: keep-alive\r\n"
+                                              "MIME-version: 1.0\r\n"
+                                              "Content-Length: ";
+
+/** HTTP server response header for connections closed after the response, for transmission before the page contents. This
+ *  indicates to the host that a page exists at the given location, and gives extra connection information. The file length and
+ *  MIME type are appended to the header when the response is sent.
+ */
+const char PROGMEM HTTP200CloseHeader[] = "HTTP/1.1 200 OK\r\n"
+                                          "Server: LUFA " LUFA_VERSION_STRING "\r\n"
+                                          "Connection: close\r\n"
+                                          "MIME-version: 1.0\r\n"
+                                          "Content-Length: ";
+
+/** HTTP server response header field name for the MIME type, sent after the file length in the response header. */
+const char PROGMEM HTTPContentTypeField[] = "\r\nContent-Type: ";
+
+/** HTTP server response header terminator, sent after the MIME type in the response header. */
+const char PROGMEM HTTPHeaderTerminator[] = "\r\n\r\n";
 
 /** HTTP server response header, for transmission before a resource not found error. This indicates to the host that the given
  *  URL is invalid, and gives extra error information.
@@ -56,30 +73,61 @@ const char PROGMEM HTTP404Header[] = "HTTP/1.1 404 Not Found\r\n"
                                      "Content-Type: text/plain\r\n\r\n"
                                      "Error 404: File Not Found: /";
 
+/** Request method and URI prefix of the only supported request type, matched case sensitively. */
+const char PROGMEM HTTPGetRequest[] = "GET /";
+
+/** HTTP version of clients supporting persistent connections, matched case insensitively against the request line. */
+const char PROGMEM HTTPVersion11[] = "http/1.1";
+
+/** Request header line closing the connection after the response, matched case insensitively against each request header. */
+const char PROGMEM HTTPConnectionCloseHeader[] = "connection: close";
+
 /** Default filename to fetch when a directory is requested */
 const char PROGMEM DefaultDirFileName[] = "index.htm";
 
 /** Default MIME type sent if no other MIME type can be determined. */
 const char PROGMEM DefaultMIMEType[] = "text/plain";
 
-/** List of MIME types for each supported file extension. */
-const MIME_Type_t MIMETypes[] =
+/** Table of MIME types for each supported file extension, indexed by the perfect hash of each extension so that the MIME type
+ *  of a file can be found with a single comparison. Unused table entries have an empty extension.
+ */
+const MIME_Type_t PROGMEM MIMETypes[HTTP_MIME_TABLE_SIZE] =
 	{
-		{.Extension = "htm", .MIMEType = "text/html"},
-		{.Extension = "jpg", .MIMEType = "image/jpeg"},
-		{.Extension = "gif", .MIMEType = "image/gif"},
-		{.Extension = "bmp", .MIMEType = "image/bmp"},
-		{.Extension = "png", .MIMEType = "image/png"},
-		{.Extension = "ico", .MIMEType = "image/x-icon"},
-		{.Extension = "exe", .MIMEType = "application/octet-stream"},
-		{.Extension = "gz",  .MIMEType = "application/x-gzip"},
-		{.Extension = "zip", .MIMEType = "application/zip"},
-		{.Extension = "pdf", .MIMEType = "application/pdf"},
+		[HTTP_MIME_HASH('h', 't', 'm')] = {.Extension = "htm", .MIMEType = "text/html"},
+		[HTTP_MIME_HASH('j', 'p', 'g')] = {.Extension = "jpg", .MIMEType = "image/jpeg"},
+		[HTTP_MIME_HASH('g', 'i', 'f')] = {.Extension = "gif", .MIMEType = "image/gif"},
+		[HTTP_MIME_HASH('b', 'm', 'p')] = {.Extension = "bmp", .MIMEType = "image/bmp"},
+		[HTTP_MIME_HASH('p', 'n', 'g')] = {.Extension = "png", .MIMEType = "image/png"},
+		[HTTP_MIME_HASH('i', 'c', 'o')] = {.Extension = "ico", .MIMEType = "image/x-icon"},
+		[HTTP_MIME_HASH('e', 'x', 'e')] = {.Extension = "exe", .MIMEType = "application/octet-stream"},
+		[HTTP_MIME_HASH('g', 'z',  0 )] = {.Extension = "gz",  .MIMEType = "application/x-gzip"},
+		[HTTP_MIME_HASH('z', 'i', 'p')] = {.Extension = "zip", .MIMEType = "application/zip"},
+		[HTTP_MIME_HASH('p', 'd', 'f')] = {.Extension = "pdf", .MIMEType = "application/pdf"},
 	};
 
+/* Each supported extension must hash to a unique MIME table index - if this check fails after an extension is added, the
+   hash multipliers in HTTP_MIME_HASH() must be changed so that the hash remains perfect */
+_Static_assert(((1UL << HTTP_MIME_HASH('h', 't', 'm')) + (1UL << HTTP_MIME_HASH('j', 'p', 'g')) +
+                (1UL << HTTP_MIME_HASH('g', 'i', 'f')) + (1UL << HTTP_MIME_HASH('b', 'm', 'p')) +
+                (1UL << HTTP_MIME_HASH('p', 'n', 'g')) + (1UL << HTTP_MIME_HASH('i', 'c', 'o')) +
+                (1UL << HTTP_MIME_HASH('e', 'x', 'e')) + (1UL << HTTP_MIME_HASH('g', 'z',  0 )) +
+                (1UL << HTTP_MIME_HASH('z', 'i', 'p')) + (1UL << HTTP_MIME_HASH('p', 'd', 'f'))) ==
+               ((1UL << HTTP_MIME_HASH('h', 't', 'm')) | (1UL << HTTP_MIME_HASH('j', 'p', 'g')) |
+                (1UL << HTTP_MIME_HASH('g', 'i', 'f')) | (1UL << HTTP_MIME_HASH('b', 'm', 'p')) |
+                (1UL << HTTP_MIME_HASH('p', 'n', 'g')) | (1UL << HTTP_MIME_HASH('i', 'c', 'o')) |
+                (1UL << HTTP_MIME_HASH('e', 'x', 'e')) | (1UL << HTTP_MIME_HASH('g', 'z',  0 )) |
+                (1UL << HTTP_MIME_HASH('z', 'i', 'p')) | (1UL << HTTP_MIME_HASH('p', 'd', 'f'))),
+               "MIME type extension hash collision");
+
 /** FATFs structure to hold the internal state of the FAT driver for the Dataflash contents. */
 FATFS DiskFATState;
 
+/** Read-ahead cache of file sectors, shared between all HTTP connections. */
+static HTTP_CachedSector_t SectorCache[HTTP_SECTOR_CACHE_SECTORS];
+
+/** Counter used to timestamp each access to the sector cache, so that the least recently used sector can be replaced. */
+static uint16_t SectorCacheAccessCount;
+
 
 /** Initialization function for the simple HTTP webserver. */
 void HTTPServerApp_Init(void)
@@ -113,6 +161,9 @@ void HTTPServerApp_Callback(void)
 		AppState->HTTPServer.FileOpen      = false;
 		AppState->HTTPServer.ACKedFilePos  = 0;
 		AppState->HTTPServer.SentChunkSize = 0;
+		AppState->HTTPServer.IdleStartTime = clock_time();
+		AppState->HTTPServer.RequestParseState = HTTP_REQUEST_PARSE_Method;
+		AppState->HTTPServer.RequestParseIndex = 0;
 	}
 
 	if (uip_acked())
@@ -124,12 +175,6 @@ void HTTPServerApp_Callback(void)
 		AppState->HTTPServer.CurrentState = AppState->HTTPServer.NextState;
 	}
 
-	if (uip_rexmit())
-	{
-		/* Return file pointer to the last ACKed position */
-		f_lseek(&AppState->HTTPServer.FileHandle, AppState->HTTPServer.ACKedFilePos);
-	}
-
 	if (uip_rexmit() || uip_acked() || uip_newdata() || uip_connected() || uip_poll())
 	{
 		switch (AppState->HTTPServer.CurrentState)
@@ -159,43 +204,64 @@ void HTTPServerApp_Callback(void)
 }
 
 /** HTTP Server State handler for the Request Process state. This state manages the processing of incoming HTTP
- *  GET requests to the server from the receiving HTTP client.
+ *  GET requests to the server from the receiving HTTP client. Requests are parsed incrementally as each segment
+ *  arrives, so that requests split across several segments are handled.
  */
 static void HTTPServerApp_OpenRequestedFile(void)
 {
 	uip_tcp_appstate_t* const AppState    = &uip_conn->appstate;
 	char*               const AppData     = (char*)uip_appdata;
 
-	/* No HTTP header received from the client, abort processing */
-	if (!(uip_newdata()))
-	  return;
-
-	char* RequestToken      = strtok(AppData, " ");
-	char* RequestedFileName = strtok(NULL, " ");
+	/* Close the file sent in response to the previous request on a persistent connection */
+	if (AppState->HTTPServer.FileOpen)
+	{
+		f_close(&AppState->HTTPServer.FileHandle);
+		AppState->HTTPServer.FileOpen = false;
+	}
 
-	/* Must be a GET request, abort otherwise */
-	if (strcmp_P(RequestToken, PSTR("GET")) != 0)
+	/* No HTTP header received from the client, close the connection if it has been idle for too long */
+	if (!(uip_newdata()))
 	{
-		uip_abort();
+		if ((clock_time_t)(clock_time() - AppState->HTTPServer.IdleStartTime) > (HTTP_KEEPALIVE_TIMEOUT * CLOCK_SECOND))
+		{
+			AppState->HTTPServer.CurrentState = WEBSERVER_STATE_Closing;
+			AppState->HTTPServer.NextState    = WEBSERVER_STATE_Closing;
+		}
+
 		return;
 	}
 
-	/* Copy over the requested filename */
-	strlcpy(AppState->HTTPServer.FileName, &RequestedFileName[1], sizeof(AppState->HTTPServer.FileName));
+	/* Process the received part of the request, waiting for the next segment if the request is not yet complete */
+	switch (HTTPServerApp_ParseRequest(AppData, uip_datalen()))
+	{
+		case HTTP_REQUEST_Incomplete:
+			return;
+		case HTTP_REQUEST_Invalid:
+			/* Must be a GET request, abort otherwise */
+			uip_abort();
+			return;
+	}
 
 	/* Determine the length of the URI so that it can be checked to see if it is a directory */
 	uint8_t FileNameLen = strlen(AppState->HTTPServer.FileName);
 
 	/* If the URI is a directory, append the default filename */
-	if ((AppState->HTTPServer.FileName[FileNameLen - 1] == '/') || !(FileNameLen))
+	if (!(FileNameLen) || (AppState->HTTPServer.FileName[FileNameLen - 1] == '/'))
 	{
 		strlcpy_P(&AppState->HTTPServer.FileName[FileNameLen], DefaultDirFileName,
 		          (sizeof(AppState->HTTPServer.FileName) - FileNameLen));
 	}
 
+	/* Discard the cached file sectors if no other connection is sending a file, so that changes to the disk contents
+	   made by the host through the Mass Storage interface are picked up */
+	if (!(HTTPServerApp_IsAnyFileOpen()))
+	  HTTPServerApp_InvalidateSectorCache();
+
 	/* Try to open the file from the Dataflash disk */
-	AppState->HTTPServer.FileOpen     = (f_open(&AppState->HTTPServer.FileHandle, AppState->HTTPServer.FileName,
-	                                            (FA_OPEN_EXISTING | FA_READ)) == FR_OK);
+	AppState->HTTPServer.FileOpen      = (f_open(&AppState->HTTPServer.FileHandle, AppState->HTTPServer.FileName,
+	                                             (FA_OPEN_EXISTING | FA_READ)) == FR_OK);
+	AppState->HTTPServer.ACKedFilePos  = 0;
+	AppState->HTTPServer.SentChunkSize = 0;
 
 	/* Lock to the SendResponseHeader state until connection terminated */
 	AppState->HTTPServer.CurrentState = WEBSERVER_STATE_SendResponseHeader;
@@ -210,8 +276,7 @@ static void HTTPServerApp_SendResponseHeader(void)
 	uip_tcp_appstate_t* const AppState    = &uip_conn->appstate;
 	char*               const AppData     = (char*)uip_appdata;
 
-	char* Extension     = strpbrk(AppState->HTTPServer.FileName, ".");
-	bool  FoundMIMEType = false;
+	char* HeaderEnd = AppData;
 
 	/* If the file isn't already open, it wasn't found - send back a 404 error response and abort */
 	if (!(AppState->HTTPServer.FileOpen))
@@ -225,60 +290,321 @@ static void HTTPServerApp_SendResponseHeader(void)
 		return;
 	}
 
-	/* Copy over the HTTP 200 response header and send it to the receiving client */
-	strcpy_P(AppData, HTTP200Header);
-
-	/* Check to see if a MIME type for the requested file's extension was found */
-	if (Extension != NULL)
+	/* Copy over the precompiled HTTP 200 response header for the connection persistence, up to the file length */
+	if (AppState->HTTPServer.KeepAlive)
 	{
-		/* Look through the MIME type list, copy over the required MIME type if found */
-		for (uint8_t i = 0; i < (sizeof(MIMETypes) / sizeof(MIMETypes[0])); i++)
-		{
-			if (strcmp(&Extension[1], MIMETypes[i].Extension) == 0)
-			{
-				strcat(AppData, MIMETypes[i].MIMEType);
-				FoundMIMEType = true;
-				break;
-			}
-		}
+		memcpy_P(HeaderEnd, HTTP200KeepAliveHeader, (sizeof(HTTP200KeepAliveHeader) - 1));
+		HeaderEnd += (sizeof(HTTP200KeepAliveHeader) - 1);
 	}
-
-	/* Check if a MIME type was found and copied to the output buffer */
-	if (!(FoundMIMEType))
+	else
 	{
-		/* MIME type not found - copy over the default MIME type */
-		strcat_P(AppData, DefaultMIMEType);
+		memcpy_P(HeaderEnd, HTTP200CloseHeader, (sizeof(HTTP200CloseHeader) - 1));
+		HeaderEnd += (sizeof(HTTP200CloseHeader) - 1);
 	}
 
+	/* Fill in the file length */
+	ultoa(f_size(&AppState->HTTPServer.FileHandle), HeaderEnd, 10);
+	HeaderEnd += strlen(HeaderEnd);
+
+	/* Add the MIME type for the requested file's extension */
+	memcpy_P(HeaderEnd, HTTPContentTypeField, (sizeof(HTTPContentTypeField) - 1));
+	HeaderEnd += (sizeof(HTTPContentTypeField) - 1);
+
+	strcpy_P(HeaderEnd, HTTPServerApp_GetMIMEType(AppState->HTTPServer.FileName));
+	HeaderEnd += strlen(HeaderEnd);
+
 	/* Add the end-of-line terminator and end-of-headers terminator after the MIME type */
-	strcat_P(AppData, PSTR("\r\n\r\n"));
+	memcpy_P(HeaderEnd, HTTPHeaderTerminator, (sizeof(HTTPHeaderTerminator) - 1));
+	HeaderEnd += (sizeof(HTTPHeaderTerminator) - 1);
 
 	/* Send the MIME header to the receiving client */
-	uip_send(AppData, strlen(AppData));
+	uip_send(AppData, (HeaderEnd - AppData));
 
-	/* When the MIME header is ACKed, progress to the data send stage */
-	AppState->HTTPServer.NextState = WEBSERVER_STATE_SendData;
+	/* When the MIME header is ACKed, progress to the data send stage, unless there is no file data to send */
+	if (f_size(&AppState->HTTPServer.FileHandle))
+	  AppState->HTTPServer.NextState = WEBSERVER_STATE_SendData;
+	else
+	  HTTPServerApp_CompleteResponse();
 }
 
 /** HTTP Server State handler for the Data Send state. This state manages the transmission of file chunks
- *  to the receiving HTTP client.
+ *  to the receiving HTTP client. Each chunk is assembled from the shared sector cache starting at the last
+ *  ACKed file position, so that retransmissions are normally served from the cache without seeking the file.
  */
 static void HTTPServerApp_SendData(void)
 {
 	uip_tcp_appstate_t* const AppState    = &uip_conn->appstate;
 	char*               const AppData     = (char*)uip_appdata;
 
-	/* Get the maximum segment size for the current packet */
-	uint16_t MaxChunkSize = uip_mss();
+	uint32_t FilePos    = AppState->HTTPServer.ACKedFilePos;
+	uint16_t ChunkSize  = MIN(uip_mss(), (f_size(&AppState->HTTPServer.FileHandle) - FilePos));
+	uint16_t BytesAdded = 0;
+
+	/* Copy the next chunk of the file out of the cached file sectors */
+	while (BytesAdded < ChunkSize)
+	{
+		const HTTP_CachedSector_t* CachedSector = HTTPServerApp_GetFileSector(&AppState->HTTPServer.FileHandle,
+		                                                                      (FilePos / _MAX_SS));
+		uint16_t SectorOffset = (FilePos % _MAX_SS);
+
+		if ((CachedSector == NULL) || (CachedSector->Length <= SectorOffset))
+		  break;
+
+		uint16_t BytesToCopy = MIN((uint16_t)(ChunkSize - BytesAdded), (uint16_t)(CachedSector->Length - SectorOffset));
+
+		memcpy(&AppData[BytesAdded], &CachedSector->Data[SectorOffset], BytesToCopy);
 
-	/* Read the next chunk of data from the open file */
-	f_read(&AppState->HTTPServer.FileHandle, AppData, MaxChunkSize, &AppState->HTTPServer.SentChunkSize);
+		BytesAdded += BytesToCopy;
+		FilePos    += BytesToCopy;
+	}
+
+	/* Abort the connection if the file could not be read, as the client has already been sent the file length */
+	if (BytesAdded != ChunkSize)
+	{
+		uip_abort();
+		return;
+	}
 
 	/* Send the next file chunk to the receiving client */
-	uip_send(AppData, AppState->HTTPServer.SentChunkSize);
+	AppState->HTTPServer.SentChunkSize = ChunkSize;
+	uip_send(AppData, ChunkSize);
+
+	/* Check if we are at the last chunk of the file, if so the next ACK should either close the connection or await the next request */
+	if (FilePos == f_size(&AppState->HTTPServer.FileHandle))
+	  HTTPServerApp_CompleteResponse();
+}
 
-	/* Check if we are at the last chunk of the file, if so next ACK should close the connection */
-	if (MaxChunkSize != AppState->HTTPServer.SentChunkSize)
-	  AppState->HTTPServer.NextState = WEBSERVER_STATE_Closing;
+/** Sets the state the current connection should enter once the response to the current request has been sent,
+ *  either closing the connection, or awaiting the next request on a persistent connection.
+ */
+static void HTTPServerApp_CompleteResponse(void)
+{
+	uip_tcp_appstate_t* const AppState = &uip_conn->appstate;
+
+	AppState->HTTPServer.NextState     = (AppState->HTTPServer.KeepAlive) ? WEBSERVER_STATE_OpenRequestedFile : WEBSERVER_STATE_Closing;
+	AppState->HTTPServer.IdleStartTime = clock_time();
+
+	/* Prepare to parse the next request on a persistent connection from its start */
+	AppState->HTTPServer.RequestParseState = HTTP_REQUEST_PARSE_Method;
+	AppState->HTTPServer.RequestParseIndex = 0;
 }
 
+/** Processes the next received part of a HTTP request on the current connection, extracting the requested filename and
+ *  the connection persistence as each character is received. The parse state is retained in the connection state between
+ *  calls, so that requests may be split across any number of received segments. The received data is not modified.
+ *
+ *  \param[in] Data    Pointer to the next received part of the request.
+ *  \param[in] Length  Number of bytes of request data to process.
+ *
+ *  \return A value from the \ref HTTP_RequestParseResults_t enum.
+ */
+static uint8_t HTTPServerApp_ParseRequest(const char* Data,
+                                          uint16_t Length)
+{
+	uip_tcp_appstate_t* const AppState = &uip_conn->appstate;
+
+	uint8_t ParseIndex = AppState->HTTPServer.RequestParseIndex;
+
+	while (Length--)
+	{
+		char Character = *(Data++);
+
+		switch (AppState->HTTPServer.RequestParseState)
+		{
+			case HTTP_REQUEST_PARSE_Method:
+				/* Must be a GET request for an absolute path, abort otherwise */
+				if (Character != pgm_read_byte(&HTTPGetRequest[ParseIndex]))
+				  return HTTP_REQUEST_Invalid;
+
+				if (++ParseIndex == (sizeof(HTTPGetRequest) - 1))
+				{
+					AppState->HTTPServer.RequestParseState = HTTP_REQUEST_PARSE_URI;
+					AppState->HTTPServer.KeepAlive         = false;
+					ParseIndex = 0;
+				}
+
+				break;
+			case HTTP_REQUEST_PARSE_URI:
+				if ((Character == ' ') || (Character == '\n'))
+				{
+					AppState->HTTPServer.FileName[ParseIndex] = '\0';
+					ParseIndex = 0;
+
+					/* Simple requests without a version have no headers, and are complete at the end of the request line */
+					if (Character == '\n')
+					  return HTTP_REQUEST_Complete;
+
+					AppState->HTTPServer.RequestParseState = HTTP_REQUEST_PARSE_Version;
+				}
+				else if ((Character != '\r') && (ParseIndex < (sizeof(AppState->HTTPServer.FileName) - 1)))
+				{
+					/* Copy over the requested filename, truncating it if it is too long */
+					AppState->HTTPServer.FileName[ParseIndex++] = Character;
+				}
+
+				break;
+			case HTTP_REQUEST_PARSE_Version:
+				if (Character == '\n')
+				{
+					/* Keep the connection open for further requests if the client supports HTTP/1.1 persistent connections */
+					AppState->HTTPServer.KeepAlive         = (ParseIndex == (sizeof(HTTPVersion11) - 1));
+					AppState->HTTPServer.RequestParseState = HTTP_REQUEST_PARSE_Headers;
+					ParseIndex = 0;
+				}
+				else if (Character != '\r')
+				{
+					ParseIndex = HTTPServerApp_MatchCharacter(ParseIndex, Character, HTTPVersion11);
+				}
+
+				break;
+			case HTTP_REQUEST_PARSE_Headers:
+				if (Character == '\n')
+				{
+					/* An empty line terminates the request headers */
+					if (!(ParseIndex))
+					  return HTTP_REQUEST_Complete;
+
+					if (ParseIndex == (sizeof(HTTPConnectionCloseHeader) - 1))
+					  AppState->HTTPServer.KeepAlive = false;
+
+					ParseIndex = 0;
+				}
+				else if (Character != '\r')
+				{
+					ParseIndex = HTTPServerApp_MatchCharacter(ParseIndex, Character, HTTPConnectionCloseHeader);
+				}
+
+				break;
+		}
+	}
+
+	AppState->HTTPServer.RequestParseIndex = ParseIndex;
+	return HTTP_REQUEST_Incomplete;
+}
+
+/** Matches the next character of a received request against a lower case string, ignoring the case of the received character.
+ *
+ *  \param[in] MatchIndex  Number of characters of the string matched so far, or \ref HTTP_REQUEST_PARSE_MISMATCH.
+ *  \param[in] Character   Next received character to match.
+ *  \param[in] String      Lower case string to match against, stored in FLASH memory.
+ *
+ *  \return Number of characters of the string now matched, or \ref HTTP_REQUEST_PARSE_MISMATCH if the received characters
+ *          do not match the string.
+ */
+static uint8_t HTTPServerApp_MatchCharacter(const uint8_t MatchIndex,
+                                           const char Character,
+                                           const char* const String)
+{
+	if ((MatchIndex == HTTP_REQUEST_PARSE_MISMATCH) || (tolower(Character) != pgm_read_byte(&String[MatchIndex])))
+	  return HTTP_REQUEST_PARSE_MISMATCH;
+
+	return (MatchIndex + 1);
+}
+
+/** Retrieves the MIME type to send for the given file, from the file's extension. The extension is looked up in the MIME type
+ *  table via its perfect hash, so that only a single table entry needs to be compared.
+ *
+ *  \param[in] FileName  Name of the file to retrieve the MIME type of.
+ *
+ *  \return Pointer to the MIME type string in FLASH memory, or the default MIME type if the file's extension is not supported.
+ */
+static const char* HTTPServerApp_GetMIMEType(const char* const FileName)
+{
+	char* Extension = strpbrk(FileName, ".");
+	char  LowerCaseExtension[sizeof(MIMETypes[0].Extension)] = {0};
+
+	/* Check to see if the requested file has an extension short enough to be in the MIME type table */
+	if ((Extension == NULL) || !(Extension[1]) || (strlen(&Extension[1]) >= sizeof(LowerCaseExtension)))
+	  return DefaultMIMEType;
+
+	for (uint8_t i = 0; Extension[i + 1]; i++)
+	  LowerCaseExtension[i] = tolower(Extension[i + 1]);
+
+	const MIME_Type_t* MIMEType = &MIMETypes[HTTP_MIME_HASH(LowerCaseExtension[0], LowerCaseExtension[1], LowerCaseExtension[2])];
+
+	/* Check that the table entry the extension hashes to is the entry for the extension */
+	if (strcmp_P(LowerCaseExtension, MIMEType->Extension) != 0)
+	  return DefaultMIMEType;
+
+	return MIMEType->MIMEType;
+}
+
+/** Retrieves the given sector of an open file from the shared sector cache, reading it from the disk into the least
+ *  recently used cache entry if it is not already cached.
+ *
+ *  \param[in,out] FileHandle   Handle of the open file to read from.
+ *  \param[in]     FileSector   Index of the sector within the file to retrieve.
+ *
+ *  \return Pointer to the cached sector, or \c NULL if the sector could not be read.
+ */
+static const HTTP_CachedSector_t* HTTPServerApp_GetFileSector(FIL* const FileHandle,
+                                                             const uint32_t FileSector)
+{
+	HTTP_CachedSector_t* CachedSector = &SectorCache[0];
+
+	for (uint8_t i = 0; i < HTTP_SECTOR_CACHE_SECTORS; i++)
+	{
+		/* Return the sector if it has already been read in for this or another connection serving the same file */
+		if (SectorCache[i].Length && (SectorCache[i].FileCluster == FileHandle->sclust) &&
+		    (SectorCache[i].FileSector == FileSector))
+		{
+			SectorCache[i].LastAccess = ++SectorCacheAccessCount;
+			return &SectorCache[i];
+		}
+
+		/* Track an unused or the least recently used entry, for replacement if the sector is not cached */
+		if (CachedSector->Length && (!(SectorCache[i].Length) ||
+		    ((uint16_t)(SectorCacheAccessCount - SectorCache[i].LastAccess) >
+		     (uint16_t)(SectorCacheAccessCount - CachedSector->LastAccess))))
+		{
+			CachedSector = &SectorCache[i];
+		}
+	}
+
+	/* Seek only if the file is not already positioned at the sector, which is normally the case when sending sequentially */
+	if ((f_tell(FileHandle) != (FileSector * _MAX_SS)) && (f_lseek(FileHandle, (FileSector * _MAX_SS)) != FR_OK))
+	  return NULL;
+
+	UINT BytesRead;
+
+	/* Whole sector aligned reads are transferred by FatFs directly from the disk into the cache entry */
+	if ((f_read(FileHandle, CachedSector->Data, _MAX_SS, &BytesRead) != FR_OK) || !(BytesRead))
+	{
+		CachedSector->Length = 0;
+		return NULL;
+	}
+
+	CachedSector->FileCluster = FileHandle->sclust;
+	CachedSector->FileSector  = FileSector;
+	CachedSector->Length      = BytesRead;
+	CachedSector->LastAccess  = ++SectorCacheAccessCount;
+
+	return CachedSector;
+}
+
+/** Discards all sectors held in the shared sector cache. */
+static void HTTPServerApp_InvalidateSectorCache(void)
+{
+	for (uint8_t i = 0; i < HTTP_SECTOR_CACHE_SECTORS; i++)
+	  SectorCache[i].Length = 0;
+}
+
+/** Determines if any HTTP connection other than the current connection has a file open.
+ *
+ *  \return Boolean \c true if another connection has a file open, \c false otherwise.
+ */
+static bool HTTPServerApp_IsAnyFileOpen(void)
+{
+	for (uint8_t i = 0; i < UIP_CONNS; i++)
+	{
+		struct uip_conn* Connection = &uip_conns[i];
+
+		if ((Connection != uip_conn) && (Connection->tcpstateflags != UIP_CLOSED) &&
+		    (Connection->lport == HTONS(HTTP_SERVER_PORT)) && Connection->appstate.HTTPServer.FileOpen)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -38,9 +38,12 @@
 
 	/* Includes: */
 		#include <avr/pgmspace.h>
+		#include <ctype.h>
+		#include <stdlib.h>
 		#include <string.h>
 
 		#include <LUFA/Version.h>
+		#include <LUFA/Common/Common.h>
 
 		#include "Config/AppConfig.h"
 
@@ -58,18 +61,56 @@
 			WEBSERVER_STATE_Closed, /**< Connection closed after all data sent */
 		};
 
+		/** States for the incremental parsing of each HTTP request received by the webserver. */
+		enum HTTP_RequestParseStates_t
+		{
+			HTTP_REQUEST_PARSE_Method, /**< Currently matching the request method */
+			HTTP_REQUEST_PARSE_URI, /**< Currently copying the requested URI */
+			HTTP_REQUEST_PARSE_Version, /**< Currently matching the HTTP version of the request line */
+			HTTP_REQUEST_PARSE_Headers, /**< Currently matching the request header lines */
+		};
+
+		/** Results of processing part of a HTTP request via \c HTTPServerApp_ParseRequest(). */
+		enum HTTP_RequestParseResults_t
+		{
+			HTTP_REQUEST_Incomplete, /**< All received request data was processed, but the request is incomplete */
+			HTTP_REQUEST_Complete, /**< The complete request has been received and processed */
+			HTTP_REQUEST_Invalid, /**< The request is malformed or uses an unsupported method */
+		};
+
 	/* Type Defines: */
-		/** Type define for a MIME type handler. */
+		/** Type define for a MIME type handler, stored in FLASH memory. */
 		typedef struct
 		{
-			char* Extension; /**< File extension (no leading '.' character) */
-			char* MIMEType;  /**< Appropriate MIME type to send when the extension is encountered */
+			char Extension[4]; /**< Lower case file extension (no leading '.' character), empty for unused table entries */
+			char MIMEType[25]; /**< Appropriate MIME type to send when the extension is encountered */
 		} MIME_Type_t;
 
+		/** Type define for a file sector held in the shared sector cache. */
+		typedef struct
+		{
+			uint32_t FileCluster; /**< Start cluster of the file the sector belongs to, identifying the file */
+			uint32_t FileSector; /**< Index of the sector within the file */
+			uint16_t Length; /**< Number of valid bytes in the sector, zero if the cache entry is unused */
+			uint16_t LastAccess; /**< Value of the cache access counter when the sector was last used */
+			uint8_t  Data[_MAX_SS]; /**< Cached sector data */
+		} HTTP_CachedSector_t;
+
 	/* Macros: */
 		/** TCP listen port for incoming HTTP traffic. */
 		#define HTTP_SERVER_PORT  80
 
+		/** Number of entries in the MIME type table, which must be a power of two. */
+		#define HTTP_MIME_TABLE_SIZE  16
+
+		/** Perfect hash of a lower case file extension of up to three characters, giving the extension's index in the MIME type
+		 *  table. Unused trailing characters of shorter extensions must be zero.
+		 */
+		#define HTTP_MIME_HASH(c1, c2, c3)  ((((c1) * 5) + ((c2) << 3) + (c3)) & (HTTP_MIME_TABLE_SIZE - 1))
+
+		/** Request parse match index indicating that the received characters do not match the string being matched. */
+		#define HTTP_REQUEST_PARSE_MISMATCH  0xFF
+
 	/* Function Prototypes: */
 		void HTTPServerApp_Init(void);
 		void HTTPServerApp_Callback(void);
@@ -78,6 +119,17 @@
 			static void HTTPServerApp_OpenRequestedFile(void);
 			static void HTTPServerApp_SendResponseHeader(void);
 			static void HTTPServerApp_SendData(void);
+			static void HTTPServerApp_CompleteResponse(void);
+			static uint8_t HTTPServerApp_ParseRequest(const char* Data,
+			                                          uint16_t Length);
+			static uint8_t HTTPServerApp_MatchCharacter(const uint8_t MatchIndex,
+			                                           const char Character,
+			                                           const char* const String);
+			static const char* HTTPServerApp_GetMIMEType(const char* const FileName);
+			static const HTTP_CachedSector_t* HTTPServerApp_GetFileSector(FIL* const FileHandle,
+			                                                             const uint32_t FileSector);
+			static void HTTPServerApp_InvalidateSectorCache(void);
+			static bool HTTPServerApp_IsAnyFileOpen(void);
 		#endif
 
 #endif
@@ -161,6 +161,55 @@ void uIPManagement_UDPCallback(void)
 	}
 }
 
+/** Determines if a received frame should be processed by the uIP stack, from the frame headers at the start of the uIP
+ *  packet buffer. Frames which would be dropped by the stack, such as multicast, IPv6 and IP packets destined for other
+ *  hosts, are rejected so that the remainder of the frame need not be read in.
+ *
+ *  \param[in] HeaderLength  Number of bytes of the frame currently stored in the uIP packet buffer.
+ *
+ *  \return Boolean \c true if the frame should be processed, \c false if it should be discarded.
+ */
+static bool uIPManagement_IsFrameAccepted(const uint16_t HeaderLength)
+{
+	struct uip_eth_hdr* EthernetHeader = (struct uip_eth_hdr*)uip_buf;
+
+	if (HeaderLength < sizeof(struct uip_eth_hdr))
+	  return false;
+
+	/* Reject frames not addressed to this host's MAC address or the broadcast address */
+	if (memcmp(&EthernetHeader->dest, &uip_ethaddr, sizeof(struct uip_eth_addr)))
+	{
+		for (uint8_t i = 0; i < sizeof(struct uip_eth_addr); i++)
+		{
+			if (EthernetHeader->dest.addr[i] != 0xFF)
+			  return false;
+		}
+	}
+
+	switch (EthernetHeader->type)
+	{
+		case HTONS(UIP_ETHTYPE_ARP):
+			return true;
+		case HTONS(UIP_ETHTYPE_IP):
+			break;
+		default:
+			return false;
+	}
+
+	/* Accept all IP packets until an IP address has been assigned */
+	if (uip_ipaddr_cmp(&uip_hostaddr, &uip_all_zeroes_addr))
+	  return true;
+
+	if (HeaderLength < (UIP_LLH_LEN + UIP_IPH_LEN))
+	  return false;
+
+	struct uip_udpip_hdr* IPHeader = (struct uip_udpip_hdr*)&uip_buf[UIP_LLH_LEN];
+
+	/* Accept packets for this host's IP address, and broadcast UDP packets */
+	return (uip_ipaddr_cmp(&IPHeader->destipaddr, &uip_hostaddr) ||
+	        ((IPHeader->proto == UIP_PROTO_UDP) && uip_ipaddr_cmp(&IPHeader->destipaddr, &uip_broadcast_addr)));
+}
+
 /** Processes Incoming packets to the server from the connected RNDIS device, creating responses as needed. */
 static void uIPManagement_ProcessIncomingPacket(void)
 {
@@ -173,8 +222,24 @@ static void uIPManagement_ProcessIncomingPacket(void)
 
 		LEDs_SetAllLEDs(LEDMASK_USB_BUSY);
 
-		/* Read the Incoming packet straight into the UIP packet buffer */
-		RNDIS_Device_ReadPacket(&Ethernet_RNDIS_Interface_Device, uip_buf, &uip_len);
+		uint16_t FrameLength;
+		RNDIS_Device_ReadPacketHeader(&Ethernet_RNDIS_Interface_Device, &FrameLength);
+
+		/* Read in only the frame headers first, straight into the UIP packet buffer */
+		uint16_t HeaderLength = MIN(FrameLength, (UIP_LLH_LEN + UIP_IPH_LEN));
+		RNDIS_Device_ReadPacketData(&Ethernet_RNDIS_Interface_Device, uip_buf, HeaderLength);
+
+		/* Read in the rest of the frame if it is to be processed, otherwise discard it without copying it */
+		if ((FrameLength <= UIP_BUFSIZE) && uIPManagement_IsFrameAccepted(HeaderLength))
+		{
+			RNDIS_Device_ReadPacketData(&Ethernet_RNDIS_Interface_Device, &uip_buf[HeaderLength], (FrameLength - HeaderLength));
+			uip_len = FrameLength;
+		}
+		else
+		{
+			RNDIS_Device_DiscardPacketData(&Ethernet_RNDIS_Interface_Device);
+			uip_len = 0;
+		}
 	}
 	else
 	{
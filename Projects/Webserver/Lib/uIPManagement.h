@@ -61,6 +61,7 @@
 		void uIPManagement_UDPCallback(void);
 
 		#if defined(INCLUDE_FROM_UIPMANAGEMENT_C)
+			static bool uIPManagement_IsFrameAccepted(const uint16_t HeaderLength);
 			static void uIPManagement_ProcessIncomingPacket(void);
 			static void uIPManagement_ManageConnections(void);
 		#endif
@@ -38,6 +38,52 @@
 
 #define BUF ((struct uip_tcpip_hdr *)&uip_buf[UIP_LLH_LEN])
 
+/* The RNDIS packet message header of each outgoing frame is written in
+   place into the room reserved in front of the frame */
+_Static_assert(UIP_CONF_BUFFER_HEADROOM == sizeof(RNDIS_Packet_Message_t),
+               "uIP buffer headroom must fit the RNDIS packet message header");
+
+/*-----------------------------------------------------------------------------*/
+static void
+uip_split_send(u8_t *frame)
+{
+	RNDIS_Packet_Message_t* Message = (RNDIS_Packet_Message_t*)(frame - UIP_CONF_BUFFER_HEADROOM);
+
+	if (USB_CurrentMode == USB_MODE_Device)
+	  RNDIS_Device_SendPacketMessage(&Ethernet_RNDIS_Interface_Device, Message, uip_len);
+	else
+	  RNDIS_Host_SendPacketMessage(&Ethernet_RNDIS_Interface_Host, Message, uip_len);
+}
+/*-----------------------------------------------------------------------------*/
+#if UIP_TCP && !UIP_CONF_IPV6
+static u16_t
+uip_split_chksum_add(u16_t sum, u16_t data_sum)
+{
+  sum += data_sum;
+  if(sum < data_sum) {
+    sum++;		/* carry */
+  }
+
+  return sum;
+}
+/*-----------------------------------------------------------------------------*/
+static u16_t
+uip_split_tcpchksum(u8_t *data, u16_t datalen)
+{
+  u16_t sum;
+
+  /* Sum the pseudo-header and the TCP header in the packet buffer,
+     followed by the payload wherever it is located. */
+  sum = UIP_PROTO_TCP + UIP_TCPH_LEN + datalen;
+  sum = uip_split_chksum_add(sum, ntohs(uip_chksum((u16_t *)&BUF->srcipaddr,
+                                                   2 * sizeof(uip_ipaddr_t))));
+  sum = uip_split_chksum_add(sum, ntohs(uip_chksum((u16_t *)&uip_buf[UIP_LLH_LEN + UIP_IPH_LEN],
+                                                   UIP_TCPH_LEN)));
+  sum = uip_split_chksum_add(sum, ntohs(uip_chksum((u16_t *)data, datalen)));
+
+  return (sum == 0) ? 0xffff : htons(sum);
+}
+#endif /* UIP_TCP && !UIP_CONF_IPV6 */
 /*-----------------------------------------------------------------------------*/
 void
 uip_split_output(void)
@@ -83,54 +129,56 @@ uip_split_output(void)
 #if UIP_CONF_IPV6
     tcpip_ipv6_output();
 #else
-	if (USB_CurrentMode == USB_MODE_Device)
-	  RNDIS_Device_SendPacket(&Ethernet_RNDIS_Interface_Device, uip_buf, uip_len);
-	else
-	  RNDIS_Host_SendPacket(&Ethernet_RNDIS_Interface_Host, uip_buf, uip_len);
+	uip_split_send(uip_buf);
 #endif /* UIP_CONF_IPV6 */
 
     /* Now, create the second packet. To do this, it is not enough to
        just alter the length field, but we must also update the TCP
-       sequence number and point the uip_appdata to a new place in
-       memory. This place is determined by the length of the first
-       packet (len1). */
+       sequence number. The headers are then moved up to directly
+       precede the payload of the second packet, which is located
+       after the payload of the first packet (len1), so that the
+       payload itself is not copied. */
     uip_len = len2 + UIP_TCPIP_HLEN + UIP_LLH_LEN;
 #if UIP_CONF_IPV6
     /* For IPv6, the IP length field does not include the IPv6 IP header
        length. */
     BUF->len[0] = ((uip_len - UIP_IPH_LEN) >> 8);
     BUF->len[1] = ((uip_len - UIP_IPH_LEN) & 0xff);
+
+    memcpy(uip_appdata, (u8_t *)uip_appdata + len1, len2);
 #else /* UIP_CONF_IPV6 */
     BUF->len[0] = (uip_len  - UIP_LLH_LEN) >> 8;
     BUF->len[1] = (uip_len - UIP_LLH_LEN) & 0xff;
 #endif /* UIP_CONF_IPV6 */
 
-    memcpy(uip_appdata, (u8_t *)uip_appdata + len1, len2);
-
     uip_add32(BUF->seqno, len1);
     BUF->seqno[0] = uip_acc32[0];
     BUF->seqno[1] = uip_acc32[1];
     BUF->seqno[2] = uip_acc32[2];
     BUF->seqno[3] = uip_acc32[3];
 
+#if UIP_CONF_IPV6
     /* Recalculate the TCP checksum. */
     BUF->tcpchksum = 0;
     BUF->tcpchksum = ~(uip_tcpchksum());
 
-#if !UIP_CONF_IPV6
+    /* Transmit the second packet. */
+    tcpip_ipv6_output();
+#else
+    /* Recalculate the TCP checksum, over the payload where it lies. */
+    BUF->tcpchksum = 0;
+    BUF->tcpchksum = ~(uip_split_tcpchksum((u8_t *)uip_appdata + len1, len2));
+
     /* Recalculate the IP checksum. */
     BUF->ipchksum = 0;
     BUF->ipchksum = ~(uip_ipchksum());
-#endif /* UIP_CONF_IPV6 */
 
-    /* Transmit the second packet. */
-#if UIP_CONF_IPV6
-    tcpip_ipv6_output();
-#else
-	if (USB_CurrentMode == USB_MODE_Device)
-	  RNDIS_Device_SendPacket(&Ethernet_RNDIS_Interface_Device, uip_buf, uip_len);
-	else
-	  RNDIS_Host_SendPacket(&Ethernet_RNDIS_Interface_Host, uip_buf, uip_len);
+    /* Transmit the second packet, with its headers moved over the end
+       of the already transmitted first packet's payload. */
+    u8_t *frame = (u8_t *)uip_appdata + len1 - (UIP_TCPIP_HLEN + UIP_LLH_LEN);
+
+    memmove(frame, uip_buf, UIP_TCPIP_HLEN + UIP_LLH_LEN);
+	uip_split_send(frame);
 #endif /* UIP_CONF_IPV6 */
     return;
   }
@@ -140,10 +188,7 @@ uip_split_output(void)
 #if UIP_CONF_IPV6
 	tcpip_ipv6_output();
 #else
-	if (USB_CurrentMode == USB_MODE_Device)
-	  RNDIS_Device_SendPacket(&Ethernet_RNDIS_Interface_Device, uip_buf, uip_len);
-	else
-	  RNDIS_Host_SendPacket(&Ethernet_RNDIS_Interface_Host, uip_buf, uip_len);
+	uip_split_send(uip_buf);
 #endif /* UIP_CONF_IPV6 */
 }
 
@@ -126,8 +126,15 @@ struct uip_eth_addr uip_ethaddr = {{0,0,0,0,0,0}};
 #endif
 
 #ifndef UIP_CONF_EXTERNAL_BUFFER
+#ifdef UIP_CONF_BUFFER_HEADROOM
+u8_t uip_headroom_buf[UIP_CONF_BUFFER_HEADROOM + UIP_BUFSIZE + 2];
+				 /* The packet buffer that contains
+				    incoming packets, preceded by room
+				    for the device driver's header. */
+#else
 u8_t uip_buf[UIP_BUFSIZE + 2];   /* The packet buffer that contains
 				    incoming packets. */
+#endif /* UIP_CONF_BUFFER_HEADROOM */
 #endif /* UIP_CONF_EXTERNAL_BUFFER */
 
 void *uip_appdata;               /* The uip_appdata pointer points to
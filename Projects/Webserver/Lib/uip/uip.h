@@ -472,8 +472,18 @@ void uip_reass_over(void);
  }
  }
  \endcode
+ *
+ * If UIP_CONF_BUFFER_HEADROOM is defined, the given number of bytes
+ * are reserved in front of the uip_buf array, so that the network
+ * device driver can add its own encapsulation header to an outgoing
+ * frame in place.
 */
+#ifdef UIP_CONF_BUFFER_HEADROOM
+extern u8_t uip_headroom_buf[UIP_CONF_BUFFER_HEADROOM + UIP_BUFSIZE + 2];
+#define uip_buf (&uip_headroom_buf[UIP_CONF_BUFFER_HEADROOM])
+#else
 extern u8_t uip_buf[UIP_BUFSIZE+2];
+#endif /* UIP_CONF_BUFFER_HEADROOM */
 
 
 
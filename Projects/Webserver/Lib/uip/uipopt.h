@@ -698,6 +698,10 @@ typedef union
 		bool     FileOpen;
 		uint32_t ACKedFilePos;
 		uint16_t SentChunkSize;
+		bool     KeepAlive;
+		clock_time_t IdleStartTime;
+		uint8_t  RequestParseState;
+		uint8_t  RequestParseIndex;
 	} HTTPServer;
 
 	struct